@@ -630,7 +630,7 @@ FareBookingCodeValidator::validate(const uint32_t& bitIndex,
   }
   else
   {
-    pTfare.swapInFlightSegmentStatus(bitIndex, segmentStatusVec);
+    pTfare.setFlightSegmentStatus(bitIndex, segmentStatusVec);
     pTfare.setFlightBookingCodeStatus(bitIndex, bookingCodeStatus);
   }
 
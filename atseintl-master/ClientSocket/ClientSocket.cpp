@@ -87,8 +87,6 @@ ClientSocket::receive(std::string& command,
                       std::string& revision,
                       std::string& response)
 {
-  char responseBuf[_ioBufSize + 1];
-
   if (!command.empty())
     command.erase();
 
@@ -148,6 +146,45 @@ ClientSocket::receive(std::string& command,
 
   LOG4CXX_DEBUG(logger, "numNeeded: " << numNeeded);
 
+  if (numNeeded == eo::CHUNKED_PAYLOAD_SIZE)
+    return readChunks(response);
+
+  return readPayload(numNeeded, response);
+}
+
+bool
+ClientSocket::readChunks(std::string& response)
+{
+  for (;;)
+  {
+    uint32_t chunkSize = 0;
+    if (_socket.read(&chunkSize, sizeof(chunkSize), _timeout, 0L) < 0)
+    {
+      const char* socketErrMsg;
+      const long socketErrNo = _socket.getLastError(&socketErrMsg);
+
+      LOG4CXX_FATAL(logger,
+                    "Impl: " << this << ", chunk size read error: " << _socket.getChannel()
+                             << " - socket error: " << socketErrNo << ": " << socketErrMsg);
+
+      return false;
+    }
+
+    // an empty chunk ends the response
+    chunkSize = ntohl(chunkSize);
+    if (chunkSize == 0)
+      return true;
+
+    if (!readPayload(chunkSize, response))
+      return false;
+  }
+}
+
+bool
+ClientSocket::readPayload(uint32_t numNeeded, std::string& response)
+{
+  char responseBuf[_ioBufSize + 1];
+
   while (numNeeded > 0)
   {
     // Read XML
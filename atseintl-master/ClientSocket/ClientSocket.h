@@ -92,6 +92,9 @@ public:
             const std::string& request);
 
 private:
+  bool readPayload(uint32_t numNeeded, std::string& response);
+  bool readChunks(std::string& response);
+
   // Generic trx header
   struct TrxHeader
   {
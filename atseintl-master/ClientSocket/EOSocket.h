@@ -16,6 +16,7 @@
 
 #include <netinet/in.h>
 
+#include <cstdint>
 #include <string>
 
 namespace eo
@@ -40,6 +41,10 @@ const long WRITE_ERROR = -99;
 const long SEC_MAX = 100000000;
 const long USEC_MAX = 1000000;
 
+// payload size in the header of a response sent in chunks, each one prefixed
+// with its length; shared by the server and ClientSocket
+const uint32_t CHUNKED_PAYLOAD_SIZE = 0xffffffff;
+
 class Socket final
 {
   template <typename Type>
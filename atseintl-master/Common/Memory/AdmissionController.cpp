@@ -0,0 +1,314 @@
+//------------------------------------------------------------------
+//
+//  Copyright Sabre 2015
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//-------------------------------------------------------------------
+#include "Common/Memory/AdmissionController.h"
+
+#include "Common/ErrorResponseException.h"
+#include "Common/Logger.h"
+#include "Common/Memory/Config.h"
+#include "Common/Memory/GlobalManager.h"
+#include "Common/Memory/TrxManager.h"
+#include "DataModel/PricingOptions.h"
+#include "DataModel/PricingTrx.h"
+#include "DataModel/ShoppingTrx.h"
+
+#include <algorithm>
+#include <ostream>
+
+namespace tse
+{
+namespace Memory
+{
+namespace
+{
+Logger
+logger("atseintl.Common.Memory.AdmissionController");
+
+// Each requested option adds a tenth of the size of the request.
+constexpr uint64_t OPTIONS_PER_UNIT = 10;
+
+// Weight of the unit size observed for a finished trx, 1/8.
+constexpr size_t CALIBRATION_SHIFT = 3;
+
+const char* const decisionNames[] = {"ADMITTED", "DEGRADED", "QUEUED", "REJECTED"};
+
+PricingOptions*
+degradableOptions(Trx& trx)
+{
+  PricingTrx* pricingTrx = dynamic_cast<PricingTrx*>(&trx);
+  if (!pricingTrx || !pricingTrx->getOptions())
+    return nullptr;
+
+  if (pricingTrx->getOptions()->getRequestedNumberOfSolutions() <= 1)
+    return nullptr;
+
+  return pricingTrx->getOptions();
+}
+}
+
+uint64_t
+TrxFeatures::units() const
+{
+  return std::max<uint64_t>(legs + sops, 1) * std::max<uint64_t>(paxTypes, 1) *
+         (OPTIONS_PER_UNIT + options) / OPTIONS_PER_UNIT;
+}
+
+TrxFeatures
+TrxFeatures::of(const Trx& trx)
+{
+  TrxFeatures features;
+
+  const PricingTrx* pricingTrx = dynamic_cast<const PricingTrx*>(&trx);
+  if (!pricingTrx)
+    return features;
+
+  features.kind = pricingTrx->getTrxType();
+  features.paxTypes = pricingTrx->paxType().size();
+  if (pricingTrx->getOptions() && pricingTrx->getOptions()->getRequestedNumberOfSolutions() > 0)
+    features.options = pricingTrx->getOptions()->getRequestedNumberOfSolutions();
+
+  if (const ShoppingTrx* shoppingTrx = dynamic_cast<const ShoppingTrx*>(pricingTrx))
+  {
+    features.legs = shoppingTrx->legs().size();
+    for (const ShoppingTrx::Leg& leg : shoppingTrx->legs())
+      features.sops += leg.sop().size();
+  }
+  else
+  {
+    features.legs = pricingTrx->travelSeg().size();
+    features.sops = pricingTrx->itin().size();
+  }
+  return features;
+}
+
+AdmissionController*
+AdmissionController::instance()
+{
+  static AdmissionController* const controller =
+      admissionBudget ? new AdmissionController(admissionBudget,
+                                                std::chrono::milliseconds(admissionQueueTimeout),
+                                                admissionDegradePercent,
+                                                admissionBaseSize,
+                                                admissionUnitSize)
+                      : nullptr;
+  return controller;
+}
+
+AdmissionController::AdmissionController(const size_t budget,
+                                         const std::chrono::milliseconds queueTimeout,
+                                         const uint32_t degradePercent,
+                                         const size_t baseSize,
+                                         const size_t unitSize)
+  : _budget(budget),
+    _queueTimeout(queueTimeout),
+    _degradePercent(std::min<uint32_t>(degradePercent, 100)),
+    _baseSize(baseSize)
+{
+  std::fill(_unitSize, _unitSize + KINDS, unitSize);
+  LOG4CXX_INFO(logger, "Admission control enabled. Budget: " << _budget << " bytes");
+}
+
+size_t
+AdmissionController::estimate(const TrxFeatures& features) const
+{
+  std::unique_lock<std::mutex> guard(_mutex);
+  return _baseSize + unitSize(features.kind) * features.units();
+}
+
+size_t
+AdmissionController::committed() const
+{
+  std::unique_lock<std::mutex> guard(_mutex);
+  return committedUnsafe();
+}
+
+size_t
+AdmissionController::committedUnsafe() const
+{
+  // The running trx may already use more than they reserved.
+  const GlobalManager* const globalManager = GlobalManager::instance();
+  return std::max(_reserved, globalManager ? globalManager->getTotalMemory() : size_t(0));
+}
+
+bool
+AdmissionController::reserve(const size_t size, const std::chrono::milliseconds timeout)
+{
+  std::unique_lock<std::mutex> guard(_mutex);
+
+  const auto fits = [&]()
+  { return _reservations == 0 || committedUnsafe() + size <= _budget; };
+
+  if (!fits() && (timeout.count() <= 0 || !_released.wait_for(guard, timeout, fits)))
+    return false;
+
+  _reserved += size;
+  ++_reservations;
+  return true;
+}
+
+void
+AdmissionController::release(const size_t reserved,
+                             const TrxFeatures& features,
+                             const size_t actual)
+{
+  {
+    std::unique_lock<std::mutex> guard(_mutex);
+
+    _reserved -= reserved;
+    --_reservations;
+
+    // Without a TrxManager there is nothing to calibrate with.
+    if (actual)
+    {
+      _totalReserved += reserved;
+      _totalActual += actual;
+      if (actual > reserved)
+        ++_underestimated;
+
+      const size_t observed = actual > _baseSize ? (actual - _baseSize) / features.units() : 0;
+      size_t& size = unitSize(features.kind);
+      size = size - (size >> CALIBRATION_SHIFT) + (observed >> CALIBRATION_SHIFT);
+    }
+  }
+  _released.notify_all();
+}
+
+TrxFeatures
+AdmissionController::degrade(const TrxFeatures& features) const
+{
+  TrxFeatures degraded(features);
+  degraded.options =
+      std::max<uint32_t>(features.options - features.options * _degradePercent / 100, 1);
+  return degraded;
+}
+
+int32_t
+AdmissionController::degradeLimit(const int32_t limit, const uint32_t percent)
+{
+  if (limit < 0 || percent == 0)
+    return limit;
+
+  const int64_t degraded = limit - int64_t(limit) * std::min<uint32_t>(percent, 100) / 100;
+  return std::max<int32_t>(int32_t(degraded), 1);
+}
+
+void
+AdmissionController::record(const Decision decision)
+{
+  std::unique_lock<std::mutex> guard(_mutex);
+  ++_decisions[decision];
+}
+
+void
+AdmissionController::print(std::ostream& os) const
+{
+  std::unique_lock<std::mutex> guard(_mutex);
+
+  os << "Admission budget: " << _budget << " reserved: " << _reserved
+     << " committed: " << committedUnsafe() << "\n";
+  for (uint8_t decision = ADMITTED; decision <= REJECTED; ++decision)
+    os << "  " << decisionNames[decision] << ": " << _decisions[decision] << "\n";
+  os << "  Reserved: " << _totalReserved << " actual: " << _totalActual
+     << " underestimated: " << _underestimated << "\n";
+}
+
+AdmissionController::Reservation::Reservation(Trx& trx)
+  : _controller(AdmissionController::instance()), _trx(trx)
+{
+  if (_controller)
+    admit();
+}
+
+AdmissionController::Reservation::Reservation(AdmissionController& controller, Trx& trx)
+  : _controller(&controller), _trx(trx)
+{
+  admit();
+}
+
+void
+AdmissionController::Reservation::admit()
+{
+  _features = TrxFeatures::of(_trx);
+  if (_features.kind == TrxFeatures::NON_PRICING)
+  {
+    // Status, metrics and the other service trx are small and must not wait behind pricing.
+    _controller = nullptr;
+    return;
+  }
+
+  _reserved = _controller->estimate(_features);
+
+  if (_controller->reserve(_reserved, std::chrono::milliseconds::zero()))
+  {
+    _controller->record(_decision = ADMITTED);
+    return;
+  }
+
+  // Over budget, ask for fewer options first and wait for the budget only if it is not enough.
+  PricingOptions* const options = _controller->_degradePercent ? degradableOptions(_trx) : nullptr;
+  TrxFeatures degraded(_features);
+  if (options)
+  {
+    degraded = _controller->degrade(_features);
+    _reserved = _controller->estimate(degraded);
+  }
+
+  if (options && _controller->reserve(_reserved, std::chrono::milliseconds::zero()))
+  {
+    _decision = DEGRADED;
+  }
+  else if (_controller->reserve(_reserved, _controller->_queueTimeout))
+  {
+    _decision = QUEUED;
+  }
+  else
+  {
+    _controller->record(REJECTED);
+    LOG4CXX_WARN(logger,
+                 "Trx rejected, estimated " << _reserved << " bytes, committed "
+                                            << _controller->committed() << " bytes");
+    throw ErrorResponseException(ErrorResponseException::TRANSACTION_THRESHOLD_REACHED);
+  }
+
+  if (options)
+  {
+    LOG4CXX_INFO(logger,
+                 "Requested options reduced from " << _features.options << " to "
+                                                   << degraded.options);
+    options->setRequestedNumberOfSolutions(static_cast<int16_t>(degraded.options));
+    static_cast<PricingTrx&>(_trx).setAdmissionDegradePercent(_controller->_degradePercent);
+    _features = degraded;
+  }
+  _controller->record(_decision);
+}
+
+AdmissionController::Reservation::~Reservation()
+{
+  if (!_controller)
+    return;
+
+  size_t actual = 0;
+  if (TrxManager* const manager = _trx.getMemoryManager())
+  {
+    manager->updateTotalMemory();
+    actual = manager->getTotalMemory();
+  }
+
+  LOG4CXX_INFO(logger,
+               "Trx memory reserved: " << _reserved << " actual: " << actual
+                                       << " units: " << _features.units() << " "
+                                       << decisionNames[_decision]);
+  _controller->release(_reserved, _features, actual);
+}
+}
+}
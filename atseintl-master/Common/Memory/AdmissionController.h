@@ -0,0 +1,136 @@
+//------------------------------------------------------------------
+//
+//  Copyright Sabre 2015
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//-------------------------------------------------------------------
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+
+namespace tse
+{
+class Trx;
+
+namespace Memory
+{
+// The request features the memory of a trx is estimated from.
+struct TrxFeatures
+{
+  static constexpr uint8_t NON_PRICING = 0xff;
+
+  uint8_t kind = NON_PRICING; // PricingTrx::TrxType
+  uint32_t legs = 0;
+  uint32_t sops = 0;
+  uint32_t paxTypes = 0;
+  uint32_t options = 0;
+
+  uint64_t units() const;
+
+  static TrxFeatures of(const Trx& trx);
+};
+
+// Reserves an estimated memory budget for a trx before it is processed.
+//
+// The estimate of a trx is a base size plus a per-kind size of each unit of its features. The
+// unit size is calibrated with the memory the finished trx actually used, as reported by their
+// TrxManager. When the budget is exceeded, the trx asks for fewer options and searches fewer fare
+// paths (see PricingTrx::admissionDegradePercent()), waits for the running trx to finish or is
+// throttled. Trx other than PricingTrx reserve nothing.
+class AdmissionController
+{
+public:
+  enum Decision : uint8_t
+  { ADMITTED,
+    DEGRADED,
+    QUEUED,
+    REJECTED };
+
+  class Reservation
+  {
+  public:
+    // Throws ErrorResponseException(TRANSACTION_THRESHOLD_REACHED) if the trx is rejected.
+    // Reserves nothing for a trx of the NON_PRICING kind.
+    explicit Reservation(Trx& trx);
+    Reservation(AdmissionController& controller, Trx& trx);
+    ~Reservation();
+
+    Reservation(const Reservation&) = delete;
+    Reservation& operator=(const Reservation&) = delete;
+
+    size_t reserved() const { return _reserved; }
+    Decision decision() const { return _decision; }
+
+  private:
+    void admit();
+
+    AdmissionController* _controller;
+    Trx& _trx;
+    TrxFeatures _features;
+    size_t _reserved = 0;
+    Decision _decision = ADMITTED;
+  };
+
+  // nullptr if the admission control is not configured
+  static AdmissionController* instance();
+
+  AdmissionController(size_t budget,
+                      std::chrono::milliseconds queueTimeout,
+                      uint32_t degradePercent,
+                      size_t baseSize,
+                      size_t unitSize);
+
+  size_t budget() const { return _budget; }
+  size_t estimate(const TrxFeatures& features) const;
+  size_t committed() const;
+
+  // false if the budget is not available within the timeout; a trx is always admitted when no
+  // other trx holds a reservation, so that the ones larger than the budget are still processed
+  bool reserve(size_t size, std::chrono::milliseconds timeout);
+  void release(size_t reserved, const TrxFeatures& features, size_t actual);
+
+  TrxFeatures degrade(const TrxFeatures& features) const;
+
+  // a search limit of a degraded trx, a negative limit is unlimited and stays so
+  static int32_t degradeLimit(int32_t limit, uint32_t percent);
+
+  void print(std::ostream& os) const;
+
+private:
+  static constexpr size_t KINDS = 9;
+
+  size_t& unitSize(uint8_t kind) { return _unitSize[kind < KINDS - 1 ? kind : KINDS - 1]; }
+  size_t unitSize(uint8_t kind) const { return _unitSize[kind < KINDS - 1 ? kind : KINDS - 1]; }
+  size_t committedUnsafe() const;
+  void record(Decision decision);
+
+  const size_t _budget;
+  const std::chrono::milliseconds _queueTimeout;
+  const uint32_t _degradePercent;
+  const size_t _baseSize;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _released;
+  size_t _reserved = 0;
+  size_t _reservations = 0;
+  size_t _unitSize[KINDS];
+
+  size_t _decisions[REJECTED + 1] = {};
+  uint64_t _totalReserved = 0;
+  uint64_t _totalActual = 0;
+  size_t _underestimated = 0;
+};
+}
+}
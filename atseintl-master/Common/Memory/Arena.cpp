@@ -0,0 +1,229 @@
+//------------------------------------------------------------------
+//
+//  Copyright Sabre 2016
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//-------------------------------------------------------------------
+#include "Common/Memory/Arena.h"
+
+#include "Util/BranchPrediction.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include <sys/mman.h>
+
+namespace tse
+{
+namespace Memory
+{
+constexpr size_t Arena::ALIGNMENT;
+constexpr size_t Arena::MIN_CHUNK_SIZE;
+constexpr size_t Arena::MAX_CHUNK_SIZE;
+
+namespace
+{
+inline size_t
+alignUp(size_t size, size_t alignment)
+{
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+}
+
+Arena::~Arena() { release(); }
+
+void*
+Arena::allocate(size_t size)
+{
+  size = alignUp(size ? size : 1, ALIGNMENT);
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  if (LIKELY(size <= size_t(_end - _cursor)))
+  {
+    void* const ptr = _cursor;
+    _cursor += size;
+    return ptr;
+  }
+
+  void* ptr;
+  if (size > MAX_CHUNK_SIZE / 8)
+  {
+    // Large objects get a chunk of their own, so that they leave the space
+    // remaining in the current chunk to the small ones.
+    Chunk* const chunk = newChunk(sizeof(Chunk) + size);
+    addChunk(chunk);
+    ptr = chunk + 1;
+  }
+  else
+  {
+    while (_nextChunkSize < sizeof(Chunk) + size)
+      _nextChunkSize *= 2;
+    Chunk* const chunk = newChunk(_nextChunkSize);
+    if (_nextChunkSize < MAX_CHUNK_SIZE)
+      _nextChunkSize *= 2;
+    addChunk(chunk);
+
+    _cursor = reinterpret_cast<char*>(chunk + 1);
+    _end = reinterpret_cast<char*>(chunk) + chunk->size;
+
+    ptr = _cursor;
+    _cursor += size;
+  }
+  const size_t bytes = _bytes;
+  lock.unlock();
+
+  // a new chunk is at least MIN_CHUNK_SIZE, worth reporting at once
+  setTotalMemory(bytes);
+  return ptr;
+}
+
+void
+Arena::import(Arena& another)
+{
+  if (&another == this)
+    return;
+
+  Chunk* chunks;
+  size_t count;
+  size_t bytes;
+  {
+    std::lock_guard<std::mutex> lock(another._mutex);
+    chunks = another._chunks;
+    count = another._chunkCount;
+    bytes = another._bytes;
+    another._chunks = nullptr;
+    another._cursor = another._end = nullptr;
+    another._nextChunkSize = MIN_CHUNK_SIZE;
+    another._chunkCount = 0;
+    another._bytes = 0;
+  }
+  another.updateTotalMemory();
+
+  if (!chunks)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Chunk* last = chunks;
+    while (last->next)
+      last = last->next;
+    last->next = _chunks;
+    _chunks = chunks;
+    _chunkCount += count;
+    _bytes += bytes;
+  }
+  updateTotalMemory();
+}
+
+void
+Arena::release()
+{
+  Chunk* chunk;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    chunk = _chunks;
+    _chunks = nullptr;
+    _cursor = _end = nullptr;
+    _nextChunkSize = MIN_CHUNK_SIZE;
+    _chunkCount = 0;
+    _bytes = 0;
+  }
+  while (chunk)
+  {
+    Chunk* const next = chunk->next;
+    freeChunk(chunk);
+    chunk = next;
+  }
+  updateTotalMemory();
+}
+
+size_t
+Arena::chunks() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _chunkCount;
+}
+
+size_t
+Arena::allocatedBytes() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _bytes;
+}
+
+void
+Arena::updateTotalMemory()
+{
+  setTotalMemory(allocatedBytes());
+}
+
+Arena::Chunk*
+Arena::newChunk(size_t size)
+{
+  void* memory = nullptr;
+  bool mapped = false;
+
+  if (_hugePages && size == MAX_CHUNK_SIZE)
+  {
+    // Map twice the size to find a huge page boundary, and unmap the rest.
+    const size_t span = 2 * size;
+    void* const region =
+        ::mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region != MAP_FAILED)
+    {
+      const uintptr_t begin = reinterpret_cast<uintptr_t>(region);
+      const uintptr_t aligned = alignUp(begin, size);
+      if (aligned > begin)
+        ::munmap(region, aligned - begin);
+      if (aligned + size < begin + span)
+        ::munmap(reinterpret_cast<void*>(aligned + size), begin + span - aligned - size);
+      memory = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+      ::madvise(memory, size, MADV_HUGEPAGE);
+#endif
+      mapped = true;
+    }
+  }
+
+  if (!memory)
+  {
+    memory = ::malloc(size);
+    if (UNLIKELY(!memory))
+      throw std::bad_alloc();
+  }
+
+  Chunk* const chunk = static_cast<Chunk*>(memory);
+  chunk->next = nullptr;
+  chunk->size = size;
+  chunk->mapped = mapped;
+  return chunk;
+}
+
+void
+Arena::freeChunk(Chunk* chunk)
+{
+  if (chunk->mapped)
+    ::munmap(chunk, chunk->size);
+  else
+    ::free(chunk);
+}
+
+// Called with the mutex locked.
+void
+Arena::addChunk(Chunk* chunk)
+{
+  chunk->next = _chunks;
+  _chunks = chunk;
+  ++_chunkCount;
+  _bytes += chunk->size;
+}
+}
+}
@@ -0,0 +1,81 @@
+//------------------------------------------------------------------
+//
+//  Copyright Sabre 2016
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//-------------------------------------------------------------------
+#pragma once
+
+#include "Common/Memory/Manager.h"
+
+#include <cstddef>
+#include <mutex>
+
+namespace tse
+{
+namespace Memory
+{
+// Monotonic allocator for objects that live as long as a transaction.
+//
+// Memory is carved from chunks which double in size from MIN_CHUNK_SIZE to
+// MAX_CHUNK_SIZE as the arena grows; requests too large to share a chunk get
+// a chunk of their own. Nothing is freed until release(), which returns all
+// chunks at once. The chunk bytes are reported as this manager's memory, so
+// that the trx manager it is registered with sees them.
+class Arena : public Manager
+{
+public:
+  static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+  static constexpr size_t MIN_CHUNK_SIZE = 64 * 1024;
+  static constexpr size_t MAX_CHUNK_SIZE = 2 * 1024 * 1024;
+
+  Arena() = default;
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+  virtual ~Arena();
+
+  // Back the largest chunks with transparent huge pages.
+  void setHugePages(bool hugePages) { _hugePages = hugePages; }
+
+  void* allocate(size_t size);
+
+  // Takes over the chunks of another arena; the memory stays valid.
+  void import(Arena& another);
+
+  void release();
+
+  size_t chunks() const;
+  size_t allocatedBytes() const;
+
+  virtual void updateTotalMemory() override final;
+
+private:
+  struct alignas(ALIGNMENT) Chunk
+  {
+    Chunk* next;
+    size_t size;
+    bool mapped;
+  };
+
+  Chunk* newChunk(size_t size);
+  void freeChunk(Chunk* chunk);
+  void addChunk(Chunk* chunk);
+
+  mutable std::mutex _mutex;
+  Chunk* _chunks = nullptr;
+  char* _cursor = nullptr;
+  char* _end = nullptr;
+  size_t _nextChunkSize = MIN_CHUNK_SIZE;
+  size_t _chunkCount = 0;
+  size_t _bytes = 0;
+  bool _hugePages = false;
+};
+}
+}
@@ -80,6 +80,28 @@ memoryMonitorUpdatePeriodGranularity(section, "MEMORY_MONITOR_UPDATE_PERIOD_GRAN
 ConfigurableValue<size_t> critiFreeRssWatermark(section,"CRITICAL_FREE_RSS_WATERMARK", 0);
 
 ConfigurableValue<size_t> warnFreeRssWatermark(section, "SOFT_FREE_RSS_WATERMARK", 0);
+
+// Allocate the objects created by a trx DataHandle from a per-trx arena, released as a whole
+// at the end of the trx, instead of one malloc each.
+ConfigurableValue<bool> trxArenaCfg(section, "TRX_ARENA", false);
+
+// Back the largest chunks of the trx arenas with transparent huge pages.
+ConfigurableValue<bool> trxArenaHugePagesCfg(section, "TRX_ARENA_HUGE_PAGES", false);
+
+// Memory budget (in bytes) reserved by the estimates of the running trx. A trx which doesn't
+// fit is processed with fewer options, waits for the others or is throttled. 0 disables it.
+ConfigurableValue<size_t> admissionBudgetCfg(section, "ADMISSION_BUDGET", 0);
+
+// How long (in milliseconds) a trx waits for the budget before it is throttled.
+ConfigurableValue<uint32_t> admissionQueueTimeoutCfg(section, "ADMISSION_QUEUE_TIMEOUT", 2000);
+
+// By how many percent the requested options are reduced when over the budget. 0 disables it.
+ConfigurableValue<uint32_t> admissionDegradePercentCfg(section, "ADMISSION_DEGRADE_PERCENT", 50);
+
+// Estimated size of any trx and the initial size per unit of its features (legs, SOPs,
+// passenger types and options); the latter is calibrated with the trx actually processed.
+ConfigurableValue<size_t> admissionBaseSizeCfg(section, "ADMISSION_BASE_SIZE", 16 * MB);
+ConfigurableValue<size_t> admissionUnitSizeCfg(section, "ADMISSION_UNIT_SIZE", MB / 4);
 }
 
 bool _managerEnabled = false;
@@ -95,6 +117,13 @@ uint32_t _monitorUpdatePeriodGranularity;
 size_t _criticalFreeRssWatermark = 6 * GB;
 size_t _softFreeRssWatermark = 9 * GB;
 bool _changesFallback = true;
+bool _trxArenaEnabled = false;
+bool _trxArenaHugePages = false;
+size_t _admissionBudget = 0;
+uint32_t _admissionQueueTimeout = 2000;
+uint32_t _admissionDegradePercent = 50;
+size_t _admissionBaseSize = 16 * MB;
+size_t _admissionUnitSize = MB / 4;
 
 void checkThresholdsAndWatermarks()
 {
@@ -148,6 +177,13 @@ configure()
   _monitorUpdatePeriodGranularity = memoryMonitorUpdatePeriodGranularity.getValue();
   _criticalFreeRssWatermark = critiFreeRssWatermark.getValue();
   _softFreeRssWatermark = warnFreeRssWatermark.getValue();
+  _trxArenaEnabled = trxArenaCfg.getValue();
+  _trxArenaHugePages = trxArenaHugePagesCfg.getValue();
+  _admissionBudget = admissionBudgetCfg.getValue();
+  _admissionQueueTimeout = admissionQueueTimeoutCfg.getValue();
+  _admissionDegradePercent = admissionDegradePercentCfg.getValue();
+  _admissionBaseSize = admissionBaseSizeCfg.getValue();
+  _admissionUnitSize = admissionUnitSizeCfg.getValue();
 
   checkThresholdsAndWatermarks();
 
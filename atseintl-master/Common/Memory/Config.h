@@ -33,6 +33,13 @@ extern uint32_t _monitorUpdatePeriodGranularity;
 extern size_t _criticalFreeRssWatermark;
 extern size_t _softFreeRssWatermark;
 extern bool _changesFallback;
+extern bool _trxArenaEnabled;
+extern bool _trxArenaHugePages;
+extern size_t _admissionBudget;
+extern uint32_t _admissionQueueTimeout;
+extern uint32_t _admissionDegradePercent;
+extern size_t _admissionBaseSize;
+extern size_t _admissionUnitSize;
 
 namespace
 {
@@ -49,6 +56,13 @@ const uint32_t& monitorUpdatePeriodGranularity = _monitorUpdatePeriodGranularity
 const size_t& criticalFreeRssWatermark = _criticalFreeRssWatermark;
 const size_t& softFreeRssWatermark = _softFreeRssWatermark;
 const bool& changesFallback = _changesFallback;
+const bool& trxArenaEnabled = _trxArenaEnabled;
+const bool& trxArenaHugePages = _trxArenaHugePages;
+const size_t& admissionBudget = _admissionBudget;
+const uint32_t& admissionQueueTimeout = _admissionQueueTimeout;
+const uint32_t& admissionDegradePercent = _admissionDegradePercent;
+const size_t& admissionBaseSize = _admissionBaseSize;
+const size_t& admissionUnitSize = _admissionUnitSize;
 }
 
 void configure();
@@ -0,0 +1,242 @@
+// ----------------------------------------------------------------
+//
+//   Copyright Sabre 2015
+//
+//           The copyright to the computer program(s) herein
+//           is the property of Sabre.
+//           The program(s) may be used and/or copied only with
+//           the written permission of Sabre or in accordance
+//           with the terms and conditions stipulated in the
+//           agreement/contract under which the program(s)
+//           have been supplied.
+//
+// ----------------------------------------------------------------
+
+#include "Common/ErrorResponseException.h"
+#include "Common/Memory/AdmissionController.h"
+#include "DataModel/PricingOptions.h"
+#include "DataModel/PricingTrx.h"
+#include "DataModel/StatusTrx.h"
+
+#include "test/include/TestConfigInitializer.h"
+#include "test/include/TestMemHandle.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+namespace tse
+{
+namespace Memory
+{
+using namespace ::testing;
+
+namespace
+{
+constexpr size_t BASE = 100;
+constexpr size_t UNIT = 10;
+}
+
+class AdmissionControllerTest : public Test
+{
+public:
+  void SetUp() { _memH(new TestConfigInitializer); }
+  void TearDown() { _memH.clear(); }
+
+protected:
+  AdmissionController* createController(size_t budget,
+                                        uint32_t queueTimeout = 0,
+                                        uint32_t degradePercent = 50)
+  {
+    return _memH(new AdmissionController(
+        budget, std::chrono::milliseconds(queueTimeout), degradePercent, BASE, UNIT));
+  }
+  PricingTrx* createTrx(int16_t options)
+  {
+    PricingTrx* trx = _memH(new PricingTrx);
+    trx->setOptions(_memH(new PricingOptions));
+    trx->getOptions()->setRequestedNumberOfSolutions(options);
+    return trx;
+  }
+  TrxFeatures features(uint32_t legs, uint32_t sops, uint32_t paxTypes, uint32_t options)
+  {
+    TrxFeatures features;
+    features.kind = PricingTrx::MIP_TRX;
+    features.legs = legs;
+    features.sops = sops;
+    features.paxTypes = paxTypes;
+    features.options = options;
+    return features;
+  }
+
+  TestMemHandle _memH;
+};
+
+TEST_F(AdmissionControllerTest, testUnits)
+{
+  EXPECT_EQ(1u, TrxFeatures().units());
+  EXPECT_EQ(12u, features(2, 10, 1, 0).units());
+  EXPECT_EQ(24u, features(2, 10, 2, 0).units());
+  EXPECT_EQ(36u, features(2, 10, 1, 20).units());
+}
+
+TEST_F(AdmissionControllerTest, testFeatures)
+{
+  PricingTrx* trx = createTrx(50);
+  trx->setTrxType(PricingTrx::MIP_TRX);
+  trx->itin().resize(3);
+  trx->paxType().resize(2);
+
+  const TrxFeatures features = TrxFeatures::of(*trx);
+  EXPECT_EQ(PricingTrx::MIP_TRX, features.kind);
+  EXPECT_EQ(3u, features.sops);
+  EXPECT_EQ(2u, features.paxTypes);
+  EXPECT_EQ(50u, features.options);
+}
+
+TEST_F(AdmissionControllerTest, testEstimate)
+{
+  AdmissionController* controller = createController(1000);
+  EXPECT_EQ(BASE + UNIT * 12, controller->estimate(features(2, 10, 1, 0)));
+}
+
+TEST_F(AdmissionControllerTest, testReserveWithinBudget)
+{
+  AdmissionController* controller = createController(100);
+  const TrxFeatures any;
+
+  EXPECT_TRUE(controller->reserve(60, std::chrono::milliseconds::zero()));
+  EXPECT_FALSE(controller->reserve(60, std::chrono::milliseconds::zero()));
+  EXPECT_TRUE(controller->reserve(40, std::chrono::milliseconds::zero()));
+  EXPECT_EQ(100u, controller->committed());
+
+  controller->release(60, any, 0);
+  EXPECT_TRUE(controller->reserve(60, std::chrono::milliseconds::zero()));
+}
+
+TEST_F(AdmissionControllerTest, testReserveLargerThanBudget)
+{
+  AdmissionController* controller = createController(100);
+
+  EXPECT_TRUE(controller->reserve(1000, std::chrono::milliseconds::zero()));
+  EXPECT_FALSE(controller->reserve(1, std::chrono::milliseconds::zero()));
+}
+
+TEST_F(AdmissionControllerTest, testQueueUntilReleased)
+{
+  AdmissionController* controller = createController(100);
+  const TrxFeatures any;
+
+  ASSERT_TRUE(controller->reserve(100, std::chrono::milliseconds::zero()));
+  std::thread releaser([&]()
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    controller->release(100, any, 0);
+  });
+
+  EXPECT_TRUE(controller->reserve(100, std::chrono::seconds(10)));
+  releaser.join();
+}
+
+TEST_F(AdmissionControllerTest, testQueueTimeout)
+{
+  AdmissionController* controller = createController(100);
+
+  ASSERT_TRUE(controller->reserve(100, std::chrono::milliseconds::zero()));
+  EXPECT_FALSE(controller->reserve(1, std::chrono::milliseconds(10)));
+}
+
+TEST_F(AdmissionControllerTest, testCalibration)
+{
+  AdmissionController* controller = createController(1000000);
+  const TrxFeatures trx = features(2, 10, 1, 0);
+
+  // the trx use 50 bytes per unit, five times more than estimated
+  for (int i = 0; i < 100; ++i)
+  {
+    const size_t reserved = controller->estimate(trx);
+    ASSERT_TRUE(controller->reserve(reserved, std::chrono::milliseconds::zero()));
+    controller->release(reserved, trx, BASE + 50 * trx.units());
+  }
+  EXPECT_NEAR(double(BASE + 50 * trx.units()), double(controller->estimate(trx)), 10 * 12);
+
+  // other kinds keep the initial unit size
+  TrxFeatures other = trx;
+  other.kind = PricingTrx::IS_TRX;
+  EXPECT_EQ(BASE + UNIT * 12, controller->estimate(other));
+}
+
+TEST_F(AdmissionControllerTest, testDegrade)
+{
+  AdmissionController* controller = createController(100, 0, 25);
+
+  EXPECT_EQ(75u, controller->degrade(features(1, 1, 1, 100)).options);
+  EXPECT_EQ(1u, controller->degrade(features(1, 1, 1, 1)).options);
+}
+
+TEST_F(AdmissionControllerTest, testDegradeLimit)
+{
+  EXPECT_EQ(3000, AdmissionController::degradeLimit(3000, 0));
+  EXPECT_EQ(2250, AdmissionController::degradeLimit(3000, 25));
+  EXPECT_EQ(1, AdmissionController::degradeLimit(3000, 100));
+  EXPECT_EQ(-1, AdmissionController::degradeLimit(-1, 25));
+}
+
+TEST_F(AdmissionControllerTest, testReservation)
+{
+  // each trx with 100 options is 100 + 10 * 11 bytes, 100 + 10 * 6 with 50
+  AdmissionController* controller = createController(400);
+  PricingTrx* first = createTrx(100);
+  PricingTrx* second = createTrx(100);
+  PricingTrx* third = createTrx(100);
+
+  {
+    const AdmissionController::Reservation firstReservation(*controller, *first);
+    EXPECT_EQ(AdmissionController::ADMITTED, firstReservation.decision());
+    EXPECT_EQ(210u, firstReservation.reserved());
+
+    const AdmissionController::Reservation secondReservation(*controller, *second);
+    EXPECT_EQ(AdmissionController::DEGRADED, secondReservation.decision());
+    EXPECT_EQ(160u, secondReservation.reserved());
+    EXPECT_EQ(50, second->getOptions()->getRequestedNumberOfSolutions());
+    EXPECT_EQ(0u, first->admissionDegradePercent());
+    EXPECT_EQ(50u, second->admissionDegradePercent());
+
+    try
+    {
+      const AdmissionController::Reservation thirdReservation(*controller, *third);
+      FAIL() << "third trx admitted";
+    }
+    catch (const ErrorResponseException& e)
+    {
+      EXPECT_EQ(ErrorResponseException::TRANSACTION_THRESHOLD_REACHED, e.code());
+    }
+    EXPECT_EQ(100, third->getOptions()->getRequestedNumberOfSolutions());
+    EXPECT_EQ(370u, controller->committed());
+  }
+  EXPECT_EQ(0u, controller->committed());
+
+  std::ostringstream os;
+  controller->print(os);
+  EXPECT_NE(std::string::npos, os.str().find("ADMITTED: 1"));
+  EXPECT_NE(std::string::npos, os.str().find("DEGRADED: 1"));
+  EXPECT_NE(std::string::npos, os.str().find("REJECTED: 1"));
+}
+
+TEST_F(AdmissionControllerTest, testNonPricingTrxNotReserved)
+{
+  AdmissionController* controller = createController(100);
+  PricingTrx* pricing = createTrx(100);
+  StatusTrx* status = _memH(new StatusTrx);
+
+  const AdmissionController::Reservation pricingReservation(*controller, *pricing);
+  EXPECT_EQ(210u, controller->committed());
+
+  const AdmissionController::Reservation statusReservation(*controller, *status);
+  EXPECT_EQ(AdmissionController::ADMITTED, statusReservation.decision());
+  EXPECT_EQ(0u, statusReservation.reserved());
+  EXPECT_EQ(210u, controller->committed());
+}
+}
+}
@@ -0,0 +1,142 @@
+// ----------------------------------------------------------------
+//
+//   Copyright Sabre 2016
+//
+//           The copyright to the computer program(s) herein
+//           is the property of Sabre.
+//           The program(s) may be used and/or copied only with
+//           the written permission of Sabre or in accordance
+//           with the terms and conditions stipulated in the
+//           agreement/contract under which the program(s)
+//           have been supplied.
+//
+// ----------------------------------------------------------------
+
+#include "Common/Memory/Arena.h"
+#include "Common/Memory/LocalManager.h"
+
+#include <gtest/gtest.h>
+
+#include "test/include/GtestHelperMacros.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace tse
+{
+namespace Memory
+{
+using namespace ::testing;
+
+class ArenaTest : public Test
+{
+};
+
+TEST_F(ArenaTest, testEmpty)
+{
+  Arena arena;
+
+  EXPECT_EQ(0, arena.chunks());
+  EXPECT_EQ(0, arena.allocatedBytes());
+  EXPECT_EQ(0, arena.getTotalMemory());
+}
+
+TEST_F(ArenaTest, testAlignedAndDistinct)
+{
+  Arena arena;
+
+  char* const a = static_cast<char*>(arena.allocate(1));
+  char* const b = static_cast<char*>(arena.allocate(24));
+  char* const c = static_cast<char*>(arena.allocate(0));
+
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(a) % Arena::ALIGNMENT);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(b) % Arena::ALIGNMENT);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(c) % Arena::ALIGNMENT);
+  EXPECT_LE(a + 1, b);
+  EXPECT_LE(b + 24, c);
+  EXPECT_EQ(1, arena.chunks());
+  EXPECT_EQ(Arena::MIN_CHUNK_SIZE, arena.allocatedBytes());
+}
+
+TEST_F(ArenaTest, testChunksGrow)
+{
+  Arena arena;
+
+  for (size_t i = 0; i < Arena::MIN_CHUNK_SIZE / 1024; ++i)
+    std::memset(arena.allocate(1024), 0, 1024);
+
+  EXPECT_EQ(2, arena.chunks());
+  EXPECT_EQ(3 * Arena::MIN_CHUNK_SIZE, arena.allocatedBytes());
+}
+
+TEST_F(ArenaTest, testLargeObjectGetsOwnChunk)
+{
+  Arena arena;
+  char* const small1 = static_cast<char*>(arena.allocate(64));
+
+  const size_t large = Arena::MAX_CHUNK_SIZE;
+  std::memset(arena.allocate(large), 0, large);
+  char* const small2 = static_cast<char*>(arena.allocate(64));
+
+  EXPECT_EQ(2, arena.chunks());
+  EXPECT_EQ(small1 + 64, small2);
+}
+
+TEST_F(ArenaTest, testReleaseReportsToParent)
+{
+  LocalManager trx;
+  Arena arena;
+  trx.registerManager(&arena);
+
+  arena.allocate(100);
+  EXPECT_EQ(Arena::MIN_CHUNK_SIZE, trx.getTotalMemory());
+
+  arena.release();
+  EXPECT_EQ(0, arena.chunks());
+  EXPECT_EQ(0, trx.getTotalMemory());
+
+  trx.unregisterManager(&arena);
+}
+
+TEST_F(ArenaTest, testImport)
+{
+  LocalManager trx;
+  Arena arena, another;
+  trx.registerManager(&arena);
+  trx.registerManager(&another);
+
+  char* const mine = static_cast<char*>(arena.allocate(8));
+  char* const theirs = static_cast<char*>(another.allocate(8));
+  std::strcpy(theirs, "IMPORT");
+
+  arena.import(another);
+
+  EXPECT_EQ(0, another.chunks());
+  EXPECT_EQ(2, arena.chunks());
+  EXPECT_STREQ("IMPORT", theirs);
+  EXPECT_EQ(2 * Arena::MIN_CHUNK_SIZE, trx.getTotalMemory());
+
+  // still allocating from our own chunk
+  EXPECT_EQ(mine + Arena::ALIGNMENT, arena.allocate(8));
+
+  trx.unregisterManager(&arena);
+  trx.unregisterManager(&another);
+}
+
+TEST_F(ArenaTest, testHugePages)
+{
+  Arena arena;
+  arena.setHugePages(true);
+
+  size_t total = 0;
+  while (arena.allocatedBytes() < 2 * Arena::MAX_CHUNK_SIZE)
+  {
+    std::memset(arena.allocate(4096), 1, 4096);
+    total += 4096;
+  }
+  EXPECT_LT(0, total);
+  arena.release();
+  EXPECT_EQ(0, arena.chunks());
+}
+}
+}
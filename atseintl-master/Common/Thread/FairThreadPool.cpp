@@ -0,0 +1,174 @@
+#include "Common/Thread/FairThreadPool.h"
+
+#include "Common/Thread/ThreadPoolInfo.h"
+
+#include <algorithm>
+
+namespace tse
+{
+
+FairTaskQueue::FairTaskQueue(time_t urgency)
+  : _urgency(urgency)
+{
+}
+
+void FairTaskQueue::push(const TseRunnableWrapper& task,
+                         const void* owner,
+                         time_t deadline,
+                         bool front)
+{
+  auto inserted(_owners.emplace(owner, Owner()));
+  Owner& queue(inserted.first->second);
+  if (inserted.second)
+  {
+    queue.finishTag = _virtualTime;
+  }
+  if (deadline != 0 && (0 == queue.deadline || deadline < queue.deadline))
+  {
+    if (queue.deadline != 0)
+    {
+      _byDeadline.erase(DeadlineKey(queue.deadline, owner));
+    }
+    queue.deadline = deadline;
+    _byDeadline.insert(DeadlineKey(deadline, owner));
+  }
+
+  Entry entry;
+  entry.task = task;
+  entry.sequence = _sequence++;
+  if (front)
+  {
+    // ahead of the owner's other tasks, but not of other owners
+    entry.startTag = _virtualTime;
+    if (!queue.entries.empty())
+    {
+      _byTag.erase(tagKey(queue.entries.front(), owner));
+    }
+    queue.entries.push_front(entry);
+    _byTag.insert(tagKey(entry, owner));
+  }
+  else
+  {
+    entry.startTag = std::max(_virtualTime, queue.finishTag);
+    queue.finishTag = entry.startTag + 1;
+    if (queue.entries.empty())
+    {
+      _byTag.insert(tagKey(entry, owner));
+    }
+    queue.entries.push_back(entry);
+  }
+  ++_size;
+}
+
+bool FairTaskQueue::pop(TseRunnableWrapper& task,
+                        time_t now)
+{
+  if (0 == _size)
+  {
+    return false;
+  }
+  const void* owner(nullptr);
+  bool urgent(false);
+  auto due(_byDeadline.lower_bound(DeadlineKey(now, nullptr)));
+  if (due != _byDeadline.end() && due->first <= now + _urgency)
+  {
+    owner = due->second;
+    urgent = true;
+  }
+  else
+  {
+    owner = std::get<2>(*_byTag.begin());
+  }
+
+  auto it(_owners.find(owner));
+  Owner& queue(it->second);
+  const Entry& entry(queue.entries.front());
+  _byTag.erase(tagKey(entry, owner));
+  if (!urgent)
+  {
+    // an urgent task jumps the queue without moving the virtual time
+    _virtualTime = std::max(_virtualTime, entry.startTag);
+  }
+  task = entry.task;
+  queue.entries.pop_front();
+  --_size;
+
+  if (queue.entries.empty())
+  {
+    // forget the owner, its address may be reused by another transaction
+    if (queue.deadline != 0)
+    {
+      _byDeadline.erase(DeadlineKey(queue.deadline, owner));
+    }
+    _owners.erase(it);
+  }
+  else
+  {
+    _byTag.insert(tagKey(queue.entries.front(), owner));
+  }
+  return true;
+}
+
+FairThreadPool::FairThreadPool(TseThreadingConst::TaskId taskId,
+                               size_t maxSize)
+  : TseThreadPool(taskId, maxSize)
+  , _queue(ThreadPoolInfo::getFairSchedulingUrgency())
+{
+}
+
+FairThreadPool::~FairThreadPool()
+{
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    _joining = true;
+  }
+  _condition.notify_all();
+  // the workers use the queue, join them before the queue goes
+  Pool pool;
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    pool.swap(_pool);
+  }
+  pool.clear();
+}
+
+void FairThreadPool::enqueue(const TseRunnableWrapper& task,
+                             bool front)
+{
+  const TseCallableTask* runnable(task.runnable());
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    if ((0 == _maxSize || _pool.size() < _maxSize)
+        && _pool.size() <= _numberActiveThreads + _queue.size())
+    {
+      std::shared_ptr<Thread> thread(new Thread(*this));
+      _pool.push_back(thread);
+    }
+    _queue.push(task,
+                runnable ? runnable->owner() : nullptr,
+                runnable ? runnable->deadline() : 0,
+                front);
+  }
+  _condition.notify_one();
+}
+
+TseRunnableWrapper FairThreadPool::getNext(unsigned)
+{
+  TseRunnableWrapper task;
+  boost::unique_lock<boost::mutex> lock(_mutex);
+  while (!_joining && _queue.empty())
+  {
+    _condition.wait(lock);
+  }
+  _queue.pop(task, std::time(nullptr));
+  ++_numberActiveThreads;
+  return task;
+}
+
+size_t FairThreadPool::getQueueSize() const
+{
+  boost::lock_guard<boost::mutex> lock(_mutex);
+  return _queue.size();
+}
+
+}// tse
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Common/Thread/TseThreadPool.h"
+
+#include <ctime>
+#include <deque>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+
+namespace tse
+{
+
+// Queue of tasks shared fairly between their owners (transactions).
+//
+// Start-time fair queuing: every task is tagged with the virtual time at which
+// its owner would start it if each backlogged owner got one task in turn, and
+// the lowest tag runs first. An owner flooding the queue only delays its own
+// tasks; a new owner's first task is tagged with the current virtual time and
+// runs after at most one task of every other owner. Owners whose deadline is
+// within the urgency window go first, earliest deadline first; owners past the
+// deadline are being aborted and get no preference.
+class FairTaskQueue : boost::noncopyable
+{
+ public:
+  explicit FairTaskQueue(time_t urgency);
+
+  void push(const TseRunnableWrapper& task,
+            const void* owner,
+            time_t deadline,
+            bool front = false);
+  bool pop(TseRunnableWrapper& task,
+           time_t now);
+
+  bool empty() const { return 0 == _size; }
+  size_t size() const { return _size; }
+  size_t numberOwners() const { return _owners.size(); }
+
+ private:
+  struct Entry
+  {
+    TseRunnableWrapper task;
+    uint64_t startTag;
+    uint64_t sequence;
+  };
+
+  struct Owner
+  {
+    std::deque<Entry> entries;
+    uint64_t finishTag = 0;
+    time_t deadline = 0;
+  };
+
+  typedef std::tuple<uint64_t, uint64_t, const void*> TagKey;
+  typedef std::pair<time_t, const void*> DeadlineKey;
+
+  static TagKey tagKey(const Entry& entry, const void* owner)
+  {
+    return TagKey(entry.startTag, entry.sequence, owner);
+  }
+
+  const time_t _urgency;
+  std::unordered_map<const void*, Owner> _owners;
+  std::set<TagKey> _byTag;// first task of each backlogged owner
+  std::set<DeadlineKey> _byDeadline;// backlogged owners with a deadline
+  uint64_t _virtualTime = 0;
+  uint64_t _sequence = 0;
+  size_t _size = 0;
+};
+
+// Pool taking its tasks from a FairTaskQueue, so that a transaction flooding
+// the pool cannot starve the others. The owner and deadline come from the
+// task, see TseCallableTask::owner(). The booster does not take tasks from
+// this pool, it would bypass the queue.
+class FairThreadPool : public TseThreadPool
+{
+ public:
+  FairThreadPool(TseThreadingConst::TaskId taskId,
+                 size_t maxSize);
+  virtual ~FairThreadPool() override;
+
+  virtual TseRunnableWrapper getNext(unsigned id) override;
+  virtual void enqueue(const TseRunnableWrapper& task,
+                       bool front = false) override;
+  virtual size_t getQueueSize() const override;
+
+ private:
+  FairTaskQueue _queue;
+};
+
+}// tse
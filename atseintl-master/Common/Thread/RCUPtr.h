@@ -0,0 +1,133 @@
+// ----------------------------------------------------------------
+//
+//   Copyright Sabre 2016
+//
+//           The copyright to the computer program(s) herein
+//           is the property of Sabre.
+//           The program(s) may be used and/or copied only with
+//           the written permission of Sabre or in accordance
+//           with the terms and conditions stipulated in the
+//           agreement/contract under which the program(s)
+//           have been supplied.
+//
+// ----------------------------------------------------------------
+#pragma once
+
+// RCUPtr holds a pointer to an immutable object that is read at a very high
+// rate from many threads and replaced rarely. Readers never lock: they enter
+// a read-side section by bumping a per-thread-striped counter, load the
+// pointer and use the object until the section ends. A writer publishes a
+// replacement with one atomic store and then waits for a grace period, i.e.
+// until every reader that could have seen the old object has left its read
+// section, before deleting it.
+//
+// The grace period uses two counter phases (as in userspace RCU): the writer
+// flips the phase twice, each time waiting for the readers of the previous
+// phase to drain. Writers are serialized by an internal mutex and block for
+// the grace period, so publish() belongs on a background thread (cache
+// notification), never on the transaction path.
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include <sched.h>
+
+namespace tse
+{
+template <typename T>
+class RCUPtr
+{
+  static const size_t NUMBER_OF_STRIPES = 32;
+
+  struct alignas(64) Stripe
+  {
+    Stripe() { _readers[0] = _readers[1] = 0; }
+
+    std::atomic<size_t> _readers[2];
+  };
+
+public:
+  class ReadGuard
+  {
+  public:
+    explicit ReadGuard(const RCUPtr& rcu)
+      : _stripe(rcu._stripes[stripeIndex()]),
+        _phase(rcu._phase.load(std::memory_order_seq_cst) & 1)
+    {
+      _stripe._readers[_phase].fetch_add(1, std::memory_order_seq_cst);
+      _ptr = rcu._ptr.load(std::memory_order_seq_cst);
+    }
+
+    ~ReadGuard() { _stripe._readers[_phase].fetch_sub(1, std::memory_order_release); }
+
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+    const T* get() const { return _ptr; }
+    const T* operator->() const { return _ptr; }
+    const T& operator*() const { return *_ptr; }
+
+  private:
+    Stripe& _stripe;
+    const unsigned _phase;
+    const T* _ptr;
+  };
+
+  explicit RCUPtr(T* initial = nullptr) : _ptr(initial), _phase(0) {}
+
+  ~RCUPtr() { delete _ptr.load(); }
+
+  RCUPtr(const RCUPtr&) = delete;
+  RCUPtr& operator=(const RCUPtr&) = delete;
+
+  // Replaces the current object and deletes the old one once no reader
+  // can reference it any more.
+  void publish(T* replacement)
+  {
+    boost::lock_guard<boost::mutex> lock(_writerMutex);
+    std::unique_ptr<const T> old(_ptr.exchange(replacement, std::memory_order_seq_cst));
+    synchronize();
+  }
+
+  // Current object for a writer which serializes its updates externally,
+  // typically to build the copy it will publish next.
+  const T* unsafeGet() const { return _ptr.load(std::memory_order_acquire); }
+
+private:
+  static size_t stripeIndex()
+  {
+    static std::atomic<size_t> nextIndex(0);
+    static thread_local size_t index(nextIndex.fetch_add(1) % NUMBER_OF_STRIPES);
+    return index;
+  }
+
+  void waitForReaders(unsigned phase) const
+  {
+    for (size_t i = 0; i < NUMBER_OF_STRIPES; ++i)
+    {
+      while (_stripes[i]._readers[phase].load(std::memory_order_acquire) != 0)
+      {
+        sched_yield();
+      }
+    }
+  }
+
+  void synchronize()
+  {
+    for (int flip = 0; flip < 2; ++flip)
+    {
+      const unsigned oldPhase(_phase.fetch_xor(1, std::memory_order_seq_cst) & 1);
+      waitForReaders(oldPhase);
+    }
+  }
+
+  std::atomic<const T*> _ptr;
+  std::atomic<unsigned> _phase;
+  mutable Stripe _stripes[NUMBER_OF_STRIPES];
+  boost::mutex _writerMutex;
+};
+} // tse
@@ -3,8 +3,10 @@
 #include "Common/Config/ConfigMan.h"
 #include "Common/Global.h"
 #include "Common/Logger.h"
+#include "Common/Thread/FairThreadPool.h"
 #include "Common/Thread/ThreadPoolInfo.h"
 #include "Common/Thread/TseThreadPool.h"
+#include "Common/Thread/WorkStealingThreadPool.h"
 
 namespace tse
 {
@@ -30,7 +32,21 @@ TseThreadPool* getThreadPool(const ThreadPoolInfo& poolInfo)
   }
   else
   {
-    std::shared_ptr<TseThreadPool> ptr(new TseThreadPool(poolInfo._taskId, poolInfo._size));
+    std::shared_ptr<TseThreadPool> ptr;
+    if (ThreadPoolInfo::getFairScheduling(poolInfo._taskId))
+    {
+      LOG4CXX_INFO(logger, TseThreadingConst::getTaskName(poolInfo._taskId) << ":fair scheduling");
+      ptr.reset(new FairThreadPool(poolInfo._taskId, poolInfo._size));
+    }
+    else if (ThreadPoolInfo::getWorkStealing(poolInfo._taskId))
+    {
+      LOG4CXX_INFO(logger, TseThreadingConst::getTaskName(poolInfo._taskId) << ":work stealing");
+      ptr.reset(new WorkStealingThreadPool(poolInfo._taskId, poolInfo._size));
+    }
+    else
+    {
+      ptr.reset(new TseThreadPool(poolInfo._taskId, poolInfo._size));
+    }
     TseThreadPool::_poolMap.insert(std::make_pair(poolInfo._taskId, ptr));
     return ptr.get();
   }
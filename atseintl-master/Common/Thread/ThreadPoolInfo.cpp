@@ -129,6 +129,12 @@ const ThreadPoolInfo& ThreadPoolInfo::get(TseThreadingConst::TaskId taskId)
       return getPoolInfo<TseThreadingConst::FAREPATHPQ_TASK>("PRICING_SVC", key);
     }
     break;
+  case TseThreadingConst::SPECULATIVE_FAREPATH_TASK:
+    {
+      static const std::string key(boosterEnabled ? "SPECULATIVE_FAREPATH_POOLSIZE" : "SPECULATIVE_FAREPATH_POOLINGTHRESHOLD");
+      return getPoolInfo<TseThreadingConst::SPECULATIVE_FAREPATH_TASK>("PRICING_SVC", key);
+    }
+    break;
   case TseThreadingConst::PRICINGUNITPQ_TASK:
     {
       static const std::string key(boosterEnabled ? "PRICINGUNITPQ_POOLSIZE" : "PRICINGUNITPQ_POOLINGTHRESHOLD");
@@ -384,6 +390,48 @@ bool ThreadPoolInfo::getBoosterCombineTasks(TseThreadingConst::TaskId taskId)
   return set.find(taskId) != set.end();
 }
 
+namespace
+{
+
+bool isTaskListed(const std::string& name,
+                  TseThreadingConst::TaskId taskId)
+{
+  std::set<int> set;
+  if (Global::hasConfig())
+  {
+    std::string tasks;
+    if (Global::config().getValue(name, tasks, "TSE_SERVER"))
+    {
+      boost::char_separator<char> sep("|", "", boost::keep_empty_tokens);
+      boost::tokenizer<boost::char_separator<char> > tokens(tasks, sep);
+      for (const auto& task : tokens)
+      {
+        int id(atoi(task.c_str()));
+        set.insert(id);
+      }
+    }
+  }
+  return set.find(taskId) != set.end();
+}
+
+}// namespace
+
+bool ThreadPoolInfo::getWorkStealing(TseThreadingConst::TaskId taskId)
+{
+  return isTaskListed("WORK_STEALING_TASKS", taskId);
+}
+
+bool ThreadPoolInfo::getFairScheduling(TseThreadingConst::TaskId taskId)
+{
+  return isTaskListed("FAIR_SCHEDULING_TASKS", taskId);
+}
+
+int ThreadPoolInfo::getFairSchedulingUrgency()
+{
+  static const int seconds(getConfigValue("FAIR_SCHEDULING_URGENCY", 1, "TSE_SERVER"));
+  return seconds;
+}
+
 int ThreadPoolInfo::getBoosterThreshold(TseThreadingConst::TaskId taskId)
 {
   static int defaultThreshold(getDefaultBoosterThreshold());
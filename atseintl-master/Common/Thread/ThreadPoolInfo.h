@@ -32,6 +32,9 @@ struct ThreadPoolInfo
   static unsigned getTransactionThreshold();
   static int getIdleThreadTimeout();
   static unsigned getBoosterCombineThreshold(TseThreadingConst::TaskId taskId);
+  static bool getWorkStealing(TseThreadingConst::TaskId taskId);
+  static bool getFairScheduling(TseThreadingConst::TaskId taskId);
+  static int getFairSchedulingUrgency();
 
   const TseThreadingConst::TaskId _taskId;
   const int _size;
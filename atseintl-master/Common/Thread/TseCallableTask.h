@@ -22,6 +22,9 @@
 
 #pragma once
 
+#include <chrono>
+#include <ctime>
+
 namespace tse
 {
 
@@ -38,7 +41,25 @@ public:
 
   void setThrottled() { _throttled = true; }
 
+  // The transaction the task works for and when it times out (0 if it does not);
+  // fair pools share their threads between owners and hurry owners near the deadline.
+  const void* owner() const { return _owner; }
+  time_t deadline() const { return _deadline; }
+  void setOwner(const void* owner, time_t deadline)
+  {
+    _owner = owner;
+    _deadline = deadline;
+  }
+
+  // Stamped by the executor when the task is queued, to measure the queue wait.
+  typedef std::chrono::steady_clock Clock;
+  void setEnqueued(Clock::time_point enqueued) { _enqueued = enqueued; }
+  Clock::time_point enqueued() const { return _enqueued; }
+
 protected:
   bool _throttled = false;
+  const void* _owner = nullptr;
+  time_t _deadline = 0;
+  Clock::time_point _enqueued;
 };
 }// tse
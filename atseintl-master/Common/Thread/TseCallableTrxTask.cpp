@@ -5,7 +5,9 @@
 #include "Common/DCFactoryBase.h"
 #include "Common/Logger.h"
 #include "Common/TSELatencyData.h"
+#include "Common/TseSrvStats.h"
 #include "DataModel/PricingTrx.h"
+#include "DataModel/TrxAborter.h"
 
 #include <sstream>
 
@@ -49,6 +51,13 @@ private:
 
 __thread TseCallableTrxTask* CurThreadTseCallableTrxTask::_curTask = nullptr;
 
+time_t
+getDeadline(const Trx& trx)
+{
+  const TrxAborter* aborter = trx.aborter();
+  return aborter ? aborter->getTimeOutAt() : 0;
+}
+
 } // anon ns
 
 TseCallableTrxTask::TseCallableTrxTask()
@@ -96,6 +105,7 @@ void
 TseCallableTrxTask::trx(PricingTrx* trx)
 {
   _trx = trx;
+  setOwner(trx, getDeadline(*trx));
 
   bool isInitialized = !(_taskSeqNum < 0);
   if (!isInitialized) // has been not initialized yet
@@ -168,6 +178,12 @@ TseCallableTrxTask::run()
   const MallocContext allocatorContext(isChildThread);
 
   TSELatencyData d(*_trx, _desc, isChildThread);
+
+  if (_enqueued != Clock::time_point())
+  {
+    const std::chrono::duration<double> wait(Clock::now() - _enqueued);
+    TseSrvStats::recordTaskQueueWait(*_trx, wait.count());
+  }
   LOG4CXX_DEBUG(_logger, "Performing \"" << _desc << "\" sequenceID=" << getSequenceID());
 
   // Cause a new diagcollector to be created for this thread
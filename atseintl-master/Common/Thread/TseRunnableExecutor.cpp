@@ -75,6 +75,10 @@ void TseRunnableExecutor::execute(TseCallableTask* runnable,
     boost::lock_guard<boost::mutex> lock(_mutex);
     ++_count;
   }
+  if (LIKELY(runnable))
+  {
+    runnable->setEnqueued(TseCallableTask::Clock::now());
+  }
   TseRunnableWrapper task(runnable, this, destroyRunnable);
   _threads->enqueue(task);
 }
@@ -93,7 +97,16 @@ void TseRunnableExecutor::wait(bool dorethrow)
   }
   while (_count != 0)
   {
-    _condition.wait(lock);
+    lock.unlock();
+    const bool ran(_threads->runPendingTask(*this));
+    lock.lock();
+    if (!ran)
+    {
+      while (_count != 0)
+      {
+        _condition.wait(lock);
+      }
+    }
   }
   assert(0 == _count);
   if (dorethrow)
@@ -182,6 +195,7 @@ TseRunnableExecutor::recordStats(uint64_t startMillis) const
                    TseThreadingConst::getTaskName(_taskId)
                    << ":samples=" << _numberSamples[_taskId]
                    << ",combinedTasks=" << _threads->getNumberCombinedTasks()
+                   << ",stolenTasks=" << _threads->getNumberStolenTasks()
                    << ",poolSize=" << poolSize
                    << ",queueSize=" << queueSize
                    << ",activeThreads=" << activeThreads
@@ -99,6 +99,16 @@ class TseRunnableWrapper
   {
     return 0 == _subtasks[0]._runnable;
   }
+
+  TseCallableTask* runnable() const
+  {
+    return _subtasks[0]._runnable;
+  }
+
+  TseRunnableExecutor* executor() const
+  {
+    return _subtasks[0]._runnableExecutor;
+  }
 };
 
 }// tse
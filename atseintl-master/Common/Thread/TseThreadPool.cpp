@@ -76,8 +76,8 @@ TseThreadPool::PoolMap TseThreadPool::_poolMap;
 TseThreadPool::Thread::Thread(TseThreadPool& pool,
                               unsigned id)
   : _pool(pool)
-  , _thread(&Thread::run, this)
   , _id(id)
+  , _thread(&Thread::run, this)
 {
   ++numberThreads;
   if (numberThreads > numberThreadsMax)
@@ -129,6 +129,7 @@ TseThreadPool::TseThreadPool(TseThreadingConst::TaskId taskId,
   , _joining(false)
   , _numberActiveThreads(0)
   , _numberCombinedTasks(0)
+  , _numberStolenTasks(0)
 {
   if (_booster)
   {
@@ -241,6 +242,18 @@ bool TseThreadPool::canUseBooster() const
          && _tasks.size() + _numberActiveThreads >= _pool.size() + _boosterThreshold;
 }
 
+bool TseThreadPool::takeForBooster(TseRunnableWrapper& task)
+{
+  if (_tasks.empty())
+  {
+    return false;
+  }
+  // combines the task with the last queued one, as the booster did when it
+  // took the task in runImmediately
+  getFirstInQueue(task);
+  return true;
+}
+
 void TseThreadPool::getFirstInQueue(TseRunnableWrapper& task)
 {
   task = _tasks.front();
@@ -361,9 +374,9 @@ TseRunnableWrapper BoosterThreadPool::getNext(unsigned id)
           {
             break;
           }
-          if (boosterEffSize > _numberActiveThreads + _tasks.size())
+          if (boosterEffSize > _numberActiveThreads + _tasks.size()
+              && pool->takeForBooster(task))
           {
-            pool->getFirstInQueue(task);
             ++_numberActiveThreads;
             return task;
           }
@@ -404,17 +417,12 @@ void BoosterThreadPool::runImmediately(TseThreadPool& pool)
   bool notify(false);
   boost::lock_guard<boost::mutex> lock(_mutex);
   adjust();
-  Tasks& poolTasks(pool.getTasks());
-  while (!poolTasks.empty()
-         && boosterEffSize > _numberActiveThreads + _tasks.size())
+  TseRunnableWrapper task;
+  while (boosterEffSize > _numberActiveThreads + _tasks.size()
+         && pool.takeForBooster(task))
   {
     notify = true; 
-    _tasks.push_back(poolTasks.front());
-    poolTasks.pop_front();
-    if (pool.shouldCombineTasks())
-    {
-      combineTasks(_tasks.back(), poolTasks, pool.getTaskId());
-    }
+    _tasks.push_back(task);
     if (!pool.shouldConsumeBacklog())
     {
       break;
@@ -13,6 +13,7 @@ namespace tse
 {
 
 class BoosterThreadPool;
+class TseRunnableExecutor;
 
 class TseThreadPool : boost::noncopyable
 {
@@ -30,8 +31,8 @@ class TseThreadPool : boost::noncopyable
 
    private:
     TseThreadPool& _pool;
-    boost::thread _thread;
     const unsigned _id;
+    boost::thread _thread;
   };
 
   typedef boost::container::deque<TseRunnableWrapper> Tasks;
@@ -44,12 +45,16 @@ class TseThreadPool : boost::noncopyable
   virtual TseRunnableWrapper getNext(unsigned id);
   virtual void killThread(unsigned id);
 
-  void enqueue(const TseRunnableWrapper& task,
-               bool front = false);
-  bool canUseBooster() const;
+  virtual void enqueue(const TseRunnableWrapper& task,
+                       bool front = false);
+  // called with the mutex locked
+  virtual bool canUseBooster() const;
+  virtual bool takeForBooster(TseRunnableWrapper& task);
+  // runs a queued task of the executor on the calling thread while it waits
+  virtual bool runPendingTask(TseRunnableExecutor&) { return false; }
   void getFirstInQueue(TseRunnableWrapper& task);
   size_t size() const;
-  size_t getQueueSize() const;
+  virtual size_t getQueueSize() const;
   unsigned getNumberActiveThreads() const { return _numberActiveThreads; }
   const BoosterThreadPool* getBooster() const { return _booster; }
   boost::mutex& getMutex() { return _mutex; }
@@ -59,6 +64,7 @@ class TseThreadPool : boost::noncopyable
   bool shouldConsumeBacklog2() const { return _shouldConsumeBacklog2; }
   bool shouldCombineTasks() const { return _shouldCombineTasks; }
   size_t getNumberCombinedTasks() const { return _numberCombinedTasks; }
+  size_t getNumberStolenTasks() const { return _numberStolenTasks; }
   static void updateTrxConcurrency(unsigned activeTrxTasks);
   static unsigned getConcurrency();
 
@@ -83,6 +89,7 @@ class TseThreadPool : boost::noncopyable
   Tasks _tasks;
   boost::atomic<unsigned> _numberActiveThreads;
   boost::atomic<size_t> _numberCombinedTasks;
+  boost::atomic<size_t> _numberStolenTasks;
   Pool _pool;
 };
 
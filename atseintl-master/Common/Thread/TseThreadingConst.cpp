@@ -51,6 +51,7 @@ const char* TaskName[] =
   "BOOSTER_TASK",
   "THROTTLING_TASK",
   "LOAD_ON_UPDATE_TASK",
+  "SPECULATIVE_FAREPATH_TASK",
   "Should not display this"
 };
 
@@ -46,7 +46,8 @@ enum TaskId
   , BOOSTER_TASK
   , THROTTLING_TASK
   , LOAD_ON_UPDATE_TASK
-  , NUMBER_TASK_TYPE// 37 
+  , SPECULATIVE_FAREPATH_TASK
+  , NUMBER_TASK_TYPE// 38 
 };
 
 const char* getTaskName(TaskId taskId);
@@ -0,0 +1,383 @@
+#include "Common/Thread/WorkStealingThreadPool.h"
+
+#include "Common/Logger.h"
+
+
+namespace tse
+{
+
+namespace
+{
+
+Logger logger("atseintl.Common.WorkStealingThreadPool");
+
+// the pool and the deque of the worker running on this thread
+__thread WorkStealingThreadPool* currentPool = nullptr;
+__thread unsigned currentWorker = 0;
+__thread uint32_t randomState = 0;
+
+unsigned nextRandom(unsigned id)
+{
+  uint32_t x(randomState ? randomState : 2463534242u + id);
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  randomState = x;
+  return x;
+}
+
+// threads outside the pools, each keeps submitting to the same injection queue
+std::atomic<unsigned> numberSubmitters(0);
+__thread unsigned submitter = 0;
+
+unsigned getSubmitter()
+{
+  if (0 == submitter)
+  {
+    submitter = ++numberSubmitters;
+  }
+  return submitter;
+}
+
+}// namespace
+
+const size_t WorkStealingDeque::CAPACITY;
+
+WorkStealingDeque::WorkStealingDeque()
+  : _top(0)
+  , _bottom(0)
+{
+  for (auto& slot : _buffer)
+  {
+    slot.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+WorkStealingDeque::~WorkStealingDeque()
+{
+  while (TseRunnableWrapper* task = pop())
+  {
+    delete task;
+  }
+}
+
+bool WorkStealingDeque::push(TseRunnableWrapper* task)
+{
+  const int64_t bottom(_bottom.load(std::memory_order_relaxed));
+  const int64_t top(_top.load(std::memory_order_acquire));
+  if (bottom - top >= static_cast<int64_t>(CAPACITY))
+  {
+    return false;
+  }
+  _buffer[bottom % CAPACITY].store(task, std::memory_order_relaxed);
+  _bottom.store(bottom + 1, std::memory_order_release);
+  return true;
+}
+
+TseRunnableWrapper* WorkStealingDeque::pop()
+{
+  const int64_t bottom(_bottom.load(std::memory_order_relaxed) - 1);
+  _bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top(_top.load(std::memory_order_relaxed));
+  TseRunnableWrapper* task(nullptr);
+  if (top <= bottom)
+  {
+    task = _buffer[bottom % CAPACITY].load(std::memory_order_relaxed);
+    if (top == bottom)
+    {
+      // the last task, a thief may be taking it as well
+      if (!_top.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+      {
+        task = nullptr;
+      }
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+  }
+  else
+  {
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+TseRunnableWrapper* WorkStealingDeque::steal()
+{
+  int64_t top(_top.load(std::memory_order_acquire));
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const int64_t bottom(_bottom.load(std::memory_order_acquire));
+  if (top < bottom)
+  {
+    TseRunnableWrapper* task(_buffer[top % CAPACITY].load(std::memory_order_relaxed));
+    if (_top.compare_exchange_strong(top, top + 1,
+                                     std::memory_order_seq_cst,
+                                     std::memory_order_relaxed))
+    {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+size_t WorkStealingDeque::size() const
+{
+  const int64_t bottom(_bottom.load());
+  const int64_t top(_top.load());
+  return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(TseThreadingConst::TaskId taskId,
+                                               size_t maxSize)
+  : TseThreadPool(taskId, maxSize)
+  , _numberSleeping(0)
+  , _numberThreads(0)
+{
+  // a deque per worker, so the number of workers is bounded even if the pool
+  // is not; waiting workers run their own tasks, so that is enough
+  size_t workers(maxSize);
+  if (0 == workers)
+  {
+    workers = std::max(1u, boost::thread::hardware_concurrency());
+  }
+  _deques.reserve(workers);
+  _injectionQueues.reserve(workers);
+  for (size_t i = 0; i < workers; ++i)
+  {
+    _deques.emplace_back(new WorkStealingDeque);
+    _injectionQueues.emplace_back(new InjectionQueue);
+  }
+  LOG4CXX_INFO(logger, TseThreadingConst::getTaskName(taskId) << ":workers=" << workers);
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    _joining = true;
+  }
+  _condition.notify_all();
+  // the workers use the deques, join them before the deques go
+  Pool pool;
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    pool.swap(_pool);
+  }
+  pool.clear();
+}
+
+void WorkStealingThreadPool::enqueue(const TseRunnableWrapper& task,
+                                     bool front)
+{
+  if (!front && this == currentPool)
+  {
+    TseRunnableWrapper* copy(new TseRunnableWrapper(task));
+    if (LIKELY(_deques[currentWorker]->push(copy)))
+    {
+      wakeWorker();
+      return;
+    }
+    // the deque is full, run the task now rather than queue it behind others
+    delete copy;
+    TseRunnableWrapper(task).run();
+    return;
+  }
+  InjectionQueue& queue(*_injectionQueues[getSubmitter() % _injectionQueues.size()]);
+  {
+    boost::lock_guard<boost::mutex> lock(queue.mutex);
+    if (front)
+    {
+      queue.tasks.push_front(task);
+    }
+    else
+    {
+      queue.tasks.push_back(task);
+    }
+    ++queue.size;
+  }
+  if (_booster
+      && getQueueSize() + _numberActiveThreads >= _numberThreads + _boosterThreshold)
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    if (canUseBooster())
+    {
+      _booster->runImmediately(*this);
+    }
+  }
+  wakeWorker();
+}
+
+TseRunnableWrapper WorkStealingThreadPool::getNext(unsigned id)
+{
+  currentPool = this;
+  currentWorker = id;
+  TseRunnableWrapper task;
+  while (!takeOwn(id, task) && !takeInjected(id, task) && !steal(id, task))
+  {
+    boost::unique_lock<boost::mutex> lock(_mutex);
+    if (_joining)
+    {
+      break;
+    }
+    ++_numberSleeping;
+    // pairs with the fence in wakeWorker() after a task is queued
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!_joining && !hasWork())
+    {
+      _condition.wait(lock);
+    }
+    --_numberSleeping;
+  }
+  ++_numberActiveThreads;
+  return task;
+}
+
+size_t WorkStealingThreadPool::getQueueSize() const
+{
+  size_t queueSize(0);
+  for (const auto& deque : _deques)
+  {
+    queueSize += deque->size();
+  }
+  for (const auto& queue : _injectionQueues)
+  {
+    queueSize += queue->size;
+  }
+  return queueSize;
+}
+
+// Called with the mutex locked.
+bool WorkStealingThreadPool::canUseBooster() const
+{
+  const size_t queueSize(getQueueSize());
+  return queueSize > 0
+         && queueSize + _numberActiveThreads >= _pool.size() + _boosterThreshold;
+}
+
+// Called with the mutex locked.
+bool WorkStealingThreadPool::takeForBooster(TseRunnableWrapper& task)
+{
+  const unsigned noWorker(static_cast<unsigned>(_deques.size()));
+  return takeInjected(nextRandom(noWorker), task) || steal(noWorker, task);
+}
+
+bool WorkStealingThreadPool::runPendingTask(TseRunnableExecutor& executor)
+{
+  if (this != currentPool)
+  {
+    return false;
+  }
+  WorkStealingDeque& deque(*_deques[currentWorker]);
+  TseRunnableWrapper* own(deque.pop());
+  if (!own)
+  {
+    return false;
+  }
+  if (own->executor() != &executor)
+  {
+    // spawned before the waiting task started, leave it to the pool; the
+    // deque has room for it since it was just popped
+    deque.push(own);
+    return false;
+  }
+  TseRunnableWrapper task(*own);
+  delete own;
+  task.run();
+  return true;
+}
+
+bool WorkStealingThreadPool::takeOwn(unsigned id, TseRunnableWrapper& task)
+{
+  if (TseRunnableWrapper* own = _deques[id]->pop())
+  {
+    task = *own;
+    delete own;
+    return true;
+  }
+  return false;
+}
+
+bool WorkStealingThreadPool::takeInjected(unsigned start, TseRunnableWrapper& task)
+{
+  const size_t size(_injectionQueues.size());
+  for (size_t i = 0; i < size; ++i)
+  {
+    InjectionQueue& queue(*_injectionQueues[(start + i) % size]);
+    if (0 == queue.size)
+    {
+      continue;
+    }
+    boost::lock_guard<boost::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty())
+    {
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+      --queue.size;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingThreadPool::steal(unsigned id, TseRunnableWrapper& task)
+{
+  const size_t size(_deques.size());
+  const size_t start(nextRandom(id) % size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    const size_t victim((start + i) % size);
+    if (victim == id)
+    {
+      continue;
+    }
+    if (TseRunnableWrapper* stolen = _deques[victim]->steal())
+    {
+      task = *stolen;
+      delete stolen;
+      ++_numberStolenTasks;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingThreadPool::hasWork() const
+{
+  return getQueueSize() > 0;
+}
+
+// Called with the mutex locked.
+void WorkStealingThreadPool::addThread()
+{
+  std::shared_ptr<Thread> thread(new Thread(*this, static_cast<unsigned>(_pool.size())));
+  _pool.push_back(thread);
+  ++_numberThreads;
+}
+
+void WorkStealingThreadPool::wakeWorker()
+{
+  // pairs with the fence after a worker counts itself sleeping and before it
+  // checks the queues: either the worker sees the task or we see the worker
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (_numberSleeping > 0)
+  {
+    {
+      boost::lock_guard<boost::mutex> lock(_mutex);
+    }
+    _condition.notify_one();
+    return;
+  }
+  // nobody idle, start another worker while there is room
+  if (_numberThreads >= _deques.size())
+  {
+    return;
+  }
+  boost::lock_guard<boost::mutex> lock(_mutex);
+  if (_pool.size() < _deques.size() && 0 == _numberSleeping)
+  {
+    addThread();
+  }
+}
+
+}// tse
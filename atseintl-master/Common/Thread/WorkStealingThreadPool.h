@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Common/Thread/TseThreadPool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace tse
+{
+
+// Chase-Lev deque of tasks owned by one worker: the owner pushes and pops at
+// the bottom without locking, other workers steal from the top. The capacity
+// is fixed; push() fails when the deque is full and the caller queues the task
+// elsewhere.
+class WorkStealingDeque : boost::noncopyable
+{
+ public:
+  static const size_t CAPACITY = 1024;
+
+  WorkStealingDeque();
+  ~WorkStealingDeque();
+
+  // owner only
+  bool push(TseRunnableWrapper* task);
+  TseRunnableWrapper* pop();
+
+  // any thread
+  TseRunnableWrapper* steal();
+  size_t size() const;
+
+ private:
+  std::atomic<int64_t> _top;
+  std::atomic<int64_t> _bottom;
+  std::atomic<TseRunnableWrapper*> _buffer[CAPACITY];
+};
+
+// Pool with a deque per worker. Tasks enqueued by a worker of the pool go to
+// its own deque and are taken back in LIFO order; idle workers steal the
+// oldest task from a randomly chosen victim. Tasks enqueued from outside the
+// pool go to an injection queue picked by the submitting thread, so external
+// submitters only contend with the threads sharing their queue. The booster
+// takes its tasks from the injection queues and the deques. A worker waiting
+// for its executor runs the tasks it spawned that are still in its deque, so
+// nested fan-out cannot starve the pool. Tasks are the same TseRunnableWrapper
+// objects, so the TseRunnableExecutor counting, cancellation and exception
+// recording are unchanged.
+class WorkStealingThreadPool : public TseThreadPool
+{
+ public:
+  WorkStealingThreadPool(TseThreadingConst::TaskId taskId,
+                         size_t maxSize);
+  virtual ~WorkStealingThreadPool() override;
+
+  virtual TseRunnableWrapper getNext(unsigned id) override;
+  virtual void enqueue(const TseRunnableWrapper& task,
+                       bool front = false) override;
+  virtual size_t getQueueSize() const override;
+  virtual bool canUseBooster() const override;
+  virtual bool takeForBooster(TseRunnableWrapper& task) override;
+  virtual bool runPendingTask(TseRunnableExecutor& executor) override;
+
+ private:
+  struct InjectionQueue
+  {
+    boost::mutex mutex;
+    Tasks tasks;
+    std::atomic<size_t> size{0};
+  };
+
+  bool takeOwn(unsigned id, TseRunnableWrapper& task);
+  bool takeInjected(unsigned start, TseRunnableWrapper& task);
+  bool steal(unsigned id, TseRunnableWrapper& task);
+  bool hasWork() const;
+  void addThread();
+  void wakeWorker();
+
+  std::vector<std::unique_ptr<WorkStealingDeque>> _deques;
+  std::vector<std::unique_ptr<InjectionQueue>> _injectionQueues;
+  std::atomic<unsigned> _numberSleeping;
+  std::atomic<size_t> _numberThreads;
+};
+
+}// tse
@@ -0,0 +1,182 @@
+#include "test/include/CppUnitHelperMacros.h"
+
+#include "Common/Thread/FairThreadPool.h"
+#include "Common/Thread/TseCallableTask.h"
+#include "Common/Thread/TseRunnableExecutor.h"
+
+#include <atomic>
+#include <vector>
+
+namespace tse
+{
+namespace
+{
+class FairExecutor : public TseRunnableExecutor
+{
+public:
+  explicit FairExecutor(TseThreadPool& pool)
+    : TseRunnableExecutor(TseThreadingConst::SCOPED_EXECUTOR_TASK, 0)
+  {
+    _threads = &pool;
+  }
+};
+
+class CountingTask : public TseCallableTask
+{
+public:
+  CountingTask(std::atomic<int>& counter, const void* owner) : _counter(counter)
+  {
+    setOwner(owner, 0);
+  }
+
+  virtual void performTask() override { ++_counter; }
+
+private:
+  std::atomic<int>& _counter;
+};
+}
+
+class FairThreadPoolTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(FairThreadPoolTest);
+  CPPUNIT_TEST(testEmpty);
+  CPPUNIT_TEST(testSingleOwnerFifo);
+  CPPUNIT_TEST(testNewOwnerNotStarved);
+  CPPUNIT_TEST(testOwnersAlternate);
+  CPPUNIT_TEST(testFront);
+  CPPUNIT_TEST(testUrgentOwnerFirst);
+  CPPUNIT_TEST(testPastDeadlineNotPreferred);
+  CPPUNIT_TEST(testOwnerForgottenWhenDrained);
+  CPPUNIT_TEST(testPool);
+  CPPUNIT_TEST_SUITE_END();
+
+  TseCallableTask _tasks[8];
+  const int _big = 1;
+  const int _small = 2;
+
+  TseRunnableWrapper wrap(size_t i) { return TseRunnableWrapper(&_tasks[i]); }
+
+  TseCallableTask* popTask(FairTaskQueue& queue, time_t now = 1000)
+  {
+    TseRunnableWrapper task;
+    CPPUNIT_ASSERT(queue.pop(task, now));
+    return task.runnable();
+  }
+
+public:
+  void testEmpty()
+  {
+    FairTaskQueue queue(1);
+    TseRunnableWrapper task;
+    CPPUNIT_ASSERT(queue.empty());
+    CPPUNIT_ASSERT(!queue.pop(task, 1000));
+  }
+
+  void testSingleOwnerFifo()
+  {
+    FairTaskQueue queue(1);
+    for (size_t i = 0; i < 3; ++i)
+      queue.push(wrap(i), &_big, 0);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), queue.size());
+    CPPUNIT_ASSERT_EQUAL(&_tasks[0], popTask(queue));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[1], popTask(queue));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[2], popTask(queue));
+    CPPUNIT_ASSERT(queue.empty());
+  }
+
+  void testNewOwnerNotStarved()
+  {
+    FairTaskQueue queue(1);
+    for (size_t i = 0; i < 6; ++i)
+      queue.push(wrap(i), &_big, 0);
+    CPPUNIT_ASSERT_EQUAL(&_tasks[0], popTask(queue));
+    queue.push(wrap(7), &_small, 0);
+    // ahead of the backlog of the big owner
+    CPPUNIT_ASSERT_EQUAL(&_tasks[7], popTask(queue));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[1], popTask(queue));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[2], popTask(queue));
+  }
+
+  void testOwnersAlternate()
+  {
+    FairTaskQueue queue(1);
+    for (size_t i = 0; i < 4; ++i)
+      queue.push(wrap(i), &_big, 0);
+    for (size_t i = 4; i < 6; ++i)
+      queue.push(wrap(i), &_small, 0);
+    CPPUNIT_ASSERT_EQUAL(&_tasks[0], popTask(queue));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[4], popTask(queue));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[1], popTask(queue));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[5], popTask(queue));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[2], popTask(queue));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[3], popTask(queue));
+  }
+
+  void testFront()
+  {
+    FairTaskQueue queue(1);
+    queue.push(wrap(0), &_big, 0);
+    queue.push(wrap(1), &_big, 0);
+    queue.push(wrap(2), &_big, 0, true);
+    CPPUNIT_ASSERT_EQUAL(&_tasks[2], popTask(queue));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[0], popTask(queue));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[1], popTask(queue));
+  }
+
+  void testUrgentOwnerFirst()
+  {
+    FairTaskQueue queue(2);
+    queue.push(wrap(0), &_big, 0);
+    queue.push(wrap(1), &_big, 0);
+    queue.push(wrap(2), &_small, 1010);
+    queue.push(wrap(3), &_small, 1010);
+    CPPUNIT_ASSERT_EQUAL(&_tasks[0], popTask(queue, 1000));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[2], popTask(queue, 1008));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[3], popTask(queue, 1008));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[1], popTask(queue, 1008));
+  }
+
+  void testPastDeadlineNotPreferred()
+  {
+    FairTaskQueue queue(2);
+    queue.push(wrap(0), &_big, 0);
+    queue.push(wrap(1), &_small, 1000);
+    queue.push(wrap(2), &_small, 1000);
+    CPPUNIT_ASSERT_EQUAL(&_tasks[0], popTask(queue, 1001));
+    CPPUNIT_ASSERT_EQUAL(&_tasks[1], popTask(queue, 1001));
+  }
+
+  void testOwnerForgottenWhenDrained()
+  {
+    FairTaskQueue queue(1);
+    queue.push(wrap(0), &_big, 1010);
+    queue.push(wrap(1), &_small, 0);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), queue.numberOwners());
+    popTask(queue);
+    popTask(queue);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), queue.numberOwners());
+    queue.push(wrap(2), &_big, 0);
+    // the old deadline is gone with the owner
+    CPPUNIT_ASSERT_EQUAL(&_tasks[2], popTask(queue, 1010));
+  }
+
+  void testPool()
+  {
+    FairThreadPool pool(TseThreadingConst::SCOPED_EXECUTOR_TASK, 4);
+    std::atomic<int> counter(0);
+    std::vector<CountingTask> bigTasks(500, CountingTask(counter, &_big));
+    std::vector<CountingTask> smallTasks(5, CountingTask(counter, &_small));
+    FairExecutor bigExecutor(pool);
+    FairExecutor smallExecutor(pool);
+    for (CountingTask& task : bigTasks)
+      bigExecutor.execute(task);
+    for (CountingTask& task : smallTasks)
+      smallExecutor.execute(task);
+    smallExecutor.wait();
+    bigExecutor.wait();
+    CPPUNIT_ASSERT_EQUAL(505, counter.load());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), pool.getQueueSize());
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(FairThreadPoolTest);
+}
@@ -0,0 +1,125 @@
+#include "test/include/CppUnitHelperMacros.h"
+
+#include "Common/Thread/RCUPtr.h"
+
+#include <boost/thread.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace tse
+{
+namespace
+{
+// Counts live instances and poisons itself on destruction so that a reader
+// using a reclaimed snapshot is detected.
+struct Tracked
+{
+  explicit Tracked(int value) : _value(value), _alive(true) { ++live(); }
+  ~Tracked()
+  {
+    _alive = false;
+    --live();
+  }
+
+  static std::atomic<int>& live()
+  {
+    static std::atomic<int> counter(0);
+    return counter;
+  }
+
+  int _value;
+  volatile bool _alive;
+};
+}
+
+class RCUPtrTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(RCUPtrTest);
+  CPPUNIT_TEST(testRead);
+  CPPUNIT_TEST(testPublishDeletesOld);
+  CPPUNIT_TEST(testDestructorDeletesCurrent);
+  CPPUNIT_TEST(testConcurrentReadersNeverSeeReclaimedObject);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testRead()
+  {
+    RCUPtr<Tracked> rcu(new Tracked(1));
+    RCUPtr<Tracked>::ReadGuard guard(rcu);
+    CPPUNIT_ASSERT_EQUAL(1, guard->_value);
+  }
+
+  void testPublishDeletesOld()
+  {
+    const int before(Tracked::live());
+    {
+      RCUPtr<Tracked> rcu(new Tracked(1));
+      rcu.publish(new Tracked(2));
+      CPPUNIT_ASSERT_EQUAL(before + 1, Tracked::live().load());
+      CPPUNIT_ASSERT_EQUAL(2, rcu.unsafeGet()->_value);
+    }
+    CPPUNIT_ASSERT_EQUAL(before, Tracked::live().load());
+  }
+
+  void testDestructorDeletesCurrent()
+  {
+    const int before(Tracked::live());
+    {
+      RCUPtr<Tracked> rcu(new Tracked(1));
+    }
+    CPPUNIT_ASSERT_EQUAL(before, Tracked::live().load());
+  }
+
+  struct Reader
+  {
+    Reader(RCUPtr<Tracked>& rcu, std::atomic<bool>& stop, std::atomic<int>& errors)
+      : _rcu(rcu), _stop(stop), _errors(errors)
+    {
+    }
+
+    void run()
+    {
+      int last(0);
+      while (!_stop)
+      {
+        RCUPtr<Tracked>::ReadGuard guard(_rcu);
+        const int value(guard->_value);
+        boost::this_thread::yield();
+        // values only grow and the object must stay alive inside the guard
+        if (!guard->_alive || guard->_value != value || value < last)
+        {
+          ++_errors;
+        }
+        last = value;
+      }
+    }
+
+    RCUPtr<Tracked>& _rcu;
+    std::atomic<bool>& _stop;
+    std::atomic<int>& _errors;
+  };
+
+  void testConcurrentReadersNeverSeeReclaimedObject()
+  {
+    RCUPtr<Tracked> rcu(new Tracked(0));
+    std::atomic<bool> stop(false);
+    std::atomic<int> errors(0);
+    boost::thread_group readers;
+    for (int i = 0; i < 6; ++i)
+    {
+      Reader reader(rcu, stop, errors);
+      readers.create_thread(boost::bind(&Reader::run, reader));
+    }
+    for (int i = 1; i <= 2000; ++i)
+    {
+      rcu.publish(new Tracked(i));
+    }
+    stop = true;
+    readers.join_all();
+    CPPUNIT_ASSERT_EQUAL(0, errors.load());
+    CPPUNIT_ASSERT_EQUAL(2000, rcu.unsafeGet()->_value);
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(RCUPtrTest);
+}
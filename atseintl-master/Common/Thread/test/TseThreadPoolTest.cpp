@@ -0,0 +1,95 @@
+#include "test/include/CppUnitHelperMacros.h"
+
+#include "Common/Thread/TseCallableTask.h"
+#include "Common/Thread/TseThreadPool.h"
+#include "test/include/TestConfigInitializer.h"
+#include "test/include/TestMemHandle.h"
+
+#include <boost/lexical_cast.hpp>
+
+namespace tse
+{
+class TseThreadPoolTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TseThreadPoolTest);
+  CPPUNIT_TEST(testTakeForBoosterCombinesTasks);
+  CPPUNIT_TEST(testTakeForBoosterWithoutCombining);
+  CPPUNIT_TEST(testTakeForBoosterEmpty);
+  CPPUNIT_TEST_SUITE_END();
+
+  TestMemHandle _memHandle;
+  TseCallableTask _tasks[4];
+
+  // queues the tasks without starting pool threads
+  void queueTasks(TseThreadPool& pool)
+  {
+    for (TseCallableTask& task : _tasks)
+    {
+      pool.getTasks().push_back(TseRunnableWrapper(&task));
+    }
+  }
+
+  void combineTasks()
+  {
+    TestConfigInitializer::setValue(
+        "BOOSTER_COMBINED_TASKS",
+        boost::lexical_cast<std::string>(int(TseThreadingConst::SCOPED_EXECUTOR_TASK)),
+        "TSE_SERVER");
+  }
+
+public:
+  void setUp() { _memHandle.create<TestConfigInitializer>(); }
+
+  void tearDown() { _memHandle.clear(); }
+
+  void testTakeForBoosterCombinesTasks()
+  {
+    combineTasks();
+    TseThreadPool pool(TseThreadingConst::SCOPED_EXECUTOR_TASK, 0);
+    CPPUNIT_ASSERT(pool.shouldCombineTasks());
+    queueTasks(pool);
+
+    TseRunnableWrapper task;
+    {
+      boost::lock_guard<boost::mutex> lock(pool.getMutex());
+      CPPUNIT_ASSERT(pool.takeForBooster(task));
+    }
+    // the first queued task carries the last one
+    CPPUNIT_ASSERT_EQUAL(&_tasks[0], task.runnable());
+    CPPUNIT_ASSERT(!task.canMerge());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), pool.getTasks().size());
+    CPPUNIT_ASSERT_EQUAL(&_tasks[1], pool.getTasks().front().runnable());
+    CPPUNIT_ASSERT_EQUAL(&_tasks[2], pool.getTasks().back().runnable());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), pool.getNumberCombinedTasks());
+    pool.getTasks().clear();
+  }
+
+  void testTakeForBoosterWithoutCombining()
+  {
+    TseThreadPool pool(TseThreadingConst::SCOPED_EXECUTOR_TASK, 0);
+    CPPUNIT_ASSERT(!pool.shouldCombineTasks());
+    queueTasks(pool);
+
+    TseRunnableWrapper task;
+    {
+      boost::lock_guard<boost::mutex> lock(pool.getMutex());
+      CPPUNIT_ASSERT(pool.takeForBooster(task));
+    }
+    CPPUNIT_ASSERT_EQUAL(&_tasks[0], task.runnable());
+    CPPUNIT_ASSERT(task.canMerge());
+    CPPUNIT_ASSERT_EQUAL(size_t(3), pool.getTasks().size());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), pool.getNumberCombinedTasks());
+    pool.getTasks().clear();
+  }
+
+  void testTakeForBoosterEmpty()
+  {
+    TseThreadPool pool(TseThreadingConst::SCOPED_EXECUTOR_TASK, 0);
+    TseRunnableWrapper task;
+    boost::lock_guard<boost::mutex> lock(pool.getMutex());
+    CPPUNIT_ASSERT(!pool.takeForBooster(task));
+    CPPUNIT_ASSERT(task.empty());
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TseThreadPoolTest);
+}
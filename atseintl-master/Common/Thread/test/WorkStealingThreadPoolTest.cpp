@@ -0,0 +1,259 @@
+#include "test/include/CppUnitHelperMacros.h"
+
+#include "Common/Thread/TseCallableTask.h"
+#include "Common/Thread/TseRunnableExecutor.h"
+#include "Common/Thread/WorkStealingThreadPool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace tse
+{
+namespace
+{
+class WorkStealingExecutor : public TseRunnableExecutor
+{
+public:
+  explicit WorkStealingExecutor(TseThreadPool& pool)
+    : TseRunnableExecutor(TseThreadingConst::SCOPED_EXECUTOR_TASK, 0)
+  {
+    _threads = &pool;
+  }
+};
+
+class CountingTask : public TseCallableTask
+{
+public:
+  explicit CountingTask(std::atomic<int>& counter) : _counter(counter) {}
+
+  virtual void performTask() override { ++_counter; }
+
+private:
+  std::atomic<int>& _counter;
+};
+
+// Spawns its children on the pool it runs in, so that they go to the deque of
+// the worker and get stolen by the others.
+class SpawningTask : public TseCallableTask
+{
+public:
+  SpawningTask(TseThreadPool& pool, std::atomic<int>& counter, int children)
+    : _pool(pool), _counter(counter), _children(children)
+  {
+  }
+
+  virtual void performTask() override
+  {
+    WorkStealingExecutor executor(_pool);
+    std::vector<CountingTask> tasks(_children, CountingTask(_counter));
+    for (CountingTask& task : tasks)
+    {
+      executor.execute(task);
+    }
+    executor.wait();
+    ++_counter;
+  }
+
+private:
+  TseThreadPool& _pool;
+  std::atomic<int>& _counter;
+  const int _children;
+};
+
+class BlockingTask : public TseCallableTask
+{
+public:
+  virtual void performTask() override
+  {
+    _started = true;
+    while (!_released)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  void waitStarted() const
+  {
+    while (!_started)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  void release() { _released = true; }
+
+private:
+  std::atomic<bool> _started{false};
+  std::atomic<bool> _released{false};
+};
+
+class ThrowingTask : public TseCallableTask
+{
+public:
+  virtual void performTask() override { throw std::runtime_error("task failed"); }
+};
+}
+
+class WorkStealingThreadPoolTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(WorkStealingThreadPoolTest);
+  CPPUNIT_TEST(testDequeOwnerLifo);
+  CPPUNIT_TEST(testDequeStealFifo);
+  CPPUNIT_TEST(testDequeFull);
+  CPPUNIT_TEST(testExternalTasks);
+  CPPUNIT_TEST(testNestedTasksAreStolen);
+  CPPUNIT_TEST(testNestedWaitOnSingleWorker);
+  CPPUNIT_TEST(testBoosterTakesQueuedTasks);
+  CPPUNIT_TEST(testExceptionRethrownByWait);
+  CPPUNIT_TEST(testCanceledExecutorSkipsTasks);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testDequeOwnerLifo()
+  {
+    WorkStealingDeque deque;
+    TseRunnableWrapper* first(new TseRunnableWrapper);
+    TseRunnableWrapper* second(new TseRunnableWrapper);
+    CPPUNIT_ASSERT(deque.push(first));
+    CPPUNIT_ASSERT(deque.push(second));
+    CPPUNIT_ASSERT_EQUAL(size_t(2), deque.size());
+    CPPUNIT_ASSERT_EQUAL(second, deque.pop());
+    CPPUNIT_ASSERT_EQUAL(first, deque.pop());
+    CPPUNIT_ASSERT(!deque.pop());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), deque.size());
+    delete first;
+    delete second;
+  }
+
+  void testDequeStealFifo()
+  {
+    WorkStealingDeque deque;
+    TseRunnableWrapper* first(new TseRunnableWrapper);
+    TseRunnableWrapper* second(new TseRunnableWrapper);
+    deque.push(first);
+    deque.push(second);
+    CPPUNIT_ASSERT_EQUAL(first, deque.steal());
+    CPPUNIT_ASSERT_EQUAL(second, deque.pop());
+    CPPUNIT_ASSERT(!deque.steal());
+    delete first;
+    delete second;
+  }
+
+  void testDequeFull()
+  {
+    WorkStealingDeque deque;
+    for (size_t i = 0; i < WorkStealingDeque::CAPACITY; ++i)
+    {
+      CPPUNIT_ASSERT(deque.push(new TseRunnableWrapper));
+    }
+    TseRunnableWrapper extra;
+    CPPUNIT_ASSERT(!deque.push(&extra));
+    delete deque.steal();
+    CPPUNIT_ASSERT(deque.push(new TseRunnableWrapper));
+  }
+
+  void testExternalTasks()
+  {
+    WorkStealingThreadPool pool(TseThreadingConst::SCOPED_EXECUTOR_TASK, 4);
+    std::atomic<int> counter(0);
+    std::vector<CountingTask> tasks(1000, CountingTask(counter));
+    {
+      WorkStealingExecutor executor(pool);
+      for (CountingTask& task : tasks)
+      {
+        executor.execute(task);
+      }
+      executor.wait();
+      CPPUNIT_ASSERT_EQUAL(1000, counter.load());
+    }
+    CPPUNIT_ASSERT(pool.size() <= 4);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), pool.getQueueSize());
+  }
+
+  void testNestedTasksAreStolen()
+  {
+    WorkStealingThreadPool pool(TseThreadingConst::SCOPED_EXECUTOR_TASK, 4);
+    std::atomic<int> counter(0);
+    std::vector<SpawningTask> tasks(2, SpawningTask(pool, counter, 200));
+    WorkStealingExecutor executor(pool);
+    for (SpawningTask& task : tasks)
+    {
+      executor.execute(task);
+    }
+    executor.wait();
+    CPPUNIT_ASSERT_EQUAL(2 * 201, counter.load());
+    CPPUNIT_ASSERT(pool.getNumberStolenTasks() > 0);
+  }
+
+  void testNestedWaitOnSingleWorker()
+  {
+    // the only worker waits for children that nobody else can run, more than
+    // its deque holds
+    WorkStealingThreadPool pool(TseThreadingConst::SCOPED_EXECUTOR_TASK, 1);
+    std::atomic<int> counter(0);
+    const int children(2 * WorkStealingDeque::CAPACITY);
+    std::vector<SpawningTask> tasks(3, SpawningTask(pool, counter, children));
+    WorkStealingExecutor executor(pool);
+    for (SpawningTask& task : tasks)
+    {
+      executor.execute(task);
+    }
+    executor.wait();
+    CPPUNIT_ASSERT_EQUAL(3 * (children + 1), counter.load());
+  }
+
+  void testBoosterTakesQueuedTasks()
+  {
+    WorkStealingThreadPool pool(TseThreadingConst::SCOPED_EXECUTOR_TASK, 1);
+    BlockingTask blocking;
+    std::atomic<int> counter(0);
+    std::vector<CountingTask> tasks(10, CountingTask(counter));
+    WorkStealingExecutor executor(pool);
+    executor.execute(blocking);
+    blocking.waitStarted();
+    for (CountingTask& task : tasks)
+    {
+      executor.execute(task);
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(10), pool.getQueueSize());
+    TseRunnableWrapper task;
+    {
+      boost::lock_guard<boost::mutex> lock(pool.getMutex());
+      CPPUNIT_ASSERT(pool.takeForBooster(task));
+    }
+    task.run();
+    CPPUNIT_ASSERT_EQUAL(1, counter.load());
+    CPPUNIT_ASSERT_EQUAL(size_t(9), pool.getQueueSize());
+    blocking.release();
+    executor.wait();
+    CPPUNIT_ASSERT_EQUAL(10, counter.load());
+  }
+
+  void testExceptionRethrownByWait()
+  {
+    WorkStealingThreadPool pool(TseThreadingConst::SCOPED_EXECUTOR_TASK, 2);
+    ThrowingTask task;
+    WorkStealingExecutor executor(pool);
+    executor.execute(task);
+    CPPUNIT_ASSERT_THROW(executor.wait(), ErrorResponseException);
+  }
+
+  void testCanceledExecutorSkipsTasks()
+  {
+    WorkStealingThreadPool pool(TseThreadingConst::SCOPED_EXECUTOR_TASK, 2);
+    std::atomic<int> counter(0);
+    std::vector<CountingTask> tasks(100, CountingTask(counter));
+    WorkStealingExecutor executor(pool);
+    executor.cancel();
+    for (CountingTask& task : tasks)
+    {
+      executor.execute(task);
+    }
+    executor.wait();
+    CPPUNIT_ASSERT_EQUAL(0, counter.load());
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(WorkStealingThreadPoolTest);
+}
@@ -25,6 +25,7 @@
 #include "Common/ErrorResponseException.h"
 #include "Common/ShoppingUtil.h"
 
+#include <cstring>
 #include <iostream>
 
 namespace tse
@@ -71,10 +72,16 @@ globalDirectionToStr(const GlobalDirection src)
 
 bool
 strToGlobalDirection(GlobalDirection& dst, const std::string& src)
+{
+  return strToGlobalDirection(dst, src.c_str());
+}
+
+bool
+strToGlobalDirection(GlobalDirection& dst, const char* src)
 {
   for (int gdIdx = 0; gdIdx < GlobalDirectionItemsCnt; gdIdx++)
   {
-    if (src == globalDirectionItems[gdIdx])
+    if (strcmp(src, globalDirectionItems[gdIdx]) == 0)
     {
       dst = static_cast<GlobalDirection>(gdIdx + 1);
       return true;
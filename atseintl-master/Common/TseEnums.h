@@ -71,6 +71,8 @@ const std::string*
 globalDirectionToStr(const GlobalDirection src);
 bool
 strToGlobalDirection(GlobalDirection& dst, const std::string& src);
+bool
+strToGlobalDirection(GlobalDirection& dst, const char* src);
 
 /*---------------------------------------------------------------------------
  * Geo Travel Types
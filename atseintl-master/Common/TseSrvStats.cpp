@@ -269,6 +269,13 @@ enum STATS
   SVC_NUMBER_CAT25_FARES,
   SVC_NUMBER_ADDON_FARES,
   SVC_NUMBER_VALIDATED_FARES,
+  // Thread pool queue wait histogram
+  TASK_WAIT_1MS,
+  TASK_WAIT_10MS,
+  TASK_WAIT_100MS,
+  TASK_WAIT_1S,
+  TASK_WAIT_LONGER,
+  TASK_WAIT_TIME,
   MAX_STAT_DATA_OFFSET
 };
 
@@ -568,6 +575,15 @@ TseSrvStats::dumpStats(std::ostream& os)
   TseSrvStats::dumpStats(os, _acStats->ABCC, "ABC");
   TseSrvStats::dumpStats(os, _acStats->S8BRAND, "S8B");
 
+  os << "<TQW"
+     << " W1=\"" << _acStats->taskQueueWait[0] << "\""
+     << " W2=\"" << _acStats->taskQueueWait[1] << "\""
+     << " W3=\"" << _acStats->taskQueueWait[2] << "\""
+     << " W4=\"" << _acStats->taskQueueWait[3] << "\""
+     << " W5=\"" << _acStats->taskQueueWait[4] << "\""
+     << " WT=\"" << _acStats->taskQueueWaitTime << "\""
+     << " />";
+
   os << "</STATS>";
 }
 
@@ -1269,6 +1285,7 @@ TseSrvStats::publishStats(Trx& trx, bool publishASAP)
 
   const MallocContextDisabler context;
   boost::lock_guard<boost::mutex> guard(trx.statDataMutex());
+  mergeTaskQueueWait(trx);
   std::vector<double>& statData = trx.statData();
 
   if (statData.empty())
@@ -1332,6 +1349,51 @@ TseSrvStats::recordServiceCall(
   statData[threadIndex] = activeThreads;
 }
 
+//----------------------------------------------------------------------------
+// recordTaskQueueWait()
+//----------------------------------------------------------------------------
+void
+TseSrvStats::recordTaskQueueWait(Trx& trx, double waitTime)
+{
+  // Every pool task reports here, keep the stat data mutex out of it
+  size_t bucket = 0;
+  for (double limit = 0.001; bucket < TASK_WAIT_LONGER - TASK_WAIT_1MS && waitTime >= limit;
+       limit *= 10)
+    ++bucket;
+
+  std::atomic<uint64_t>* taskQueueWait = trx.taskQueueWait();
+  taskQueueWait[bucket].fetch_add(1, std::memory_order_relaxed);
+  taskQueueWait[Trx::TASK_QUEUE_WAIT_SIZE - 1].fetch_add(static_cast<uint64_t>(waitTime * 1e6),
+                                                          std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+// mergeTaskQueueWait()
+//----------------------------------------------------------------------------
+void
+TseSrvStats::mergeTaskQueueWait(Trx& trx)
+{
+  // Already locked by the caller
+  std::atomic<uint64_t>* taskQueueWait = trx.taskQueueWait();
+  uint64_t waits[Trx::TASK_QUEUE_WAIT_SIZE];
+  bool any = false;
+  for (size_t i = 0; i < Trx::TASK_QUEUE_WAIT_SIZE; ++i)
+  {
+    waits[i] = taskQueueWait[i].exchange(0, std::memory_order_relaxed);
+    any = any || waits[i] != 0;
+  }
+  if (!any)
+    return;
+
+  std::vector<double>& statData = trx.statData();
+  if (statData.empty())
+    setupTrxStats(statData);
+
+  for (size_t i = 0; i <= TASK_WAIT_LONGER - TASK_WAIT_1MS; ++i)
+    statData[TASK_WAIT_1MS + i] += double(waits[i]);
+  statData[TASK_WAIT_TIME] += double(waits[Trx::TASK_QUEUE_WAIT_SIZE - 1]) / 1e6;
+}
+
 //----------------------------------------------------------------------------
 // publishAppConsoleStats()
 //----------------------------------------------------------------------------
@@ -1419,6 +1481,11 @@ TseSrvStats::publishAppConsoleStats(Trx& trx)
   _acStats->TicketingCxr.totalReqSize += static_cast<uint64_t>(statData[TICKETINGCXR_REQ_SIZE]);
   _acStats->TicketingCxr.totalRspSize += static_cast<uint64_t>(statData[TICKETINGCXR_RSP_SIZE]);
 
+  // Task queue wait
+  for (size_t i = 0; i <= TASK_WAIT_LONGER - TASK_WAIT_1MS; ++i)
+    _acStats->taskQueueWait[i] += static_cast<uint64_t>(statData[TASK_WAIT_1MS + i]);
+  _acStats->taskQueueWaitTime += statData[TASK_WAIT_TIME];
+
   // SVC ELAPSED
   _acStats->faresCollectionServiceElapsed += statData[SVC_FARES_COLLECTION_ELAPSED];
   _acStats->faresValidationServiceElapsed += statData[SVC_FARES_VALIDATION_ELAPSED];
@@ -1865,6 +1932,7 @@ TseSrvStats::dumpTrxStats(std::ostream& oss, Trx& trx)
 {
   const MallocContextDisabler context;
   boost::lock_guard<boost::mutex> guard(trx.statDataMutex());
+  mergeTaskQueueWait(trx);
   std::vector<double>& statData = trx.statData();
 
   if (statData.empty())
@@ -1907,6 +1975,17 @@ TseSrvStats::dumpTrxStats(std::ostream& oss, Trx& trx)
   oss << fmter2 % "S8BRAND" % statData[S8BRAND_OK] % statData[S8BRAND_ERROR] %
              statData[S8BRAND_ELAPSED] % "" % statData[S8BRAND_REQ_SIZE] %
              statData[S8BRAND_RSP_SIZE];
+
+  oss << "\n"
+      << "===================== Thread pool queue wait ======================="
+      << "\n"
+      << "   <1ms |  <10ms | <100ms |    <1s | Longer | Total wait"
+      << "\n";
+
+  boost::format fmter3("%1$7d | %2$6d | %3$6d | %4$6d | %5$6d | %6$10.4f\n");
+
+  oss << fmter3 % statData[TASK_WAIT_1MS] % statData[TASK_WAIT_10MS] % statData[TASK_WAIT_100MS] %
+             statData[TASK_WAIT_1S] % statData[TASK_WAIT_LONGER] % statData[TASK_WAIT_TIME];
 }
 
 //----------------------------------------------------------------------------
@@ -1943,28 +2022,23 @@ TseSrvStats::mergeTrxStats(MultiExchangeTrx& multiTrx)
     setupTrxStats(statData);
 
   if (!multiTrx.skipNewPricingTrx())
-    mergeTrxStats(
-        statData, multiTrx.newPricingTrx()->statData(), multiTrx.newPricingTrx()->statDataMutex());
+    mergeTrxStats(statData, *multiTrx.newPricingTrx());
   if (!multiTrx.skipExcPricingTrx1())
-    mergeTrxStats(statData,
-                  multiTrx.excPricingTrx1()->statData(),
-                  multiTrx.excPricingTrx1()->statDataMutex());
+    mergeTrxStats(statData, *multiTrx.excPricingTrx1());
   if (!multiTrx.skipExcPricingTrx2())
-    mergeTrxStats(statData,
-                  multiTrx.excPricingTrx2()->statData(),
-                  multiTrx.excPricingTrx2()->statDataMutex());
+    mergeTrxStats(statData, *multiTrx.excPricingTrx2());
 }
 
 //----------------------------------------------------------------------------
 // mergeTrxStats()
 //----------------------------------------------------------------------------
 void
-TseSrvStats::mergeTrxStats(std::vector<double>& toStatData,
-                           std::vector<double>& fromStatData,
-                           boost::mutex& fromMutex)
+TseSrvStats::mergeTrxStats(std::vector<double>& toStatData, Trx& fromTrx)
 {
   const MallocContextDisabler context;
-  boost::lock_guard<boost::mutex> guard(fromMutex);
+  boost::lock_guard<boost::mutex> guard(fromTrx.statDataMutex());
+  mergeTaskQueueWait(fromTrx);
+  std::vector<double>& fromStatData = fromTrx.statData();
 
   if (!fromStatData.empty())
   {
@@ -120,6 +120,8 @@ public:
 
   static void updateErrorCounts(ErrorResponseException::ErrorResponseCode errorCode);
 
+  static void recordTaskQueueWait(Trx& trx, double waitTime);
+
   static void publishStats(Trx& trx, bool publishASAP = true);
   static void dumpTrxStats(std::ostream& oss, Trx& trx);
 
@@ -178,9 +180,8 @@ private:
 
   static void setupTrxStats(std::vector<double>& statData);
 
-  static void mergeTrxStats(std::vector<double>& toStatData,
-                            std::vector<double>& fromStatData,
-                            boost::mutex& fromMutex);
+  static void mergeTrxStats(std::vector<double>& toStatData, Trx& fromTrx);
+  static void mergeTaskQueueWait(Trx& trx);
 
   static bool
   publishAsapOP01(asap::AsapDomain& domain, const std::vector<double>& statData, Trx& trx);
@@ -67,7 +67,7 @@ XMLConstruct::openElement(const char* tagName, size_t tagSize) // lint !e601
 
   history.push(XMLRecord(data.size(), tagSize));
 
-  data += tagName;
+  data.append(tagName, tagSize);
 
   openTag = true;
 
@@ -175,6 +175,55 @@ XMLConstruct::addAttribute(const char* attributeName,
   return !error;
 }
 
+/**
+ * Add an attribute for an XML tag in fixed point format. The value is written
+ * to a local buffer; the output is the same as with a fixed ostringstream.
+ *
+ * @param attributeName - the name of the attribute to be added.
+ * @param attributeSize - the size of the attribute.
+ * @param value - the value for this attribute.
+ * @param numDecimal - the number of decimals.
+ * @param trimZeros - whether the trailing zeros are removed.
+ * @return bool - whether the insertion is successful or not.
+ */
+
+bool
+XMLConstruct::addDoubleAttribute(const char* attributeName,
+                                 size_t attributeSize,
+                                 double value,
+                                 int numDecimal,
+                                 bool trimZeros)
+{
+  if (value == 0 && (numDecimal == 0 || trimZeros))
+    return addAttribute(attributeName, attributeSize, "0", 1);
+
+  char tmp[64];
+  size_t valueSize = 0;
+  if (LIKELY(numDecimal >= 0))
+    valueSize = tse::number_format::formatFixed(value, numDecimal, tmp, sizeof(tmp));
+
+  if (UNLIKELY(valueSize == 0))
+  {
+    // too long for the buffer
+    std::ostringstream stringStream;
+    stringStream.setf(std::ios::fixed, std::ios::floatfield);
+    stringStream.precision(numDecimal);
+    stringStream << value;
+    std::string formattedDouble = stringStream.str();
+    const std::string::size_type idx = formattedDouble.find_last_not_of('0');
+    if (trimZeros && idx != std::string::npos)
+      formattedDouble.erase(idx + 1);
+    return addAttribute(attributeName, attributeSize, formattedDouble.data(), formattedDouble.size());
+  }
+
+  if (trimZeros)
+  {
+    while (valueSize > 1 && tmp[valueSize - 1] == '0')
+      --valueSize;
+  }
+  return addAttribute(attributeName, attributeSize, tmp, valueSize);
+}
+
 /*
  * Add data to an element.
  *
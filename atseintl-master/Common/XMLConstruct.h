@@ -15,6 +15,7 @@
 #pragma once
 
 #include "Util/BranchPrediction.h"
+#include "Util/NumberFormat.h"
 
 #include <boost/container/string.hpp>
 
@@ -23,6 +24,7 @@
 #include <sstream>
 #include <stack>
 #include <string>
+#include <vector>
 
 #include <cstdint>
 
@@ -116,13 +118,21 @@ public:
   inline bool addAlsoEmptyAttribute(const std::string& attributeName, const std::string& value);
 
 private:
+  template <typename T>
+  inline bool addIntegerAttribute(const char* attributeName, size_t attributeSize, T value);
+  bool addDoubleAttribute(const char* attributeName,
+                          size_t attributeSize,
+                          double value,
+                          int numDecimal,
+                          bool trimZeros);
+
   size_t offset = 0;
 
   size_t size;
 
   std::string data;
 
-  std::stack<XMLRecord> history;
+  std::stack<XMLRecord, std::vector<XMLRecord>> history;
 
   bool error = false;
   bool openTag = false;
@@ -159,7 +169,7 @@ XMLConstruct::openElement(const char* tagName)
 inline bool
 XMLConstruct::openElement(const std::string& tagName)
 {
-  return openElement(tagName.c_str());
+  return openElement(tagName.data(), tagName.size());
 }
 
 /**
@@ -177,19 +187,26 @@ XMLConstruct::addAttribute(const char* attributeName, const char* value)
 inline bool
 XMLConstruct::addAttribute(const std::string& attributeName, const std::string& value)
 {
-  return addAttribute(attributeName.c_str(), value.c_str());
+  // up to the first null character, as with c_str()
+  return addAttribute(attributeName.data(),
+                      attributeName.size(),
+                      value.data(),
+                      strnlen(value.data(), value.size()));
 }
 
 inline bool
 XMLConstruct::addAttribute(const std::string& attributeName, const char* value)
 {
-  return addAttribute(attributeName.c_str(), value);
+  return addAttribute(attributeName.data(), attributeName.size(), value, strlen(value));
 }
 
 inline bool
 XMLConstruct::addAttribute(const std::string& attributeName, const boost::container::string& value)
 {
-  return addAttribute(attributeName.c_str(), value.c_str());
+  return addAttribute(attributeName.data(),
+                      attributeName.size(),
+                      value.data(),
+                      strnlen(value.data(), value.size()));
 }
 
 inline bool
@@ -209,7 +226,12 @@ XMLConstruct::addAttributeNoNull(const char* attributeName, const std::string& v
 inline bool
 XMLConstruct::addAttributeNoNull(const std::string& attributeName, const std::string& value)
 {
-  return addAttributeNoNull(attributeName.c_str(), value.c_str());
+  if (value.empty() || value[0] == 0)
+    return true;
+  return addAttribute(attributeName.data(),
+                      attributeName.size(),
+                      value.data(),
+                      strnlen(value.data(), value.size()));
 }
 
 /**
@@ -221,19 +243,13 @@ XMLConstruct::addAttributeNoNull(const std::string& attributeName, const std::st
 inline bool
 XMLConstruct::addAttributeShort(const char* attributeName, int16_t value)
 {
-  char tmp[6];
-
-  memset(tmp, '\0', sizeof(tmp));
-
-  sprintf(tmp, "%d", value);
-
-  return addAttribute(attributeName, strlen(attributeName), tmp, strlen(tmp));
+  return addIntegerAttribute(attributeName, strlen(attributeName), value);
 }
 
 inline bool
 XMLConstruct::addAttributeShort(const std::string& attributeName, int16_t value)
 {
-  return addAttributeShort(attributeName.c_str(), value);
+  return addIntegerAttribute(attributeName.data(), attributeName.size(), value);
 }
 
 /**
@@ -245,19 +261,13 @@ XMLConstruct::addAttributeShort(const std::string& attributeName, int16_t value)
 inline bool
 XMLConstruct::addAttributeUShort(const char* attributeName, uint16_t value)
 {
-  char tmp[6];
-
-  memset(tmp, '\0', sizeof(tmp));
-
-  sprintf(tmp, "%u", value);
-
-  return addAttribute(attributeName, strlen(attributeName), tmp, strlen(tmp));
+  return addIntegerAttribute(attributeName, strlen(attributeName), value);
 }
 
 inline bool
 XMLConstruct::addAttributeUShort(const std::string& attributeName, uint16_t value)
 {
-  return addAttributeUShort(attributeName.c_str(), value);
+  return addIntegerAttribute(attributeName.data(), attributeName.size(), value);
 }
 
 /**
@@ -269,19 +279,13 @@ XMLConstruct::addAttributeUShort(const std::string& attributeName, uint16_t valu
 inline bool
 XMLConstruct::addAttributeInteger(const char* attributeName, int32_t value)
 {
-  char tmp[20];
-
-  memset(tmp, '\0', sizeof(tmp));
-
-  sprintf(tmp, "%d", value);
-
-  return addAttribute(attributeName, strlen(attributeName), tmp, strlen(tmp));
+  return addIntegerAttribute(attributeName, strlen(attributeName), value);
 }
 
 inline bool
 XMLConstruct::addAttributeInteger(const std::string& attributeName, int32_t value)
 {
-  return addAttributeInteger(attributeName.c_str(), value);
+  return addIntegerAttribute(attributeName.data(), attributeName.size(), value);
 }
 
 /**
@@ -293,19 +297,13 @@ XMLConstruct::addAttributeInteger(const std::string& attributeName, int32_t valu
 inline bool
 XMLConstruct::addAttributeUInteger(const char* attributeName, uint32_t value)
 {
-  char tmp[20];
-
-  memset(tmp, '\0', sizeof(tmp));
-
-  sprintf(tmp, "%u", value);
-
-  return addAttribute(attributeName, strlen(attributeName), tmp, strlen(tmp));
+  return addIntegerAttribute(attributeName, strlen(attributeName), value);
 }
 
 inline bool
 XMLConstruct::addAttributeUInteger(const std::string& attributeName, uint32_t value)
 {
-  return addAttributeUInteger(attributeName.c_str(), value);
+  return addIntegerAttribute(attributeName.data(), attributeName.size(), value);
 }
 
 /**
@@ -317,19 +315,13 @@ XMLConstruct::addAttributeUInteger(const std::string& attributeName, uint32_t va
 inline bool
 XMLConstruct::addAttributeLong(const char* attributeName, int64_t value)
 {
-  char tmp[21];
-
-  memset(tmp, '\0', sizeof(tmp));
-
-  sprintf(tmp, "%ld", value);
-
-  return addAttribute(attributeName, strlen(attributeName), tmp, strlen(tmp));
+  return addIntegerAttribute(attributeName, strlen(attributeName), value);
 }
 
 inline bool
 XMLConstruct::addAttributeLong(const std::string& attributeName, int64_t value)
 {
-  return addAttributeLong(attributeName.c_str(), value);
+  return addIntegerAttribute(attributeName.data(), attributeName.size(), value);
 }
 
 /**
@@ -341,19 +333,13 @@ XMLConstruct::addAttributeLong(const std::string& attributeName, int64_t value)
 inline bool
 XMLConstruct::addAttributeULong(const char* attributeName, uint64_t value)
 {
-  char tmp[21];
-
-  memset(tmp, '\0', sizeof(tmp));
-
-  sprintf(tmp, "%lu", value);
-
-  return addAttribute(attributeName, strlen(attributeName), tmp, strlen(tmp));
+  return addIntegerAttribute(attributeName, strlen(attributeName), value);
 }
 
 inline bool
 XMLConstruct::addAttributeULong(const std::string& attributeName, uint64_t value)
 {
-  return addAttributeULong(attributeName.c_str(), value);
+  return addIntegerAttribute(attributeName.data(), attributeName.size(), value);
 }
 
 /**
@@ -366,31 +352,13 @@ XMLConstruct::addAttributeULong(const std::string& attributeName, uint64_t value
 inline bool
 XMLConstruct::addAttributeDouble(const char* attributeName, double value, int numDecimal)
 {
-  if (value == 0)
-  {
-    if (numDecimal == 0)
-      return (addAttribute(attributeName, strlen(attributeName), "0", 1));
-  }
-
-  std::ostringstream stringStream;
-
-  stringStream.setf(std::ios::fixed, std::ios::floatfield);
-  stringStream.setf(std::ios::right, std::ios::adjustfield);
-
-  stringStream.precision(numDecimal);
-
-  stringStream << value;
-
-  std::string formattedDouble = stringStream.str();
-
-  return (addAttribute(
-      attributeName, strlen(attributeName), formattedDouble.c_str(), formattedDouble.size()));
+  return addDoubleAttribute(attributeName, strlen(attributeName), value, numDecimal, false);
 }
 
 inline bool
 XMLConstruct::addAttributeDouble(const std::string& attributeName, double value, int numDecimal)
 {
-  return addAttributeDouble(attributeName.c_str(), value, numDecimal);
+  return addDoubleAttribute(attributeName.data(), attributeName.size(), value, numDecimal, false);
 }
 
 /**
@@ -402,33 +370,14 @@ XMLConstruct::addAttributeDouble(const std::string& attributeName, double value,
 inline bool
 XMLConstruct::addAttributeDouble(const char* attributeName, double value)
 {
-  if (value == 0)
-  {
-    return (addAttribute(attributeName, strlen(attributeName), "0", 1));
-  }
-
-  std::ostringstream stringStream;
-
-  stringStream.setf(std::ios::fixed, std::ios::floatfield);
-  stringStream.setf(std::ios::right, std::ios::adjustfield);
-
-  stringStream << value;
-
-  std::string formattedDouble = stringStream.str();
-  std::string zeroStr("0");
-  std::string::size_type idx = formattedDouble.find_last_not_of(zeroStr);
-
-  if (idx != std::string::npos)
-    formattedDouble.erase((idx + 1), formattedDouble.size());
-
-  return (addAttribute(
-      attributeName, strlen(attributeName), formattedDouble.c_str(), formattedDouble.size()));
+  // default stream precision, trailing zeros removed
+  return addDoubleAttribute(attributeName, strlen(attributeName), value, 6, true);
 }
 
 inline bool
 XMLConstruct::addAttributeDouble(const std::string& attributeName, double value)
 {
-  return addAttributeDouble(attributeName.c_str(), value);
+  return addDoubleAttribute(attributeName.data(), attributeName.size(), value, 6, true);
 }
 
 /**
@@ -451,7 +400,7 @@ XMLConstruct::addAttributeBoolean(const char* attributeName, bool value)
 inline bool
 XMLConstruct::addAttributeBoolean(const std::string& attributeName, bool value)
 {
-  return addAttributeBoolean(attributeName.c_str(), value);
+  return addAttribute(attributeName.data(), attributeName.size(), value ? "T" : "F", 1);
 }
 
 /**
@@ -463,20 +412,14 @@ XMLConstruct::addAttributeBoolean(const std::string& attributeName, bool value)
 inline bool
 XMLConstruct::addAttributeChar(const char* attributeName, char value)
 {
-  char tmp[2];
-
-  memset(tmp, '\0', sizeof(tmp));
-
-  tmp[0] = value;
-  tmp[1] = '\0';
-
-  return (addAttribute(attributeName, strlen(attributeName), tmp, strlen(tmp)));
+  // a null character gives an empty value, which is not added
+  return addAttribute(attributeName, strlen(attributeName), &value, value ? 1 : 0);
 }
 
 inline bool
 XMLConstruct::addAttributeChar(const std::string& attributeName, char value)
 {
-  return addAttributeChar(attributeName.c_str(), value);
+  return addAttribute(attributeName.data(), attributeName.size(), &value, value ? 1 : 0);
 }
 
 /**
@@ -520,6 +463,22 @@ XMLConstruct::addAlsoEmptyAttribute(const char* attributeName, const char* value
 inline bool
 XMLConstruct::addAlsoEmptyAttribute(const std::string& attributeName, const std::string& value)
 {
-  return addAlsoEmptyAttribute(attributeName.c_str(), value.c_str());
+  uint16_t addEmptyValue = 1;
+  return addAttribute(attributeName.data(),
+                      attributeName.size(),
+                      value.data(),
+                      strnlen(value.data(), value.size()),
+                      addEmptyValue);
 }
 
+/**
+ *  Add an XML attribute for an element in integer format, as "%d" does.
+ */
+template <typename T>
+inline bool
+XMLConstruct::addIntegerAttribute(const char* attributeName, size_t attributeSize, T value)
+{
+  char tmp[tse::number_format::IntegerBufferSize];
+  const size_t size = tse::number_format::formatInteger(value, tmp);
+  return addAttribute(attributeName, attributeSize, tmp, size);
+}
@@ -0,0 +1,112 @@
+//-------------------------------------------------------------------------------
+// Copyright 2016, Sabre Inc.  All rights reserved.
+// This software/documentation is the confidential and proprietary product of
+// Sabre Inc.   Any unauthorized use, reproduction, or transfer of this
+// software/documentation,  in any medium, or incorporation of this
+// software/documentation into any system or publication, is strictly prohibited.
+//-------------------------------------------------------------------------------
+
+#include "DBAccess/ArrayFetchSizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace tse
+{
+namespace
+{
+// a smaller result is forgotten slowly, a larger one at once, so that a
+// query returning a varying number of rows rarely needs a second fetch
+constexpr double DECAY = 0.125;
+
+uint32_t
+roundUpToPowerOfTwo(uint64_t rows)
+{
+  uint32_t size(1);
+  while (size < rows && size < ArrayFetchSizer::MAX_ARRAY_FETCH_SIZE)
+  {
+    size <<= 1;
+  }
+  return size;
+}
+}
+
+constexpr uint32_t ArrayFetchSizer::MAX_ARRAY_FETCH_SIZE;
+
+ArrayFetchSizer&
+ArrayFetchSizer::instance()
+{
+  static ArrayFetchSizer sizer;
+  return sizer;
+}
+
+uint16_t
+ArrayFetchSizer::arrayFetchSize(const std::string& queryName,
+                                uint16_t configured,
+                                uint32_t rowWidth)
+{
+  uint32_t size(configured);
+  if (!enabled())
+  {
+    return std::max<uint32_t>(size, 1);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::unordered_map<std::string, double>::const_iterator it(_expectedRows.find(queryName));
+    if (it != _expectedRows.end())
+    {
+      // one row more than expected ends the result in the first fetch
+      size = roundUpToPowerOfTwo(uint64_t(std::ceil(it->second)) + 1);
+    }
+  }
+
+  const uint32_t fitting(_memoryLimit / std::max<uint32_t>(rowWidth, 1));
+  size = std::min(size, std::min(fitting, MAX_ARRAY_FETCH_SIZE));
+  return uint16_t(std::max<uint32_t>(size, 1));
+}
+
+bool
+ArrayFetchSizer::fits(const std::string& queryName,
+                      uint16_t configured,
+                      uint32_t rowWidth,
+                      uint16_t arrayFetchSize)
+{
+  if (!enabled())
+  {
+    return true;
+  }
+  // some slack, so that buffers are not recreated as the row count wobbles
+  const uint32_t advised(this->arrayFetchSize(queryName, configured, rowWidth));
+  return uint32_t(arrayFetchSize) * 2 >= advised && arrayFetchSize <= advised * 4;
+}
+
+void
+ArrayFetchSizer::record(const std::string& queryName, uint64_t rows)
+{
+  if (!enabled())
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::pair<std::unordered_map<std::string, double>::iterator, bool> inserted(
+      _expectedRows.insert(std::make_pair(queryName, double(rows))));
+  double& expected(inserted.first->second);
+  if (rows >= expected)
+  {
+    expected = double(rows);
+  }
+  else
+  {
+    expected -= (expected - double(rows)) * DECAY;
+  }
+}
+
+uint64_t
+ArrayFetchSizer::expectedRows(const std::string& queryName)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::unordered_map<std::string, double>::const_iterator it(_expectedRows.find(queryName));
+  return it == _expectedRows.end() ? 0 : uint64_t(std::ceil(it->second));
+}
+} // tse
@@ -0,0 +1,63 @@
+//-------------------------------------------------------------------------------
+// Copyright 2016, Sabre Inc.  All rights reserved.
+// This software/documentation is the confidential and proprietary product of
+// Sabre Inc.   Any unauthorized use, reproduction, or transfer of this
+// software/documentation,  in any medium, or incorporation of this
+// software/documentation into any system or publication, is strictly prohibited.
+//-------------------------------------------------------------------------------
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace tse
+{
+// Learns how many rows each query returns and sizes its define buffers to it.
+//
+// The array fetch size configured in SQLQUERY_OPTIONS is one size for every
+// execution of a query. Most DAO queries return a handful of rows and do not
+// need the 50 row buffers, while a few return thousands and make that many
+// round trips. Once a query has run, its define buffers are sized to hold the
+// rows it usually returns plus one, so the bundled execute and fetch usually
+// gets the whole result, but never more rows than fit in the memory limit.
+//
+// Enabled with ARRAY_FETCH_MEMORY (bytes per define buffer collection) in
+// SQLQUERY_OPTIONS_DEFAULTS.
+class ArrayFetchSizer : boost::noncopyable
+{
+public:
+  static constexpr uint32_t MAX_ARRAY_FETCH_SIZE = 65535;
+
+  static ArrayFetchSizer& instance();
+
+  // 0 disables the learning, queries fetch their configured array size
+  void setMemoryLimit(uint32_t bytes) { _memoryLimit = bytes; }
+  uint32_t memoryLimit() const { return _memoryLimit; }
+  bool enabled() const { return _memoryLimit != 0; }
+
+  // rows to fetch at a time for a query whose rows take rowWidth bytes
+  uint16_t arrayFetchSize(const std::string& queryName, uint16_t configured, uint32_t rowWidth);
+
+  // false if buffers of arrayFetchSize rows are too far off to be pooled
+  bool fits(const std::string& queryName,
+            uint16_t configured,
+            uint32_t rowWidth,
+            uint16_t arrayFetchSize);
+
+  // one execution of the query returned rows rows
+  void record(const std::string& queryName, uint64_t rows);
+
+  // rows the query is expected to return, 0 if it has not run yet
+  uint64_t expectedRows(const std::string& queryName);
+
+private:
+  uint32_t _memoryLimit = 0;
+  std::mutex _mutex;
+  std::unordered_map<std::string, double> _expectedRows;
+};
+} // tse
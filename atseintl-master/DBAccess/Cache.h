@@ -11,6 +11,7 @@
 #include "DBAccess/LDCActionQueue.h"
 #include "DBAccess/raw_ptr.h"
 #include "DBAccess/RemoteCache/RemoteCacheHeader.h"
+#include "DBAccess/SingleFlight.h"
 
 #include <vector>
 
@@ -31,7 +32,15 @@ struct CompressedCacheStats
       _numberEmpty(0),
       _memoryEstimate(0),
       _averageRatio(0),
-      _threshold(0)
+      _threshold(0),
+      _hits(0),
+      _misses(0),
+      _inflations(0),
+      _deflations(0),
+      _admissionRejects(0),
+      _coalescedLoads(0),
+      _coalescedWaits(0),
+      _coalescedTimeouts(0)
   {
   }
   size_t _totalSize;
@@ -44,9 +53,28 @@ struct CompressedCacheStats
   size_t _memoryEstimate;
   double _averageRatio;
   size_t _threshold;
+  size_t _hits;
+  size_t _misses;
+  size_t _inflations;
+  size_t _deflations;
+  size_t _admissionRejects;
+  size_t _coalescedLoads;
+  size_t _coalescedWaits;
+  size_t _coalescedTimeouts;
   std::string _errors;
 };
 
+template <class Key>
+struct CacheKeyHash
+{
+  size_t operator()(const Key& key) const
+  {
+    size_t hash(0);
+    tse::hashCombine(hash, key);
+    return hash;
+  }
+};
+
 template <class Key, class Type, class FactoryType>
 class Cache
 {
@@ -68,6 +96,7 @@ public:
   typedef std::shared_ptr<Type> pointer_type;
 #endif // _USERAWPOINTERS
   typedef typename std::shared_ptr<std::vector<Key>> key_vector_type;
+  typedef SingleFlight<Key, pointer_type, CacheKeyHash<Key>> single_flight_type;
 
   Cache(FactoryType& factory, const std::string& type, const std::string& name, size_t version)
     : _factory(factory),
@@ -94,6 +123,26 @@ public:
 
   virtual pointer_type getIfResident(const Key& key) = 0;
 
+  // get() with concurrent misses of a key loading it only once
+  pointer_type getCoalesced(const Key& key)
+  {
+    if (!_singleFlight.enabled())
+    {
+      return get(key);
+    }
+    pointer_type ptr(getIfResident(key));
+    if (ptr)
+    {
+      return ptr;
+    }
+    MallocContextDisabler context;
+    return _singleFlight.run(key,
+                             [this, &key]() { return get(key); },
+                             [this, &key]() { return loadAlone(key); });
+  }
+
+  single_flight_type& singleFlight() { return _singleFlight; }
+
   virtual CompressedDataPtr getCompressed(const Key& key,
                                           tse::RemoteCache::RCStatus& status,
                                           bool& fromQuery)
@@ -265,6 +314,24 @@ private:
 
   const size_t _version;
   tse::DiskCache::CacheTypeOptions* _cto;
+  single_flight_type _singleFlight;
+
+  // Loads the key without waiting for the placeholder of the load in
+  // flight; the loaded object replaces the placeholder and wakes its waiters.
+  pointer_type loadAlone(const Key& key)
+  {
+    Type* created(_factory.create(key, 0)._ptr);
+    if (created)
+    {
+      put(key, created, false);
+      pointer_type ptr(getIfResident(key));
+      if (ptr)
+      {
+        return ptr;
+      }
+    }
+    return get(key);
+  }
 
   Cache();
   Cache(const Cache& rhs);
@@ -89,6 +89,10 @@ public:
 
   virtual void init(bool preLoad = true) {}
 
+  // Called by the cache initializer; loads the cache also when a transaction
+  // already created it empty while it was warming in the background.
+  virtual void warm() { init(true); }
+
   virtual void store(const ObjectKey& key) = 0;
 
   virtual bool nodupInvalidate(const ObjectKey& key)
@@ -19,6 +19,7 @@
 #include "DBAccess/LRUCache.h"
 #include "DBAccess/MirrorCache.h"
 #include "DBAccess/PerfectHash.h"
+#include "DBAccess/ShardedLRUCache.h"
 #include "DBAccess/SimpleCache.h"
 
 #include <string>
@@ -33,6 +34,8 @@ static const char* CACHE_TYPE_DUAL = "DualMapCache";
 static const char* CACHE_TYPE_MIRROR = "MirrorCache";
 static const char* CACHE_TYPE_PERFECT = "PerfectCache";
 static const char* CACHE_TYPE_COMPRESSED = "CompressedCache";
+static const char* CACHE_TYPE_SHARDED_LRU = "ShardedLRUCache";
+static const char* CACHE_TYPE_FROZEN = "FrozenCache";
 
 static const char* CACHE_NAME_UNDEFINED = "UNDEFINED";
 
@@ -108,6 +111,23 @@ public:
     {
       retval = new sfc::CompressedCache<Key, T>(factory, cacheName, capacity, version);
     }
+    else if (cacheType == CACHE_TYPE_FROZEN)
+    {
+      retval = new FrozenCache<Key, T>(factory, cacheName, capacity, version);
+    }
+    else if (cacheType == CACHE_TYPE_SHARDED_LRU)
+    {
+      // optional argument is the number of shards, e.g. ShardedLRUCache:128
+      if (cacheArgs.empty())
+      {
+        retval = new sfc::ShardedLRUCache<Key, T>(factory, cacheName, version, capacity);
+      }
+      else
+      {
+        retval = new sfc::ShardedLRUCache<Key, T>(
+            factory, cacheName, version, capacity, atoi(cacheArgs.c_str()));
+      }
+    }
     else
     {
       // If cache type missing or invalid, default to one of the following:
@@ -12,13 +12,53 @@
 #include "Common/Thread/TseScopedExecutor.h"
 #include "DBAccess/DiskCache.h"
 
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <ostream>
+
 namespace tse
 {
+namespace
+{
+std::string
+upperCase(const std::string& name)
+{
+  std::string uc(name);
+  std::transform(uc.begin(), uc.end(), uc.begin(), (int (*)(int))toupper);
+  return uc;
+}
+
+int64_t
+millisSince(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                               start).count();
+}
+}
+
+void
+CacheInitializer::CacheInitializationTask::run()
+{
+  _initializer.started(*this);
+  try
+  {
+    _ctl->warm();
+  }
+  catch (...)
+  {
+    _initializer.finished(*this, false);
+    throw;
+  }
+  _initializer.finished(*this, true);
+}
+
 CacheInitializer::CacheInitializer(TseScopedExecutor* scopedExecutor,
                                    std::map<std::string, CacheManager::CacheParm>& cacheParms)
   : _scopedExecutor(scopedExecutor),
     _cacheParms(cacheParms),
-    _logger("atseintl.DBAccess.CacheInitializer")
+    _logger("atseintl.DBAccess.CacheInitializer"),
+    _started(std::chrono::steady_clock::now())
 {
 }
 
@@ -41,6 +81,9 @@ operator()(std::pair<const std::string, CacheControl*>& p)
   DiskCache::CacheTypeOptions* cto = DISKCACHE.getCacheTypeOptions(cacheName);
   bool ldcEnabled = ((cto != nullptr) && (cto->enabled));
 
+  _tasks.emplace_back(*this, cacheName, &ctl, parm.background);
+  _byName[upperCase(cacheName)] = &_tasks.back();
+
   if (parm.loadOnStart || ldcEnabled)
   {
     if (parm.loadOnStart)
@@ -51,16 +94,226 @@ operator()(std::pair<const std::string, CacheControl*>& p)
     {
       LOG4CXX_TRACE(_logger, "Initializing " << cacheName << " cache (for LDC only)");
     }
-    _tasks.push_back(CacheInitializationTask(&ctl));
-    if (_scopedExecutor)
-    {
-      _scopedExecutor->execute(_tasks.back());
-    }
   }
   else
   {
     LOG4CXX_TRACE(_logger, "Load disabled for " << cacheName << " cache");
+    _tasks.back()._state = NOT_LOADED;
     ctl.init(false);
   }
 }
+
+void
+CacheInitializer::wait()
+{
+  std::vector<CacheInitializationTask*> startNow;
+  {
+    boost::lock_guard<boost::mutex> g(_mutex);
+    for (CacheInitializationTask& task : _tasks)
+    {
+      if (task._state != PENDING)
+      {
+        continue;
+      }
+      for (const std::string& dependency : _cacheParms[task._name].loadAfter)
+      {
+        std::map<std::string, CacheInitializationTask*>::const_iterator it(
+            _byName.find(upperCase(dependency)));
+        if (it == _byName.end())
+        {
+          LOG4CXX_WARN(_logger,
+                       "Cache " << task._name << " set to load after unknown cache "
+                                << dependency);
+        }
+        else if ((it->second->_state == PENDING) && (it->second != &task))
+        {
+          it->second->_dependents.push_back(&task);
+          ++task._unmet;
+        }
+      }
+      if (!task._background)
+      {
+        ++_foreground;
+      }
+      ++_loading;
+    }
+
+    // caches that would wait for each other load without waiting
+    std::map<CacheInitializationTask*, size_t> unmet;
+    std::vector<CacheInitializationTask*> startable;
+    for (CacheInitializationTask& task : _tasks)
+    {
+      unmet[&task] = task._unmet;
+      if ((task._state == PENDING) && (task._unmet == 0))
+      {
+        startable.push_back(&task);
+        startNow.push_back(&task);
+      }
+    }
+    while (!startable.empty())
+    {
+      CacheInitializationTask* task(startable.back());
+      startable.pop_back();
+      for (CacheInitializationTask* dependent : task->_dependents)
+      {
+        if (--unmet[dependent] == 0)
+        {
+          startable.push_back(dependent);
+        }
+      }
+    }
+    for (CacheInitializationTask& task : _tasks)
+    {
+      if ((task._state == PENDING) && (unmet[&task] != 0))
+      {
+        LOG4CXX_ERROR(_logger,
+                      "Cache " << task._name << " waits on a load order cycle, loading anyway");
+        task._unmet = 0;
+        startNow.push_back(&task);
+      }
+    }
+  }
+
+  for (CacheInitializationTask* task : startNow)
+  {
+    execute(*task);
+  }
+
+  bool background(false);
+  {
+    boost::unique_lock<boost::mutex> lock(_mutex);
+    while (_foreground != 0)
+    {
+      _condition.wait(lock);
+    }
+    // the last background cache to finish releases the LDC environment
+    background = (_loading != 0);
+    _waited = true;
+  }
+  LOG4CXX_INFO(_logger,
+               "Caches loaded in " << millisSince(_started) << "ms"
+                                   << (background ? ", background caches still loading" : ""));
+  if (!background)
+  {
+    DISKCACHE.doneWithEnvironment();
+  }
+}
+
+void
+CacheInitializer::execute(CacheInitializationTask& task)
+{
+  if (_scopedExecutor)
+  {
+    _scopedExecutor->execute(task);
+  }
+  else
+  {
+    task.run();
+  }
+}
+
+void
+CacheInitializer::started(CacheInitializationTask& task)
+{
+  boost::lock_guard<boost::mutex> g(_mutex);
+  task._state = LOADING;
+  task._started = std::chrono::steady_clock::now();
+}
+
+void
+CacheInitializer::finished(CacheInitializationTask& task, bool successful)
+{
+  const uint64_t objects(task._ctl->cacheSize());
+  std::vector<CacheInitializationTask*> startNow;
+  bool lastBackground(false);
+  {
+    boost::lock_guard<boost::mutex> g(_mutex);
+    task._state = successful ? READY : FAILED;
+    task._elapsedMillis = millisSince(task._started);
+    task._objects = objects;
+    lastBackground = (--_loading == 0) && _waited;
+    if (!task._background)
+    {
+      --_foreground;
+      _condition.notify_all();
+    }
+    for (CacheInitializationTask* dependent : task._dependents)
+    {
+      if ((dependent->_unmet != 0) && (--dependent->_unmet == 0))
+      {
+        startNow.push_back(dependent);
+      }
+    }
+  }
+
+  LOG4CXX_INFO(_logger,
+               "Cache " << task._name << (successful ? " loaded" : " failed to load") << " in "
+                        << task._elapsedMillis << "ms, " << objects << " objects");
+
+  for (CacheInitializationTask* dependent : startNow)
+  {
+    execute(*dependent);
+  }
+
+  if (lastBackground)
+  {
+    LOG4CXX_INFO(_logger, "Background caches loaded in " << millisSince(_started) << "ms");
+    DISKCACHE.doneWithEnvironment();
+  }
+}
+
+bool
+CacheInitializer::ready(const std::string& cacheName) const
+{
+  boost::lock_guard<boost::mutex> g(_mutex);
+  std::map<std::string, CacheInitializationTask*>::const_iterator it(
+      _byName.find(upperCase(cacheName)));
+  return (it == _byName.end()) ||
+         ((it->second->_state != PENDING) && (it->second->_state != LOADING));
+}
+
+bool
+CacheInitializer::warming(const std::string& cacheName) const
+{
+  boost::lock_guard<boost::mutex> g(_mutex);
+  std::map<std::string, CacheInitializationTask*>::const_iterator it(
+      _byName.find(upperCase(cacheName)));
+  return (it != _byName.end()) && it->second->_background &&
+         ((it->second->_state == PENDING) || (it->second->_state == LOADING));
+}
+
+bool
+CacheInitializer::allReady() const
+{
+  boost::lock_guard<boost::mutex> g(_mutex);
+  for (const CacheInitializationTask& task : _tasks)
+  {
+    if ((task._state == PENDING) || (task._state == LOADING))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+CacheInitializer::print(std::ostream& os) const
+{
+  boost::lock_guard<boost::mutex> g(_mutex);
+  for (const CacheInitializationTask& task : _tasks)
+  {
+    const int64_t elapsed(task._state == LOADING ? millisSince(task._started)
+                                                 : task._elapsedMillis);
+    os << std::setw(40) << std::left << task._name << std::setw(11) << stateToString(task._state)
+       << std::setw(12) << std::right << task._objects << std::setw(10) << elapsed << "ms"
+       << (task._background ? " background" : "") << std::endl;
+  }
+}
+
+const char*
+CacheInitializer::stateToString(State state)
+{
+  static const char* const names[] = {"PENDING", "LOADING", "READY", "FAILED", "NOT_LOADED"};
+  return names[state];
+}
 }
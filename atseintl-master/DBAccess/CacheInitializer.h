@@ -13,25 +13,68 @@
 #include "DBAccess/CacheManager.h"
 #include "DBAccess/DataAccessObject.h"
 
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <chrono>
+#include <iosfwd>
 #include <list>
+#include <map>
+#include <string>
+#include <vector>
 
 namespace tse
 {
 
 class TseScopedExecutor;
 
+// Loads the caches at server start on the executor's threads.
+//
+// A cache starts loading once the caches it is configured to load after
+// (CacheParm::loadAfter) are done, so independent caches load side by side
+// while dependent ones wait only for what they need. wait() returns when
+// all caches but the ones warmed in the background (CacheParm::background)
+// are loaded; those go on loading while the server takes traffic. A
+// transaction asking for a cache still warming gets it created empty, and
+// its misses are read from the database until the load is done.
 class CacheInitializer
 {
 public:
+  enum State
+  {
+    PENDING = 0,
+    LOADING,
+    READY,
+    FAILED,
+    NOT_LOADED
+  };
+
   class CacheInitializationTask : public TseCallableTask
   {
   public:
-    CacheInitializationTask(CacheControl* ctl) : _ctl(ctl) {}
+    CacheInitializationTask(CacheInitializer& initializer,
+                            const std::string& name,
+                            CacheControl* ctl,
+                            bool background)
+      : _initializer(initializer), _name(name), _ctl(ctl), _background(background)
+    {
+    }
 
-    void run() override { _ctl->init(true); }
+    void run() override;
 
   private:
+    friend class CacheInitializer;
+
+    CacheInitializer& _initializer;
+    const std::string _name;
     CacheControl* _ctl;
+    const bool _background;
+    State _state = PENDING;
+    size_t _unmet = 0;
+    std::vector<CacheInitializationTask*> _dependents;
+    std::chrono::steady_clock::time_point _started;
+    int64_t _elapsedMillis = 0;
+    uint64_t _objects = 0;
   };
 
   CacheInitializer(TseScopedExecutor* scopedExecutor,
@@ -40,11 +83,39 @@ public:
 
   void operator()(std::pair<const std::string, CacheControl*>& p);
 
+  // Starts the caches not waiting for others, returns when the caches not
+  // warmed in the background are done.
+  void wait();
+
+  bool ready(const std::string& cacheName) const;
+  bool allReady() const;
+  // background cache not loaded yet
+  bool warming(const std::string& cacheName) const;
+
+  // one line per cache: name, state, objects, elapsed time
+  void print(std::ostream& os) const;
+
+  static const char* stateToString(State state);
+
 private:
+  CacheInitializer(const CacheInitializer&) = delete;
+  CacheInitializer& operator=(const CacheInitializer&) = delete;
+
+  void execute(CacheInitializationTask& task);
+  void started(CacheInitializationTask& task);
+  void finished(CacheInitializationTask& task, bool successful);
+
   TseScopedExecutor* _scopedExecutor;
   std::map<std::string, CacheManager::CacheParm>& _cacheParms;
   Logger _logger;
   std::list<CacheInitializationTask> _tasks;
+  std::map<std::string, CacheInitializationTask*> _byName;
+  mutable boost::mutex _mutex;
+  boost::condition_variable _condition;
+  size_t _foreground = 0;
+  size_t _loading = 0;
+  bool _waited = false;
+  std::chrono::steady_clock::time_point _started;
 };
 
 } // namespace tse
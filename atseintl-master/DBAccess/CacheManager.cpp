@@ -33,6 +33,9 @@
 #include "DBAccess/DBServerPool.h"
 #include "DBAccess/RemoteCache/ReadConfig.h"
 
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+
 #include <algorithm>
 #include <cctype>
 #include <functional>
@@ -126,6 +129,10 @@ CacheManager::CacheManager(tse::ConfigMan& config) : _config(config)
         parm.cacheBy = DAOUtils::HALFMONTHLY;
         parm.partialConsolidationLimit = std::numeric_limits<size_t>::max();
         parm.fullConsolidationLimit = std::numeric_limits<size_t>::max();
+        parm.loadAfter.clear();
+        parm.background = false;
+        parm.batchWindow = 0;
+        parm.batchSize = 100;
         break;
       case 1:
         if (i->value != "0")
@@ -179,6 +186,25 @@ CacheManager::CacheManager(tse::ConfigMan& config) : _config(config)
         if (!i->value.empty())
           parm.fullConsolidationLimit = atoi(i->value.c_str());
         break;
+      case 10:
+        // caches to be loaded before this one, separated by '/'
+        parm.loadAfter.clear();
+        boost::split(parm.loadAfter, i->value, boost::is_any_of("/ "), boost::token_compress_on);
+        parm.loadAfter.erase(std::remove(parm.loadAfter.begin(), parm.loadAfter.end(), ""),
+                             parm.loadAfter.end());
+        break;
+      case 11:
+        // loaded while the server already takes traffic
+        parm.background = (i->value == "1");
+        break;
+      case 12:
+        // microseconds a cache miss waits for others to be loaded with it
+        parm.batchWindow = atoi(i->value.c_str());
+        break;
+      case 13:
+        if (!i->value.empty())
+          parm.batchSize = atoi(i->value.c_str());
+        break;
       }
     }
   }
@@ -211,16 +237,34 @@ CacheManager::CacheManager(tse::ConfigMan& config) : _config(config)
     dbHistoryServerPool.setIdleCloseTimeout(idleTimeout);
   }
 
-  static constexpr int NUM_THREADS = 5;
-  TseScopedExecutor taskPool(TseThreadingConst::CACHE_INITIALIZATION_TASK, NUM_THREADS);
-  CacheInitializer initCache(&taskPool, cacheParms);
-  registry.forEach(initCache);
-  DISKCACHE.doneWithEnvironment();
+  int singleFlightTimeout(0);
+  if (config.getValue("singleflighttimeout", singleFlightTimeout) && singleFlightTimeout >= 0)
+  {
+    _singleFlightTimeout = singleFlightTimeout;
+  }
+
+  int numThreads(0);
+  if (!config.getValue("cacheinitthreads", numThreads) || numThreads < 1)
+  {
+    numThreads = 5;
+  }
+  _initializationPool.reset(
+      new TseScopedExecutor(TseThreadingConst::CACHE_INITIALIZATION_TASK, numThreads));
+  _cacheInitializer.reset(new CacheInitializer(_initializationPool.get(), cacheParms));
+  CacheInitializer& initCache(*_cacheInitializer);
+  auto addCache = [&initCache](std::pair<const std::string, CacheControl*>& p)
+  { initCache(p); };
+  registry.forEach(addCache);
+  initCache.wait();
   dump();
   _initialized = true;
 }
 
-CacheManager::~CacheManager() { dump(); }
+CacheManager::~CacheManager()
+{
+  _cacheInitializer.reset();
+  dump();
+}
 
 CacheManager&
 CacheManager::instance()
@@ -230,6 +274,12 @@ CacheManager::instance()
   return *CacheManager::_instance;
 }
 
+bool
+CacheManager::cacheWarming(const std::string& id) const
+{
+  return _cacheInitializer && _cacheInitializer->warming(id);
+}
+
 int
 CacheManager::cacheSize(const std::string& id) const
 {
@@ -304,6 +354,30 @@ CacheManager::cachePartialConsolidationLimit(const std::string& id) const
     return std::numeric_limits<size_t>::max();
 }
 
+uint32_t
+CacheManager::cacheBatchWindow(const std::string& id) const
+{
+  std::string key(id);
+  std::transform(key.begin(), key.end(), key.begin(), toupper);
+  std::map<std::string, CacheParm>::const_iterator i = cacheParms.find(key);
+  if (i != cacheParms.end())
+    return i->second.batchWindow;
+  else
+    return 0;
+}
+
+size_t
+CacheManager::cacheBatchSize(const std::string& id) const
+{
+  std::string key(id);
+  std::transform(key.begin(), key.end(), key.begin(), toupper);
+  std::map<std::string, CacheParm>::const_iterator i = cacheParms.find(key);
+  if (i != cacheParms.end())
+    return i->second.batchSize;
+  else
+    return 0;
+}
+
 size_t
 CacheManager::getTotalCapacity(const std::string& id) const
 {
@@ -11,13 +11,17 @@
 #include <algorithm>
 #include <cctype>
 #include <limits>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace tse
 {
 class CacheControl;
+class CacheInitializer;
 class ConfigMan;
 class Logger;
+class TseScopedExecutor;
 
 class CacheManager
 {
@@ -31,6 +35,8 @@ public:
   const std::string& cacheType(const std::string& key) const;
   size_t cacheFullConsolidationLimit(const std::string& key) const;
   size_t cachePartialConsolidationLimit(const std::string& key) const;
+  uint32_t cacheBatchWindow(const std::string& key) const;
+  size_t cacheBatchSize(const std::string& key) const;
   void dump(int level = log4cxx::Level::INFO_INT) const;
   void dump(std::ostream& s) const;
   DAOUtils::CacheBy cacheBy(const std::string& key) const;
@@ -60,7 +66,10 @@ public:
         threshold(0),
         cacheBy(DAOUtils::HALFMONTHLY),
         partialConsolidationLimit(std::numeric_limits<size_t>::max()),
-        fullConsolidationLimit(std::numeric_limits<size_t>::max())
+        fullConsolidationLimit(std::numeric_limits<size_t>::max()),
+        background(false),
+        batchWindow(0),
+        batchSize(100)
     {
     }
 
@@ -74,6 +83,10 @@ public:
     DAOUtils::CacheBy cacheBy;
     size_t partialConsolidationLimit;
     size_t fullConsolidationLimit;
+    std::vector<std::string> loadAfter;
+    bool background;
+    uint32_t batchWindow;
+    size_t batchSize;
 
     inline int print(const std::string& name, std::ostream& os) const
     {
@@ -98,12 +111,34 @@ public:
       ++l;
       os << name << ".fullConsolidationLimit=" << fullConsolidationLimit << std::endl;
       ++l;
+      os << name << ".loadAfter=";
+      for (size_t i = 0; i < loadAfter.size(); ++i)
+      {
+        os << (i == 0 ? "" : "/") << loadAfter[i];
+      }
+      os << std::endl;
+      ++l;
+      os << name << ".background=" << background << std::endl;
+      ++l;
+      os << name << ".batchWindow=" << batchWindow << std::endl;
+      ++l;
+      os << name << ".batchSize=" << batchSize << std::endl;
+      ++l;
       return l;
     }
   };
 
   static bool initialized();
 
+  // load progress of the caches, also of those still warming in the background
+  const CacheInitializer& cacheInitializer() const { return *_cacheInitializer; }
+
+  // true while a background cache is still being loaded
+  bool cacheWarming(const std::string& id) const;
+
+  // how long a cache miss waits for another thread loading the same key, 0 if it does not
+  uint32_t singleFlightTimeout() const { return _singleFlightTimeout; }
+
   static bool useGenericCache()
   {
     return _useGenericCache;
@@ -115,6 +150,10 @@ protected:
 
   static std::map<std::string, CacheParm> cacheParms;
 
+  uint32_t _singleFlightTimeout = 2000;
+  std::unique_ptr<TseScopedExecutor> _initializationPool;
+  std::unique_ptr<CacheInitializer> _cacheInitializer;
+
   CacheManager(ConfigMan& config);
   virtual ~CacheManager();
 
@@ -2,6 +2,7 @@
 
 #include "DBAccess/Cache.h"
 #include "DBAccess/CompressedData.h"
+#include "DBAccess/FrequencySketch.h"
 #include "DBAccess/PointerDeleter.h"
 
 #include <condition_variable>
@@ -11,6 +12,17 @@
 
 //./appconsole.pl atsedbld05b 5432 CCSTATS FARE
 
+// Entries are kept compressed and the most valuable ones also inflated, up
+// to _capacity inflated entries (the "uncompressed" LRU key list). A
+// compressed entry which is inflated on access only stays inflated if its
+// estimated access frequency (FrequencySketch) beats the one of the LRU
+// entry it would push out, so hot markets stay inflated and one-off
+// lookups of cold ones don't churn the inflated tier.
+//
+// Inflation runs outside _mutex: concurrent lookups of the same entry share
+// one Inflation and wait on its once-flag only, lookups of other entries
+// are not blocked.
+
 namespace sfc
 {
 template <typename Key, typename Type>
@@ -60,6 +72,17 @@ protected:
 
   typedef std::list<Key> Keys;
 
+  // one inflation of a compressed entry; the thread which runs it decides
+  // under _mutex whether the result stays in the cache
+  struct Inflation
+  {
+    explicit Inflation(const CompressedDataPtr& compressed) : _compressed(compressed) {}
+
+    std::once_flag _once;
+    CompressedDataPtr _compressed;
+    _pointer_type _restored;
+  };
+
   struct CacheEntry
   {
     CacheEntry(Keys& uckeys,
@@ -73,6 +96,7 @@ protected:
     typename Keys::iterator _compressedKeyIterator;
     _pointer_type _inflated;
     CompressedData* _compressed;
+    std::shared_ptr<Inflation> _inflation;
   };
 
   typedef std::unordered_map<Key, CacheEntry, hash_func> Map;
@@ -85,6 +109,12 @@ protected:
   std::mutex _mutex;
   std::condition_variable _condition;
   PointerDeleter<CompressedData> _compressedDeleter;
+  FrequencySketch _sketch;
+  size_t _hits;
+  size_t _misses;
+  size_t _inflations;
+  size_t _deflations;
+  size_t _admissionRejects;
 
   void deleteCompressed(CompressedData* compressed)
   {
@@ -119,6 +149,7 @@ protected:
       {
         this->moveToAccumulator(mit->second._inflated.get());
         mit->second._inflated = _pointer_type();
+        ++_deflations;
         if (this->_totalCapacity > 0)
         {
           _compressedKeys.push_back(*kit);
@@ -143,6 +174,29 @@ protected:
     uit->second._uncompressedKeyIterator = --_uncompressedKeys.end();
   }
 
+  // Whether an inflated entry may enter the uncompressed list: always while
+  // there is room, otherwise only if it is accessed more often than the
+  // entry it would deflate.
+  bool admit(const typename Map::iterator& uit)
+  {
+    if (_keysSize < _capacity)
+    {
+      return true;
+    }
+    for (const Key& key : _uncompressedKeys)
+    {
+      typename Map::const_iterator mit(_map.find(key));
+      if (mit != _map.end()
+          && mit->second._compressed
+          && mit->second._inflated
+          && mit->second._inflated != _uninitializedCacheEntry)
+      {
+        return _sketch.frequency(hash_func()(uit->first)) > _sketch.frequency(hash_func()(key));
+      }
+    }
+    return true;
+  }
+
   void controlMapSize(RemovedKey& removedKey)
   {
     if (!_compressedKeys.empty()
@@ -180,109 +234,70 @@ protected:
     const MallocContextDisabler disableCustomAllocator;
     try
     {
-      CompressedData compressed;
+      std::shared_ptr<Inflation> inflation;
       {
-        RemovedKey removedKey(*this);
         std::unique_lock<std::mutex> lock(_mutex);
+        if (create)
+        {
+          _sketch.increment(hash_func()(key));
+        }
         typename Map::iterator mit(_map.find(key));
         bool inMap(mit != _map.end());
+        // another thread put _uninitializedCacheEntry
+        while (inMap && _uninitializedCacheEntry == mit->second._inflated)
+        {
+          _condition.wait(lock);
+          inMap = (mit = _map.find(key)) != _map.end();
+        }
         if (inMap)
         {
           if (mit->second._inflated)
           {
-            if (mit->second._inflated != _uninitializedCacheEntry)
+            if (mit->second._uncompressedKeyIterator != _uncompressedKeys.end())
             {
-              if (mit->second._uncompressedKeyIterator != _uncompressedKeys.end())
-              {
-                _uncompressedKeys.splice(_uncompressedKeys.end(),
-                                         _uncompressedKeys,
-                                         mit->second._uncompressedKeyIterator);
-                mit->second._uncompressedKeyIterator = --_uncompressedKeys.end();
-              }
-              return mit->second._inflated;
-            }
-            else// another thread put _uninitializedCacheEntry
-            {
-              do
-              {
-                _condition.wait(lock);
-                inMap = (mit = _map.find(key)) != _map.end();
-                if (inMap
-                    && mit->second._inflated
-                    && mit->second._inflated != _uninitializedCacheEntry)
-                {
-                  return mit->second._inflated;
-                }
-              } while (inMap && _uninitializedCacheEntry == mit->second._inflated);
+              _uncompressedKeys.splice(_uncompressedKeys.end(),
+                                       _uncompressedKeys,
+                                       mit->second._uncompressedKeyIterator);
+              mit->second._uncompressedKeyIterator = --_uncompressedKeys.end();
             }
+            ++_hits;
+            return mit->second._inflated;
           }
-          if (inMap
-              && !mit->second._inflated
-              && mit->second._compressed
-              && mit->second._compressed->empty())
+          if (mit->second._compressed)
           {
-            do
+            if (!mit->second._inflation)
             {
-              _condition.wait(lock);
-              inMap = (mit = _map.find(key)) != _map.end();
-              if (inMap && mit->second._inflated
-                  && mit->second._inflated != _uninitializedCacheEntry)
-              {
-                return mit->second._inflated;
-              }
-            } while (inMap && mit->second._compressed && mit->second._compressed->empty());
-          }
-          if (inMap
-              && !mit->second._inflated
-              && mit->second._compressed
-              && !mit->second._compressed->empty())
-          {
-            mit->second._compressed->swap(compressed);
+              CompressedData* compressed(mit->second._compressed);
+              // create shared_ptr under lock
+              mit->second._inflation = std::make_shared<Inflation>(CompressedDataPtr(
+                  compressed, DeleterFunc<CompressedData>(compressed, _compressedDeleter)));
+            }
+            inflation = mit->second._inflation;
           }
         }
-        if (create && !inMap)
+        else if (create)
         {
           insertUninitialized(key);
+          ++_misses;
         }
       }
-      if (!compressed.empty())
-      {
-        _pointer_type restored(this->_factory.uncompress(compressed));
-        _pointer_type ret;
-        if (restored)
+      if (inflation)
+      {
+        bool inflater(false);
+        std::call_once(inflation->_once,
+                       [this, &inflation, &inflater]()
+                       {
+          inflation->_restored = _pointer_type(this->_factory.uncompress(*inflation->_compressed));
+          inflater = true;
+        });
+        const _pointer_type restored(inflation->_restored);
+        if (inflater)
         {
-          std::unique_lock<std::mutex> lock(_mutex);
-          typename Map::iterator mit(_map.find(key));
-          if (mit != _map.end())
-          {
-            if (mit->second._inflated)
-            {
-              if (_uninitializedCacheEntry != mit->second._inflated)
-              {
-                ret = mit->second._inflated;
-              }
-            }
-            else if (mit->second._compressed != nullptr && mit->second._compressed->empty())
-            {
-              mit->second._compressed->swap(compressed);
-              ret = restored;
-              if (_uncompressedKeys.end() == mit->second._uncompressedKeyIterator)
-              {
-                mit->second._inflated = restored;
-                restored = _pointer_type();
-                insertUncompressed(mit);
-              }
-            }
-          }
-          if (restored)
-          {
-            this->moveToAccumulator(restored.get());
-          }
+          keepInflated(key, inflation);
         }
-        _condition.notify_all();
-        if (ret)
+        if (restored)
         {
-          return ret;
+          return restored;
         }
       }
       if (create)
@@ -299,6 +314,38 @@ protected:
     return _pointer_type();
   }
 
+  // Called by the thread which inflated the entry: the object stays in the
+  // cache if the entry still refers to this inflation and passes admission,
+  // otherwise it goes to the accumulator once the caller is done with it.
+  void keepInflated(const Key& key, const std::shared_ptr<Inflation>& inflation)
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    bool kept(false);
+    typename Map::iterator mit(_map.find(key));
+    if (mit != _map.end() && mit->second._inflation == inflation)
+    {
+      mit->second._inflation.reset();
+      if (inflation->_restored)
+      {
+        ++_inflations;
+        if (admit(mit))
+        {
+          mit->second._inflated = inflation->_restored;
+          insertUncompressed(mit);
+          kept = true;
+        }
+        else
+        {
+          ++_admissionRejects;
+        }
+      }
+    }
+    if (!kept && inflation->_restored)
+    {
+      this->moveToAccumulator(inflation->_restored.get());
+    }
+  }
+
   tse::CreateResult<Type> createEntry(const Key& key)
   {
     _pointer_type created;
@@ -412,6 +459,7 @@ protected:
           this->moveToAccumulator(pr.first->second._inflated.get());
         }
         pr.first->second._inflated = _pointer_type();
+        pr.first->second._inflation.reset();
         if (pr.first->second._compressed)
         {
           --_notEmptySize;
@@ -453,6 +501,12 @@ public:
     , _capacity(capacity)
     , _keysSize(0)
     , _notEmptySize(0)
+    , _sketch(capacity)
+    , _hits(0)
+    , _misses(0)
+    , _inflations(0)
+    , _deflations(0)
+    , _admissionRejects(0)
   {
     this->_cacheDeleter.setCachePtr(this);
   }
@@ -471,6 +525,7 @@ public:
   {
     std::unique_lock<std::mutex> lock(_mutex);
     _capacity = capacity;
+    _sketch.resize(capacity);
   }
 
   virtual _pointer_type getIfResident(const Key& key) override { return get(key, false); }
@@ -520,6 +575,7 @@ public:
           this->moveToAccumulator(pr.first->second._inflated.get());
         }
         pr.first->second._inflated = _pointer_type();
+        pr.first->second._inflation.reset();
         if (pr.first->second._compressed)
         {
           deleteCompressed(pr.first->second._compressed);
@@ -710,6 +766,11 @@ public:
     stats._compressedSize = 0 == this->_totalCapacity ? stats._totalSize - stats._uncompressedSize
                                                       : _compressedKeys.size();
     stats._threshold = this->_threshold;
+    stats._hits = _hits;
+    stats._misses = _misses;
+    stats._inflations = _inflations;
+    stats._deflations = _deflations;
+    stats._admissionRejects = _admissionRejects;
     size_t compressedBytes(0);
     size_t uncompressedBytes(0);
     size_t numberCompressed(0);
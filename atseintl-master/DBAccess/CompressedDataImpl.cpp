@@ -4,6 +4,7 @@
 #include "Common/Global.h"
 #include "Common/TSSCacheCommon.h"
 #include "DBAccess/CompressedData.h"
+#include "DBAccess/CompressionDictionary.h"
 
 #include <lz4.h>
 #include <snappy.h>
@@ -134,10 +135,24 @@ namespace CompressedDataImpl
 {
 
 sfc::CompressedData* compress(const char* input,
-                              size_t inputSz)
+                              size_t inputSz,
+                              CompressionDictionarySlot* dictionarySlot)
 {
   std::vector<char> compressed;
   size_t compressedSz(0);
+  if (dictionarySlot)
+  {
+    const CompressionDictionary* dictionary(dictionarySlot->dictionary());
+    if (nullptr == dictionary)
+    {
+      dictionarySlot->addSample(input, inputSz);
+    }
+    else if (compressWithDictionary(*dictionary, input, inputSz, compressed))
+    {
+      return new sfc::CompressedData(compressed, inputSz, compressed.size());
+    }
+    compressed.clear();
+  }
   if (UNLIKELY(lz4()))
   {
     lzCompress(input, inputSz, compressed);
@@ -173,7 +188,15 @@ std::vector<char>* uncompress(const sfc::CompressedData& compressedData,
       uncompressed.resize(compressedData._inflatedSz);
       buffer = &uncompressed;
     }
-    if (lz4())
+    if (isDictionaryCompressed(compressedData._deflated))
+    {
+      if (uncompressWithDictionary(
+          compressedData._deflated, &(*buffer)[0], compressedData._inflatedSz))
+      {
+        return buffer;
+      }
+    }
+    else if (lz4())
     {
       lzDecompress(*buffer, compressedData._deflated);
       return buffer;
@@ -190,6 +213,20 @@ std::vector<char>* uncompress(const sfc::CompressedData& compressedData,
   return nullptr;
 }
 
+sfc::CompressedData* withoutDictionary(const sfc::CompressedData& compressedData)
+{
+  if (!isDictionaryCompressed(compressedData._deflated) || 0 == compressedData._inflatedSz)
+  {
+    return nullptr;
+  }
+  std::vector<char> inflated(compressedData._inflatedSz);
+  if (!uncompressWithDictionary(compressedData._deflated, &inflated[0], inflated.size()))
+  {
+    return nullptr;
+  }
+  return compress(&inflated[0], inflated.size());
+}
+
 }// CompressedDataImpl
 
 }// tse
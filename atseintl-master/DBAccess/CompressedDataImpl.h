@@ -10,12 +10,21 @@ class CompressedData;
 
 namespace tse
 {
+class CompressionDictionarySlot;
 
 namespace CompressedDataImpl
 {
 
+// With a dictionary slot the entry is compressed with the trained
+// dictionary of its type, or sampled for training while there is none.
 sfc::CompressedData* compress(const char* input,
-                              size_t inputSz);
+                              size_t inputSz,
+                              CompressionDictionarySlot* dictionarySlot = nullptr);
+
+// Copy of dictionary compressed data compressed without the dictionary,
+// for a process that does not know it; nullptr if the data does not use
+// a dictionary or can not be inflated.
+sfc::CompressedData* withoutDictionary(const sfc::CompressedData& compressedData);
 
 std::vector<char>* uncompress(const sfc::CompressedData& compressedData,
                               std::vector<char>& uncompressed);
@@ -7,6 +7,7 @@
 #include "Common/Utils/ShadowVector.h"
 #include "DBAccess/CompressedData.h"
 #include "DBAccess/CompressedDataImpl.h"
+#include "DBAccess/CompressionDictionary.h"
 #include "DBAccess/HashKey.h"
 #include "DBAccess/LocKey.h"
 #include "DBAccess/TSEDateInterval.h"
@@ -18,6 +19,7 @@
 #include <cstring>
 #include <sstream>
 #include <type_traits>
+#include <typeinfo>
 
 namespace tse
 {
@@ -519,9 +521,12 @@ compressVector(const T* vect)
 {
   if (vect && !vect->empty())
   {
+    // one dictionary per entry type
+    static CompressionDictionarySlot* const dictionarySlot(
+        CompressionDictionaries::slot(typeid(T).name()));
     WBuffer os;
     os.write(*vect);
-    return CompressedDataImpl::compress(os.buffer(), os.size());
+    return CompressedDataImpl::compress(os.buffer(), os.size(), dictionarySlot);
   }
   return nullptr;
 }
@@ -0,0 +1,556 @@
+#include "DBAccess/CompressionDictionary.h"
+
+#include "Common/Config/ConfigMan.h"
+#include "Common/Global.h"
+#include "Common/Logger.h"
+#include "DBAccess/DiskCache.h"
+
+#include <boost/thread/locks.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+
+#include <dirent.h>
+#include <lz4.h>
+
+namespace tse
+{
+class CompressionDictionary : boost::noncopyable
+{
+public:
+  explicit CompressionDictionary(const std::string& content)
+    : _content(content), _id(checksum(content))
+  {
+    std::memset(&_stream, 0, sizeof(_stream));
+    LZ4_loadDict(&_stream, _content.data(), static_cast<int>(_content.size()));
+  }
+
+  // FNV-1a, never 0
+  static uint32_t checksum(const std::string& content)
+  {
+    uint32_t hash(2166136261u);
+    for (const char c : content)
+    {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return hash != 0 ? hash : 1;
+  }
+
+  uint32_t id() const { return _id; }
+
+  const std::string& content() const { return _content; }
+
+  // The stream primed with the dictionary is copied, so one dictionary
+  // serves any number of concurrent compressions.
+  int compress(const char* input, int inputSz, char* output) const
+  {
+    LZ4_stream_t stream(_stream);
+    return LZ4_compress_continue(&stream, input, output, inputSz);
+  }
+
+  int uncompress(const char* input, int inputSz, char* output, int outputSz) const
+  {
+    return LZ4_decompress_safe_usingDict(
+        input, output, inputSz, outputSz, _content.data(), static_cast<int>(_content.size()));
+  }
+
+private:
+  const std::string _content;
+  const uint32_t _id;
+  LZ4_stream_t _stream;
+};
+
+namespace
+{
+const size_t MAX_DICTIONARY_SIZE = 64 * 1024;
+const size_t MAX_SAMPLE_SIZE = 4 * 1024;
+const size_t DEFAULT_NUMBER_OF_SAMPLES = 500;
+
+// as a snappy stream: a varint length > 32GB, as an LZ4 stream: a negative
+// block size
+const char MARKER[] = {'\x80', '\x80', '\x80', '\x80', '\x7f'};
+const size_t HEADER_SIZE = sizeof(MARKER) + sizeof(uint32_t);
+
+const char FILE_MAGIC[8] = {'T', 'S', 'E', 'L', 'Z', '4', 'D', '1'};
+const char* const FILE_EXTENSION = ".lz4dict";
+
+Logger&
+logger()
+{
+  static Logger logger("atseintl.DBAccess.CompressionDictionary");
+  return logger;
+}
+
+struct DictionaryConfig
+{
+  DictionaryConfig() : _enabled(false), _numberOfSamples(DEFAULT_NUMBER_OF_SAMPLES)
+  {
+    if (Global::hasConfig())
+    {
+      std::string value;
+      Global::config().getValue("COMPRESSION_DICTIONARY", value, "TSE_SERVER");
+      _enabled = value == "Y" || value == "y";
+      value.clear();
+      if (Global::config().getValue("COMPRESSION_DICTIONARY_SAMPLES", value, "TSE_SERVER") &&
+          std::atoi(value.c_str()) > 0)
+      {
+        _numberOfSamples = std::atoi(value.c_str());
+      }
+    }
+    // dictionaries live and go with the LDC files, they are kept on disk
+    // only while the LDC is active
+    if (DiskCache::isActivated())
+    {
+      _directory = DiskCache::instance().directory();
+    }
+  }
+
+  bool _enabled;
+  size_t _numberOfSamples;
+  std::string _directory;
+};
+
+const DictionaryConfig&
+dictionaryConfig()
+{
+  static const DictionaryConfig config;
+  return config;
+}
+
+// Dictionaries by id in an open addressed table. Entries are only added,
+// so lookups need no lock.
+struct Registry
+{
+  static const size_t ID_TABLE_SIZE = 1024;
+
+  Registry()
+  {
+    for (std::atomic<const CompressionDictionary*>& entry : _byId)
+    {
+      entry = nullptr;
+    }
+  }
+
+  boost::mutex _mutex;
+  std::map<std::string, std::unique_ptr<CompressionDictionarySlot>> _slots;
+  std::vector<std::unique_ptr<const CompressionDictionary>> _dictionaries;
+  std::atomic<const CompressionDictionary*> _byId[ID_TABLE_SIZE];
+};
+
+Registry&
+registry()
+{
+  static Registry registry;
+  return registry;
+}
+
+std::string
+fileName(const std::string& directory, const std::string& name)
+{
+  return directory + "/" + name + FILE_EXTENSION;
+}
+
+bool
+endsWith(const std::string& name, const std::string& suffix)
+{
+  return name.size() > suffix.size() &&
+         0 == name.compare(name.size() - suffix.size(), suffix.size(), suffix);
+}
+
+inline uint64_t
+kmer(const char* data)
+{
+  uint64_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+}
+
+CompressionDictionarySlot::CompressionDictionarySlot(const std::string& name,
+                                                     size_t numberOfSamples,
+                                                     const std::string& directory)
+  : _name(name), _numberOfSamples(numberOfSamples), _directory(directory), _dictionary(nullptr)
+{
+}
+
+void
+CompressionDictionarySlot::addSample(const char* data, size_t size)
+{
+  // compressing threads never wait for each other or for the training
+  boost::unique_lock<boost::mutex> lock(_mutex, boost::try_to_lock);
+  if (!lock.owns_lock() || dictionary() != nullptr)
+  {
+    return;
+  }
+  _samples.emplace_back(data, std::min(size, MAX_SAMPLE_SIZE));
+  if (_samples.size() < _numberOfSamples)
+  {
+    return;
+  }
+  const std::string content(trainDictionary(_samples, MAX_DICTIONARY_SIZE));
+  std::vector<std::string>().swap(_samples);
+  const CompressionDictionary* trained(content.empty() ? nullptr
+                                                       : CompressionDictionaries::add(content));
+  if (trained != nullptr)
+  {
+    publish(trained);
+    LOG4CXX_INFO(logger(),
+                 "Trained compression dictionary " << _name << " id=" << trained->id()
+                                                   << " size=" << content.size());
+    if (!_directory.empty())
+    {
+      CompressionDictionaries::save(*this, _directory);
+    }
+  }
+}
+
+void
+CompressionDictionarySlot::publish(const CompressionDictionary* dictionary)
+{
+  _dictionary.store(dictionary, std::memory_order_release);
+}
+
+namespace CompressionDictionaries
+{
+CompressionDictionarySlot*
+slot(const char* name)
+{
+  const DictionaryConfig& config(dictionaryConfig());
+  if (!config._enabled)
+  {
+    return nullptr;
+  }
+  Registry& reg(registry());
+  CompressionDictionarySlot* created(nullptr);
+  {
+    boost::lock_guard<boost::mutex> lock(reg._mutex);
+    std::unique_ptr<CompressionDictionarySlot>& entry(reg._slots[name]);
+    if (entry)
+    {
+      return entry.get();
+    }
+    entry.reset(new CompressionDictionarySlot(name, config._numberOfSamples, config._directory));
+    created = entry.get();
+  }
+  // load() registers the dictionary under the registry mutex
+  if (!config._directory.empty())
+  {
+    load(*created, config._directory);
+  }
+  return created;
+}
+
+const CompressionDictionary*
+find(uint32_t id)
+{
+  Registry& reg(registry());
+  for (size_t i = 0; i < Registry::ID_TABLE_SIZE; ++i)
+  {
+    const CompressionDictionary* dictionary(
+        reg._byId[(id + i) % Registry::ID_TABLE_SIZE].load(std::memory_order_acquire));
+    if (nullptr == dictionary || dictionary->id() == id)
+    {
+      return dictionary;
+    }
+  }
+  return nullptr;
+}
+
+const CompressionDictionary*
+add(const std::string& content)
+{
+  const uint32_t id(CompressionDictionary::checksum(content));
+  Registry& reg(registry());
+  boost::lock_guard<boost::mutex> lock(reg._mutex);
+  for (size_t i = 0; i < Registry::ID_TABLE_SIZE; ++i)
+  {
+    std::atomic<const CompressionDictionary*>& entry(
+        reg._byId[(id + i) % Registry::ID_TABLE_SIZE]);
+    const CompressionDictionary* dictionary(entry.load(std::memory_order_relaxed));
+    if (nullptr == dictionary)
+    {
+      reg._dictionaries.emplace_back(new CompressionDictionary(content));
+      entry.store(reg._dictionaries.back().get(), std::memory_order_release);
+      return reg._dictionaries.back().get();
+    }
+    if (dictionary->id() == id)
+    {
+      // ids identify the content in the deflated data, two different
+      // dictionaries must never share one
+      return dictionary->content() == content ? dictionary : nullptr;
+    }
+  }
+  return nullptr;
+}
+
+bool
+load(CompressionDictionarySlot& slot, const std::string& directory)
+{
+  std::ifstream ifs(fileName(directory, slot.name()).c_str(), std::ios::binary);
+  if (!ifs)
+  {
+    return false;
+  }
+  char magic[sizeof(FILE_MAGIC)] = {};
+  uint32_t id(0);
+  uint32_t size(0);
+  ifs.read(magic, sizeof(magic));
+  ifs.read(reinterpret_cast<char*>(&id), sizeof(id));
+  ifs.read(reinterpret_cast<char*>(&size), sizeof(size));
+  if (!ifs || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0 || size > MAX_DICTIONARY_SIZE)
+  {
+    LOG4CXX_WARN(logger(), "Invalid compression dictionary file for " << slot.name());
+    return false;
+  }
+  std::string content(size, '\0');
+  ifs.read(&content[0], size);
+  if (!ifs || CompressionDictionary::checksum(content) != id)
+  {
+    LOG4CXX_WARN(logger(), "Corrupt compression dictionary file for " << slot.name());
+    return false;
+  }
+  const CompressionDictionary* dictionary(add(content));
+  if (nullptr == dictionary)
+  {
+    return false;
+  }
+  slot.publish(dictionary);
+  LOG4CXX_INFO(logger(), "Loaded compression dictionary " << slot.name() << " id=" << id);
+  return true;
+}
+
+bool
+save(const CompressionDictionarySlot& slot, const std::string& directory)
+{
+  const CompressionDictionary* dictionary(slot.dictionary());
+  if (nullptr == dictionary)
+  {
+    return false;
+  }
+  const std::string target(fileName(directory, slot.name()));
+  const std::string temporary(target + ".tmp");
+  {
+    std::ofstream ofs(temporary.c_str(), std::ios::binary | std::ios::trunc);
+    const uint32_t id(dictionary->id());
+    const uint32_t size(static_cast<uint32_t>(dictionary->content().size()));
+    ofs.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    ofs.write(reinterpret_cast<const char*>(&id), sizeof(id));
+    ofs.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    ofs.write(dictionary->content().data(), size);
+    if (!ofs)
+    {
+      LOG4CXX_WARN(logger(), "Cannot write compression dictionary " << temporary);
+      std::remove(temporary.c_str());
+      return false;
+    }
+  }
+  return 0 == std::rename(temporary.c_str(), target.c_str());
+}
+
+size_t
+removeFiles(const std::string& directory)
+{
+  size_t removed(0);
+  DIR* dir(opendir(directory.c_str()));
+  if (nullptr == dir)
+  {
+    return removed;
+  }
+  const std::string extension(FILE_EXTENSION);
+  const std::string temporaryExtension(extension + ".tmp");
+  for (const dirent* entry(readdir(dir)); entry != nullptr; entry = readdir(dir))
+  {
+    const std::string baseName(entry->d_name);
+    const bool isDictionary(endsWith(baseName, extension) ||
+                            endsWith(baseName, temporaryExtension));
+    if (isDictionary && 0 == std::remove((directory + "/" + baseName).c_str()))
+    {
+      ++removed;
+    }
+  }
+  closedir(dir);
+  if (removed > 0)
+  {
+    LOG4CXX_INFO(logger(), "Removed " << removed << " compression dictionary files");
+  }
+  return removed;
+}
+}
+
+std::string
+trainDictionary(const std::vector<std::string>& samples, size_t maxSize)
+{
+  static const size_t K = sizeof(uint64_t);
+  static const size_t SEGMENT_SIZE = 64;
+
+  // number of samples containing each k-byte string
+  struct KmerCount
+  {
+    uint32_t _count;
+    uint32_t _lastSample;
+  };
+  std::unordered_map<uint64_t, KmerCount> counts;
+  for (uint32_t s = 0; s < samples.size(); ++s)
+  {
+    const std::string& sample(samples[s]);
+    for (size_t i = 0; i + K <= sample.size(); ++i)
+    {
+      KmerCount& count(counts.emplace(kmer(&sample[i]), KmerCount{0, UINT32_MAX}).first->second);
+      if (count._lastSample != s)
+      {
+        count._lastSample = s;
+        ++count._count;
+      }
+    }
+  }
+
+  struct Segment
+  {
+    const char* _data;
+    size_t _size;
+  };
+  std::vector<Segment> segments;
+  for (const std::string& sample : samples)
+  {
+    for (size_t begin = 0; begin + K <= sample.size(); begin += SEGMENT_SIZE)
+    {
+      segments.push_back(
+          Segment{sample.data() + begin, std::min(SEGMENT_SIZE, sample.size() - begin)});
+    }
+  }
+  // a segment is worth the samples sharing its content not yet covered
+  auto score = [&counts](const Segment& segment)
+  {
+    uint64_t total(0);
+    for (size_t i = 0; i + K <= segment._size; ++i)
+    {
+      const uint32_t count(counts.find(kmer(segment._data + i))->second._count);
+      if (count > 1)
+      {
+        total += count;
+      }
+    }
+    return total;
+  };
+
+  // lazy greedy: scores only drop as content gets covered, so a popped
+  // segment whose rescore still tops the queue is the best one
+  std::priority_queue<std::pair<uint64_t, uint32_t>> queue;
+  for (uint32_t i = 0; i < segments.size(); ++i)
+  {
+    const uint64_t value(score(segments[i]));
+    if (value > 0)
+    {
+      queue.emplace(value, i);
+    }
+  }
+  std::vector<uint32_t> chosen;
+  size_t size(0);
+  while (!queue.empty() && size < maxSize)
+  {
+    const uint32_t index(queue.top().second);
+    queue.pop();
+    const uint64_t value(score(segments[index]));
+    if (0 == value)
+    {
+      continue;
+    }
+    if (!queue.empty() && value < queue.top().first)
+    {
+      queue.emplace(value, index);
+      continue;
+    }
+    const Segment& segment(segments[index]);
+    for (size_t i = 0; i + K <= segment._size; ++i)
+    {
+      counts.find(kmer(segment._data + i))->second._count = 0;
+    }
+    chosen.push_back(index);
+    size += segment._size;
+  }
+
+  std::string dictionary;
+  dictionary.reserve(size);
+  for (std::vector<uint32_t>::const_reverse_iterator it(chosen.rbegin()); it != chosen.rend(); ++it)
+  {
+    dictionary.append(segments[*it]._data, segments[*it]._size);
+  }
+  if (dictionary.size() > maxSize)
+  {
+    dictionary.erase(0, dictionary.size() - maxSize);
+  }
+  return dictionary;
+}
+
+uint32_t
+dictionaryId(const CompressionDictionary& dictionary)
+{
+  return dictionary.id();
+}
+
+const std::string&
+dictionaryContent(const CompressionDictionary& dictionary)
+{
+  return dictionary.content();
+}
+
+bool
+isDictionaryCompressed(const std::vector<char>& deflated)
+{
+  return deflated.size() > HEADER_SIZE && 0 == std::memcmp(&deflated[0], MARKER, sizeof(MARKER));
+}
+
+bool
+compressWithDictionary(const CompressionDictionary& dictionary,
+                       const char* input,
+                       size_t inputSz,
+                       std::vector<char>& deflated)
+{
+  if (0 == inputSz || inputSz > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+  {
+    return false;
+  }
+  deflated.resize(HEADER_SIZE + LZ4_compressBound(static_cast<int>(inputSz)));
+  const uint32_t id(dictionary.id());
+  std::memcpy(&deflated[0], MARKER, sizeof(MARKER));
+  std::memcpy(&deflated[sizeof(MARKER)], &id, sizeof(id));
+  const int compressedSz(
+      dictionary.compress(input, static_cast<int>(inputSz), &deflated[HEADER_SIZE]));
+  if (compressedSz <= 0)
+  {
+    return false;
+  }
+  deflated.resize(HEADER_SIZE + compressedSz);
+  return true;
+}
+
+bool
+uncompressWithDictionary(const std::vector<char>& deflated, char* output, size_t outputSz)
+{
+  if (!isDictionaryCompressed(deflated))
+  {
+    return false;
+  }
+  uint32_t id(0);
+  std::memcpy(&id, &deflated[sizeof(MARKER)], sizeof(id));
+  const CompressionDictionary* dictionary(CompressionDictionaries::find(id));
+  if (nullptr == dictionary)
+  {
+    LOG4CXX_ERROR(logger(), "Unknown compression dictionary id=" << id);
+    return false;
+  }
+  const int inflatedSz(dictionary->uncompress(&deflated[HEADER_SIZE],
+                                              static_cast<int>(deflated.size() - HEADER_SIZE),
+                                              output,
+                                              static_cast<int>(outputSz)));
+  return inflatedSz >= 0 && static_cast<size_t>(inflatedSz) == outputSz;
+}
+
+} // tse
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Trained dictionaries for the LZ4 compression of cache entries.
+//
+// Flattened entries of one type (FareInfo, GeneralFareRuleInfo, ... vectors)
+// share most of their bytes, but each entry is compressed on its own and is
+// usually too small for LZ4 to find those repeats. A dictionary built from a
+// sample of entries of the type primes every compression and decompression
+// with the common content.
+//
+// Each type has a CompressionDictionarySlot. Until it has a dictionary it
+// collects samples from the entries being compressed; when it has enough it
+// trains one, publishes it and, while the LDC is active, stores it in the LDC
+// directory, from where it is loaded at the next start. The files are
+// removed whenever LDC data is removed. Compressed data carries the id of
+// its dictionary, and dictionaries are never released, so entries compressed
+// before and after a dictionary change can be inflated alike.
+//
+// Dictionaries are local to the process. Entries served to remote cache
+// peers are compressed again without one.
+//
+// Enabled with COMPRESSION_DICTIONARY=Y in TSE_SERVER.
+
+namespace tse
+{
+class CompressionDictionary;
+
+class CompressionDictionarySlot : boost::noncopyable
+{
+public:
+  // a trained dictionary is saved to the directory unless it is empty
+  CompressionDictionarySlot(const std::string& name,
+                            size_t numberOfSamples,
+                            const std::string& directory = "");
+
+  const std::string& name() const { return _name; }
+
+  const CompressionDictionary* dictionary() const
+  {
+    return _dictionary.load(std::memory_order_acquire);
+  }
+
+  // Records the entry for training; trains and publishes the dictionary
+  // when enough samples have been seen.
+  void addSample(const char* data, size_t size);
+
+  void publish(const CompressionDictionary* dictionary);
+
+private:
+  const std::string _name;
+  const size_t _numberOfSamples;
+  const std::string _directory;
+  std::atomic<const CompressionDictionary*> _dictionary;
+  boost::mutex _mutex;
+  std::vector<std::string> _samples;
+};
+
+namespace CompressionDictionaries
+{
+// Slot of the entry type, nullptr if dictionaries are disabled.
+CompressionDictionarySlot*
+slot(const char* name);
+
+// Dictionary with the given id, nullptr if unknown in this process.
+const CompressionDictionary*
+find(uint32_t id);
+
+// Takes ownership; an equal dictionary already known is returned instead.
+const CompressionDictionary*
+add(const std::string& content);
+
+bool
+load(CompressionDictionarySlot& slot, const std::string& directory);
+
+bool
+save(const CompressionDictionarySlot& slot, const std::string& directory);
+
+// Removes the dictionary files of the directory, returns their number.
+size_t
+removeFiles(const std::string& directory);
+}
+
+// Picks the byte ranges of the samples shared by most of them, up to
+// maxSize bytes, the most valuable at the end where LZ4 matches are cheapest.
+std::string
+trainDictionary(const std::vector<std::string>& samples, size_t maxSize);
+
+uint32_t
+dictionaryId(const CompressionDictionary& dictionary);
+
+const std::string&
+dictionaryContent(const CompressionDictionary& dictionary);
+
+// Dictionary format of the deflated data: a marker no snappy or LZ4 stream
+// of an entry can start with, the dictionary id, one LZ4 block.
+bool
+isDictionaryCompressed(const std::vector<char>& deflated);
+
+bool
+compressWithDictionary(const CompressionDictionary& dictionary,
+                       const char* input,
+                       size_t inputSz,
+                       std::vector<char>& deflated);
+
+bool
+uncompressWithDictionary(const std::vector<char>& deflated, char* output, size_t outputSz);
+
+} // tse
@@ -0,0 +1,171 @@
+//-------------------------------------------------------------------------------
+// Copyright 2016, Sabre Inc.  All rights reserved.
+// This software/documentation is the confidential and proprietary product of
+// Sabre Inc.   Any unauthorized use, reproduction, or transfer of this
+// software/documentation,  in any medium, or incorporation of this
+// software/documentation into any system or publication, is strictly prohibited.
+//-------------------------------------------------------------------------------
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace tse
+{
+// Coalesces concurrent cache misses of one DAO into batched queries.
+//
+// Keys that differ only in the DAO's batchable columns form a batch group.
+// The first thread to miss a key of a group opens a batch and waits up to
+// the batch window for other threads missing keys of the same group, or
+// until the batch is full. It then loads all the keys with one query, on
+// one pooled connection, and hands each waiting thread its own result.
+template <typename Key, typename T>
+class DAOBatchLoader : boost::noncopyable
+{
+public:
+  // Oracle takes at most 1000 values in an IN list, and the bind variable
+  // list of a substituted parameter is limited in length as well
+  static constexpr size_t MAX_BATCH_KEYS = 500;
+
+  // loads keys[i] into results[i]
+  typedef std::function<void(const std::vector<Key>& keys, std::vector<T*>& results)> BatchQuery;
+
+  void setLimits(uint32_t windowMicros, size_t maxKeys)
+  {
+    _windowMicros = windowMicros;
+    _maxKeys = (maxKeys < MAX_BATCH_KEYS) ? maxKeys : size_t(MAX_BATCH_KEYS);
+  }
+
+  bool enabled() const { return _windowMicros != 0 && _maxKeys > 1; }
+
+  // false if the key was not loaded in a batch, the caller loads it alone
+  bool load(const Key& group, const Key& key, const BatchQuery& query, T*& result)
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    typename OpenBatches::iterator it(findOpen(group));
+    if (it != _open.end())
+    {
+      BatchPtr batch(it->second);
+      if (std::find(batch->keys.begin(), batch->keys.end(), key) != batch->keys.end())
+      {
+        // each result is owned by exactly one caller
+        return false;
+      }
+      const size_t index(batch->keys.size());
+      batch->keys.push_back(key);
+      if (batch->keys.size() >= _maxKeys)
+      {
+        _open.erase(it);
+        _condition.notify_all();
+      }
+      while (!batch->done)
+      {
+        _condition.wait(lock);
+      }
+      if (batch->error)
+      {
+        std::rethrow_exception(batch->error);
+      }
+      result = batch->results[index];
+      return true;
+    }
+
+    BatchPtr batch(std::make_shared<Batch>());
+    batch->keys.push_back(key);
+    _open.push_back(std::make_pair(group, batch));
+
+    const std::chrono::steady_clock::time_point deadline(std::chrono::steady_clock::now() +
+                                                         std::chrono::microseconds(_windowMicros));
+    while (isOpen(group, batch) &&
+           _condition.wait_until(lock, deadline) != std::cv_status::timeout)
+    {
+    }
+    if (isOpen(group, batch))
+    {
+      _open.erase(findOpen(group));
+    }
+    lock.unlock();
+
+    // the batch is closed, no one else touches its keys
+    try
+    {
+      query(batch->keys, batch->results);
+      if (batch->results.size() != batch->keys.size())
+      {
+        throw std::logic_error("batch query returned a wrong number of results");
+      }
+    }
+    catch (...)
+    {
+      batch->error = std::current_exception();
+    }
+
+    ++_batches;
+    _batchedKeys += batch->keys.size();
+
+    lock.lock();
+    batch->done = true;
+    _condition.notify_all();
+    lock.unlock();
+
+    if (batch->error)
+    {
+      std::rethrow_exception(batch->error);
+    }
+    result = batch->results.front();
+    return true;
+  }
+
+  uint64_t batches() const { return _batches; }
+  uint64_t batchedKeys() const { return _batchedKeys; }
+
+private:
+  struct Batch
+  {
+    std::vector<Key> keys;
+    std::vector<T*> results;
+    bool done = false;
+    std::exception_ptr error;
+  };
+  typedef std::shared_ptr<Batch> BatchPtr;
+  // few groups are open at a time, and keys need not be ordered
+  typedef std::vector<std::pair<Key, BatchPtr>> OpenBatches;
+
+  typename OpenBatches::iterator findOpen(const Key& group)
+  {
+    typename OpenBatches::iterator it(_open.begin());
+    while (it != _open.end() && !(it->first == group))
+    {
+      ++it;
+    }
+    return it;
+  }
+
+  bool isOpen(const Key& group, const BatchPtr& batch)
+  {
+    typename OpenBatches::iterator it(findOpen(group));
+    return it != _open.end() && it->second == batch;
+  }
+
+  uint32_t _windowMicros = 0;
+  size_t _maxKeys = 0;
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  OpenBatches _open;
+  std::atomic<uint64_t> _batches{0};
+  std::atomic<uint64_t> _batchedKeys{0};
+};
+} // tse
@@ -35,56 +35,26 @@ public:
 
   void init(bool load = true) override
   {
-    boost::lock_guard<boost::mutex> g(_mutex);
-    T*& t = T::_instance;
-    if (t == nullptr)
+    // A cache still warming in the background is created empty for the
+    // transaction asking for it, which serves its misses from the database;
+    // the initialization task loads it (warm()).
+    if (load && CacheManager::instance().cacheWarming(_id))
     {
-      CacheManager& cm = CacheManager::instance();
-
-      int cacheSize = cm.cacheSize(_id);
-      const std::string& cacheType = cm.cacheType(_id);
-      size_t fullConsolidationLimit = cm.cacheFullConsolidationLimit(_id);
-      size_t partialConsolidationLimit = cm.cachePartialConsolidationLimit(_id);
-
-      t = new T(cacheSize, cacheType);
-      t->setName(_id);
-      t->setFullConsolidationLimit(fullConsolidationLimit);
-      t->setPartialConsolidationLimit(partialConsolidationLimit);
-      t->setTotalCapacity(cm.getTotalCapacity(_id));
-      t->setThreshold(cm.getThreshold(_id));
-
-      if (load)
-      {
-        t->setLoading(true);
-        DiskCache::Timer loadTimer;
-
-        LOG4CXX_DEBUG(t->getLogger(), "Starting LOAD for cache [" << _id << "].");
-        loadTimer.reset();
-        t->load();
-        DISKCACHE.doneWithDB(_id);
-        loadTimer.checkpoint();
-        size_t cacheSize(t->cache().size());
-        if (cacheSize > 0)
-        {
-          std::string ess(cacheSize > 1 ? "s" : "");
-          LOG4CXX_INFO(t->getLogger(),
-                       "Loaded [" << cacheSize << "] object" << ess << " for cache [" << _id << "]."
-                                  << "  SOURCE=" << t->loadSourceAsString() << "."
-                                  << "  ELAPSED=" << loadTimer.elapsed() << "ms."
-                                  << "  CPU=" << loadTimer.cpu() << "ms.");
-        }
-
-        // Perform a full consolidation so things start out clean
-        t->consolidate(true);
-
-        t->setLoading(false);
-      }
-
-      t->setLoadOnUpdate(cm.cacheLoadOnUpdate(_id));
-      t->setCacheBy(cm.cacheBy(_id));
+      load = false;
+    }
+    create();
+    if (load)
+    {
+      loadOnce();
     }
   }
 
+  void warm() override
+  {
+    create();
+    loadOnce();
+  }
+
   uint64_t accessCount() override
   {
     T* t = T::_instance;
@@ -581,7 +551,73 @@ public:
   }
 
 private:
+  void create()
+  {
+    boost::lock_guard<boost::mutex> g(_mutex);
+    T*& t = T::_instance;
+    if (t == nullptr)
+    {
+      CacheManager& cm = CacheManager::instance();
+
+      int cacheSize = cm.cacheSize(_id);
+      const std::string& cacheType = cm.cacheType(_id);
+      size_t fullConsolidationLimit = cm.cacheFullConsolidationLimit(_id);
+      size_t partialConsolidationLimit = cm.cachePartialConsolidationLimit(_id);
+
+      T* created = new T(cacheSize, cacheType);
+      created->setName(_id);
+      created->setFullConsolidationLimit(fullConsolidationLimit);
+      created->setPartialConsolidationLimit(partialConsolidationLimit);
+      created->setBatchLimits(cm.cacheBatchWindow(_id), cm.cacheBatchSize(_id));
+      created->setSingleFlightTimeout(cm.singleFlightTimeout());
+      created->setTotalCapacity(cm.getTotalCapacity(_id));
+      created->setThreshold(cm.getThreshold(_id));
+      created->setLoadOnUpdate(cm.cacheLoadOnUpdate(_id));
+      created->setCacheBy(cm.cacheBy(_id));
+      t = created;
+    }
+  }
+
+  // Loads the cache unless it was loaded already. Does not hold _mutex, so
+  // transactions can use a cache created while it is warming.
+  void loadOnce()
+  {
+    boost::lock_guard<boost::mutex> g(_loadMutex);
+    if (_loaded)
+    {
+      return;
+    }
+    _loaded = true;
+
+    T* t = T::_instance;
+    t->setLoading(true);
+    DiskCache::Timer loadTimer;
+
+    LOG4CXX_DEBUG(t->getLogger(), "Starting LOAD for cache [" << _id << "].");
+    loadTimer.reset();
+    t->load();
+    DISKCACHE.doneWithDB(_id);
+    loadTimer.checkpoint();
+    size_t cacheSize(t->cache().size());
+    if (cacheSize > 0)
+    {
+      std::string ess(cacheSize > 1 ? "s" : "");
+      LOG4CXX_INFO(t->getLogger(),
+                   "Loaded [" << cacheSize << "] object" << ess << " for cache [" << _id << "]."
+                              << "  SOURCE=" << t->loadSourceAsString() << "."
+                              << "  ELAPSED=" << loadTimer.elapsed() << "ms."
+                              << "  CPU=" << loadTimer.cpu() << "ms.");
+    }
+
+    // Perform a full consolidation so things start out clean
+    t->consolidate(true);
+
+    t->setLoading(false);
+  }
+
   static boost::mutex _mutex;
+  static boost::mutex _loadMutex;
+  static bool _loaded;
 
   std::string _id;
 };
@@ -589,6 +625,12 @@ private:
 template <typename T>
 boost::mutex DAOHelper<T>::_mutex;
 
+template <typename T>
+boost::mutex DAOHelper<T>::_loadMutex;
+
+template <typename T>
+bool DAOHelper<T>::_loaded = false;
+
 template <typename T>
 void
 deleteVectorOfPointers(std::vector<T*>& v)
@@ -17,7 +17,9 @@
 #include "DBAccess/CacheControl.h"
 #include "DBAccess/CacheFactory.h"
 #include "DBAccess/CacheManager.h"
+#include "DBAccess/CompressedDataImpl.h"
 #include "DBAccess/CreateResult.h"
+#include "DBAccess/DAOBatchLoader.h"
 #include "DBAccess/DeleteList.h"
 #include "DBAccess/DiskCache.h"
 #include "DBAccess/LDCHelper.h"
@@ -282,6 +284,12 @@ public:
     }
     if (compressed)
     {
+      // the peer does not have this process' compression dictionaries
+      sfc::CompressedData* plain(CompressedDataImpl::withoutDictionary(*compressed));
+      if (plain)
+      {
+        compressed.reset(plain);
+      }
       LOG4CXX_DEBUG(getLogger(),
                     __FUNCTION__ << " #### name:" << name() << ",key:" << key
                                  << " status=" << status
@@ -398,7 +406,11 @@ protected:
 
     size_t size() { return _cache->size(); }
 
-    size_t clear() { return _cache->clear(); }
+    size_t clear()
+    {
+      _cache->singleFlight().forgetAll();
+      return _cache->clear();
+    }
 
     void emptyTrash() { _cache->emptyTrash(); }
 
@@ -416,7 +428,7 @@ protected:
     pointer_type get(const Key& key)
     {
       ++_dao._readCount;
-      return _cache->get(key);
+      return _cache->getCoalesced(key);
     }
 
     pointer_type getIfResident(const Key& key)
@@ -438,7 +450,16 @@ protected:
       _cache->put(key, object, updateLDC);
     }
 
-    size_t invalidate(const Key& key) { return _cache->invalidate(key); }
+    size_t invalidate(const Key& key)
+    {
+      _cache->singleFlight().forget(key);
+      return _cache->invalidate(key);
+    }
+
+    void setSingleFlightTimeout(uint32_t timeoutMillis)
+    {
+      _cache->singleFlight().setTimeout(timeoutMillis);
+    }
 
     bool ldcEnabled() const { return _cache->ldcEnabled(); }
 
@@ -455,6 +476,11 @@ protected:
     void getCompressionStats(sfc::CompressedCacheStats& stats)
     {
       _cache->getCompressionStats(stats);
+      const typename sfc::Cache<Key, T>::single_flight_type::Stats flights(
+          _cache->singleFlight().stats());
+      stats._coalescedLoads = flights.loads;
+      stats._coalescedWaits = flights.coalesced;
+      stats._coalescedTimeouts = flights.timeouts;
     }
 
     void disposeCache(double fraction)
@@ -525,6 +551,15 @@ protected:
 
   virtual CreateResult<T> create(const Key& key, bool isHistorical)
   {
+    if (UNLIKELY(_ldcHelper.lazyLoad()) && !isHistorical)
+    {
+      CreateResult<T> mapped;
+      mapped._ptr = _ldcHelper.getFromMappedFile(key);
+      if (mapped._ptr != nullptr)
+      {
+        return mapped;
+      }
+    }
     CreateResult<T> remote;
     RemoteCache::RCClient::get(*this, key, remote, isHistorical);
     if (remote)// client enabled
@@ -549,16 +584,54 @@ protected:
     // got here for server and local creates
     ++_accessCount;
     CreateResult<T> local;
-    local._ptr = create(key);
+    local._ptr = batchedCreate(key);
     return local;
   }
 
+  // A DAO whose query can load several keys at once opts in to batched
+  // loading of its cache misses by overriding batchGroup(), which clears
+  // the batchable columns of the key, and createBatch(), which loads keys
+  // of one batch group with a single query into results in key order.
+  virtual bool batchGroup(const Key& key, Key& group) const { return false; }
+
+  virtual void createBatch(const std::vector<Key>& keys, std::vector<T*>& results) {}
+
+  void setSingleFlightTimeout(uint32_t timeoutMillis)
+  {
+    _cache.setSingleFlightTimeout(timeoutMillis);
+  }
+
+  void setBatchLimits(uint32_t windowMicros, size_t maxKeys)
+  {
+    _batchLoader.setLimits(windowMicros, maxKeys);
+  }
+
+  uint64_t batches() const { return _batchLoader.batches(); }
+
+  uint64_t batchedKeys() const { return _batchLoader.batchedKeys(); }
+
   virtual void destroy(Key key, T* t) = 0;
 
   virtual size_t clear() { return _cache.clear(); }
 
   void emptyTrash() { _cache.emptyTrash(); }
 
+  T* batchedCreate(const Key& key)
+  {
+    Key group;
+    T* t(nullptr);
+    if (_batchLoader.enabled() && batchGroup(key, group) &&
+        _batchLoader.load(group,
+                          key,
+                          [this](const std::vector<Key>& keys, std::vector<T*>& results)
+                          { createBatch(keys, results); },
+                          t))
+    {
+      return t;
+    }
+    return create(key);
+  }
+
   virtual void store(const ObjectKey& objectKey)
   {
     Key key;
@@ -987,6 +1060,7 @@ protected:
   DAOFactory _factory;
   DAOCache _cache;
   LDCHelper_type _ldcHelper;
+  DAOBatchLoader<Key, T> _batchLoader;
 };
 
 } // namespace tse;
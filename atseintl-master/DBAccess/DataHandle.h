@@ -289,6 +289,8 @@ public:
       _trxId(trxId),
       _today(date.date())
   {
+    if (trxId > -1 && Memory::trxArenaEnabled)
+      _deleteList.enableArena(Memory::trxArenaHugePages);
   }
 
   bool isHistEnabled(const DateTime& date) const
@@ -304,7 +306,7 @@ public:
     t = static_cast<T*>(allocate(sizeof(T)));
     new (t) T;
 
-    _deleteList.adoptPooled(t);
+    adopt(t);
   }
 
   template <typename T>
@@ -328,6 +330,9 @@ public:
 private:
   void* allocate(size_t size)
   {
+    if (_deleteList.arenaEnabled())
+      return _deleteList.allocateFromArena(size);
+
     void* ptr = ::malloc(size);
 
     if (UNLIKELY(nullptr == ptr))
@@ -336,7 +341,21 @@ private:
     return ptr;
   }
 
-  void deallocate(void* ptr) { ::free(ptr); }
+  // arena memory is released with the arena
+  void deallocate(void* ptr)
+  {
+    if (!_deleteList.arenaEnabled())
+      ::free(ptr);
+  }
+
+  template <typename T>
+  void adopt(T* t)
+  {
+    if (_deleteList.arenaEnabled())
+      _deleteList.adoptFromArena(t);
+    else
+      _deleteList.adoptPooled(t);
+  }
 
 public:
   template <typename T, typename... Args>
@@ -346,7 +365,7 @@ public:
     try
     {
       new (result) T(std::forward<Args>(args)...);
-      _deleteList.adoptPooled(result);
+      adopt(result);
       return *result;
     }
     catch (...)
@@ -43,12 +43,16 @@ size_t _deletelist_sizes[16] = { 0,   1,   2,   4,    8,    16,   32,   64,
                                  128, 256, 512, 1024, 2048, 4096, 8192, 16384 };
 
 DeleteList::DeleteList(size_t numContainers, Memory::CompositeManager* parentManager)
-  : _numContainers(numContainers), _ptrs(&_ptrsSingle), _smartPtrs(&_smartPtrsSingle)
+  : _numContainers(numContainers),
+    _ptrs(&_ptrsSingle),
+    _smartPtrs(&_smartPtrsSingle),
+    _arenas(&_arenaSingle)
 {
   if (_numContainers > 1)
   {
     _ptrs = new PtrList[_numContainers];
     _smartPtrs = new SmartPtrList[_numContainers];
+    _arenas = new Memory::Arena[_numContainers];
   }
 
   if (parentManager)
@@ -60,6 +64,8 @@ DeleteList::DeleteList(size_t numContainers, Memory::CompositeManager* parentMan
 
       _smartPtrs[i].enableMemoryTracking();
       parentManager->registerManager(&_smartPtrs[i]);
+
+      parentManager->registerManager(&_arenas[i]);
     }
   }
 }
@@ -87,6 +93,10 @@ DeleteList::~DeleteList()
     {
       delete[] _smartPtrs;
     }
+    if (_arenas != &_arenaSingle)
+    {
+      delete[] _arenas;
+    }
     sw.stop();
     LOG4CXX_DEBUG(_logger,
                   "destruction elapsed time: " << sw.elapsedTime()
@@ -103,6 +113,10 @@ DeleteList::~DeleteList()
     {
       delete[] _smartPtrs;
     }
+    if (_arenas != &_arenaSingle)
+    {
+      delete[] _arenas;
+    }
   }
 }
 
@@ -288,10 +302,25 @@ DeleteList::import(DeleteList& another)
       another._ptrs[n].clear();
     }
   }
+  // the imported objects may live in the other list's arenas
+  for (size_t n = 0; n != another._numContainers; ++n)
+  {
+    _arenas[n % _numContainers].import(another._arenas[n]);
+  }
   if (UNLIKELY(_debugLoggingFlags & DEBUG_STATISTICS))
     _importCount++;
 }
 
+void
+DeleteList::enableArena(bool hugePages)
+{
+  for (size_t n = 0; n != _numContainers; ++n)
+  {
+    _arenas[n].setHugePages(hugePages);
+  }
+  _arenaEnabled = true;
+}
+
 void
 DeleteList::deallocate()
 {
@@ -299,6 +328,12 @@ DeleteList::deallocate()
   {
     deallocate(n);
   }
+  // an object may have been imported into another container than the
+  // arena it lives in, so the arenas go only when all of them are destroyed
+  for (size_t n = 0; n != _numContainers; ++n)
+  {
+    _arenas[n].release();
+  }
 }
 
 void
@@ -2,6 +2,7 @@
 
 #include "Common/Global.h"
 #include "Common/Logger.h"
+#include "Common/Memory/Arena.h"
 #include "Common/Memory/CompositeManager.h"
 #include "Common/Memory/Config.h"
 #include "Common/StopWatch.h"
@@ -14,6 +15,7 @@
 #include <cstdio>
 #include <functional>
 #include <memory>
+#include <type_traits>
 
 #include <pthread.h>
 
@@ -91,6 +93,28 @@ private:
     static const PooledPointerDeleter<T> _instance;
   };
 
+  // Objects allocated from the arena are destroyed here; their memory is
+  // released with the arena.
+  template <typename T>
+  class ArenaPointerDeleter : public DeleterBase
+  {
+  public:
+    static const ArenaPointerDeleter<T>& instance() { return _instance; }
+
+  private:
+    ArenaPointerDeleter() {}
+    ArenaPointerDeleter(const ArenaPointerDeleter<T>&);
+    void operator=(const ArenaPointerDeleter<T>&);
+
+    void deallocate(void* ptr) const override { static_cast<T*>(ptr)->~T(); }
+
+    const char* typeName() const override { return typeid(T).name(); }
+    size_t typeSize() const override { return sizeof(T); } // lint !e1516
+    bool pooled() const override { return true; }
+
+    static const ArenaPointerDeleter<T> _instance;
+  };
+
 public:
   class PointerManager
   {
@@ -287,6 +311,11 @@ private:
   SmartPtrList _smartPtrsSingle;
   SmartPtrList* _smartPtrs;
 
+  // one arena per container, for the same reason
+  Memory::Arena _arenaSingle;
+  Memory::Arena* _arenas;
+  bool _arenaEnabled = false;
+
   DeleteList(const DeleteList&);
   DeleteList& operator=(const DeleteList&);
 
@@ -382,20 +411,39 @@ public:
   }
 
   /**
-   *  Import all the objects managed by another DeleteList into this one.
-   *  On exit, the other DeleteList will be cleared.
+   *  Allocate from the arena instead of the heap. The arena memory is
+   *  released when the list is cleared or destroyed, after all the objects
+   *  in the list have been destroyed.
    */
+  void enableArena(bool hugePages);
 
-  void import(DeleteList& another);
+  bool arenaEnabled() const { return _arenaEnabled; }
+
+  void* allocateFromArena(size_t size) { return _arenas[containerIndex()].allocate(size); }
 
-  void clear()
+  /**
+   *  Adopt an object allocated from the arena. There is nothing to do at
+   *  the end for trivially destructible types, they are not even listed.
+   */
+  template <typename T>
+  void adoptFromArena(T* t)
   {
-    for (size_t n = 0; n != _numContainers; ++n)
+    if (!std::is_trivially_destructible<T>::value)
     {
-      deallocate(n);
+      const size_t index = containerIndex();
+      _ptrs[index].push_back(PointerManager(t, ArenaPointerDeleter<T>::instance()));
     }
   }
 
+  /**
+   *  Import all the objects managed by another DeleteList into this one.
+   *  On exit, the other DeleteList will be cleared.
+   */
+
+  void import(DeleteList& another);
+
+  void clear() { deallocate(); }
+
 public:
   // DEBUG FLAG VALUES
 
@@ -442,5 +490,8 @@ const DeleteList::PooledPointerDeleter<T> DeleteList::PooledPointerDeleter<T>::_
 template <typename T>
 const DeleteList::PointerDeleter<T> DeleteList::PointerDeleter<T>::_instance;
 
+template <typename T>
+const DeleteList::ArenaPointerDeleter<T> DeleteList::ArenaPointerDeleter<T>::_instance;
+
 } // namespace tse
 
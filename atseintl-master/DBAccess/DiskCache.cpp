@@ -28,7 +28,9 @@
 #include "Common/TseUtil.h"
 #include "DBAccess/CacheControl.h"
 #include "DBAccess/CacheRegistry.h"
+#include "DBAccess/CompressionDictionary.h"
 #include "DBAccess/DistCache.h"
+#include "DBAccess/LDCMappedFile.h"
 
 #include <boost/tokenizer.hpp>
 
@@ -121,6 +123,7 @@ static const char* DataFormats[DiskCache::DataFormat_END] = { "BN2" };
 
 static const char* TABLE_CTL_FILE_EXT = ".ctl";
 static const char* TABLE_OPEN_FILE_EXT = ".open";
+static const char* MAPPED_FILE_EXT = ".ldcm";
 static const char* LAST_UPDATE_FILE = ".lastupdate";
 static const char* CLEAR_NEXT_START_FILE = ".clear";
 static const char* VERIFY_NEXT_CYCLE_FILE = ".verify";
@@ -320,7 +323,7 @@ getLDCControlFileValue(const std::string& ldcDir,
 
 DiskCache::DataBlob::~DataBlob()
 {
-  if (_dataBuffer != nullptr)
+  if (_dataBuffer != nullptr && _owner == nullptr)
   {
     delete[] _dataBuffer;
   }
@@ -331,7 +334,11 @@ DiskCache::DataBlob::clear()
 {
   if (UNLIKELY(_dataBuffer != nullptr))
   {
-    delete[] _dataBuffer;
+    if (_owner == nullptr)
+    {
+      delete[] _dataBuffer;
+    }
+    _owner.reset();
 
     _dataBuffer = nullptr;
     _dataBufferSize = 0;
@@ -545,6 +552,35 @@ DiskCache::DataBlob::setRawData(char* data, uint32_t dataLen)
   return retval;
 }
 
+bool
+DiskCache::DataBlob::setMappedData(const char* data,
+                                   uint32_t dataLen,
+                                   std::shared_ptr<const void> owner)
+{
+  unsigned char sha1_buf[SHA_DIGEST_LENGTH];
+
+  clear();
+  if (UNLIKELY((data == nullptr) || (dataLen < _headerSize) || (owner == nullptr)))
+  {
+    return false;
+  }
+
+  SHA1(reinterpret_cast<const unsigned char*>(&data[_headerSize]), dataLen - _headerSize, sha1_buf);
+  if (UNLIKELY(memcmp(reinterpret_cast<const BlobHeader*>(data)->sha1,
+                      sha1_buf,
+                      SHA_DIGEST_LENGTH) != 0))
+  {
+    return false;
+  }
+
+  // never written through; getRawData() callers only read
+  _dataBuffer = const_cast<char*>(data);
+  _owner = owner;
+  _dataBufferSize = dataLen;
+  _dataSize = _dataBufferSize - _headerSize;
+  return true;
+}
+
 char*
 DiskCache::DataBlob::getRawData(uint32_t* dataLen)
 {
@@ -909,6 +945,11 @@ DiskCache::CacheTypeOptions::dbRemove()
     retval = removeFile(dbFileName);
   }
 
+  DISKCACHE.removeMappedFile(name);
+  // dictionaries are trained from entries of any table, they are retrained
+  // at the next start
+  CompressionDictionaries::removeFiles(DISKCACHE._directory);
+
   return retval;
 }
 
@@ -1232,6 +1273,24 @@ DiskCache::DiskCache(tse::ConfigMan& config)
   // Data Store product.
   getConfigOption("USE_TXN_MODEL", _useTransactionModel, validateBoolean);
 
+  // MAPPED_FILES keeps a memory-mapped snapshot of each table next to its Berkeley DB file.
+  // The snapshot is written after a cache has been loaded from the DB file, and at the next
+  // start the cache is deserialized from the mapping instead of the DB file.
+  getConfigOption("MAPPED_FILES", _mappedFiles, validateBoolean);
+
+  // MAPPED_LAZY_TYPES lists (comma separated) the caches that are not deserialized from their
+  // snapshot at start; their objects are materialized from the mapping on first access.
+  // Not for caches that are iterated as a whole.
+  std::string mappedLazyTypes;
+  getConfigOption("MAPPED_LAZY_TYPES", mappedLazyTypes, validateNotEmpty);
+  boost::char_separator<char> typeSep(", ");
+  boost::tokenizer<boost::char_separator<char>> lazyTypes(mappedLazyTypes, typeSep);
+  for (std::string type : lazyTypes)
+  {
+    STR_TOUPPER(type);
+    _mappedLazyTypes.insert(type);
+  }
+
   // SHUTDOWN_DISKCACHE_BEFORE_ABORT shutdown the diskacache adapter before the abort call.
   bool shutdownDiskCacheBeforeAbort = false;
   getConfigOption("SHUTDOWN_DISKCACHE_BEFORE_ABORT", shutdownDiskCacheBeforeAbort, validateBoolean);
@@ -1743,6 +1802,281 @@ DiskCache::constructDBFileName(const std::string& cacheName, int version)
   return os.str();
 }
 
+std::string
+DiskCache::constructMappedFileName(const std::string& cacheName, int version)
+{
+  std::string dbFileName(constructDBFileName(cacheName, version));
+  if (!dbFileName.empty())
+  {
+    dbFileName.replace(dbFileName.size() - 3, 3, MAPPED_FILE_EXT);
+  }
+  return dbFileName;
+}
+
+bool
+DiskCache::mappedLazyLoad(const std::string& name) const
+{
+  std::string uc(name);
+  STR_TOUPPER(uc);
+  return _mappedFiles && (_mappedLazyTypes.count(uc) != 0);
+}
+
+// Caller holds _mappedMutex.  The snapshot of the table is mapped the first time the
+// table is asked for; a file that cannot be used is removed.
+DiskCache::MappedTable*
+DiskCache::mappedTable(const std::string& name)
+{
+  std::string uc(name);
+  STR_TOUPPER(uc);
+  std::map<std::string, MappedTable>::iterator it(_mappedTables.find(uc));
+  if (it != _mappedTables.end())
+  {
+    return &it->second;
+  }
+
+  CacheControl* ctrl = CacheRegistry::instance().getCacheControl(name);
+  if (ctrl == nullptr)
+  {
+    return nullptr;
+  }
+
+  MappedTable& table(_mappedTables[uc]);
+  table.version = ctrl->tableVersion();
+  table.path = _directory + "/" + constructMappedFileName(name, table.version);
+  if (access(table.path.c_str(), F_OK) == 0)
+  {
+    table.file = LDCMappedFile::open(table.path, table.version);
+    if ((table.file == nullptr) || !LDCMappedFile::readSuperseded(table.path, table.superseded))
+    {
+      LOG4CXX_WARN(getLogger(), "Removing unusable mapped file [" << table.path << "].");
+      table.file.reset();
+      table.superseded.clear();
+      removeFile(table.path);
+    }
+    else
+    {
+      LOG4CXX_INFO(getLogger(),
+                   "Mapped [" << table.file->size() << "] objects of cache [" << name << "] from ["
+                              << table.path << "], [" << table.superseded.size()
+                              << "] superseded.");
+    }
+  }
+  if (table.file == nullptr)
+  {
+    removeFile(LDCMappedFile::supersededPath(table.path));
+  }
+  return &table;
+}
+
+std::shared_ptr<const LDCMappedFile>
+DiskCache::getMappedFile(const std::string& name, STRINGSET& superseded)
+{
+  if (!_mappedFiles)
+  {
+    return nullptr;
+  }
+
+  boost::lock_guard<boost::mutex> g(_mappedMutex);
+  MappedTable* table(mappedTable(name));
+  if ((table == nullptr) || (table->file == nullptr))
+  {
+    return nullptr;
+  }
+  superseded = table->superseded;
+  return table->file;
+}
+
+bool
+DiskCache::readFromMappedFile(const std::string& name, const std::string& key, DataBlob* blob)
+{
+  std::shared_ptr<const LDCMappedFile> file;
+  {
+    boost::lock_guard<boost::mutex> g(_mappedMutex);
+    MappedTable* table(mappedTable(name));
+    if ((table == nullptr) || (table->file == nullptr) || (table->superseded.count(key) != 0))
+    {
+      return false;
+    }
+    file = table->file;
+  }
+
+  LDCMappedFile::Record record;
+  if (!file->find(key, record))
+  {
+    return false;
+  }
+
+  if (UNLIKELY(!blob->setMappedData(record.data, record.dataSize, file)))
+  {
+    LOG4CXX_ERROR(getLogger(),
+                  "Damaged object in mapped file of cache [" << name << "], key [" << key
+                                                             << "].");
+    removeMappedFile(name);
+    return false;
+  }
+
+  LOG4CXX_DEBUG(getLogger(),
+                "Read Object from mapped LDC Cache [" << name << "], Key [" << key << "].");
+  return true;
+}
+
+// Called before the key is written to (blob) or deleted from the DB file: from now on the key
+// is read from the DB file, and it is logged next to the snapshot so that a restart does not
+// read it from the mapping either.  Returns false if the blob is the one in the snapshot,
+// typically an object materialized from it, and need not be written at all.
+bool
+DiskCache::supersedeMapped(const std::string& name, const std::string& key, DataBlob* blob)
+{
+  boost::lock_guard<boost::mutex> g(_mappedMutex);
+  MappedTable* table(mappedTable(name));
+  if (table == nullptr)
+  {
+    return true;
+  }
+
+  if ((blob != nullptr) && (table->file != nullptr) && !table->writing &&
+      (table->superseded.count(key) == 0))
+  {
+    LDCMappedFile::Record record;
+    uint32_t dataLen(0);
+    blob->getRawData(&dataLen);
+    if (table->file->find(key, record) && (record.dataSize == dataLen) &&
+        (memcmp(reinterpret_cast<const DataBlob::BlobHeader*>(record.data)->sha1,
+                blob->getHeader()->sha1,
+                SHA_DIGEST_LENGTH) == 0))
+    {
+      return false;
+    }
+  }
+
+  if (table->writing)
+  {
+    table->pending.insert(key);
+  }
+
+  if ((table->file != nullptr) && table->superseded.insert(key).second &&
+      !LDCMappedFile::appendSuperseded(table->path, key))
+  {
+    LOG4CXX_WARN(getLogger(),
+                 "Removing mapped file [" << table->path << "], cannot log superseded key [" << key
+                                          << "].");
+    removeFile(table->path);
+    removeFile(LDCMappedFile::supersededPath(table->path));
+  }
+  return true;
+}
+
+bool
+DiskCache::writeMappedFile(const std::string& name)
+{
+  std::string path;
+  uint32_t version(0);
+  uint32_t generation(0);
+  {
+    boost::lock_guard<boost::mutex> g(_mappedMutex);
+    MappedTable* table(mappedTable(name));
+    if (!_mappedFiles || (table == nullptr) || table->writing)
+    {
+      return false;
+    }
+    table->writing = true;
+    table->pending.clear();
+    path = table->path;
+    version = table->version;
+    generation = table->generation;
+  }
+
+  Timer timer;
+  timer.reset();
+
+  LDCMappedFile::Writer writer(path, version);
+  DBC* dbCur(nullptr);
+  DBRead dbrc(DBREAD_SUCCESS);
+  bool retval(true);
+  while (retval && !shuttingDown())
+  {
+    DataBlob blob;
+    std::string key;
+    dbrc = readNextFromDB(&dbCur, name, key, &blob);
+    if (dbrc != DBREAD_SUCCESS)
+    {
+      break;
+    }
+    uint32_t dataLen(0);
+    const char* data(blob.getRawData(&dataLen));
+    retval = writer.add(key, data, dataLen);
+  }
+
+  if (dbCur != nullptr)
+  {
+    dbCur->close(dbCur);
+  }
+  retval = retval && (dbrc == DBREAD_DONE);
+
+  boost::lock_guard<boost::mutex> g(_mappedMutex);
+  MappedTable* table(mappedTable(name));
+  table->writing = false;
+  if (retval && (table->generation == generation))
+  {
+    // While the new snapshot replaces the old one the log covers both of them; it is cut
+    // down to the keys written during the copy once the new snapshot is in place.
+    STRINGSET both(table->superseded);
+    both.insert(table->pending.begin(), table->pending.end());
+    retval = LDCMappedFile::writeSuperseded(path, both) && writer.commit();
+    if (retval)
+    {
+      LDCMappedFile::writeSuperseded(path, table->pending);
+    }
+  }
+  else
+  {
+    retval = false;
+  }
+  if (!retval)
+  {
+    LOG4CXX_WARN(getLogger(), "Mapped file for cache [" << name << "] not written.");
+    return false;
+  }
+
+  table->file = LDCMappedFile::open(path, version);
+  table->superseded.swap(table->pending);
+  table->pending.clear();
+  if (table->file == nullptr)
+  {
+    table->superseded.clear();
+    removeFile(path);
+    removeFile(LDCMappedFile::supersededPath(path));
+  }
+
+  timer.checkpoint();
+  LOG4CXX_INFO(getLogger(),
+               "Wrote [" << writer.size() << "] objects of cache [" << name << "] to mapped file ["
+                         << path << "] in " << timer.elapsed() << "ms.");
+  return (table->file != nullptr);
+}
+
+void
+DiskCache::removeMappedFile(const std::string& name)
+{
+  if (!_mappedFiles)
+  {
+    return;
+  }
+
+  boost::lock_guard<boost::mutex> g(_mappedMutex);
+  MappedTable* table(mappedTable(name));
+  if (table != nullptr)
+  {
+    // objects already read keep their own reference to the mapping
+    table->file.reset();
+    table->superseded.clear();
+    table->pending.clear();
+    ++table->generation;
+    removeFile(table->path);
+    removeFile(LDCMappedFile::supersededPath(table->path));
+  }
+}
+
 DB_ENV*
 DiskCache::createDBEnvironment(u_int32_t openFlags, const char* mode)
 {
@@ -2013,6 +2347,12 @@ DiskCache::writeToDB(const std::string& name, const std::string& key, DataBlob&
     _activeIO.fetch_add(1, std::memory_order_release);
   }
 
+  if (_mappedFiles && !supersedeMapped(name, key, &blob))
+  {
+    _activeIO.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
   bool retval(true);
   std::string reason;
   DBT dbKey;
@@ -2083,6 +2423,11 @@ DiskCache::readFromDB(const std::string& name, std::string& key, DataBlob* blob)
     return DBREAD_FAILURE;
   }
 
+  if (_mappedFiles && readFromMappedFile(name, key, blob))
+  {
+    return DBREAD_SUCCESS;
+  }
+
   {
     boost::lock_guard<boost::mutex> g(_mutex);
     if (!isActivated())
@@ -2260,6 +2605,11 @@ DiskCache::deleteFromDB(const std::string& name, const std::string& key)
     _activeIO.fetch_add(1, std::memory_order_release);
   }
 
+  if (_mappedFiles)
+  {
+    supersedeMapped(name, key, nullptr);
+  }
+
   bool retval(true);
   std::string reason;
 
@@ -2320,6 +2670,8 @@ DiskCache::truncateDB(const std::string& name)
     _activeIO.fetch_add(1, std::memory_order_release);
   }
 
+  removeMappedFile(name);
+
   bool retval(true);
   int ret(0);
   uint32_t numDeleted(0);
@@ -2456,6 +2808,11 @@ DiskCache::removeObsoleteTableVersions()
         file += '/';
         file.append(thisDbName);
 
+        std::string mappedFile(file);
+        mappedFile.replace(mappedFile.size() - 3, 3, MAPPED_FILE_EXT);
+        removeFile(mappedFile);
+        removeFile(LDCMappedFile::supersededPath(mappedFile));
+
         PROTECT_DBENV
         if (_dbEnv != nullptr)
         {
@@ -22,6 +22,8 @@
 #include <utime.h>
 
 #include <atomic>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <sstream>
@@ -37,6 +39,7 @@ namespace tse
 static const char* DISKCACHE_ALL = "";
 static const long DISKCACHE_ALL_VERSIONS = -1;
 
+class LDCMappedFile;
 class Logger;
 
 class DiskCache
@@ -159,6 +162,9 @@ public:
     DiskCache::DataFormat getData(char*& buffer, size_t& size, char*& bufferToDelete);
 
     bool setRawData(char* data, uint32_t dataLen);
+    // Uses the data in place instead of copying it; owner keeps it alive
+    // as long as the blob refers to it.
+    bool setMappedData(const char* data, uint32_t dataLen, std::shared_ptr<const void> owner);
     char* getRawData(uint32_t* dataLen);
     BlobHeader* getHeader() { return reinterpret_cast<BlobHeader*>(_dataBuffer); }
 
@@ -167,6 +173,7 @@ public:
 #define UNCOMPRESSED '0'
 
     char* _dataBuffer = nullptr;
+    std::shared_ptr<const void> _owner;
     uint32_t _dataBufferSize = 0;
     uint32_t _dataSize = 0;
     uint32_t _headerSize = sizeof(BlobHeader);
@@ -315,6 +322,7 @@ public:
               const std::string& flatKey = DISKCACHE_ALL);
 
   std::string constructDBFileName(const std::string& cacheName, int version = -1);
+  std::string constructMappedFileName(const std::string& cacheName, int version = -1);
   DateTime getLastUpdateTime();
   void updateLastUpdateTime();
 
@@ -346,6 +354,17 @@ public:
   uint32_t getKeys(const std::string& name, STRINGSET& list, bool withDates = false);
   uint32_t readKeys(const std::string& name);
 
+  // Memory-mapped snapshots of the tables (see LDCMappedFile.h).  Keys
+  // written to or deleted from the Berkeley DB table after the snapshot was
+  // taken are superseded: they are read from the table, not the mapping.
+  bool mappedFiles() const { return _mappedFiles; }
+  bool mappedLazyLoad(const std::string& name) const;
+  std::shared_ptr<const LDCMappedFile>
+  getMappedFile(const std::string& name, STRINGSET& superseded);
+  bool readFromMappedFile(const std::string& name, const std::string& key, DataBlob* blob);
+  bool writeMappedFile(const std::string& name);
+  void removeMappedFile(const std::string& name);
+
   bool doVerifyNextCycle();
 
   const std::string& directory() const { return _directory; }
@@ -396,6 +415,25 @@ private:
 
   CACHE_TYPE_CTRL _cacheCtrl;
 
+  struct MappedTable
+  {
+    std::string path;
+    uint32_t version = 0;
+    std::shared_ptr<const LDCMappedFile> file;
+    STRINGSET superseded;
+    STRINGSET pending;
+    bool writing = false;
+    uint32_t generation = 0;
+  };
+
+  bool _mappedFiles = false;
+  STRINGSET _mappedLazyTypes;
+  std::map<std::string, MappedTable> _mappedTables;
+  boost::mutex _mappedMutex;
+
+  MappedTable* mappedTable(const std::string& name);
+  bool supersedeMapped(const std::string& name, const std::string& key, DataBlob* blob);
+
   bool _shuttingDown = false;
 
   bool _distCacheEventMaster;
@@ -3,18 +3,29 @@
 #include "Allocator/TrxMalloc.h"
 #include "Common/Hasher.h"
 #include "Common/KeyedFactory.h"
+#include "Common/Thread/RCUPtr.h"
 #include "Common/Thread/TSELockGuards.h"
 #include "Common/Thread/TSEReadWriteLock.h"
 #include "DBAccess/Cache.h"
 
-#include <list>
-#include <set>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
 #include <stdexcept>
+#include <vector>
 
 #include <tr1/unordered_map>
 
 namespace sfc
 {
+// Cache made of two maps:
+//  - the "read" map is an immutable snapshot published through an RCUPtr.
+//    Readers look it up without any lock; updates (put/invalidate/clear and
+//    consolidate) publish a modified copy and free the old one after a grace
+//    period.
+//  - the "read/write" map holds objects loaded since the last consolidation
+//    and is protected by a read/write lock.
+// consolidate() moves objects from the read/write map into a new snapshot.
 template <typename Key, typename Type>
 class DualMapCache : public Cache<Key, Type>
 {
@@ -29,19 +40,17 @@ private:
     }
   };
   typedef typename Cache<Key, Type>::pointer_type PointerType;
-  typedef std::set<Key> Set;
-  typedef typename Set::iterator SetIterator;
   typedef std::tr1::unordered_map<Key, PointerType, hash_func> Map;
   typedef typename Map::iterator MapIterator;
+  typedef typename Map::const_iterator MapConstIterator;
 
-  Map _readMap;
+  tse::RCUPtr<Map> _readMap;
   Map _readWriteMap;
   TSEReadWriteLock _mutex;
+  // serializes all updates, both of the snapshot and of the read/write map
+  boost::mutex _publishMutex;
   PointerType _initializingCacheEntry;
-  PointerType _flushedCacheEntry;
   size_t _capacity; // not used
-  bool _mustClear;
-  Set _deleteList;
 
 protected:
   struct deleter
@@ -63,8 +72,8 @@ private:
   // is generated.
   struct mapValueSetter
   {
-    mapValueSetter(DualMapCache<Key, Type>& cache, bool setReadWriteMap, const Key& key)
-      : _cache(cache), _key(key), _setReadWriteMap(setReadWriteMap), _valueSet(false)
+    mapValueSetter(DualMapCache<Key, Type>& cache, const Key& key)
+      : _cache(cache), _key(key), _valueSet(false)
     {
     }
 
@@ -73,28 +82,14 @@ private:
       if (!_valueSet)
       {
         TSEWriteGuard<> l(_cache._mutex);
-        if (_setReadWriteMap)
-        {
-          _cache._readWriteMap.erase(_key);
-        }
-        else
-        {
-          _cache._readMap[_key] = _cache._flushedCacheEntry;
-        }
+        _cache._readWriteMap.erase(_key);
       }
     }
 
     void setValue(const PointerType& value)
     {
       TSEWriteGuard<> l(_cache._mutex);
-      if (_setReadWriteMap)
-      {
-        _cache._readWriteMap[_key] = value;
-      }
-      else
-      {
-        _cache._readMap[_key] = value;
-      }
+      _cache._readWriteMap[_key] = value;
       _cache.queueDiskPut(_key, true);
       _valueSet = true;
     }
@@ -102,43 +97,56 @@ private:
   private:
     DualMapCache<Key, Type>& _cache;
     const Key& _key;
-    bool _setReadWriteMap;
     bool _valueSet;
   };
 
+  bool findInReadMap(const Key& key, PointerType& value) const
+  {
+    typename tse::RCUPtr<Map>::ReadGuard readMap(_readMap);
+    const MapConstIterator it = readMap->find(key);
+    if (it == readMap->end())
+    {
+      return false;
+    }
+    value = it->second;
+    return true;
+  }
+
+  bool inReadMap(const Key& key) const
+  {
+    const Map& readMap(*_readMap.unsafeGet());
+    return readMap.find(key) != readMap.end();
+  }
+
 public:
   DualMapCache(KeyedFactory<Key, Type>& factory,
                const std::string& name,
                size_t capacity,
                size_t version)
     : Cache<Key, Type>(factory, "SimpleDualMapCache", name, version),
-      _capacity(capacity),
-      _mustClear(false)
+      _readMap(new Map),
+      _capacity(capacity)
   {
     PointerType initializingPtr(new Type);
-    PointerType flushedPtr(new Type);
-
     _initializingCacheEntry = initializingPtr;
-    _flushedCacheEntry = flushedPtr;
   }
 
   virtual ~DualMapCache() {}
 
   size_t size() override
   {
-    // There should be no lock necessary for fetching this number.
-    // The copy is an atomic operation.
-    // TSEReadGuard<> l(_mutex);
-
-    return _readMap.size() + _readWriteMap.size();
+    size_t result(0);
+    {
+      typename tse::RCUPtr<Map>::ReadGuard readMap(_readMap);
+      result = readMap->size();
+    }
+    TSEReadGuard<> l(_mutex);
+    return result + _readWriteMap.size();
   }
 
   size_t consolidationSize() override
   {
-    // There should be no lock necessary for fetching this number.
-    // The copy is an atomic operation.
-    // TSEReadGuard<> l(_mutex);
-
+    TSEReadGuard<> l(_mutex);
     return _readWriteMap.size();
   }
 
@@ -154,175 +162,92 @@ public:
   PointerType getIfResident(const Key& key) override
   {
     // Check the "quick access" map first
-    MapIterator mapIter = _readMap.find(key);
-    if (mapIter != _readMap.end())
+    PointerType value;
+    if (findInReadMap(key, value))
     {
-      if ((mapIter->second != _initializingCacheEntry) && (mapIter->second != _flushedCacheEntry))
-      {
-        return mapIter->second;
-      }
-      else
-      {
-        return PointerType();
-      }
+      return value;
     }
-    else
+
+    // IF it wasn't found there, check the "updatable" map
+    TSEReadGuard<> l(_mutex);
+    MapConstIterator mapIter = _readWriteMap.find(key);
+    if (mapIter != _readWriteMap.end() && mapIter->second != _initializingCacheEntry)
     {
-      // IF it wasn't found there, check the "updatable" map
-      TSEReadGuard<> l(_mutex);
-      mapIter = _readWriteMap.find(key);
-      if (mapIter != _readWriteMap.end() && mapIter->second != _initializingCacheEntry)
-      {
-        return mapIter->second;
-      }
-      else
-      {
-        return PointerType();
-      }
+      return mapIter->second;
     }
+    return PointerType();
   }
+
   void emptyTrash() override {}
 
   PointerType get(const Key& key) override
   {
     // Check the "quick access" map first
-    MapIterator j = _readMap.find(key);
-
-    // IF there is an entry in the "quick access" map
-    if (j != _readMap.end())
+    PointerType value;
+    if (LIKELY(findInReadMap(key, value)))
     {
-      // IF it is a valid entry  -> return it
-
-      if ((j->second != _initializingCacheEntry) && (j->second != _flushedCacheEntry))
-      {
-        return j->second;
-      }
-      else
-      {
-
-        TSEReadGuard<> l(_mutex);
+      return value;
+    }
 
-        // An entry exists in the "quick access" map for this object.
-        // This means that either it was present and is no longer or
-        // it is in the process of being loaded by another thread.
+    // IF it wasn't found there, check the "updatable" map
 
-        // Set the flag to indicate if it is being loaded by another thread
+    MallocContextDisabler mallocController(false);
 
-        bool usePreExisting = (j->second != _flushedCacheEntry);
+    // see if the item is in the cache already, locking the container
+    // while we perform the lookup
+    {
+      TSEReadGuard<> l(_mutex);
+      MapIterator j = _readWriteMap.find(key);
+      if (j != _readWriteMap.end())
+      {
+        bool usePreExisting = true;
 
-        // LOOP until either the item has been loaded by another thread or
-        //      it has been flushed from the cache.  (The "end()" test is really
-        //      not needed here since entries are not ever removed from this map.
-        //      They are merely flagged as "flushed".)
-        while (j != _readMap.end() && j->second == _initializingCacheEntry && usePreExisting)
+        while (j != _readWriteMap.end() && j->second == _initializingCacheEntry && usePreExisting)
         {
-          // Delay to give the other thread time to load the object
-
           l.release();
           usleep(10);
           l.acquire();
 
-          // FETCH the intry for the object from the map
-          j = _readMap.find(key);
-
-          // IF it is now flagged as having been flushed
-          if (j == _readMap.end())
-          {
-          }
-          else if (j->second == _flushedCacheEntry)
+          j = _readWriteMap.find(key);
+          if (j == _readWriteMap.end())
           {
-            // Ensure solo updatge access to the map
-            l.release();
-            TSEWriteGuard<> lw(_mutex);
+            mallocController.activate();
+            usePreExisting = false;
 
-            // IF the object is still flagged as flushed (no other thread is
-            //    creating it)
-
-            j = _readMap.find(key);
-            if (j->second == _flushedCacheEntry)
+            l.release();
             {
-              // ASSUME responsibility for creating the object
-              usePreExisting = false;
-
-              _readMap[key] = _initializingCacheEntry;
+              TSEWriteGuard<> lw(_mutex);
+              _readWriteMap[key] = _initializingCacheEntry;
             }
+            l.acquire();
           }
         }
-
         // the item is present, return it
         if (usePreExisting)
-        {
           return j->second;
-        }
-        else
-        {
-          // the item is not present already.
-          // Perform the expensive operation of constructing the object
-
-          MallocContextDisabler mallocController;
-
-          mapValueSetter valueSetter(*this, false, key);
-          const PointerType ret(Cache<Key, Type>::_factory.create(key));
-          valueSetter.setValue(ret);
-          return ret;
-        }
       }
-    }
-    else
-    {
-      // IF it wasn't found there, check the "updatable" map
-
-      MallocContextDisabler mallocController(false);
-
-      // see if the item is in the cache already, locking the container
-      // while we perform the lookup
+      else
       {
-        TSEReadGuard<> l(_mutex);
-        j = _readWriteMap.find(key);
-        if (j != _readWriteMap.end())
-        {
-          bool usePreExisting = true;
+        mallocController.activate();
 
-          while (j != _readWriteMap.end() && j->second == _initializingCacheEntry && usePreExisting)
-          {
-            l.release();
-            usleep(10);
-            l.acquire();
-
-            j = _readWriteMap.find(key);
-            if (j == _readWriteMap.end())
-            {
-              mallocController.activate();
-              usePreExisting = false;
-
-              TSEWriteGuard<> l(_mutex);
-              _readWriteMap[key] = _initializingCacheEntry;
-            }
-          }
-          // the item is present, return it
-          if (usePreExisting)
-            return j->second;
-        }
-        else
+        l.release();
         {
-          mallocController.activate();
-
-          l.release();
           TSEWriteGuard<> lw(_mutex);
           _readWriteMap[key] = _initializingCacheEntry;
         }
+        l.acquire();
       }
+    }
 
-      mallocController.activate();
+    mallocController.activate();
 
-      // the item is not present already.
-      // unlock the container, while we perform the expensive
-      // operation of constructing the object
-      mapValueSetter valueSetter(*this, true, key);
-      const PointerType ret(Cache<Key, Type>::_factory.create(key));
-      valueSetter.setValue(ret);
-      return ret;
-    }
+    // the item is not present already.
+    // unlock the container, while we perform the expensive
+    // operation of constructing the object
+    mapValueSetter valueSetter(*this, key);
+    const PointerType ret(Cache<Key, Type>::_factory.create(key));
+    valueSetter.setValue(ret);
+    return ret;
   }
 
   void put(const Key& key, Type* object, bool updateLDC = true) override
@@ -332,29 +257,22 @@ public:
 
   virtual void put(const Key& key, PointerType object, bool updateLDC = true)
   {
-    // IF an object for this key is in the "readOnly map"
-    MapIterator j = _readMap.find(key);
-    if (j != _readMap.end())
+    MallocContextDisabler mallocController;
+    boost::lock_guard<boost::mutex> g(_publishMutex);
+
+    // IF an object for this key is in the "read only" map
+    if (inReadMap(key))
     {
-      // Replace it
-      _readMap[key] = object;
+      // Publish a copy with the object replaced
+      Map* next(new Map(*_readMap.unsafeGet()));
+      (*next)[key] = object;
+      _readMap.publish(next);
     }
-    else // ELSE (Not present in the "ReadOnly map")
+    else
     {
       // Add the object to the "updateable map", or replace the entry for the key if present
-      // (There should be a check here for the "uninitialized entry to fire trigger)
-
-      j = _readWriteMap.find(key);
-      if (j != _readWriteMap.end())
-      {
-        _readWriteMap[key] = object;
-      }
-      else
-      {
-        // Add the object to the "updateable map", or replace the entry for the key if present
-        TSEWriteGuard<> l(_mutex);
-        _readWriteMap[key] = object;
-      }
+      TSEWriteGuard<> l(_mutex);
+      _readWriteMap[key] = object;
     }
 
     if (updateLDC)
@@ -369,23 +287,20 @@ public:
     bool ldcOp(true), distCacheOp(true);
     this->queueDiskInvalidate(key, distCacheOp, ldcOp);
 
-    // IF the key is present in the "read only" map.
-    MapIterator readMapIter = _readMap.find(key);
-    if (readMapIter != _readMap.end())
-    {
-      // Flag it as invalid
-      _readMap[key] = _flushedCacheEntry;
+    MallocContextDisabler mallocController;
+    boost::lock_guard<boost::mutex> g(_publishMutex);
 
-      TSEWriteGuard<> l(_mutex);
-      result += 1;
-      _deleteList.insert(key);
-    }
-    else
+    // IF the key is present in the "read only" map, publish a copy without it
+    if (inReadMap(key))
     {
-      // Remove the key from the "updatable map" if present
-      TSEWriteGuard<> l(_mutex);
-      _readWriteMap.erase(key);
+      Map* next(new Map(*_readMap.unsafeGet()));
+      result += next->erase(key);
+      _readMap.publish(next);
     }
+
+    // Remove the key from the "updatable map" if present
+    TSEWriteGuard<> l(_mutex);
+    result += _readWriteMap.erase(key);
     return result;
   }
 
@@ -393,14 +308,14 @@ public:
   {
     const std::shared_ptr<std::vector<Key>> allKeys(new std::vector<Key>);
 
-    allKeys->reserve(_readMap.size() + _readWriteMap.size());
-
     // Get the keys from the "read only" map
-    for (auto& elem : _readMap)
     {
-      // Don't include the key if the object was removed from the cache
-      if (elem.second != _initializingCacheEntry && elem.second != _flushedCacheEntry)
+      typename tse::RCUPtr<Map>::ReadGuard readMap(_readMap);
+      allKeys->reserve(readMap->size());
+      for (const auto& elem : *readMap)
+      {
         allKeys->push_back(elem.first);
+      }
     }
 
     // Add any keys that are in the "updatable map"
@@ -416,24 +331,15 @@ public:
 
   size_t clear() override
   {
-    size_t result(0);
-    // Flag the "readOnly map" entries as invalid
-    // (Can't actually clear it because there is no locking for this map)
-    for (auto& elem : _readMap)
-    {
-      // Don't include the key if the object is in the process of being created
-      // if (j->second != _initializingCacheEntry && j->second != _flushedCacheEntry)
-      {
-        _readMap[elem.first] = _flushedCacheEntry;
+    MallocContextDisabler mallocController;
+    boost::lock_guard<boost::mutex> g(_publishMutex);
 
-        TSEWriteGuard<> l(_mutex);
-        _deleteList.insert(elem.first);
-      }
-    }
+    size_t result(_readMap.unsafeGet()->size());
+    _readMap.publish(new Map);
 
     // Delete all entries from the updatable map
     TSEWriteGuard<> l(_mutex);
-    result = _readWriteMap.size();
+    result += _readWriteMap.size();
     _readWriteMap.clear();
 
     this->queueDiskClear();
@@ -442,41 +348,44 @@ public:
 
   size_t consolidate(size_t maxRecordsToConsolidate) override
   {
-    size_t numMoved = 0;
-
-    // Ensure there is no contention during the updates
-    TSEWriteGuard<> l(_mutex);
+    MallocContextDisabler mallocController;
+    boost::lock_guard<boost::mutex> g(_publishMutex);
 
-    // FOR EACH item in the "delete list"
-    for (const auto& elem : _deleteList)
+    Map* next(new Map(*_readMap.unsafeGet()));
+    std::vector<Key> moved;
     {
-      // IF it has not been replaced in the map
-      MapIterator j = _readMap.find(elem);
-      if (j != _readMap.end() && (j->second == _flushedCacheEntry))
+      TSEReadGuard<> l(_mutex);
+      // FOR EACH item in the "updatable map" which is not being created
+      for (MapConstIterator j = _readWriteMap.begin();
+           j != _readWriteMap.end() && moved.size() < maxRecordsToConsolidate;
+           ++j)
       {
-        //  Remove it from the "read only" map
-        _readMap.erase(elem);
+        if (j->second != _initializingCacheEntry)
+        {
+          (*next)[j->first] = j->second;
+          moved.push_back(j->first);
+        }
       }
     }
 
-    // Clear the "delete list"
-    _deleteList.clear();
+    // Readers find the moved objects in the new snapshot from now on
+    _readMap.publish(next);
 
-    // FOR EACH item in the "updatable map"
-    for (MapIterator j = _readWriteMap.begin();
-         (j != _readWriteMap.end()) && (numMoved < maxRecordsToConsolidate);
-         j++, numMoved++)
+    // Remove the moved entries from the "updatable map", unless they were
+    // replaced by a reload in the meantime
+    TSEWriteGuard<> l(_mutex);
+    const Map& readMap(*_readMap.unsafeGet());
+    for (const Key& key : moved)
     {
-      //     Insert it into the "read only" map
-      _readMap[j->first] = j->second;
+      MapIterator j = _readWriteMap.find(key);
+      if (j != _readWriteMap.end() && j->second == readMap.find(key)->second)
+      {
+        _readWriteMap.erase(j);
+      }
     }
 
-    // Remove all entries from the "updatabale map"
-    _readWriteMap.clear();
-
-    return numMoved;
+    return moved.size();
   }
 };
 
 } // namespace sfc
-
@@ -343,6 +343,66 @@ FareDAO::create(FareKey key)
   return ret;
 }
 
+bool
+FareDAO::batchGroup(const FareKey& key, FareKey& group) const
+{
+  group = FareKey(key._a, key._b);
+  return true;
+}
+
+void
+FareDAO::createBatch(const std::vector<FareKey>& keys,
+                     std::vector<std::vector<const FareInfo*>*>& results)
+{
+  std::vector<CarrierCode> carriers;
+  carriers.reserve(keys.size());
+  for (const FareKey& key : keys)
+  {
+    carriers.push_back(key._c);
+  }
+
+  std::vector<const FareInfo*> fareInfo;
+
+  DBAdapterPool& dbAdapterPool = DBAdapterPool::instance();
+  DBAdapterPool::pointer_type dbAdapter = dbAdapterPool.get(this->cacheClass());
+  try
+  {
+    QueryGetDomFares df(dbAdapter->getAdapter());
+    df.findFares(fareInfo, keys.front()._a, keys.front()._b, carriers);
+  }
+  catch (...)
+  {
+    LOG4CXX_WARN(_logger, "DB exception in FareDAO::createBatch");
+    for (const FareInfo* info : fareInfo)
+    {
+      delete info;
+    }
+    throw;
+  }
+
+  // an empty list for carriers without fares, so they are not queried again
+  results.clear();
+  results.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i)
+  {
+    results.push_back(new std::vector<const FareInfo*>);
+  }
+
+  for (const FareInfo* info : fareInfo)
+  {
+    std::vector<CarrierCode>::const_iterator it(
+        std::find(carriers.begin(), carriers.end(), info->_carrier));
+    if (it != carriers.end())
+    {
+      results[it - carriers.begin()]->push_back(info);
+    }
+    else
+    {
+      delete info;
+    }
+  }
+}
+
 void
 FareDAO::destroy(FareKey key, std::vector<const FareInfo*>* recs)
 {
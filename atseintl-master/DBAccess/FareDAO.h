@@ -97,6 +97,12 @@ protected:
 
   std::vector<const FareInfo*>* create(FareKey key) override;
 
+  // misses of the carriers of one market are loaded with one query
+  bool batchGroup(const FareKey& key, FareKey& group) const override;
+
+  void createBatch(const std::vector<FareKey>& keys,
+                   std::vector<std::vector<const FareInfo*>*>& results) override;
+
   void destroy(FareKey key, std::vector<const FareInfo*>* t) override;
 
   virtual void load() override;
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sfc
+{
+// Approximate access frequency of cache keys (TinyLFU, Einziger et al.):
+// a count-min sketch of 4-bit counters, four per key, packed sixteen to a
+// 64-bit word. After 10 * capacity increments all counters are halved, so
+// the estimate follows the recent popularity of a key rather than its
+// lifetime total. Not thread safe; callers serialize access.
+class FrequencySketch
+{
+public:
+  explicit FrequencySketch(size_t capacity = 0) : _sampleSize(0), _additions(0)
+  {
+    resize(capacity);
+  }
+
+  void resize(size_t capacity)
+  {
+    size_t words(1);
+    while (words * 4 < capacity && words < (size_t(1) << 26))
+    {
+      words <<= 1;
+    }
+    _table.assign(words, 0);
+    _sampleSize = 10 * (capacity > 0 ? capacity : 1);
+    _additions = 0;
+  }
+
+  unsigned frequency(size_t hash) const
+  {
+    const uint64_t h(spread(hash));
+    unsigned frequency(MAX_COUNT);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+      const unsigned count(
+          static_cast<unsigned>((_table[index(h, i)] >> offset(h, i)) & MAX_COUNT));
+      if (count < frequency)
+      {
+        frequency = count;
+      }
+    }
+    return frequency;
+  }
+
+  void increment(size_t hash)
+  {
+    const uint64_t h(spread(hash));
+    bool added(false);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+      uint64_t& word(_table[index(h, i)]);
+      const unsigned shift(offset(h, i));
+      if (((word >> shift) & MAX_COUNT) != MAX_COUNT)
+      {
+        word += uint64_t(1) << shift;
+        added = true;
+      }
+    }
+    if (added && ++_additions >= _sampleSize)
+    {
+      reset();
+    }
+  }
+
+  void clear()
+  {
+    _table.assign(_table.size(), 0);
+    _additions = 0;
+  }
+
+private:
+  static const uint64_t MAX_COUNT = 15;
+
+  static uint64_t spread(uint64_t h)
+  {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  // each of the four counters of a key lives in its own word
+  size_t index(uint64_t h, unsigned i) const
+  {
+    return static_cast<size_t>((h >> (16 * i)) * (2 * i + 1) + i) & (_table.size() - 1);
+  }
+
+  static unsigned offset(uint64_t h, unsigned i) { return ((h >> (8 * i + 4)) & 15) << 2; }
+
+  // halves every counter; 0x7777... drops the bit shifted in from the
+  // neighbouring counter
+  void reset()
+  {
+    for (uint64_t& word : _table)
+    {
+      word = (word >> 1) & 0x7777777777777777ULL;
+    }
+    _additions /= 2;
+  }
+
+  std::vector<uint64_t> _table;
+  size_t _sampleSize;
+  size_t _additions;
+};
+} // sfc
@@ -25,6 +25,7 @@
 #include "DBAccess/FareCalcConfigText.h"
 #include "DBAccess/Flattenizable.h"
 #include "DBAccess/HashKey.h"
+#include "DBAccess/LDCMappedFile.h"
 #include "DBAccess/LDCOperationCounts.h"
 #include "Util/Time.h"
 
@@ -110,6 +111,7 @@ private:
   LDCHelper& operator=(const LDCHelper& other);
 
   DiskCache::CacheTypeOptions* _cto;
+  bool _lazyLoad = false;
   bool _loadmaster;
   bool _eventmaster;
   const CachePtr _uninitializedCacheEntry;
@@ -478,6 +480,7 @@ public:
     size_t maxAllowed(DISKCACHE.getMaxActiveDeserializeTasks());
     const auto readSleepTime = std::chrono::duration_cast<Time::Duration>(
         std::chrono::milliseconds(DISKCACHE.getDeserializeSleepMillis()));
+    DiskCache::STRINGSET superseded;
 
     if (dao().ldcEnabled() && (!DISKCACHE.bdbDisabled()))
     {
@@ -485,6 +488,11 @@ public:
       {
         LOG4CXX_DEBUG(getLogger(), "LDC is too old for cache [" << name() << "].");
       }
+      else if (std::shared_ptr<const LDCMappedFile> mapped =
+                   DISKCACHE.getMappedFile(name(), superseded))
+      {
+        numCreated = loadFromMappedFile(mapped, superseded);
+      }
       else
       {
         TseScopedExecutor executor(TseThreadingConst::LDC_TASK, DISKCACHE.getSerializeQueueThreadMax());
@@ -555,6 +563,11 @@ public:
                             << name() << "]"
                             << " in " << readTimer.elapsed() << "ms (elapsed)"
                             << " and " << readTimer.cpu() << "ms (cpu).");
+
+          if (DISKCACHE.mappedFiles() && (numCreated > 0))
+          {
+            DISKCACHE.writeMappedFile(name());
+          }
         }
         else
         {
@@ -576,6 +589,129 @@ public:
     return (numCreated > 0);
   }
 
+  // Deserializes the snapshot in place, or only notes it for lazyLoad()
+  // when the cache is configured to be materialized on access. Superseded
+  // keys are read from the Berkeley DB table instead.
+  size_t loadFromMappedFile(const std::shared_ptr<const LDCMappedFile>& mapped,
+                            const DiskCache::STRINGSET& superseded)
+  {
+    if (DISKCACHE.mappedLazyLoad(name()))
+    {
+      _lazyLoad = true;
+      LOG4CXX_DEBUG(getLogger(),
+                    "Mapped [" << mapped->size() << "] objects for cache [" << name()
+                               << "], materialized on access.");
+      return mapped->size();
+    }
+
+    size_t numCreated(0);
+    size_t maxAllowed(DISKCACHE.getMaxActiveDeserializeTasks());
+    const auto readSleepTime = std::chrono::duration_cast<Time::Duration>(
+        std::chrono::milliseconds(DISKCACHE.getDeserializeSleepMillis()));
+    TseScopedExecutor executor(TseThreadingConst::LDC_TASK, DISKCACHE.getSerializeQueueThreadMax());
+    std::vector<DeserializeTask*> tasks;
+    DiskCache::Timer readTimer;
+
+    readTimer.reset();
+
+    for (size_t i = 0; (i < mapped->size()) && (!DISKCACHE.shuttingDown()); ++i)
+    {
+      if (UNLIKELY(maxAllowed && ((i - numCreated) > maxAllowed)))
+      {
+        Time::sleepFor(readSleepTime);
+      }
+
+      const LDCMappedFile::Record record(mapped->record(i));
+      DiskCache::DataBlob* blob = new DiskCache::DataBlob();
+      if (UNLIKELY((record.key == nullptr) ||
+                   !blob->setMappedData(record.data, record.dataSize, mapped)))
+      {
+        delete blob;
+        LOG4CXX_ERROR(getLogger(),
+                      "LDC load failure for [" << name() << "] !!! - DAMAGED MAPPED FILE");
+        executor.cancel();
+        break;
+      }
+
+      std::string flatKey(record.key, record.keySize);
+      if (superseded.count(flatKey) != 0)
+      {
+        delete blob;
+        continue;
+      }
+
+      DeserializeTask* dt = new DeserializeTask(*this, blob, flatKey, numCreated);
+      executor.execute(dt);
+      tasks.push_back(dt);
+    }
+
+    for (DiskCache::STRINGSET::const_iterator it = superseded.begin();
+         (it != superseded.end()) && !executor.isCanceled() && (!DISKCACHE.shuttingDown());
+         ++it)
+    {
+      std::string flatKey(*it);
+      DiskCache::DataBlob* blob = new DiskCache::DataBlob();
+      if (DISKCACHE.readFromDB(name(), flatKey, blob) != DiskCache::DBREAD_SUCCESS)
+      {
+        // deleted since the snapshot was taken
+        delete blob;
+        continue;
+      }
+
+      DeserializeTask* dt = new DeserializeTask(*this, blob, flatKey, numCreated);
+      executor.execute(dt);
+      tasks.push_back(dt);
+    }
+
+    executor.wait();
+
+    for (auto& task : tasks)
+    {
+      delete task;
+    }
+
+    readTimer.checkpoint();
+
+    if (executor.isCanceled())
+    {
+      LOG4CXX_INFO(getLogger(), "Clearing out any items loaded in cache for [" << name() << "].");
+      dao().clear();
+      DISKCACHE.removeMappedFile(name());
+      return 0;
+    }
+
+    LOG4CXX_DEBUG(getLogger(),
+                  "Completed load from mapped LDC for ["
+                      << name() << "]"
+                      << " in " << readTimer.elapsed() << "ms (elapsed)"
+                      << " and " << readTimer.cpu() << "ms (cpu).");
+
+    // refresh the snapshot once a quarter of it is read from the table
+    if (superseded.size() * 4 > mapped->size())
+    {
+      DISKCACHE.writeMappedFile(name());
+    }
+    return numCreated;
+  }
+
+  bool lazyLoad() const { return _lazyLoad; }
+
+  // Object of a cache loaded lazily, materialized from its snapshot, or
+  // from the Berkeley DB table for superseded keys; nullptr if neither has
+  // the key.
+  T* getFromMappedFile(const Key& key)
+  {
+    KeyStream stream(0);
+    stream << key;
+    std::string flatKey(stream);
+    DiskCache::DataBlob blob;
+    if (DISKCACHE.readFromDB(name(), flatKey, &blob) != DiskCache::DBREAD_SUCCESS)
+    {
+      return nullptr;
+    }
+    return DataBlobHelper<Key, T>::unflatten(&blob, flatKey.c_str(), name(), *_cto);
+  }
+
   void invalidate(const std::string& flatKey)
   {
     Key key;
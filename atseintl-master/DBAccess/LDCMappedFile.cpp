@@ -0,0 +1,321 @@
+#include "DBAccess/LDCMappedFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tse
+{
+namespace
+{
+const char MAGIC[8] = {'T', 'S', 'E', 'L', 'D', 'C', 'M', '1'};
+const uint32_t FORMAT_VERSION = 1;
+const uint64_t ALIGNMENT = 8;
+
+struct FileHeader
+{
+  char magic[8];
+  uint32_t formatVersion;
+  uint32_t tableVersion;
+  uint64_t recordCount;
+  uint64_t indexOffset;
+  uint64_t fileSize;
+};
+
+struct RecordHeader
+{
+  uint32_t keySize;
+  uint32_t dataSize;
+};
+
+// FNV-1a, stable across builds unlike std::hash
+uint64_t
+hashKey(const char* key, size_t size)
+{
+  uint64_t hash(0xcbf29ce484222325ULL);
+  for (size_t i = 0; i < size; ++i)
+  {
+    hash ^= static_cast<unsigned char>(key[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+uint64_t
+align(uint64_t offset)
+{
+  return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+}
+
+LDCMappedFile::Writer::Writer(const std::string& path, uint32_t tableVersion)
+  : _path(path),
+    _tmpPath(path + ".tmp"),
+    _tableVersion(tableVersion),
+    _out(_tmpPath.c_str(), std::ios::binary | std::ios::trunc),
+    _offset(sizeof(FileHeader)),
+    _committed(false)
+{
+  // the header is written by commit()
+  const FileHeader header = {};
+  _out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+LDCMappedFile::Writer::~Writer()
+{
+  if (!_committed)
+  {
+    _out.close();
+    std::remove(_tmpPath.c_str());
+  }
+}
+
+void
+LDCMappedFile::Writer::pad()
+{
+  static const char zeros[ALIGNMENT] = {};
+  const uint64_t aligned(align(_offset));
+  _out.write(zeros, aligned - _offset);
+  _offset = aligned;
+}
+
+bool
+LDCMappedFile::Writer::add(const std::string& key, const char* data, uint32_t dataSize)
+{
+  const IndexEntry entry = {hashKey(key.data(), key.size()), _offset};
+  _index.push_back(entry);
+
+  const RecordHeader header = {static_cast<uint32_t>(key.size()), dataSize};
+  _out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  _out.write(key.data(), key.size());
+  _offset += sizeof(header) + key.size();
+  pad();
+  _out.write(data, dataSize);
+  _offset += dataSize;
+  pad();
+
+  return _out.good();
+}
+
+bool
+LDCMappedFile::Writer::commit()
+{
+  if (!_out.good())
+  {
+    return false;
+  }
+
+  std::sort(_index.begin(),
+            _index.end(),
+            [](const IndexEntry& left, const IndexEntry& right)
+            {
+    return left.hash < right.hash || (left.hash == right.hash && left.offset < right.offset);
+  });
+
+  FileHeader header = {};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.formatVersion = FORMAT_VERSION;
+  header.tableVersion = _tableVersion;
+  header.recordCount = _index.size();
+  header.indexOffset = _offset;
+  header.fileSize = _offset + _index.size() * sizeof(IndexEntry);
+
+  if (!_index.empty())
+  {
+    _out.write(reinterpret_cast<const char*>(&_index[0]), _index.size() * sizeof(IndexEntry));
+  }
+  _out.seekp(0);
+  _out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  _out.close();
+
+  if (_out.fail() || std::rename(_tmpPath.c_str(), _path.c_str()) != 0)
+  {
+    return false;
+  }
+  _committed = true;
+  return true;
+}
+
+std::shared_ptr<const LDCMappedFile>
+LDCMappedFile::open(const std::string& path, uint32_t tableVersion)
+{
+  const int fd(::open(path.c_str(), O_RDONLY));
+  if (fd < 0)
+  {
+    return nullptr;
+  }
+
+  struct stat st;
+  void* base(MAP_FAILED);
+  if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(FileHeader))
+  {
+    base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  ::close(fd);
+  if (base == MAP_FAILED)
+  {
+    return nullptr;
+  }
+
+  const size_t length(st.st_size);
+  const FileHeader& header(*static_cast<const FileHeader*>(base));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.formatVersion != FORMAT_VERSION || header.tableVersion != tableVersion ||
+      header.fileSize != length || header.indexOffset < sizeof(FileHeader) ||
+      header.indexOffset % ALIGNMENT != 0 ||
+      header.recordCount > (length - header.indexOffset) / sizeof(IndexEntry) ||
+      header.indexOffset + header.recordCount * sizeof(IndexEntry) != length)
+  {
+    munmap(base, length);
+    return nullptr;
+  }
+
+  return std::shared_ptr<const LDCMappedFile>(new LDCMappedFile(
+      static_cast<const char*>(base), length, header.recordCount, header.indexOffset));
+}
+
+std::string
+LDCMappedFile::supersededPath(const std::string& path)
+{
+  return path + ".del";
+}
+
+// The log is a sequence of records of a key size followed by the key.
+bool
+LDCMappedFile::readSuperseded(const std::string& path, std::set<std::string>& keys)
+{
+  std::ifstream in(supersededPath(path).c_str(), std::ios::binary);
+  if (!in.is_open())
+  {
+    return true;
+  }
+  uint32_t keySize(0);
+  while (in.read(reinterpret_cast<char*>(&keySize), sizeof(keySize)))
+  {
+    std::string key(keySize, '\0');
+    if (!in.read(&key[0], keySize))
+    {
+      return false;
+    }
+    keys.insert(key);
+  }
+  return in.gcount() == 0;
+}
+
+bool
+LDCMappedFile::appendSuperseded(const std::string& path, const std::string& key)
+{
+  std::string record(sizeof(uint32_t), '\0');
+  const uint32_t keySize(static_cast<uint32_t>(key.size()));
+  std::memcpy(&record[0], &keySize, sizeof(keySize));
+  record += key;
+
+  const int fd(::open(supersededPath(path).c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644));
+  if (fd < 0)
+  {
+    return false;
+  }
+  // a single write; a record torn by a crash makes readSuperseded() reject the log
+  const bool written(::write(fd, record.data(), record.size()) ==
+                     static_cast<ssize_t>(record.size()));
+  ::close(fd);
+  return written;
+}
+
+bool
+LDCMappedFile::writeSuperseded(const std::string& path, const std::set<std::string>& keys)
+{
+  const std::string logPath(supersededPath(path));
+  const std::string tmpPath(logPath + ".tmp");
+  {
+    std::ofstream out(tmpPath.c_str(), std::ios::binary | std::ios::trunc);
+    for (const std::string& key : keys)
+    {
+      const uint32_t keySize(static_cast<uint32_t>(key.size()));
+      out.write(reinterpret_cast<const char*>(&keySize), sizeof(keySize));
+      out.write(key.data(), key.size());
+    }
+    out.close();
+    if (out.fail())
+    {
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmpPath.c_str(), logPath.c_str()) != 0)
+  {
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+  return true;
+}
+
+LDCMappedFile::LDCMappedFile(const char* base, size_t length, size_t size, uint64_t indexOffset)
+  : _base(base), _length(length), _size(size), _indexOffset(indexOffset)
+{
+}
+
+LDCMappedFile::~LDCMappedFile() { munmap(const_cast<char*>(_base), _length); }
+
+bool
+LDCMappedFile::recordAt(uint64_t offset, Record& record) const
+{
+  if (offset % ALIGNMENT != 0 || offset < sizeof(FileHeader) ||
+      offset + sizeof(RecordHeader) > _indexOffset)
+  {
+    return false;
+  }
+  const RecordHeader& header(*reinterpret_cast<const RecordHeader*>(_base + offset));
+  const uint64_t dataOffset(align(offset + sizeof(RecordHeader) + header.keySize));
+  if (dataOffset + header.dataSize > _indexOffset)
+  {
+    return false;
+  }
+  record.key = _base + offset + sizeof(RecordHeader);
+  record.keySize = header.keySize;
+  record.data = _base + dataOffset;
+  record.dataSize = header.dataSize;
+  return true;
+}
+
+LDCMappedFile::Record
+LDCMappedFile::record(size_t i) const
+{
+  const IndexEntry* const index(reinterpret_cast<const IndexEntry*>(_base + _indexOffset));
+  Record record;
+  if (i < _size && !recordAt(index[i].offset, record))
+  {
+    record = Record();
+  }
+  return record;
+}
+
+bool
+LDCMappedFile::find(const std::string& key, Record& record) const
+{
+  const IndexEntry* const begin(reinterpret_cast<const IndexEntry*>(_base + _indexOffset));
+  const IndexEntry* const end(begin + _size);
+  const uint64_t hash(hashKey(key.data(), key.size()));
+
+  for (const IndexEntry* entry = std::lower_bound(begin,
+                                                  end,
+                                                  hash,
+                                                  [](const IndexEntry& entry, uint64_t hash)
+                                                  { return entry.hash < hash; });
+       entry != end && entry->hash == hash;
+       ++entry)
+  {
+    if (recordAt(entry->offset, record) && record.keySize == key.size() &&
+        std::memcmp(record.key, key.data(), key.size()) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+} // tse
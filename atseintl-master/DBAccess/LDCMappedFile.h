@@ -0,0 +1,108 @@
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+// Memory-mapped snapshot of an LDC table.
+//
+// A snapshot is an immutable file with the flat keys and DataBlob bytes of
+// one cache type. It is written from the Berkeley DB table and mapped
+// read-only at the next start, where the blobs are deserialized straight
+// from the mapping. All references inside the file are offsets from its
+// start, so the mapping is usable wherever it lands:
+//
+//   header | record ... record | index
+//
+// Records start at 8-byte boundaries and hold the key size, the blob size,
+// the key and, again 8-byte aligned, the blob. The index at the tail is
+// sorted by key hash, so a single key is found with a binary search that
+// touches no page of any other record.
+//
+// Keys written to or deleted from the Berkeley DB table after the snapshot
+// was taken are appended to a log next to it ("<path>.del"). The log keeps
+// the snapshot usable across restarts: only the logged keys are read from
+// the table instead of the mapping.
+
+namespace tse
+{
+class LDCMappedFile : boost::noncopyable
+{
+public:
+  struct Record
+  {
+    const char* key = nullptr;
+    uint32_t keySize = 0;
+    const char* data = nullptr;
+    uint32_t dataSize = 0;
+  };
+
+private:
+  struct IndexEntry
+  {
+    uint64_t hash;
+    uint64_t offset;
+  };
+
+public:
+  class Writer : boost::noncopyable
+  {
+  public:
+    // The file appears under path only once commit() succeeds.
+    Writer(const std::string& path, uint32_t tableVersion);
+    ~Writer();
+
+    bool add(const std::string& key, const char* data, uint32_t dataSize);
+    bool commit();
+
+    size_t size() const { return _index.size(); }
+
+  private:
+    void pad();
+
+    const std::string _path;
+    const std::string _tmpPath;
+    const uint32_t _tableVersion;
+    std::ofstream _out;
+    uint64_t _offset;
+    std::vector<IndexEntry> _index;
+    bool _committed;
+  };
+
+  // nullptr if the file is missing, damaged or of another table version
+  static std::shared_ptr<const LDCMappedFile>
+  open(const std::string& path, uint32_t tableVersion);
+
+  // Log of the keys superseded since the snapshot at path was written. A
+  // missing log is empty; false if the log is damaged.
+  static std::string supersededPath(const std::string& path);
+  static bool readSuperseded(const std::string& path, std::set<std::string>& keys);
+  static bool appendSuperseded(const std::string& path, const std::string& key);
+  // replaces the whole log
+  static bool writeSuperseded(const std::string& path, const std::set<std::string>& keys);
+
+  ~LDCMappedFile();
+
+  size_t size() const { return _size; }
+
+  // i-th record in index order; key is nullptr if the record is damaged
+  Record record(size_t i) const;
+
+  bool find(const std::string& key, Record& record) const;
+
+private:
+  LDCMappedFile(const char* base, size_t length, size_t size, uint64_t indexOffset);
+
+  bool recordAt(uint64_t offset, Record& record) const;
+
+  const char* const _base;
+  const size_t _length;
+  const size_t _size;
+  const uint64_t _indexOffset;
+};
+} // tse
@@ -5,24 +5,25 @@
 // amount of data is read from at a high frequency from multiple
 // threads, while it is written to very infrequently.
 //
-// The cache works by keeping a main cache with copies, or 'mirrors'
-// of the cache. When an attempt is made to retrieve an item from
-// the cache, a mirror is chosen and locked. The mirror is then
-// checked to see if it contains the key. If it does contain the key,
-// it is returned. Otherwise the master cache is queried, and the
-// result will be placed in the mirror.
+// The cache keeps a master cache and an immutable snapshot of it which
+// readers access without taking any lock (see Common/Thread/RCUPtr.h).
+// A lookup that hits the snapshot costs one hash lookup plus two
+// uncontended atomic increments. A lookup that misses the snapshot
+// falls back to the master cache, and the key is queued so that the
+// next snapshot includes it. Queued keys are merged into the snapshot in
+// one batch on the cache notification thread (emptyTrash, put and
+// invalidate), so a transaction never copies the table or waits for a
+// grace period.
 //
-// This greatly reduces contention when reading, since threads will be
-// getting data from different mirrors in most cases, and they only
-// have to lock the mirror they are getting data from.
+// Whenever a key in the snapshot is changed or removed (cache notify),
+// a modified copy of the snapshot is published atomically and the old
+// one is deleted after a grace period. This is much slower than changing
+// a normal cache, and so a MirrorCache is only efficient in cases where
+// there are many more reads than writes.
 //
-// Whenever a key in the cache is changed or removed, all the mirrors
-// must be locked and the key removed from the mirror. This is therefore
-// much slower than changing a normal cache, and so a MirrorCache is
-// only efficient in cases where there are many more reads than writes.
-//
-// The MirrorCache also duplicates data, and so it is only suitable
-// when the data set is relatively small (probably up to a few megabytes)
+// The snapshot duplicates the index of the master cache, and so it is only
+// suitable when the data set is relatively small (probably up to a few
+// megabytes)
 //
 // The original motivation for this cache was for the multi airport
 // city table, which is relatively small, frequently updated, but
@@ -31,11 +32,14 @@
 #pragma once
 
 #include "Allocator/TrxMalloc.h"
+#include "Common/Thread/RCUPtr.h"
 #include "DBAccess/SimpleCache.h"
 
-#include <map>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 
-#include <pthread.h>
+#include <tr1/unordered_map>
+#include <tr1/unordered_set>
 
 namespace tse
 {
@@ -43,128 +47,119 @@ namespace tse
 template <typename Key, typename Type>
 class MirrorCache : public sfc::SimpleCache<Key, Type>
 {
-  typedef typename sfc::Cache<Key, Type>::pointer_type ValuePtr;
-  typedef std::map<Key, ValuePtr> Map;
-  typedef typename Map::iterator MapIterator;
-  typedef typename Map::const_iterator MapConstIterator;
-
-  struct Mirror
+  struct hash_func
   {
-    Map map;
-    boost::mutex mutex;
+    size_t operator()(const Key& key) const
+    {
+      size_t hash(0);
+      hashCombine(hash, key);
+      return hash;
+    }
   };
 
-  Mirror* _mirrors;
-  size_t _nmirrors;
+  typedef typename sfc::Cache<Key, Type>::pointer_type ValuePtr;
+  typedef std::tr1::unordered_map<Key, ValuePtr, hash_func> Map;
+  typedef typename Map::const_iterator MapConstIterator;
+  typedef std::tr1::unordered_set<Key, hash_func> KeySet;
+
+  RCUPtr<Map> _snapshot;
+  // serializes snapshot rebuilds with updates of the master cache
+  boost::mutex _writerMutex;
+  // keys loaded into the master cache but not yet in the snapshot
+  boost::mutex _pendingMutex;
+  KeySet _pending;
 
-  class MirrorGetter
+  // Looks the key up in the current snapshot, returns false on a miss.
+  bool findInSnapshot(const Key& key, ValuePtr& value) const
   {
-  public:
-    MirrorGetter(Mirror* mirrors, size_t nmirrors) : _mirror(nullptr)
+    typename RCUPtr<Map>::ReadGuard snapshot(_snapshot);
+    const MapConstIterator it = snapshot->find(key);
+    if (it == snapshot->end())
     {
-      const size_t startIndex = pthread_self() % nmirrors;
-      for (size_t tries = 0; tries != nmirrors; ++tries)
-      {
-        size_t index = (startIndex + tries) % nmirrors;
-        const bool res = mirrors[index].mutex.try_lock();
-        if (res)
-        {
-          _mirror = &mirrors[index];
-          break;
-        }
-      }
+      return false;
     }
+    value = it->second;
+    return true;
+  }
 
-    ~MirrorGetter()
+  // Called after a snapshot miss on the transaction thread: only queues
+  // the key. Never waits for the queue mutex; a key dropped here is simply
+  // queued again on its next miss.
+  void addPending(const Key& key)
+  {
+    boost::unique_lock<boost::mutex> lock(_pendingMutex, boost::try_to_lock);
+    if (lock.owns_lock())
     {
-      if (LIKELY(_mirror))
-      {
-        _mirror->mutex.unlock();
-      }
+      const MallocContextDisabler disableMalloc;
+      _pending.insert(key);
     }
+  }
 
-    Mirror* mirror() { return _mirror; }
-
-  private:
-    Mirror* _mirror;
-  };
-
-  void invalidateFromMirrors(const Key& key)
+  // Adds the queued keys still resident in the master cache to 'next' and
+  // makes it the current snapshot. Requires _writerMutex.
+  void publish(Map* next)
   {
-    for (size_t n = 0; n != _nmirrors; ++n)
+    KeySet pending;
+    {
+      boost::lock_guard<boost::mutex> lock(_pendingMutex);
+      pending.swap(_pending);
+    }
+    for (const Key& key : pending)
     {
-      boost::lock_guard<boost::mutex> g(_mirrors[n].mutex);
-      _mirrors[n].map.erase(key);
+      const ValuePtr value = sfc::SimpleCache<Key, Type>::getIfResident(key);
+      if (value)
+      {
+        (*next)[key] = value;
+      }
     }
+    _snapshot.publish(next);
   }
 
-  void clearMirrors()
+  bool hasPending()
   {
-    for (size_t n = 0; n != _nmirrors; ++n)
-    {
-      boost::lock_guard<boost::mutex> g(_mirrors[n].mutex);
-      _mirrors[n].map.clear();
-    }
+    boost::lock_guard<boost::mutex> lock(_pendingMutex);
+    return !_pending.empty();
   }
 
 public:
+  // 'nmirrors' is no longer used; it is accepted so that existing
+  // MirrorCache:<n> cache configurations stay valid
   MirrorCache(sfc::KeyedFactory<Key, Type>& factory,
               const std::string& name,
               size_t version,
               size_t nmirrors = 11)
-    : sfc::SimpleCache<Key, Type>(factory, name, 0, version), _nmirrors(nmirrors > 0 ? nmirrors : 1)
+    : sfc::SimpleCache<Key, Type>(factory, name, 0, version), _snapshot(new Map)
   {
-    _mirrors = new Mirror[_nmirrors];
   }
 
-  virtual ~MirrorCache() { delete[] _mirrors; }
+  virtual ~MirrorCache() {}
 
   ValuePtr getIfResident(const Key& key) override
   {
-    MirrorGetter getter(_mirrors, _nmirrors);
-    if (getter.mirror() == nullptr)
+    ValuePtr value;
+    if (findInSnapshot(key, value))
     {
-      return sfc::SimpleCache<Key, Type>::getIfResident(key);
+      return value;
     }
 
-    Mirror& mirror = *getter.mirror();
-
-    const MapConstIterator mirrorIt = mirror.map.find(key);
-    if (mirrorIt != mirror.map.end())
-    {
-      return mirrorIt->second;
-    }
-
-    const MallocContextDisabler disableMalloc;
-
-    ValuePtr value = sfc::SimpleCache<Key, Type>::getIfResident(key);
+    value = sfc::SimpleCache<Key, Type>::getIfResident(key);
     if (value)
     {
-      mirror.map.insert(std::pair<Key, ValuePtr>(key, value));
+      addPending(key);
     }
     return value;
   }
 
   ValuePtr get(const Key& key) override
   {
-    MirrorGetter getter(_mirrors, _nmirrors);
-    if (UNLIKELY(getter.mirror() == nullptr))
-    {
-      return sfc::SimpleCache<Key, Type>::get(key);
-    }
-
-    Mirror& mirror = *getter.mirror();
-
-    const MapConstIterator mirrorIt = mirror.map.find(key);
-    if (mirrorIt != mirror.map.end())
+    ValuePtr value;
+    if (LIKELY(findInSnapshot(key, value)))
     {
-      return mirrorIt->second;
+      return value;
     }
 
-    const MallocContextDisabler disableMalloc;
-
-    ValuePtr value = sfc::SimpleCache<Key, Type>::get(key);
-    mirror.map.insert(std::pair<Key, ValuePtr>(key, value));
+    value = sfc::SimpleCache<Key, Type>::get(key);
+    addPending(key);
     return value;
   }
 
@@ -175,23 +170,61 @@ public:
 
   void put(const Key& key, ValuePtr object, bool updateLDC = true) override
   {
+    const MallocContextDisabler disableMalloc;
+    boost::lock_guard<boost::mutex> lock(_writerMutex);
     sfc::SimpleCache<Key, Type>::put(key, object, updateLDC);
-    invalidateFromMirrors(key);
+    {
+      boost::lock_guard<boost::mutex> pendingLock(_pendingMutex);
+      _pending.insert(key);
+    }
+    const Map& current(*_snapshot.unsafeGet());
+    if (current.find(key) != current.end())
+    {
+      // readers must not see the replaced object any more
+      publish(new Map(current));
+    }
   }
 
   size_t invalidate(const Key& key) override
   {
+    const MallocContextDisabler disableMalloc;
+    boost::lock_guard<boost::mutex> lock(_writerMutex);
     size_t removed(sfc::SimpleCache<Key, Type>::invalidate(key));
-    invalidateFromMirrors(key);
+    const Map& current(*_snapshot.unsafeGet());
+    if (current.find(key) != current.end())
+    {
+      Map* next(new Map(current));
+      next->erase(key);
+      publish(next);
+    }
     return removed;
   }
 
   size_t clear() override
   {
+    const MallocContextDisabler disableMalloc;
+    boost::lock_guard<boost::mutex> lock(_writerMutex);
     size_t result(sfc::SimpleCache<Key, Type>::clear());
-    clearMirrors();
+    {
+      boost::lock_guard<boost::mutex> pendingLock(_pendingMutex);
+      _pending.clear();
+    }
+    _snapshot.publish(new Map);
     return result;
   }
+
+  // Runs periodically on the cache notification thread; merges the keys
+  // queued by lookups since the last run into the snapshot.
+  void emptyTrash() override
+  {
+    sfc::SimpleCache<Key, Type>::emptyTrash();
+    if (!hasPending())
+    {
+      return;
+    }
+    const MallocContextDisabler disableMalloc;
+    boost::lock_guard<boost::mutex> lock(_writerMutex);
+    publish(new Map(*_snapshot.unsafeGet()));
+  }
 };
 }
-
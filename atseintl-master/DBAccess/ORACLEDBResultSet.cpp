@@ -23,6 +23,7 @@
 #include "Common/TSEException.h"
 #include "Common/TseSrvStats.h"
 #include "Common/TseUtil.h"
+#include "DBAccess/ArrayFetchSizer.h"
 #include "DBAccess/CacheManager.h"
 #include "DBAccess/ORACLEAdapter.h"
 #include "DBAccess/ORACLEConnectionTimer.h"
@@ -292,6 +293,7 @@ ORACLEDBResultSet::nextRow()
       {
         LOG4CXX_DEBUG(getLogger(), "No rows to process");
       }
+      recordFetchCount();
       ORACLE_TIMER_STOP;
       return nullptr;
     }
@@ -355,6 +357,7 @@ ORACLEDBResultSet::nextRow()
         _numFetched += rowsFetched;
         return _currentRow;
       }
+      recordFetchCount();
       ORACLE_TIMER_STOP;
       return nullptr;
     }
@@ -376,6 +379,7 @@ ORACLEDBResultSet::nextRow()
     {
       LOG4CXX_DEBUG(getLogger(), "No more rows to process");
     }
+    recordFetchCount();
     ORACLE_TIMER_STOP;
     return nullptr;
   }
@@ -502,6 +506,16 @@ ORACLEDBResultSet::setOracleDefines()
   return true;
 }
 
+void
+ORACLEDBResultSet::recordFetchCount()
+{
+  ArrayFetchSizer& sizer(ArrayFetchSizer::instance());
+  if (sizer.enabled())
+  {
+    sizer.record(_sqlQueryObject->getQueryName(), _numFetched);
+  }
+}
+
 int32_t
 ORACLEDBResultSet::getFieldCount()
 {
@@ -78,6 +78,9 @@ private:
 
   uint32_t getArrayFetchSize() { return _arrayFetchSize; }
 
+  // teaches the array fetch sizing how many rows the query returned
+  void recordFetchCount();
+
   int32_t getFieldCount();
 
   ORACLEConnectionTimer* oracleConnectionTimer();
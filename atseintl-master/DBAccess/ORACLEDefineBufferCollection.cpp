@@ -18,6 +18,7 @@
 
 #include "DBAccess/ORACLEDefineBufferCollection.h"
 
+#include "DBAccess/ArrayFetchSizer.h"
 #include "DBAccess/ORACLEAdapter.h"
 
 #include <oci.h>
@@ -48,13 +49,24 @@ ORACLEDefineBufferCollection::createDefineBuffers(ORACLEAdapter& adapter,
   deleteDefineBuffers();
 
   if (arrayFetchSize > 0)
-    _arrayFetchSize = arrayFetchSize;
+    _configuredArrayFetchSize = arrayFetchSize;
   else
-    _arrayFetchSize = 1;
+    _configuredArrayFetchSize = 1;
 
   if (maxBufferStackSize > 0)
     _maxBufferStackSize = maxBufferStackSize;
 
+  // Describe the whole SELECT list first; the number of rows to fetch at a
+  // time depends on the width of a row.
+  struct Column
+  {
+    uint16_t dataType;
+    uint16_t size;
+    uint16_t sizeInChars;
+  };
+  std::vector<Column> columns;
+  _rowWidth = 0;
+
   uint32_t position = 1;
   int32_t status = OCI_SUCCESS;
 
@@ -139,21 +151,30 @@ ORACLEDefineBufferCollection::createDefineBuffers(ORACLEAdapter& adapter,
 
     OCIDescriptorFree(ociColumnParam, OCI_DTYPE_PARAM);
 
+    columns.push_back(Column{dataType, size, sizeInChars});
+    _rowWidth += ORACLEDefineBuffer::getRowWidth(dataType, size);
+  }
+
+  oracleStatusCode = status;
+
+  if (status != OCI_SUCCESS)
+    return false;
+
+  _arrayFetchSize = ArrayFetchSizer::instance().arrayFetchSize(
+      _queryName, _configuredArrayFetchSize, _rowWidth);
+
+  position = 1;
+  for (const Column& column : columns)
+  {
     ORACLEDefineBuffer* defineBuffer = ORACLEDefineBuffer::createDefineBuffer(
-        dataType, position, size, _arrayFetchSize, sizeInChars);
+        column.dataType, position++, column.size, _arrayFetchSize, column.sizeInChars);
 
     if (!defineBuffer)
       return false;
 
     addDefineBuffer(defineBuffer);
   }
-
-  oracleStatusCode = status;
-
-  if (status == OCI_SUCCESS)
-    return true;
-
-  return false;
+  return true;
 }
 
 void
@@ -713,12 +734,29 @@ ORACLEDefineBufferCollection::releaseDefineBufferCollection(ORACLEDefineBufferCo
   {
     target->freeDefineBuffers(adapter);
 
+    const bool sizeFits = ArrayFetchSizer::instance().fits(target->getQueryName(),
+                                                           target->_configuredArrayFetchSize,
+                                                           target->getRowWidth(),
+                                                           target->getArrayFetchSize());
+
     { // Mutex lock scope
       boost::lock_guard<boost::mutex> g(_mutex);
 
       BufferStackMap::iterator iter = _bufferCache.find(target->getQueryName());
 
-      if (iter != _bufferCache.end())
+      if (!sizeFits)
+      {
+        // The query returns far more or far fewer rows than the buffers
+        // were sized for; the next execution creates them anew.
+        LOG4CXX_DEBUG(getLogger(),
+                      "ORACLE Define buffers resized for query: "
+                          << target->getQueryName() << " array fetch size: "
+                          << target->getArrayFetchSize());
+
+        delete target;
+        target = nullptr;
+      }
+      else if (iter != _bufferCache.end())
       {
         BufferStack& bufferStack((*iter).second);
         if (bufferStack.size() >= target->getMaxBufferStackSize())
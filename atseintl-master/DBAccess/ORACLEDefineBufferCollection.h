@@ -55,6 +55,7 @@ public:
   int32_t getSize(int index) const;
   uint16_t getSizeInChars(int index) const;
   uint16_t getArrayFetchSize() const { return _arrayFetchSize; }
+  uint32_t getRowWidth() const { return _rowWidth; }
   uint16_t getMaxBufferStackSize() const { return _maxBufferStackSize; }
   const std::string& getQueryName() const { return _queryName; }
 
@@ -86,6 +87,8 @@ private:
 
   std::string _queryName;
   uint16_t _arrayFetchSize = 1;
+  uint16_t _configuredArrayFetchSize = 1;
+  uint32_t _rowWidth = 0;
   uint16_t _maxBufferStackSize = 10;
 
   static boost::mutex _mutex;
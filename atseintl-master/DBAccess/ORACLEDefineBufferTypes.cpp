@@ -109,6 +109,33 @@ ORACLEDefineBuffer::createDefineBuffer(
   return nullptr;
 }
 
+uint32_t
+ORACLEDefineBuffer::getRowWidth(uint16_t dataType, int32_t size)
+{
+  // null indicator and returned data length
+  const uint32_t indicators = sizeof(int16_t) + sizeof(uint16_t);
+
+  switch (dataType)
+  {
+  case SQLT_INT:
+    return indicators + (size < 10 ? sizeof(int32_t) : sizeof(int64_t));
+  case SQLT_NUM:
+    return indicators + 21;
+  case SQLT_STR:
+  case SQLT_CHR:
+  case SQLT_AFC:
+  case SQLT_AVC:
+    return indicators + size + 1;
+  case SQLT_DAT:
+    return indicators + sizeof(OCIDate);
+  case SQLT_TIMESTAMP:
+    return indicators + sizeof(OCIDateTime*);
+  default:
+    break;
+  }
+  return 0;
+}
+
 uint16_t
 ORACLEDefineBuffer::getDataType() const
 {
@@ -64,6 +64,9 @@ public:
   static ORACLEDefineBuffer* createDefineBuffer(
       uint16_t dataType, uint32_t position, int32_t size, uint32_t count, uint16_t sizeInChars);
 
+  // bytes one row of the column takes in its define buffer, 0 if unsupported
+  static uint32_t getRowWidth(uint16_t dataType, int32_t size);
+
 protected:
   ORACLEDefineBuffer(
       uint16_t dataType, uint32_t position, int32_t size, uint32_t count, uint16_t sizeInChars);
@@ -21,11 +21,20 @@
 
 #include "Common/Assert.h"
 #include "Common/KeyedFactory.h"
+#include "Common/Thread/RCUPtr.h"
 #include "Common/TseCodeTypes.h"
 #include "Common/TseStringTypes.h"
+#include "DBAccess/HashKey.h"
 #include "DBAccess/SimpleCache.h"
 
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <pthread.h>
 #include <sys/types.h>
@@ -173,6 +182,424 @@ public:
   }
 };
 
+//----------------------------------------------------------------------------
+// Immutable minimal perfect hash index (hash and displace, see "Hash,
+// displace, and compress" by Belazzougui, Botelho and Dietzfelbinger).
+// The n keys are stored in one contiguous array of n entries; a second array
+// of n displacements maps the key's first-level bucket either directly to a
+// slot (singleton buckets) or to the seed of a second-level hash. A lookup is
+// one key hash, two multiplications and one probe of the entry array.
+//----------------------------------------------------------------------------
+template <typename Key, typename Value>
+class PerfectHashIndex
+{
+public:
+  struct Entry
+  {
+    Key _key;
+    Value _value;
+  };
+
+  PerfectHashIndex() {}
+
+  // builds the index over the entries; keys must be unique
+  explicit PerfectHashIndex(const std::vector<Entry>& entries) { build(entries); }
+
+  const Value* find(const Key& key) const
+  {
+    if (UNLIKELY(_entries.empty()))
+    {
+      return nullptr;
+    }
+    const Entry& entry(_entries[slotOf(key)]);
+    return (entry._value && entry._key == key) ? &entry._value : nullptr;
+  }
+
+  size_t size() const { return _entries.size(); }
+
+  const std::vector<Entry>& entries() const { return _entries; }
+
+  size_t memoryUsed() const
+  {
+    return sizeof(*this) + _entries.capacity() * sizeof(Entry) +
+           _displacements.capacity() * sizeof(int32_t);
+  }
+
+  // Returns a copy with the value of an indexed key replaced, or nullptr if
+  // the key is not indexed. An empty value removes the key from lookups.
+  PerfectHashIndex* copyWith(const Key& key, const Value& value) const
+  {
+    if (_entries.empty())
+    {
+      return nullptr;
+    }
+    const size_t slot(slotOf(key));
+    if (!(_entries[slot]._key == key))
+    {
+      return nullptr;
+    }
+    PerfectHashIndex* copy(new PerfectHashIndex(*this));
+    copy->_entries[slot]._value = value;
+    return copy;
+  }
+
+private:
+  static size_t keyHash(const Key& key)
+  {
+    size_t hash(0);
+    hashCombine(hash, key);
+    return hash;
+  }
+
+  // murmur3 fmix64 of the key hash salted with the displacement
+  uint64_t mix(uint64_t hash, uint64_t displacement) const
+  {
+    uint64_t h(hash + (displacement + _seed) * 0x9E3779B97F4A7C15ULL);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  size_t slotOf(const Key& key) const
+  {
+    const uint64_t hash(keyHash(key));
+    const int32_t d(_displacements[mix(hash, 0) % _displacements.size()]);
+    return d < 0 ? static_cast<size_t>(-d - 1) : mix(hash, d) % _entries.size();
+  }
+
+  void build(const std::vector<Entry>& entries)
+  {
+    static const uint64_t MAX_SEEDS = 32;
+
+    // keys with equal hashes cannot be separated by any seed; they are left
+    // out of the index and served by the owning cache
+    std::vector<std::pair<uint64_t, uint32_t>> byHash(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+      byHash[i] = std::make_pair(static_cast<uint64_t>(keyHash(entries[i]._key)),
+                                 static_cast<uint32_t>(i));
+    }
+    std::sort(byHash.begin(), byHash.end());
+    std::vector<Entry> indexed;
+    std::vector<uint64_t> hashes;
+    indexed.reserve(entries.size());
+    hashes.reserve(entries.size());
+    for (size_t i = 0; i < byHash.size(); ++i)
+    {
+      const bool collides((i > 0 && byHash[i - 1].first == byHash[i].first) ||
+                          (i + 1 < byHash.size() && byHash[i + 1].first == byHash[i].first));
+      if (!collides)
+      {
+        indexed.push_back(entries[byHash[i].second]);
+        hashes.push_back(byHash[i].first);
+      }
+    }
+    if (indexed.empty())
+    {
+      return;
+    }
+
+    for (_seed = 1; _seed <= MAX_SEEDS; ++_seed)
+    {
+      if (place(indexed, hashes))
+      {
+        return;
+      }
+    }
+    // an empty index sends every lookup to the owning cache
+    _entries.clear();
+    _displacements.clear();
+  }
+
+  bool place(const std::vector<Entry>& entries, const std::vector<uint64_t>& hashes)
+  {
+    static const uint32_t MAX_DISPLACEMENT = 1 << 20;
+    const size_t n(entries.size());
+
+    std::vector<std::vector<uint32_t>> buckets(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      buckets[mix(hashes[i], 0) % n].push_back(static_cast<uint32_t>(i));
+    }
+    std::vector<uint32_t> order(n);
+    for (size_t b = 0; b < n; ++b)
+    {
+      order[b] = static_cast<uint32_t>(b);
+    }
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&buckets](uint32_t a, uint32_t b)
+                     { return buckets[a].size() > buckets[b].size(); });
+
+    _displacements.assign(n, 0);
+    std::vector<bool> taken(n, false);
+    std::vector<size_t> slots;
+    size_t ob(0);
+
+    // place the multi-key buckets, largest first, each with the first
+    // displacement that maps all its keys to distinct free slots
+    for (; ob < n && buckets[order[ob]].size() > 1; ++ob)
+    {
+      const std::vector<uint32_t>& bucket(buckets[order[ob]]);
+      uint32_t d(1);
+      for (; d < MAX_DISPLACEMENT; ++d)
+      {
+        slots.clear();
+        bool ok(true);
+        for (uint32_t i : bucket)
+        {
+          const size_t slot(mix(hashes[i], d) % n);
+          if (taken[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end())
+          {
+            ok = false;
+            break;
+          }
+          slots.push_back(slot);
+        }
+        if (ok)
+        {
+          break;
+        }
+      }
+      if (d == MAX_DISPLACEMENT)
+      {
+        return false;
+      }
+      _displacements[order[ob]] = static_cast<int32_t>(d);
+      for (size_t k = 0; k < slots.size(); ++k)
+      {
+        taken[slots[k]] = true;
+      }
+    }
+
+    // singleton buckets take the remaining free slots directly
+    _entries.assign(n, Entry());
+    size_t freeSlot(0);
+    for (; ob < n && buckets[order[ob]].size() == 1; ++ob)
+    {
+      while (taken[freeSlot])
+      {
+        ++freeSlot;
+      }
+      taken[freeSlot] = true;
+      _displacements[order[ob]] = -static_cast<int32_t>(freeSlot) - 1;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      _entries[slotOf(entries[i]._key)] = entries[i];
+    }
+    return true;
+  }
+
+  std::vector<Entry> _entries;
+  std::vector<int32_t> _displacements;
+  uint64_t _seed = 1;
+};
+
+//----------------------------------------------------------------------------
+// Cache for static reference data (Loc, MultiAirportCity, GlobalDir, Nation,
+// Mileage). Objects are loaded and invalidated through a SimpleCache; the
+// resident objects are periodically frozen into a PerfectHashIndex published
+// through an RCUPtr, so lookups of frozen keys take no lock at all.
+//
+// The index is rebuilt by consolidate() (called after the cache load) and by
+// emptyTrash() on the cache notification thread once the keys loaded since
+// the last build reach a quarter of the index size, which keeps the build
+// cost linear. A lookup which misses the index only raises a flag. Updates
+// of frozen keys (cache notify) publish a patched copy of the index.
+//----------------------------------------------------------------------------
+template <typename Key, typename Type>
+class FrozenCache : public sfc::SimpleCache<Key, Type>
+{
+  typedef typename sfc::Cache<Key, Type>::pointer_type ValuePtr;
+  typedef PerfectHashIndex<Key, ValuePtr> Index;
+
+  static const size_t MIN_REBUILD_BATCH = 64;
+
+  RCUPtr<Index> _index;
+  boost::mutex _writerMutex;
+  // resident keys seen by the last rebuild, including keys left out of the
+  // index because of hash collisions
+  size_t _frozen;
+  std::atomic<bool> _missed;
+
+  bool findFrozen(const Key& key, ValuePtr& value) const
+  {
+    typename RCUPtr<Index>::ReadGuard index(_index);
+    const ValuePtr* found(index->find(key));
+    if (found == nullptr)
+    {
+      return false;
+    }
+    value = *found;
+    return true;
+  }
+
+  // Requires _writerMutex.
+  size_t notFrozen()
+  {
+    const size_t resident(sfc::SimpleCache<Key, Type>::size());
+    return resident > _frozen ? resident - _frozen : 0;
+  }
+
+  // Requires _writerMutex.
+  bool rebuildDue()
+  {
+    return notFrozen() >= std::max(MIN_REBUILD_BATCH, _index.unsafeGet()->size() / 4);
+  }
+
+  // Requires _writerMutex.
+  size_t rebuild()
+  {
+    const MallocContextDisabler disableMalloc;
+    const std::shared_ptr<std::vector<Key>> keys(sfc::SimpleCache<Key, Type>::keys());
+    std::vector<typename Index::Entry> entries;
+    entries.reserve(keys->size());
+    for (const Key& key : *keys)
+    {
+      typename Index::Entry entry;
+      entry._value = sfc::SimpleCache<Key, Type>::getIfResident(key);
+      if (entry._value)
+      {
+        entry._key = key;
+        entries.push_back(entry);
+      }
+    }
+    _index.publish(new Index(entries));
+    _frozen = entries.size();
+    return entries.size();
+  }
+
+  // Called on the transaction thread after a lookup missed the index.
+  void noteNotFrozen()
+  {
+    if (!_missed.load(std::memory_order_relaxed))
+    {
+      _missed.store(true, std::memory_order_relaxed);
+    }
+  }
+
+public:
+  FrozenCache(sfc::KeyedFactory<Key, Type>& factory,
+              const std::string& name,
+              size_t capacity,
+              size_t version)
+    : sfc::SimpleCache<Key, Type>(factory, name, capacity, version),
+      _index(new Index),
+      _frozen(0),
+      _missed(false)
+  {
+  }
+
+  virtual ~FrozenCache() {}
+
+  size_t frozenSize() const { return _index.unsafeGet()->size(); }
+
+  size_t frozenMemoryUsed() const { return _index.unsafeGet()->memoryUsed(); }
+
+  ValuePtr getIfResident(const Key& key) override
+  {
+    ValuePtr value;
+    if (findFrozen(key, value))
+    {
+      return value;
+    }
+    value = sfc::SimpleCache<Key, Type>::getIfResident(key);
+    if (value)
+    {
+      noteNotFrozen();
+    }
+    return value;
+  }
+
+  ValuePtr get(const Key& key) override
+  {
+    ValuePtr value;
+    if (LIKELY(findFrozen(key, value)))
+    {
+      return value;
+    }
+    value = sfc::SimpleCache<Key, Type>::get(key);
+    noteNotFrozen();
+    return value;
+  }
+
+  void put(const Key& key, Type* object, bool updateLDC = true) override
+  {
+    this->put(key, ValuePtr(object), updateLDC);
+  }
+
+  void put(const Key& key, ValuePtr object, bool updateLDC = true) override
+  {
+    boost::lock_guard<boost::mutex> lock(_writerMutex);
+    sfc::SimpleCache<Key, Type>::put(key, object, updateLDC);
+    const MallocContextDisabler disableMalloc;
+    Index* patched(_index.unsafeGet()->copyWith(key, object));
+    if (patched)
+    {
+      _index.publish(patched);
+    }
+    else if (rebuildDue())
+    {
+      rebuild();
+    }
+  }
+
+  size_t invalidate(const Key& key) override
+  {
+    boost::lock_guard<boost::mutex> lock(_writerMutex);
+    const size_t removed(sfc::SimpleCache<Key, Type>::invalidate(key));
+    const MallocContextDisabler disableMalloc;
+    Index* patched(_index.unsafeGet()->copyWith(key, ValuePtr()));
+    if (patched)
+    {
+      _index.publish(patched);
+    }
+    return removed;
+  }
+
+  size_t clear() override
+  {
+    boost::lock_guard<boost::mutex> lock(_writerMutex);
+    const size_t result(sfc::SimpleCache<Key, Type>::clear());
+    const MallocContextDisabler disableMalloc;
+    _index.publish(new Index);
+    _frozen = 0;
+    return result;
+  }
+
+  // Runs periodically on the cache notification thread.
+  void emptyTrash() override
+  {
+    sfc::SimpleCache<Key, Type>::emptyTrash();
+    if (!_missed.exchange(false))
+    {
+      return;
+    }
+    boost::lock_guard<boost::mutex> lock(_writerMutex);
+    if (rebuildDue())
+    {
+      rebuild();
+    }
+  }
+
+  size_t consolidationSize() override
+  {
+    boost::lock_guard<boost::mutex> lock(_writerMutex);
+    return notFrozen();
+  }
+
+  size_t consolidate(size_t maxRecordsToConsolidate) override
+  {
+    boost::lock_guard<boost::mutex> lock(_writerMutex);
+    return rebuild();
+  }
+};
+
 template <typename Key, typename Value>
 struct PerfectHashGenerator
 {
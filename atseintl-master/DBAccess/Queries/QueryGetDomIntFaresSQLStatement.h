@@ -134,16 +134,16 @@ public:
     f->_routingNumber = row->getString(ROUTING);
     f->_ruleNumber = row->getString(RULE);
 
-    std::string dir = row->getString(DIRECTIONALITY);
-    if (UNLIKELY(dir == "F"))
+    // single character codes, compared in place for every fare row
+    const char* dir = row->getString(DIRECTIONALITY);
+    if (UNLIKELY(dir[0] == 'F' && dir[1] == '\0'))
       f->_directionality = FROM;
-    else if (UNLIKELY(dir == "T"))
+    else if (UNLIKELY(dir[0] == 'T' && dir[1] == '\0'))
       f->_directionality = TO;
-    else if (LIKELY(dir.empty() || dir == " " || dir == "B"))
+    else if (LIKELY(dir[0] == '\0' || ((dir[0] == ' ' || dir[0] == 'B') && dir[1] == '\0')))
       f->_directionality = BOTH;
 
-    std::string gd = row->getString(GLOBALDIR);
-    strToGlobalDirection(f->_globalDirection, gd);
+    strToGlobalDirection(f->_globalDirection, row->getString(GLOBALDIR));
 
     f->_owrt = row->getString(OWRT)[0];
     if (f->_owrt == ROUND_TRIP_MAYNOT_BE_HALVED)
@@ -407,16 +407,15 @@ public:
     f->_routingNumber = row->getString(ROUTING);
     f->_ruleNumber = row->getString(RULE);
 
-    std::string dir = row->getString(DIRECTIONALITY);
-    if (dir == "F")
+    const char* dir = row->getString(DIRECTIONALITY);
+    if (dir[0] == 'F' && dir[1] == '\0')
       f->_directionality = FROM;
-    else if (dir == "T")
+    else if (dir[0] == 'T' && dir[1] == '\0')
       f->_directionality = TO;
-    else if (dir.empty() || dir == " " || dir == "B")
+    else if (dir[0] == '\0' || ((dir[0] == ' ' || dir[0] == 'B') && dir[1] == '\0'))
       f->_directionality = BOTH;
 
-    std::string gd = row->getString(GLOBALDIR);
-    strToGlobalDirection(f->_globalDirection, gd);
+    strToGlobalDirection(f->_globalDirection, row->getString(GLOBALDIR));
 
     f->_owrt = row->getString(OWRT)[0];
     if (f->_owrt == ROUND_TRIP_MAYNOT_BE_HALVED)
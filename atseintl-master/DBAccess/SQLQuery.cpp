@@ -21,6 +21,7 @@
 #include "Common/Logger.h"
 #include "Common/TseCodeTypes.h"
 #include "Common/TseStringTypes.h"
+#include "DBAccess/ArrayFetchSizer.h"
 #include "DBAccess/DataManager.h"
 #include "DBAccess/DBAccessConsts.h"
 #include "DBAccess/SQLStatementHelper.h"
@@ -173,6 +174,19 @@ SQLQuery::loadQueryOptions(ConfigMan& config)
     }
   }
 
+  if (config.getValue("ARRAY_FETCH_MEMORY", tempValue, "SQLQUERY_OPTIONS_DEFAULTS"))
+  {
+    errno = 0;
+    long temp = strtol(tempValue.c_str(), nullptr, 10);
+    if (temp >= 0 && errno == 0)
+    {
+      temp = (temp > 0x7fffffff) ? 0x7fffffff : temp;
+      ArrayFetchSizer::instance().setMemoryLimit(static_cast<uint32_t>(temp));
+      LOG4CXX_INFO(_logger,
+                   "Setting SQLQuery Options: ARRAY_FETCH_MEMORY to " << temp << ".");
+    }
+  }
+
   LOG4CXX_INFO(_logger,
                "Setting SQLQuery Options: default ARRAY_FETCH_SIZE to " << _defaultArrayFetchSize
                                                                         << ".");
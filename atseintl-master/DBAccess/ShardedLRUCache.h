@@ -0,0 +1,512 @@
+//-------------------------------------------------------------------------------
+// Copyright 2016, Sabre Inc.  All rights reserved.
+// This software/documentation is the confidential and proprietary product of
+// Sabre Inc.   Any unauthorized use, reproduction, or transfer of this
+// software/documentation,  in any medium, or incorporation of this
+// software/documentation into any system or publication, is strictly prohibited.
+//-------------------------------------------------------------------------------
+//
+
+#pragma once
+
+#include "Allocator/TrxMalloc.h"
+#include "Common/Global.h"
+#include "Common/Hasher.h"
+#include "Common/KeyedFactory.h"
+#include "DBAccess/Cache.h"
+
+#include <boost/thread/condition.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <tr1/unordered_map>
+
+namespace sfc
+{
+// LRUCache variant for the hot, heavily shared caches (Fare, GeneralFareRule).
+// The key space is split into a power-of-two number of shards, each with its
+// own mutex, map and condition, so concurrent lookups of different keys do not
+// serialize on one lock. Within a shard recency is approximated with the CLOCK
+// algorithm: a hit only sets a reference bit instead of relinking a list node,
+// and eviction sweeps the slot array giving referenced entries a second chance.
+//
+// Creation, invalidation, LDC and accumulator semantics are the same as in
+// LRUCache; only the eviction order is approximate and per shard.
+template <typename Key, typename Type, typename FactoryType = KeyedFactory<Key, Type> >
+class ShardedLRUCache : public Cache<Key, Type, FactoryType>
+{
+public:
+  static const size_t DEFAULT_NUMBER_OF_SHARDS = 64;
+
+private:
+  struct hash_func
+  {
+    size_t operator()(const Key& key) const
+    {
+      tse::Hasher hasher(tse::Global::hasherMethod());
+      hasher << key;
+      return hasher.hash();
+    }
+  };
+
+  typedef typename Cache<Key, Type, FactoryType>::pointer_type _pointer_type;
+  typedef std::tr1::unordered_map<Key, size_t, hash_func> Map;
+  typedef typename Map::iterator MapIterator;
+
+  static const size_t CAPACITY_MAX = (size_t)(-1);
+  // map value of an entry whose object is being constructed by another thread
+  static const size_t NO_SLOT = (size_t)(-1);
+
+  struct Slot
+  {
+    Slot() : _key(nullptr), _referenced(false), _occupied(false) {}
+
+    // points at the key stored in the shard map, nodes are stable across rehash
+    const Key* _key;
+    _pointer_type _value;
+    bool _referenced;
+    bool _occupied;
+  };
+
+  struct Shard
+  {
+    Shard() : _hand(0), _resident(0), _capacity(CAPACITY_MAX) {}
+
+    boost::mutex _mutex;
+    boost::condition _condition;
+    Map _map;
+    std::vector<Slot> _slots;
+    std::vector<size_t> _freeSlots;
+    size_t _hand;
+    size_t _resident;
+    size_t _capacity;
+  };
+
+  std::unique_ptr<Shard[]> _shards;
+  size_t _numberOfShards;
+  unsigned _shardBits;
+  size_t _capacity;
+  // Cache::_accumulator is shared by all shards
+  boost::mutex _accumulatorMutex;
+
+  static size_t roundUpToPowerOf2(size_t n)
+  {
+    size_t result(1);
+    while (result < n && result < (size_t(1) << 16))
+    {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  Shard& shardFor(const Key& key)
+  {
+    if (_numberOfShards == 1)
+    {
+      return _shards[0];
+    }
+    // finalize the hash (murmur3 fmix32) and use its high bits so that the
+    // shard index does not correlate with the bucket index inside the shard map
+    uint32_t h(static_cast<uint32_t>(hash_func()(key)));
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return _shards[h >> (32 - _shardBits)];
+  }
+
+  // splits the total capacity so that the shards add up to it exactly
+  size_t shardCapacity(size_t shard) const
+  {
+    if (_capacity == CAPACITY_MAX)
+    {
+      return CAPACITY_MAX;
+    }
+    const size_t capacity(_capacity / _numberOfShards +
+                          (shard < _capacity % _numberOfShards ? 1 : 0));
+    return std::max<size_t>(1, capacity);
+  }
+
+  void retire(Type* object)
+  {
+    boost::mutex::scoped_lock lock(_accumulatorMutex);
+    this->moveToAccumulator(object);
+  }
+
+  template <typename Parm>
+  _pointer_type getInternal(const Key& key, Parm parm)
+  {
+    MallocContextDisabler mallocController(false);
+    Shard& shard(shardFor(key));
+
+    // see if the item is in the cache already, locking the shard
+    // while we perform the lookup
+    {
+      boost::mutex::scoped_lock lock(shard._mutex);
+
+      MapIterator j = shard._map.find(key);
+      if (j != shard._map.end())
+      {
+        bool useExistingObject = true;
+        // If the object is in the process of being put in the cache,
+        // wait for it to complete
+        while (j->second == NO_SLOT)
+        {
+          shard._condition.wait(lock);
+          j = shard._map.find(key);
+
+          // IF the item was deleted from the map
+          if (j == shard._map.end())
+          {
+            // Flag it as under construction and create it in this thread
+            mallocController.activate();
+            shard._map.insert(std::pair<Key, size_t>(key, NO_SLOT));
+            useExistingObject = false;
+            break;
+          }
+        }
+
+        if (useExistingObject)
+        {
+          Slot& slot(shard._slots[j->second]);
+          slot._referenced = true;
+          return slot._value;
+        }
+      }
+      else
+      {
+        // Add a placeholder so that concurrent requests for the same key
+        // wait for this thread instead of creating duplicates
+        mallocController.activate();
+        shard._map.insert(std::pair<Key, size_t>(key, NO_SLOT));
+      }
+    }
+
+    try
+    {
+      // construct the object with the shard unlocked
+      mallocController.activate();
+
+      bool distCacheOp(false);
+      Type* ptr = this->getDistCache(key, distCacheOp);
+      if (nullptr == ptr)
+      {
+        ptr = create(key, parm);
+      }
+      _pointer_type ret(ptr);
+      {
+        boost::mutex::scoped_lock lock(shard._mutex);
+        shard._map.erase(key);
+        putWithoutLock(shard, key, ret, distCacheOp, true);
+
+        // Notify any threads waiting that the object is initialized
+        shard._condition.notify_all();
+      }
+      return ret;
+    }
+    catch (...)
+    {
+      // Remove the placeholder and notify any other thread waiting for it
+      boost::mutex::scoped_lock lock(shard._mutex);
+      if (shard._map.erase(key) > 0)
+      {
+        bool distCacheOp(false), ldcOp(true);
+        this->queueDiskInvalidate(key, distCacheOp, ldcOp);
+      }
+      shard._condition.notify_all();
+
+      throw;
+    }
+  }
+
+  template <typename Parm>
+  Type* create(const Key& key, Parm p)
+  {
+    return this->_factory.create(key, p);
+  }
+
+  // a dummy type used to signal to 'getInternal' that there is
+  // no parameter at all
+  struct null_t
+  {
+  };
+
+  Type* create(const Key& key, null_t p) { return this->_factory.create(key); }
+
+public:
+  ShardedLRUCache(FactoryType& factory,
+                  const std::string& name,
+                  size_t version,
+                  size_t capacity = tse::Global::getUnlimitedCacheSize(),
+                  size_t numberOfShards = DEFAULT_NUMBER_OF_SHARDS)
+    : Cache<Key, Type, FactoryType>(factory, "ShardedLRUCache", name, version),
+      _numberOfShards(roundUpToPowerOf2(numberOfShards)),
+      _shardBits(0),
+      _capacity((capacity == tse::Global::getUnlimitedCacheSize()) ? CAPACITY_MAX : capacity)
+  {
+    while ((size_t(1) << _shardBits) < _numberOfShards)
+    {
+      ++_shardBits;
+    }
+    _shards.reset(new Shard[_numberOfShards]);
+    for (size_t i = 0; i < _numberOfShards; ++i)
+    {
+      _shards[i]._capacity = shardCapacity(i);
+    }
+  }
+
+  virtual ~ShardedLRUCache() {}
+
+  size_t numberOfShards() const { return _numberOfShards; }
+
+  size_t size() override
+  {
+    size_t result(0);
+    for (size_t i = 0; i < _numberOfShards; ++i)
+    {
+      boost::mutex::scoped_lock lock(_shards[i]._mutex);
+      result += _shards[i]._map.size();
+    }
+    return result;
+  }
+
+  virtual void reserve(size_t capacity)
+  {
+    _capacity = (capacity == tse::Global::getUnlimitedCacheSize()) ? CAPACITY_MAX : capacity;
+    for (size_t i = 0; i < _numberOfShards; ++i)
+    {
+      boost::mutex::scoped_lock lock(_shards[i]._mutex);
+      _shards[i]._capacity = shardCapacity(i);
+    }
+  }
+
+  _pointer_type get(const Key& key) override { return getInternal(key, null_t()); }
+
+  template <typename Parm>
+  _pointer_type get(const Key& key, Parm parm)
+  {
+    return getInternal(key, parm);
+  }
+
+  _pointer_type getIfResident(const Key& key) override
+  {
+    Shard& shard(shardFor(key));
+    boost::mutex::scoped_lock lock(shard._mutex);
+
+    MapIterator j = shard._map.find(key);
+    // If the object is in the process of being put in the cache,
+    // wait for it to complete
+    while (j != shard._map.end() && j->second == NO_SLOT)
+    {
+      shard._condition.wait(lock);
+      j = shard._map.find(key);
+    }
+    if (j != shard._map.end())
+    {
+      Slot& slot(shard._slots[j->second]);
+      slot._referenced = true;
+      return slot._value;
+    }
+    return _pointer_type();
+  }
+
+  void put(const Key& key, Type* object, bool updateLDC = true) override
+  {
+    put(key, _pointer_type(object), updateLDC);
+  }
+
+  virtual void put(const Key& key, _pointer_type object, bool updateLDC = true)
+  {
+    Shard& shard(shardFor(key));
+    boost::mutex::scoped_lock lock(shard._mutex);
+    putWithoutLock(shard, key, object, true, updateLDC);
+  }
+
+  size_t invalidate(const Key& key) override
+  {
+    Shard& shard(shardFor(key));
+    boost::mutex::scoped_lock lock(shard._mutex);
+
+    // Wait for any construction of the object that is in progress
+    //      to end before clearing the cache object
+    MapIterator j = shard._map.find(key);
+    while (j != shard._map.end() && j->second == NO_SLOT)
+    {
+      shard._condition.wait(lock);
+      j = shard._map.find(key);
+    }
+
+    bool distCacheOp(true), ldcOp(true);
+    size_t result(j != shard._map.end() ? 1 : 0);
+    erase(shard, key, distCacheOp, ldcOp);
+    return result;
+  }
+
+  std::shared_ptr<std::vector<Key>> keys() override
+  {
+    const std::shared_ptr<std::vector<Key>> allKeys(new std::vector<Key>);
+    for (size_t i = 0; i < _numberOfShards; ++i)
+    {
+      boost::mutex::scoped_lock lock(_shards[i]._mutex);
+      allKeys->reserve(allKeys->size() + _shards[i]._map.size());
+      for (auto& elem : _shards[i]._map)
+      {
+        allKeys->push_back(elem.first);
+      }
+    }
+    return allKeys;
+  }
+
+  size_t clear() override
+  {
+    size_t result(0);
+    for (size_t i = 0; i < _numberOfShards; ++i)
+    {
+      Shard& shard(_shards[i]);
+      boost::mutex::scoped_lock lock(shard._mutex);
+      result += shard._map.size();
+      for (const Slot& slot : shard._slots)
+      {
+        if (slot._occupied)
+        {
+          retire(slot._value.get());
+        }
+      }
+      shard._map.clear();
+      shard._slots.clear();
+      shard._freeSlots.clear();
+      shard._hand = 0;
+      shard._resident = 0;
+    }
+    this->queueDiskClear();
+    return result;
+  }
+
+  void emptyTrash() override
+  {
+    boost::mutex::scoped_lock lock(_accumulatorMutex);
+    if (!this->_accumulator.empty())
+    {
+      this->_cacheDeleter.moveToTrashBin(this->_accumulator);
+    }
+  }
+
+private:
+  size_t allocateSlot(Shard& shard, const Key* key, _pointer_type object)
+  {
+    size_t idx;
+    if (!shard._freeSlots.empty())
+    {
+      idx = shard._freeSlots.back();
+      shard._freeSlots.pop_back();
+    }
+    else
+    {
+      idx = shard._slots.size();
+      shard._slots.push_back(Slot());
+    }
+    Slot& slot(shard._slots[idx]);
+    slot._key = key;
+    slot._value = object;
+    slot._referenced = true;
+    slot._occupied = true;
+    ++shard._resident;
+    return idx;
+  }
+
+  void releaseSlot(Shard& shard, size_t idx)
+  {
+    Slot& slot(shard._slots[idx]);
+    slot._key = nullptr;
+    slot._value = _pointer_type();
+    slot._referenced = false;
+    slot._occupied = false;
+    shard._freeSlots.push_back(idx);
+    --shard._resident;
+  }
+
+  // CLOCK sweep: evicts unreferenced entries until the shard fits its capacity,
+  // clearing the reference bit of the entries it passes over. The slot just
+  // inserted is never chosen.
+  void makeRoom(Shard& shard, size_t newSlot, bool updateLDC)
+  {
+    while (shard._resident > shard._capacity)
+    {
+      if (shard._hand >= shard._slots.size())
+      {
+        shard._hand = 0;
+      }
+      const size_t idx(shard._hand++);
+      Slot& slot(shard._slots[idx]);
+      if (!slot._occupied || idx == newSlot)
+      {
+        continue;
+      }
+      if (slot._referenced)
+      {
+        slot._referenced = false;
+        continue;
+      }
+      const Key key(*slot._key);
+      retire(slot._value.get());
+      releaseSlot(shard, idx);
+      shard._map.erase(key);
+      if (updateLDC)
+      {
+        bool distCacheOp(false), ldcOp(true);
+        this->queueDiskInvalidate(key, distCacheOp, ldcOp);
+      }
+    }
+  }
+
+  void erase(Shard& shard, const Key& key, bool distCacheOp, bool ldcOp)
+  {
+    const MapIterator j = shard._map.find(key);
+    if (j != shard._map.end())
+    {
+      // If the object has more than a placeholder in the map
+      if (j->second != NO_SLOT)
+      {
+        retire(shard._slots[j->second]._value.get());
+        releaseSlot(shard, j->second);
+      }
+
+      // Remove the object from the map (placeholder or full object)
+      shard._map.erase(j);
+      this->queueDiskInvalidate(key, distCacheOp, ldcOp);
+    }
+  }
+
+  void putWithoutLock(
+      Shard& shard, const Key& key, _pointer_type object, bool distCacheOp, bool updateLDC)
+  {
+    const std::pair<MapIterator, bool> res =
+        shard._map.insert(std::pair<Key, size_t>(key, NO_SLOT));
+    if (res.second && updateLDC)
+    {
+      this->queueDiskPut(key, distCacheOp);
+    }
+
+    // if an item with the same key is already in the cache, replace
+    // its value in place and keep the slot
+    if (!res.second && res.first->second != NO_SLOT)
+    {
+      Slot& slot(shard._slots[res.first->second]);
+      retire(slot._value.get());
+      slot._value = object;
+      slot._referenced = true;
+      return;
+    }
+
+    res.first->second = allocateSlot(shard, &res.first->first, object);
+
+    // make sure there's enough room for the item
+    makeRoom(shard, res.first->second, updateLDC);
+  }
+};
+
+} // namespace sfc
@@ -0,0 +1,153 @@
+//-------------------------------------------------------------------------------
+// Copyright 2016, Sabre Inc.  All rights reserved.
+// This software/documentation is the confidential and proprietary product of
+// Sabre Inc.   Any unauthorized use, reproduction, or transfer of this
+// software/documentation,  in any medium, or incorporation of this
+// software/documentation into any system or publication, is strictly prohibited.
+//-------------------------------------------------------------------------------
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace sfc
+{
+// Runs at most one load per key at a time.
+//
+// The first caller of run() for a key loads it. Callers arriving while the
+// load is in flight wait on its shared future instead of loading the key
+// again, and get the same value or the same exception. A caller that has
+// waited for the timeout runs loadAlone instead, which must not wait for
+// the load in flight, so a hung query delays the others only that long.
+template <typename Key, typename Value, typename Hash>
+class SingleFlight : boost::noncopyable
+{
+public:
+  struct Stats
+  {
+    uint64_t loads = 0;
+    uint64_t coalesced = 0;
+    uint64_t timeouts = 0;
+  };
+
+  // 0 disables coalescing, every caller loads
+  void setTimeout(uint32_t timeoutMillis) { _timeoutMillis = timeoutMillis; }
+
+  bool enabled() const { return _timeoutMillis != 0; }
+
+  template <typename Load, typename LoadAlone>
+  Value run(const Key& key, Load load, LoadAlone loadAlone)
+  {
+    Shard& shard(_shards[Hash()(key) % SHARDS]);
+    FlightPtr flight;
+    bool leader(false);
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      FlightPtr& slot(shard.flights[key]);
+      if (!slot)
+      {
+        slot = std::make_shared<Flight>();
+        leader = true;
+      }
+      flight = slot;
+    }
+
+    if (leader)
+    {
+      ++_loads;
+      try
+      {
+        Value value(load());
+        flight->promise.set_value(value);
+        land(shard, key, flight);
+        return value;
+      }
+      catch (...)
+      {
+        flight->promise.set_exception(std::current_exception());
+        land(shard, key, flight);
+        throw;
+      }
+    }
+
+    ++_coalesced;
+    if (flight->future.wait_for(std::chrono::milliseconds(_timeoutMillis)) ==
+        std::future_status::ready)
+    {
+      return flight->future.get();
+    }
+    ++_timeouts;
+    return loadAlone();
+  }
+
+  // Later callers of run() start a new load instead of joining the one in
+  // flight, whose value may predate an invalidation of the key.
+  void forget(const Key& key)
+  {
+    Shard& shard(_shards[Hash()(key) % SHARDS]);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.flights.erase(key);
+  }
+
+  void forgetAll()
+  {
+    for (Shard& shard : _shards)
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.flights.clear();
+    }
+  }
+
+  Stats stats() const
+  {
+    Stats stats;
+    stats.loads = _loads;
+    stats.coalesced = _coalesced;
+    stats.timeouts = _timeouts;
+    return stats;
+  }
+
+private:
+  struct Flight
+  {
+    Flight() : future(promise.get_future().share()) {}
+
+    std::promise<Value> promise;
+    std::shared_future<Value> future;
+  };
+  typedef std::shared_ptr<Flight> FlightPtr;
+  typedef std::unordered_map<Key, FlightPtr, Hash> Flights;
+
+  struct Shard
+  {
+    std::mutex mutex;
+    Flights flights;
+  };
+
+  static constexpr size_t SHARDS = 16;
+
+  // removes the flight unless it was forgotten and replaced meanwhile
+  void land(Shard& shard, const Key& key, const FlightPtr& flight)
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    typename Flights::iterator it(shard.flights.find(key));
+    if (it != shard.flights.end() && it->second == flight)
+    {
+      shard.flights.erase(it);
+    }
+  }
+
+  uint32_t _timeoutMillis = 0;
+  Shard _shards[SHARDS];
+  std::atomic<uint64_t> _loads{0};
+  std::atomic<uint64_t> _coalesced{0};
+  std::atomic<uint64_t> _timeouts{0};
+};
+} // sfc
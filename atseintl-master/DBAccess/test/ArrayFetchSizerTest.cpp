@@ -0,0 +1,93 @@
+#include "test/include/CppUnitHelperMacros.h"
+#include "DBAccess/ArrayFetchSizer.h"
+
+namespace tse
+{
+class ArrayFetchSizerTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ArrayFetchSizerTest);
+  CPPUNIT_TEST(testDisabled);
+  CPPUNIT_TEST(testConfiguredUntilLearned);
+  CPPUNIT_TEST(testLearnedRowsPlusOne);
+  CPPUNIT_TEST(testMemoryLimit);
+  CPPUNIT_TEST(testLargerResultAtOnce);
+  CPPUNIT_TEST(testSmallerResultSlowly);
+  CPPUNIT_TEST(testFits);
+  CPPUNIT_TEST_SUITE_END();
+
+  ArrayFetchSizer* _sizer;
+
+public:
+  void setUp() { _sizer = new ArrayFetchSizer; }
+  void tearDown() { delete _sizer; }
+
+  void testDisabled()
+  {
+    CPPUNIT_ASSERT(!_sizer->enabled());
+    _sizer->record("GETFARES", 3);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), _sizer->expectedRows("GETFARES"));
+    CPPUNIT_ASSERT_EQUAL(uint16_t(50), _sizer->arrayFetchSize("GETFARES", 50, 100));
+    CPPUNIT_ASSERT_EQUAL(uint16_t(1), _sizer->arrayFetchSize("GETFARES", 0, 100));
+    CPPUNIT_ASSERT(_sizer->fits("GETFARES", 50, 100, 1));
+  }
+
+  void testConfiguredUntilLearned()
+  {
+    _sizer->setMemoryLimit(1000000);
+    CPPUNIT_ASSERT_EQUAL(uint16_t(50), _sizer->arrayFetchSize("GETFARES", 50, 100));
+  }
+
+  void testLearnedRowsPlusOne()
+  {
+    _sizer->setMemoryLimit(1000000);
+    _sizer->record("GETFARES", 3);
+    CPPUNIT_ASSERT_EQUAL(uint16_t(4), _sizer->arrayFetchSize("GETFARES", 50, 100));
+    _sizer->record("GETFARES", 200);
+    CPPUNIT_ASSERT_EQUAL(uint16_t(256), _sizer->arrayFetchSize("GETFARES", 50, 100));
+    _sizer->record("GETNATIONS", 0);
+    CPPUNIT_ASSERT_EQUAL(uint16_t(1), _sizer->arrayFetchSize("GETNATIONS", 50, 100));
+  }
+
+  void testMemoryLimit()
+  {
+    _sizer->setMemoryLimit(10000);
+    CPPUNIT_ASSERT_EQUAL(uint16_t(20), _sizer->arrayFetchSize("GETFARES", 50, 500));
+    _sizer->record("GETFARES", 5000);
+    CPPUNIT_ASSERT_EQUAL(uint16_t(20), _sizer->arrayFetchSize("GETFARES", 50, 500));
+    CPPUNIT_ASSERT_EQUAL(uint16_t(1), _sizer->arrayFetchSize("GETFARES", 50, 50000));
+  }
+
+  void testLargerResultAtOnce()
+  {
+    _sizer->setMemoryLimit(1000000);
+    _sizer->record("GETFARES", 10);
+    _sizer->record("GETFARES", 100);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(100), _sizer->expectedRows("GETFARES"));
+  }
+
+  void testSmallerResultSlowly()
+  {
+    _sizer->setMemoryLimit(1000000);
+    _sizer->record("GETFARES", 100);
+    _sizer->record("GETFARES", 20);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(90), _sizer->expectedRows("GETFARES"));
+    CPPUNIT_ASSERT_EQUAL(uint16_t(128), _sizer->arrayFetchSize("GETFARES", 50, 100));
+    for (int i = 0; i < 100; ++i)
+      _sizer->record("GETFARES", 20);
+    CPPUNIT_ASSERT_EQUAL(uint16_t(32), _sizer->arrayFetchSize("GETFARES", 50, 100));
+  }
+
+  void testFits()
+  {
+    _sizer->setMemoryLimit(1000000);
+    CPPUNIT_ASSERT(_sizer->fits("GETFARES", 50, 100, 50));
+    _sizer->record("GETFARES", 3);
+    CPPUNIT_ASSERT(!_sizer->fits("GETFARES", 50, 100, 50));
+    CPPUNIT_ASSERT(_sizer->fits("GETFARES", 50, 100, 4));
+    CPPUNIT_ASSERT(_sizer->fits("GETFARES", 50, 100, 16));
+    _sizer->record("GETFARES", 1000);
+    CPPUNIT_ASSERT(!_sizer->fits("GETFARES", 50, 100, 16));
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(ArrayFetchSizerTest);
+}
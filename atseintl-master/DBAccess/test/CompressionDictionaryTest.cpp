@@ -0,0 +1,210 @@
+#include "test/include/CppUnitHelperMacros.h"
+#include "DBAccess/CompressedData.h"
+#include "DBAccess/CompressedDataImpl.h"
+#include "DBAccess/CompressionDictionary.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+#include <lz4.h>
+#include <unistd.h>
+
+namespace tse
+{
+namespace
+{
+// flattened entry resembling a small FareInfo vector
+std::string
+entry(unsigned seed)
+{
+  static const char* const carriers[] = {"AA", "UA", "DL", "LH", "BA", "AF"};
+  std::ostringstream os;
+  for (unsigned i = 0; i <= seed % 4; ++i)
+  {
+    os << carriers[(seed + i) % 6] << "|ATP|" << (seed * 7 + i) % 1000 << "|DFW|LON|FARECLASS"
+       << char('A' + (seed + i) % 26) << "|2016-01-01|9999-12-31|USD|" << (seed * 13 + i) % 2000
+       << ".00|RULE" << (seed * 31) % 10000 << "|TARIFF" << seed % 999 << "|OWRT1|GLOBALAT|";
+  }
+  return os.str();
+}
+}
+
+class CompressionDictionaryTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(CompressionDictionaryTest);
+  CPPUNIT_TEST(testTrainRespectsMaxSize);
+  CPPUNIT_TEST(testRoundTrip);
+  CPPUNIT_TEST(testBetterRatioThanPlainLZ4);
+  CPPUNIT_TEST(testAddIsIdempotent);
+  CPPUNIT_TEST(testUnknownDictionary);
+  CPPUNIT_TEST(testPlainDataIsNotDictionaryCompressed);
+  CPPUNIT_TEST(testSlotTrainsAfterSamples);
+  CPPUNIT_TEST(testSaveAndLoad);
+  CPPUNIT_TEST(testRemoveFiles);
+  CPPUNIT_TEST(testWithoutDictionary);
+  CPPUNIT_TEST_SUITE_END();
+
+  std::vector<std::string> _samples;
+
+  const CompressionDictionary* trained()
+  {
+    return CompressionDictionaries::add(trainDictionary(_samples, 16 * 1024));
+  }
+
+public:
+  void setUp()
+  {
+    for (unsigned i = 0; i < 300; ++i)
+    {
+      _samples.push_back(entry(i));
+    }
+  }
+
+  void tearDown() { _samples.clear(); }
+
+  void testTrainRespectsMaxSize()
+  {
+    const std::string dictionary(trainDictionary(_samples, 1000));
+    CPPUNIT_ASSERT(!dictionary.empty());
+    CPPUNIT_ASSERT(dictionary.size() <= 1000);
+    CPPUNIT_ASSERT(trainDictionary(std::vector<std::string>(), 1000).empty());
+  }
+
+  void testRoundTrip()
+  {
+    const CompressionDictionary* dictionary(trained());
+    CPPUNIT_ASSERT(dictionary != nullptr);
+    for (unsigned i = 1000; i < 1100; ++i)
+    {
+      const std::string input(entry(i));
+      std::vector<char> deflated;
+      CPPUNIT_ASSERT(compressWithDictionary(*dictionary, input.data(), input.size(), deflated));
+      CPPUNIT_ASSERT(isDictionaryCompressed(deflated));
+      std::string output(input.size(), '\0');
+      CPPUNIT_ASSERT(uncompressWithDictionary(deflated, &output[0], output.size()));
+      CPPUNIT_ASSERT_EQUAL(input, output);
+    }
+  }
+
+  void testBetterRatioThanPlainLZ4()
+  {
+    const CompressionDictionary* dictionary(trained());
+    size_t plainBytes(0);
+    size_t dictionaryBytes(0);
+    for (unsigned i = 1000; i < 1100; ++i)
+    {
+      const std::string input(entry(i));
+      std::vector<char> plain(LZ4_compressBound(input.size()));
+      plainBytes += LZ4_compress(input.data(), &plain[0], input.size());
+      std::vector<char> deflated;
+      compressWithDictionary(*dictionary, input.data(), input.size(), deflated);
+      dictionaryBytes += deflated.size();
+    }
+    CPPUNIT_ASSERT(dictionaryBytes < plainBytes);
+  }
+
+  void testAddIsIdempotent()
+  {
+    const std::string content(trainDictionary(_samples, 4096));
+    const CompressionDictionary* dictionary(CompressionDictionaries::add(content));
+    CPPUNIT_ASSERT(dictionary != nullptr);
+    CPPUNIT_ASSERT_EQUAL(dictionary, CompressionDictionaries::add(content));
+    CPPUNIT_ASSERT_EQUAL(dictionary, CompressionDictionaries::find(dictionaryId(*dictionary)));
+    CPPUNIT_ASSERT_EQUAL(content, dictionaryContent(*dictionary));
+  }
+
+  void testUnknownDictionary()
+  {
+    const CompressionDictionary* dictionary(trained());
+    const std::string input(entry(5000));
+    std::vector<char> deflated;
+    compressWithDictionary(*dictionary, input.data(), input.size(), deflated);
+    // corrupt the dictionary id
+    deflated[5] ^= 0x5a;
+    deflated[6] ^= 0x5a;
+    std::string output(input.size(), '\0');
+    CPPUNIT_ASSERT(!uncompressWithDictionary(deflated, &output[0], output.size()));
+  }
+
+  void testPlainDataIsNotDictionaryCompressed()
+  {
+    const std::string input(entry(7));
+    std::vector<char> plain(LZ4_compressBound(input.size()));
+    plain.resize(LZ4_compress(input.data(), &plain[0], input.size()));
+    CPPUNIT_ASSERT(!isDictionaryCompressed(plain));
+    CPPUNIT_ASSERT(!isDictionaryCompressed(std::vector<char>()));
+  }
+
+  void testSlotTrainsAfterSamples()
+  {
+    CompressionDictionarySlot slot("CompressionDictionaryTest", 50);
+    for (unsigned i = 0; i < 49; ++i)
+    {
+      slot.addSample(_samples[i].data(), _samples[i].size());
+    }
+    CPPUNIT_ASSERT(slot.dictionary() == nullptr);
+    slot.addSample(_samples[49].data(), _samples[49].size());
+    CPPUNIT_ASSERT(slot.dictionary() != nullptr);
+  }
+
+  void testSaveAndLoad()
+  {
+    char directory[] = "/tmp/CompressionDictionaryTestXXXXXX";
+    CPPUNIT_ASSERT(mkdtemp(directory) != nullptr);
+    CompressionDictionarySlot slot("CompressionDictionaryTest", 50, directory);
+    for (unsigned i = 0; i < 50; ++i)
+    {
+      slot.addSample(_samples[i].data(), _samples[i].size());
+    }
+    CompressionDictionarySlot loaded("CompressionDictionaryTest", 50);
+    CPPUNIT_ASSERT(CompressionDictionaries::load(loaded, directory));
+    CPPUNIT_ASSERT_EQUAL(slot.dictionary(), loaded.dictionary());
+    std::remove((std::string(directory) + "/CompressionDictionaryTest.lz4dict").c_str());
+    rmdir(directory);
+  }
+
+  void testRemoveFiles()
+  {
+    char directory[] = "/tmp/CompressionDictionaryTestXXXXXX";
+    CPPUNIT_ASSERT(mkdtemp(directory) != nullptr);
+    CompressionDictionarySlot slot("CompressionDictionaryTest", 50, directory);
+    for (unsigned i = 0; i < 50; ++i)
+    {
+      slot.addSample(_samples[i].data(), _samples[i].size());
+    }
+    const std::string other(std::string(directory) + "/FARE.db");
+    std::ofstream(other.c_str()) << "ldc";
+    CPPUNIT_ASSERT_EQUAL(size_t(1), CompressionDictionaries::removeFiles(directory));
+    CompressionDictionarySlot loaded("CompressionDictionaryTest", 50);
+    CPPUNIT_ASSERT(!CompressionDictionaries::load(loaded, directory));
+    CPPUNIT_ASSERT(std::ifstream(other.c_str()).good());
+    std::remove(other.c_str());
+    rmdir(directory);
+  }
+
+  void testWithoutDictionary()
+  {
+    const CompressionDictionary* dictionary(trained());
+    const std::string input(entry(6000));
+    std::vector<char> deflated;
+    CPPUNIT_ASSERT(compressWithDictionary(*dictionary, input.data(), input.size(), deflated));
+    const sfc::CompressedData withDictionary(deflated, input.size(), deflated.size());
+
+    std::unique_ptr<sfc::CompressedData> plain(
+        CompressedDataImpl::withoutDictionary(withDictionary));
+    CPPUNIT_ASSERT(plain != nullptr);
+    CPPUNIT_ASSERT(!isDictionaryCompressed(plain->_deflated));
+    CPPUNIT_ASSERT_EQUAL(input.size(), plain->_inflatedSz);
+    std::vector<char> buffer;
+    const std::vector<char>* inflated(CompressedDataImpl::uncompress(*plain, buffer));
+    CPPUNIT_ASSERT(inflated != nullptr);
+    CPPUNIT_ASSERT_EQUAL(input, std::string(inflated->begin(), inflated->end()));
+
+    CPPUNIT_ASSERT(CompressedDataImpl::withoutDictionary(*plain) == nullptr);
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(CompressionDictionaryTest);
+}
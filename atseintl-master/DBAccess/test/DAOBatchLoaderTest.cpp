@@ -0,0 +1,174 @@
+#include "test/include/CppUnitHelperMacros.h"
+#include "DBAccess/DAOBatchLoader.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tse
+{
+namespace
+{
+typedef DAOBatchLoader<std::string, std::string> Loader;
+
+struct Query
+{
+  std::atomic<int> calls{0};
+  std::atomic<size_t> largest{0};
+  bool fail = false;
+
+  Loader::BatchQuery function()
+  {
+    return [this](const std::vector<std::string>& keys, std::vector<std::string*>& results)
+    {
+      ++calls;
+      if (keys.size() > largest)
+        largest = keys.size();
+      if (fail)
+        throw std::runtime_error("ORA-03113");
+      for (const std::string& key : keys)
+        results.push_back(new std::string("value of " + key));
+    };
+  }
+};
+}
+
+class DAOBatchLoaderTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(DAOBatchLoaderTest);
+  CPPUNIT_TEST(testDisabled);
+  CPPUNIT_TEST(testSingleKey);
+  CPPUNIT_TEST(testConcurrentMissesCoalesce);
+  CPPUNIT_TEST(testFullBatchDoesNotWait);
+  CPPUNIT_TEST(testGroupsLoadSeparately);
+  CPPUNIT_TEST(testErrorReachesAllWaiters);
+  CPPUNIT_TEST_SUITE_END();
+
+  // each thread loads its own key, all of one group unless groups > 1
+  void loadConcurrently(Loader& loader,
+                        Query& query,
+                        size_t threads,
+                        size_t groups,
+                        std::vector<std::string>& values,
+                        std::atomic<int>& errors)
+  {
+    values.assign(threads, "");
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < threads; ++i)
+    {
+      workers.emplace_back([&, i]()
+                           {
+        const std::string group("G" + std::to_string(i % groups));
+        const std::string key(group + "|" + std::to_string(i));
+        std::string* value(nullptr);
+        try
+        {
+          if (loader.load(group, key, query.function(), value))
+          {
+            values[i] = *value;
+            delete value;
+          }
+        }
+        catch (const std::runtime_error&)
+        {
+          ++errors;
+        }
+      });
+    }
+    for (std::thread& worker : workers)
+      worker.join();
+  }
+
+public:
+  void testDisabled()
+  {
+    Loader loader;
+    CPPUNIT_ASSERT(!loader.enabled());
+    loader.setLimits(1000, 1);
+    CPPUNIT_ASSERT(!loader.enabled());
+    loader.setLimits(0, 100);
+    CPPUNIT_ASSERT(!loader.enabled());
+    loader.setLimits(1000, 100);
+    CPPUNIT_ASSERT(loader.enabled());
+  }
+
+  void testSingleKey()
+  {
+    Loader loader;
+    loader.setLimits(1000, 100);
+    Query query;
+    std::string* value(nullptr);
+    CPPUNIT_ASSERT(loader.load("G", "G|1", query.function(), value));
+    CPPUNIT_ASSERT_EQUAL(std::string("value of G|1"), *value);
+    CPPUNIT_ASSERT_EQUAL(1, query.calls.load());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), loader.batches());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), loader.batchedKeys());
+    delete value;
+  }
+
+  void testConcurrentMissesCoalesce()
+  {
+    Loader loader;
+    loader.setLimits(200000, 100);
+    Query query;
+    std::vector<std::string> values;
+    std::atomic<int> errors(0);
+    loadConcurrently(loader, query, 16, 1, values, errors);
+
+    CPPUNIT_ASSERT_EQUAL(0, errors.load());
+    for (size_t i = 0; i < values.size(); ++i)
+      CPPUNIT_ASSERT_EQUAL("value of G0|" + std::to_string(i), values[i]);
+    CPPUNIT_ASSERT(query.calls.load() < 16);
+    CPPUNIT_ASSERT(query.largest.load() > 1);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(16), loader.batchedKeys());
+  }
+
+  void testFullBatchDoesNotWait()
+  {
+    Loader loader;
+    // a window long enough to fail the test if a full batch waited for it
+    loader.setLimits(60000000, 4);
+    Query query;
+    std::vector<std::string> values;
+    std::atomic<int> errors(0);
+    loadConcurrently(loader, query, 8, 1, values, errors);
+
+    CPPUNIT_ASSERT_EQUAL(0, errors.load());
+    CPPUNIT_ASSERT_EQUAL(2, query.calls.load());
+    CPPUNIT_ASSERT_EQUAL(size_t(4), query.largest.load());
+  }
+
+  void testGroupsLoadSeparately()
+  {
+    Loader loader;
+    loader.setLimits(200000, 100);
+    Query query;
+    std::vector<std::string> values;
+    std::atomic<int> errors(0);
+    loadConcurrently(loader, query, 12, 3, values, errors);
+
+    CPPUNIT_ASSERT_EQUAL(0, errors.load());
+    for (size_t i = 0; i < values.size(); ++i)
+      CPPUNIT_ASSERT_EQUAL("value of G" + std::to_string(i % 3) + "|" + std::to_string(i),
+                           values[i]);
+    CPPUNIT_ASSERT(query.calls.load() >= 3);
+  }
+
+  void testErrorReachesAllWaiters()
+  {
+    Loader loader;
+    loader.setLimits(60000000, 4);
+    Query query;
+    query.fail = true;
+    std::vector<std::string> values;
+    std::atomic<int> errors(0);
+    loadConcurrently(loader, query, 4, 1, values, errors);
+
+    CPPUNIT_ASSERT_EQUAL(4, errors.load());
+    CPPUNIT_ASSERT_EQUAL(1, query.calls.load());
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(DAOBatchLoaderTest);
+}
@@ -0,0 +1,64 @@
+#include "test/include/CppUnitHelperMacros.h"
+#include "DBAccess/FrequencySketch.h"
+
+namespace tse
+{
+class FrequencySketchTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(FrequencySketchTest);
+  CPPUNIT_TEST(testIncrement);
+  CPPUNIT_TEST(testCountersSaturate);
+  CPPUNIT_TEST(testAging);
+  CPPUNIT_TEST(testClear);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testIncrement()
+  {
+    sfc::FrequencySketch sketch(100);
+    CPPUNIT_ASSERT_EQUAL(0u, sketch.frequency(42));
+    for (int i = 0; i < 3; ++i)
+    {
+      sketch.increment(42);
+    }
+    sketch.increment(43);
+    CPPUNIT_ASSERT_EQUAL(3u, sketch.frequency(42));
+    CPPUNIT_ASSERT(sketch.frequency(43) >= 1);
+  }
+
+  void testCountersSaturate()
+  {
+    sfc::FrequencySketch sketch(1000);
+    for (int i = 0; i < 100; ++i)
+    {
+      sketch.increment(7);
+    }
+    CPPUNIT_ASSERT_EQUAL(15u, sketch.frequency(7));
+  }
+
+  void testAging()
+  {
+    sfc::FrequencySketch sketch(10);
+    for (int i = 0; i < 8; ++i)
+    {
+      sketch.increment(1);
+    }
+    // the sample size is 10 * capacity, other keys push it over
+    for (size_t key = 100; key < 200; ++key)
+    {
+      sketch.increment(key);
+    }
+    CPPUNIT_ASSERT(sketch.frequency(1) <= 4);
+    CPPUNIT_ASSERT(sketch.frequency(1) >= 1);
+  }
+
+  void testClear()
+  {
+    sfc::FrequencySketch sketch(10);
+    sketch.increment(5);
+    sketch.clear();
+    CPPUNIT_ASSERT_EQUAL(0u, sketch.frequency(5));
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(FrequencySketchTest);
+}
@@ -0,0 +1,270 @@
+#include "test/include/CppUnitHelperMacros.h"
+#include "Common/TseCodeTypes.h"
+#include "DBAccess/PerfectHash.h"
+#include "DBAccess/SimpleCache.h"
+#include "test/include/MockDataManager.h"
+#include "test/include/TestConfigInitializer.h"
+#include "test/include/TestMemHandle.h"
+
+#include <algorithm>
+
+namespace tse
+{
+namespace
+{
+class LocFactory : public sfc::KeyedFactory<LocCode, std::string>
+{
+public:
+  LocFactory() : _created(0) {}
+
+  std::string* create(LocCode key) override
+  {
+    ++_created;
+    return new std::string(key.c_str());
+  }
+
+  void destroy(LocCode key, std::string* object) override { delete object; }
+
+  int _created;
+};
+
+// All three letter city/airport codes plus five letter codes, about the size
+// of the production Loc table.
+void
+locCodes(std::vector<LocCode>& codes)
+{
+  char code[6] = {};
+  for (code[0] = 'A'; code[0] <= 'Z'; ++code[0])
+    for (code[1] = 'A'; code[1] <= 'Z'; ++code[1])
+      for (code[2] = 'A'; code[2] <= 'Z'; ++code[2])
+      {
+        code[3] = 0;
+        codes.push_back(LocCode(code));
+      }
+  for (int i = 0; i < 20000; ++i)
+  {
+    code[0] = 'A' + i % 26;
+    code[1] = 'A' + i / 26 % 26;
+    code[2] = '0' + i / 676 % 10;
+    code[3] = '0' + i / 6760 % 10;
+    code[4] = 0;
+    codes.push_back(LocCode(code));
+  }
+  std::sort(codes.begin(), codes.end());
+  codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+}
+
+// Ids below 4 share one hash value, which no seed can separate.
+struct CollidingKey
+{
+  int _id;
+
+  bool operator==(const CollidingKey& other) const { return _id == other._id; }
+};
+
+size_t
+hash_value(const CollidingKey& key)
+{
+  return key._id < 4 ? 0 : key._id;
+}
+}
+
+class FrozenCacheTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(FrozenCacheTest);
+  CPPUNIT_TEST(testIndexFindsAllKeys);
+  CPPUNIT_TEST(testIndexRejectsUnknownKeys);
+  CPPUNIT_TEST(testIndexCopyWith);
+  CPPUNIT_TEST(testConsolidateFreezes);
+  CPPUNIT_TEST(testIndexSkipsCollidingKeys);
+  CPPUNIT_TEST(testMissesTriggerRebuild);
+  CPPUNIT_TEST(testMissesDoNotRebuildOnLookup);
+  CPPUNIT_TEST(testInvalidate);
+  CPPUNIT_TEST(testPutReplacesFrozen);
+  CPPUNIT_TEST(testClear);
+  CPPUNIT_TEST_SUITE_END();
+
+  class SpecificTestConfigInitializer : public TestConfigInitializer
+  {
+  public:
+    SpecificTestConfigInitializer()
+    {
+      DiskCache::initialize(_config);
+      _memHandle.create<MockDataManager>();
+    }
+
+    ~SpecificTestConfigInitializer() { _memHandle.clear(); }
+
+  private:
+    TestMemHandle _memHandle;
+  };
+
+  typedef PerfectHashIndex<LocCode, int> Index;
+
+  TestMemHandle _memHandle;
+  LocFactory* _factory;
+  std::vector<LocCode> _codes;
+
+public:
+  void setUp()
+  {
+    _memHandle.create<SpecificTestConfigInitializer>();
+    _factory = _memHandle.create<LocFactory>();
+    locCodes(_codes);
+  }
+
+  void tearDown()
+  {
+    _memHandle.clear();
+    _codes.clear();
+  }
+
+  void buildIndexEntries(std::vector<Index::Entry>& entries)
+  {
+    for (size_t i = 0; i < _codes.size(); ++i)
+    {
+      Index::Entry entry;
+      entry._key = _codes[i];
+      entry._value = static_cast<int>(i + 1);
+      entries.push_back(entry);
+    }
+  }
+
+  void testIndexFindsAllKeys()
+  {
+    std::vector<Index::Entry> entries;
+    buildIndexEntries(entries);
+    Index index(entries);
+    CPPUNIT_ASSERT_EQUAL(entries.size(), index.size());
+    for (const Index::Entry& entry : entries)
+    {
+      const int* value(index.find(entry._key));
+      CPPUNIT_ASSERT(value != nullptr);
+      CPPUNIT_ASSERT_EQUAL(entry._value, *value);
+    }
+  }
+
+  void testIndexRejectsUnknownKeys()
+  {
+    std::vector<Index::Entry> entries;
+    buildIndexEntries(entries);
+    Index index(entries);
+    CPPUNIT_ASSERT(index.find(LocCode("ZZZZZ")) == nullptr);
+    CPPUNIT_ASSERT(index.find(LocCode("A")) == nullptr);
+    CPPUNIT_ASSERT(Index().find(LocCode("DFW")) == nullptr);
+  }
+
+  void testIndexCopyWith()
+  {
+    std::vector<Index::Entry> entries;
+    buildIndexEntries(entries);
+    Index index(entries);
+    std::unique_ptr<Index> removed(index.copyWith(LocCode("DFW"), 0));
+    CPPUNIT_ASSERT(removed.get() != nullptr);
+    CPPUNIT_ASSERT(removed->find(LocCode("DFW")) == nullptr);
+    CPPUNIT_ASSERT(removed->find(LocCode("KRK")) != nullptr);
+    CPPUNIT_ASSERT(index.find(LocCode("DFW")) != nullptr);
+    CPPUNIT_ASSERT(index.copyWith(LocCode("ZZZZZ"), 1) == nullptr);
+  }
+
+  void testConsolidateFreezes()
+  {
+    FrozenCache<LocCode, std::string> cache(*_factory, "Loc", 0, 1);
+    for (size_t i = 0; i < 50; ++i)
+    {
+      cache.put(_codes[i], new std::string(_codes[i].c_str()), false);
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(0), cache.frozenSize());
+    CPPUNIT_ASSERT_EQUAL(size_t(50), cache.consolidationSize());
+    CPPUNIT_ASSERT_EQUAL(size_t(50), cache.consolidate(0));
+    CPPUNIT_ASSERT_EQUAL(size_t(50), cache.frozenSize());
+    CPPUNIT_ASSERT_EQUAL(std::string(_codes[7].c_str()), *cache.get(_codes[7]));
+    CPPUNIT_ASSERT_EQUAL(0, _factory->_created);
+  }
+
+  void testIndexSkipsCollidingKeys()
+  {
+    typedef PerfectHashIndex<CollidingKey, int> CollidingIndex;
+    std::vector<CollidingIndex::Entry> entries;
+    for (int i = 0; i < 100; ++i)
+    {
+      CollidingIndex::Entry entry;
+      entry._key._id = i;
+      entry._value = i + 1;
+      entries.push_back(entry);
+    }
+    CollidingIndex index(entries);
+    CPPUNIT_ASSERT_EQUAL(size_t(96), index.size());
+    for (int i = 0; i < 100; ++i)
+    {
+      const CollidingKey key = {i};
+      const int* value(index.find(key));
+      if (i < 4)
+      {
+        CPPUNIT_ASSERT(value == nullptr);
+      }
+      else
+      {
+        CPPUNIT_ASSERT(value != nullptr);
+        CPPUNIT_ASSERT_EQUAL(i + 1, *value);
+      }
+    }
+  }
+
+  void testMissesTriggerRebuild()
+  {
+    FrozenCache<LocCode, std::string> cache(*_factory, "Loc", 0, 1);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(std::string(_codes[i].c_str()), *cache.get(_codes[i]));
+    }
+    cache.emptyTrash();
+    CPPUNIT_ASSERT_EQUAL(size_t(1000), cache.frozenSize());
+    CPPUNIT_ASSERT_EQUAL(1000, _factory->_created);
+  }
+
+  void testMissesDoNotRebuildOnLookup()
+  {
+    FrozenCache<LocCode, std::string> cache(*_factory, "Loc", 0, 1);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      cache.get(_codes[i]);
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(0), cache.frozenSize());
+    CPPUNIT_ASSERT_EQUAL(size_t(1000), cache.consolidationSize());
+  }
+
+  void testInvalidate()
+  {
+    FrozenCache<LocCode, std::string> cache(*_factory, "Loc", 0, 1);
+    cache.get(LocCode("DFW"));
+    cache.get(LocCode("KRK"));
+    cache.consolidate(0);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), cache.invalidate(LocCode("DFW")));
+    CPPUNIT_ASSERT(!cache.getIfResident(LocCode("DFW")));
+    CPPUNIT_ASSERT(cache.getIfResident(LocCode("KRK")));
+    cache.get(LocCode("DFW"));
+    CPPUNIT_ASSERT_EQUAL(3, _factory->_created);
+  }
+
+  void testPutReplacesFrozen()
+  {
+    FrozenCache<LocCode, std::string> cache(*_factory, "Loc", 0, 1);
+    cache.get(LocCode("DFW"));
+    cache.consolidate(0);
+    cache.put(LocCode("DFW"), new std::string("Dallas"), false);
+    CPPUNIT_ASSERT_EQUAL(std::string("Dallas"), *cache.get(LocCode("DFW")));
+  }
+
+  void testClear()
+  {
+    FrozenCache<LocCode, std::string> cache(*_factory, "Loc", 0, 1);
+    cache.get(LocCode("DFW"));
+    cache.consolidate(0);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), cache.clear());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), cache.frozenSize());
+    CPPUNIT_ASSERT(!cache.getIfResident(LocCode("DFW")));
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(FrozenCacheTest);
+}
@@ -0,0 +1,203 @@
+#include "test/include/CppUnitHelperMacros.h"
+#include "DBAccess/LDCMappedFile.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+
+#include <unistd.h>
+
+namespace tse
+{
+namespace
+{
+std::string
+key(unsigned i)
+{
+  std::ostringstream os;
+  os << "ATP|AA|" << i;
+  return os.str();
+}
+
+std::string
+data(unsigned i)
+{
+  return std::string(i % 97 + 1, char('a' + i % 26));
+}
+}
+
+class LDCMappedFileTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(LDCMappedFileTest);
+  CPPUNIT_TEST(testFind);
+  CPPUNIT_TEST(testRecordsAreAligned);
+  CPPUNIT_TEST(testAllRecords);
+  CPPUNIT_TEST(testEmpty);
+  CPPUNIT_TEST(testOtherTableVersion);
+  CPPUNIT_TEST(testTruncatedFile);
+  CPPUNIT_TEST(testNotCommitted);
+  CPPUNIT_TEST(testMappingOutlivesFile);
+  CPPUNIT_TEST(testSupersededLog);
+  CPPUNIT_TEST(testSupersededLogRewritten);
+  CPPUNIT_TEST(testTornSupersededLog);
+  CPPUNIT_TEST_SUITE_END();
+
+  std::string _directory;
+  std::string _path;
+
+  void write(unsigned count, uint32_t version = 3)
+  {
+    LDCMappedFile::Writer writer(_path, version);
+    for (unsigned i = 0; i < count; ++i)
+    {
+      const std::string d(data(i));
+      CPPUNIT_ASSERT(writer.add(key(i), d.data(), d.size()));
+    }
+    CPPUNIT_ASSERT(writer.commit());
+  }
+
+public:
+  void setUp()
+  {
+    char directory[] = "/tmp/LDCMappedFileTestXXXXXX";
+    CPPUNIT_ASSERT(mkdtemp(directory) != nullptr);
+    _directory = directory;
+    _path = _directory + "/FARE.3.ldcm";
+  }
+
+  void tearDown()
+  {
+    std::remove(_path.c_str());
+    std::remove(LDCMappedFile::supersededPath(_path).c_str());
+    rmdir(_directory.c_str());
+  }
+
+  void testFind()
+  {
+    write(1000);
+    std::shared_ptr<const LDCMappedFile> file(LDCMappedFile::open(_path, 3));
+    CPPUNIT_ASSERT(file != nullptr);
+    CPPUNIT_ASSERT_EQUAL(size_t(1000), file->size());
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+      LDCMappedFile::Record record;
+      CPPUNIT_ASSERT(file->find(key(i), record));
+      CPPUNIT_ASSERT_EQUAL(key(i), std::string(record.key, record.keySize));
+      CPPUNIT_ASSERT_EQUAL(data(i), std::string(record.data, record.dataSize));
+    }
+    LDCMappedFile::Record record;
+    CPPUNIT_ASSERT(!file->find(key(1000), record));
+    CPPUNIT_ASSERT(!file->find("", record));
+  }
+
+  void testRecordsAreAligned()
+  {
+    write(100);
+    std::shared_ptr<const LDCMappedFile> file(LDCMappedFile::open(_path, 3));
+    for (size_t i = 0; i < file->size(); ++i)
+    {
+      const LDCMappedFile::Record record(file->record(i));
+      CPPUNIT_ASSERT_EQUAL(uintptr_t(0), reinterpret_cast<uintptr_t>(record.data) % 8);
+    }
+  }
+
+  void testAllRecords()
+  {
+    write(500);
+    std::shared_ptr<const LDCMappedFile> file(LDCMappedFile::open(_path, 3));
+    std::set<std::string> keys;
+    for (size_t i = 0; i < file->size(); ++i)
+    {
+      const LDCMappedFile::Record record(file->record(i));
+      CPPUNIT_ASSERT(record.key != nullptr);
+      keys.insert(std::string(record.key, record.keySize));
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(500), keys.size());
+    CPPUNIT_ASSERT(file->record(500).key == nullptr);
+  }
+
+  void testEmpty()
+  {
+    write(0);
+    std::shared_ptr<const LDCMappedFile> file(LDCMappedFile::open(_path, 3));
+    CPPUNIT_ASSERT(file != nullptr);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), file->size());
+    LDCMappedFile::Record record;
+    CPPUNIT_ASSERT(!file->find(key(0), record));
+  }
+
+  void testOtherTableVersion()
+  {
+    write(10, 4);
+    CPPUNIT_ASSERT(LDCMappedFile::open(_path, 3) == nullptr);
+    CPPUNIT_ASSERT(LDCMappedFile::open(_path, 4) != nullptr);
+  }
+
+  void testTruncatedFile()
+  {
+    write(10);
+    CPPUNIT_ASSERT_EQUAL(0, truncate(_path.c_str(), 100));
+    CPPUNIT_ASSERT(LDCMappedFile::open(_path, 3) == nullptr);
+    CPPUNIT_ASSERT(LDCMappedFile::open(_directory + "/MISSING.3.ldcm", 3) == nullptr);
+  }
+
+  void testNotCommitted()
+  {
+    {
+      LDCMappedFile::Writer writer(_path, 3);
+      CPPUNIT_ASSERT(writer.add(key(0), "x", 1));
+    }
+    CPPUNIT_ASSERT(access(_path.c_str(), F_OK) != 0);
+    CPPUNIT_ASSERT(access((_path + ".tmp").c_str(), F_OK) != 0);
+  }
+
+  void testMappingOutlivesFile()
+  {
+    write(10);
+    std::shared_ptr<const LDCMappedFile> file(LDCMappedFile::open(_path, 3));
+    std::remove(_path.c_str());
+    LDCMappedFile::Record record;
+    CPPUNIT_ASSERT(file->find(key(7), record));
+    CPPUNIT_ASSERT_EQUAL(data(7), std::string(record.data, record.dataSize));
+  }
+
+  void testSupersededLog()
+  {
+    std::set<std::string> keys;
+    CPPUNIT_ASSERT(LDCMappedFile::readSuperseded(_path, keys));
+    CPPUNIT_ASSERT(keys.empty());
+
+    CPPUNIT_ASSERT(LDCMappedFile::appendSuperseded(_path, key(1)));
+    CPPUNIT_ASSERT(LDCMappedFile::appendSuperseded(_path, key(2)));
+    CPPUNIT_ASSERT(LDCMappedFile::appendSuperseded(_path, key(1)));
+    CPPUNIT_ASSERT(LDCMappedFile::readSuperseded(_path, keys));
+    CPPUNIT_ASSERT_EQUAL(size_t(2), keys.size());
+    CPPUNIT_ASSERT(keys.count(key(1)) && keys.count(key(2)));
+  }
+
+  void testSupersededLogRewritten()
+  {
+    CPPUNIT_ASSERT(LDCMappedFile::appendSuperseded(_path, key(1)));
+    std::set<std::string> written;
+    written.insert(key(3));
+    CPPUNIT_ASSERT(LDCMappedFile::writeSuperseded(_path, written));
+
+    std::set<std::string> keys;
+    CPPUNIT_ASSERT(LDCMappedFile::readSuperseded(_path, keys));
+    CPPUNIT_ASSERT(keys == written);
+    CPPUNIT_ASSERT(access((LDCMappedFile::supersededPath(_path) + ".tmp").c_str(), F_OK) != 0);
+  }
+
+  void testTornSupersededLog()
+  {
+    CPPUNIT_ASSERT(LDCMappedFile::appendSuperseded(_path, key(1)));
+    CPPUNIT_ASSERT(LDCMappedFile::appendSuperseded(_path, key(2)));
+    const std::string logPath(LDCMappedFile::supersededPath(_path));
+    CPPUNIT_ASSERT_EQUAL(0, truncate(logPath.c_str(), 4 + key(1).size() + 2));
+    std::set<std::string> keys;
+    CPPUNIT_ASSERT(!LDCMappedFile::readSuperseded(_path, keys));
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(LDCMappedFileTest);
+}
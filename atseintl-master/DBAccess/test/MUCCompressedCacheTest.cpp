@@ -38,6 +38,7 @@ class MUCCompressedCacheTest : public CppUnit::TestFixture
   CPPUNIT_TEST(testMUCCompressedCache_2);
   CPPUNIT_TEST(testMUCCompressedCache_3);
   CPPUNIT_TEST(testMUCCompressedCache_4);
+  CPPUNIT_TEST(testHotEntriesStayInflated);
   CPPUNIT_TEST_SUITE_END();
 
   TestMemHandle _memHandle;
@@ -228,6 +229,43 @@ public:
     return 0;
   }
 
+  void testHotEntriesStayInflated()
+  {
+    TestMarkupControlDAO dao;
+    sfc::TestKeyedFactory<Key, std::vector<MarkupControl*> > factory(dao);
+    sfc::CompressedCacheTest<Key, std::vector<MarkupControl*> > cache(
+        factory, "MarkupControl", 10, 3);
+    for (Key key = 0; key < 100; ++key)
+    {
+      CPPUNIT_ASSERT(cache.get(key));
+    }
+    for (int i = 0; i < 20; ++i)
+    {
+      for (Key key = 0; key < 5; ++key)
+      {
+        CPPUNIT_ASSERT(cache.get(key));
+      }
+    }
+    // a scan of cold entries must not deflate the hot ones
+    for (Key key = 50; key < 60; ++key)
+    {
+      CPPUNIT_ASSERT(checkEntry(key, *cache.get(key)));
+    }
+    sfc::CompressedCacheStats before;
+    cache.getCompressionStats(before);
+    CPPUNIT_ASSERT(before._admissionRejects > 0);
+    for (Key key = 0; key < 5; ++key)
+    {
+      CPPUNIT_ASSERT(checkEntry(key, *cache.get(key)));
+    }
+    sfc::CompressedCacheStats after;
+    cache.getCompressionStats(after);
+    CPPUNIT_ASSERT_EQUAL(before._hits + 5, after._hits);
+    CPPUNIT_ASSERT_EQUAL(before._inflations, after._inflations);
+    CPPUNIT_ASSERT_EQUAL(size_t(100), after._misses);
+    CPPUNIT_ASSERT(after._errors.empty());
+  }
+
   void testMUCCompressedCache_1() { testMUCCache(CACHE_SIZE); }
 
   void testMUCCompressedCache_2() { testMUCCache(MAXNUMBERKEYS); }
@@ -0,0 +1,232 @@
+#include "test/include/CppUnitHelperMacros.h"
+#include "DBAccess/ShardedLRUCache.h"
+#include "test/include/MockDataManager.h"
+#include "test/include/TestConfigInitializer.h"
+#include "test/include/TestMemHandle.h"
+
+#include <boost/atomic.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+
+#include <stdexcept>
+
+namespace tse
+{
+namespace
+{
+typedef int Key;
+
+class CountingFactory : public sfc::KeyedFactory<Key, std::string>
+{
+public:
+  CountingFactory() : _created(0), _throwOn(-1) {}
+
+  std::string* create(Key key) override
+  {
+    ++_created;
+    if (key == _throwOn)
+    {
+      throw std::runtime_error("create failed");
+    }
+    return new std::string(boost::lexical_cast<std::string>(key));
+  }
+
+  void destroy(Key key, std::string* object) override { delete object; }
+
+  boost::atomic<int> _created;
+  int _throwOn;
+};
+
+// Each worker hammers a small, hot key range, which is the access pattern of
+// the Fare and GeneralFareRule caches in a busy pricing server.
+struct Worker
+{
+  Worker(sfc::Cache<Key, std::string>& cache, int numKeys, int numGets, int seed, int& numErrors)
+    : _cache(cache), _numKeys(numKeys), _numGets(numGets), _seed(seed), _numErrors(numErrors)
+  {
+  }
+
+  void run()
+  {
+    unsigned state(static_cast<unsigned>(_seed) * 2654435761u + 1);
+    for (int i = 0; i < _numGets; ++i)
+    {
+      state = state * 1103515245u + 12345u;
+      const Key key(static_cast<Key>((state >> 8) % _numKeys));
+      const std::string* ptr(_cache.get(key).get());
+      if (nullptr == ptr || *ptr != boost::lexical_cast<std::string>(key))
+      {
+        ++_numErrors;
+      }
+    }
+  }
+
+  sfc::Cache<Key, std::string>& _cache;
+  const int _numKeys;
+  const int _numGets;
+  const int _seed;
+  int& _numErrors;
+};
+}
+
+class ShardedLRUCacheTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ShardedLRUCacheTest);
+  CPPUNIT_TEST(testNumberOfShardsRoundedToPowerOf2);
+  CPPUNIT_TEST(testGetCreatesOnce);
+  CPPUNIT_TEST(testCapacityIsEnforced);
+  CPPUNIT_TEST(testReferencedEntriesSurviveEviction);
+  CPPUNIT_TEST(testInvalidate);
+  CPPUNIT_TEST(testPutReplaces);
+  CPPUNIT_TEST(testClear);
+  CPPUNIT_TEST(testCreateFailureRemovesPlaceholder);
+  CPPUNIT_TEST(testMultiThread);
+  CPPUNIT_TEST_SUITE_END();
+
+  class SpecificTestConfigInitializer : public TestConfigInitializer
+  {
+  public:
+    SpecificTestConfigInitializer()
+    {
+      DiskCache::initialize(_config);
+      _memHandle.create<MockDataManager>();
+    }
+
+    ~SpecificTestConfigInitializer() { _memHandle.clear(); }
+
+  private:
+    TestMemHandle _memHandle;
+  };
+
+  TestMemHandle _memHandle;
+  CountingFactory* _factory;
+
+public:
+  void setUp()
+  {
+    _memHandle.create<SpecificTestConfigInitializer>();
+    _factory = _memHandle.create<CountingFactory>();
+  }
+
+  void tearDown() { _memHandle.clear(); }
+
+  void testNumberOfShardsRoundedToPowerOf2()
+  {
+    sfc::ShardedLRUCache<Key, std::string> cache(*_factory, "Test", 1, 100, 5);
+    CPPUNIT_ASSERT_EQUAL(size_t(8), cache.numberOfShards());
+    sfc::ShardedLRUCache<Key, std::string> single(*_factory, "Test", 1, 100, 0);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), single.numberOfShards());
+  }
+
+  void testGetCreatesOnce()
+  {
+    sfc::ShardedLRUCache<Key, std::string> cache(*_factory, "Test", 1);
+    CPPUNIT_ASSERT_EQUAL(std::string("7"), *cache.get(7));
+    CPPUNIT_ASSERT_EQUAL(std::string("7"), *cache.get(7));
+    CPPUNIT_ASSERT_EQUAL(1, _factory->_created.load());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), cache.size());
+    CPPUNIT_ASSERT(cache.getIfResident(7));
+    CPPUNIT_ASSERT(!cache.getIfResident(8));
+  }
+
+  void testCapacityIsEnforced()
+  {
+    sfc::ShardedLRUCache<Key, std::string> cache(*_factory, "Test", 1, 40, 4);
+    for (Key key = 0; key < 1000; ++key)
+    {
+      CPPUNIT_ASSERT(cache.get(key));
+    }
+    CPPUNIT_ASSERT(cache.size() <= 40);
+    cache.emptyTrash();
+  }
+
+  void testReferencedEntriesSurviveEviction()
+  {
+    sfc::ShardedLRUCache<Key, std::string> cache(*_factory, "Test", 1, 4, 1);
+    for (Key key = 0; key < 4; ++key)
+    {
+      cache.get(key);
+    }
+    // one full sweep clears all reference bits and evicts key 0,
+    // then touching key 2 must keep it over the unreferenced ones
+    cache.get(4);
+    CPPUNIT_ASSERT(!cache.getIfResident(0));
+    cache.get(2);
+    cache.get(5);
+    CPPUNIT_ASSERT(cache.getIfResident(2));
+    CPPUNIT_ASSERT(cache.getIfResident(5));
+    CPPUNIT_ASSERT_EQUAL(size_t(4), cache.size());
+    cache.emptyTrash();
+  }
+
+  void testInvalidate()
+  {
+    sfc::ShardedLRUCache<Key, std::string> cache(*_factory, "Test", 1);
+    cache.get(1);
+    cache.get(2);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), cache.invalidate(1));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), cache.invalidate(1));
+    CPPUNIT_ASSERT(!cache.getIfResident(1));
+    CPPUNIT_ASSERT(cache.getIfResident(2));
+    cache.get(1);
+    CPPUNIT_ASSERT_EQUAL(3, _factory->_created.load());
+    cache.emptyTrash();
+  }
+
+  void testPutReplaces()
+  {
+    sfc::ShardedLRUCache<Key, std::string> cache(*_factory, "Test", 1);
+    cache.get(3);
+    cache.put(3, new std::string("three"), false);
+    CPPUNIT_ASSERT_EQUAL(std::string("three"), *cache.get(3));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), cache.size());
+    cache.emptyTrash();
+  }
+
+  void testClear()
+  {
+    sfc::ShardedLRUCache<Key, std::string> cache(*_factory, "Test", 1);
+    for (Key key = 0; key < 100; ++key)
+    {
+      cache.get(key);
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(100), cache.keys()->size());
+    CPPUNIT_ASSERT_EQUAL(size_t(100), cache.clear());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), cache.size());
+    cache.emptyTrash();
+  }
+
+  void testCreateFailureRemovesPlaceholder()
+  {
+    sfc::ShardedLRUCache<Key, std::string> cache(*_factory, "Test", 1);
+    _factory->_throwOn = 9;
+    CPPUNIT_ASSERT_THROW(cache.get(9), std::runtime_error);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), cache.size());
+    _factory->_throwOn = -1;
+    CPPUNIT_ASSERT_EQUAL(std::string("9"), *cache.get(9));
+  }
+
+  void testMultiThread()
+  {
+    sfc::ShardedLRUCache<Key, std::string> cache(*_factory, "Test", 1, 500, 16);
+    // keep evicted objects alive while other workers may still read them
+    cache.setAccumulatorSize(1000000);
+    const int NUMTHREADS(8);
+    boost::thread threads[NUMTHREADS];
+    int numErrors[NUMTHREADS] = {};
+    for (int i = 0; i < NUMTHREADS; ++i)
+    {
+      Worker worker(cache, 1000, 20000, i, numErrors[i]);
+      threads[i] = boost::thread(boost::bind(&Worker::run, worker));
+    }
+    for (int i = 0; i < NUMTHREADS; ++i)
+    {
+      threads[i].join();
+      CPPUNIT_ASSERT_EQUAL(0, numErrors[i]);
+    }
+    CPPUNIT_ASSERT(cache.size() <= 500);
+    cache.emptyTrash();
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(ShardedLRUCacheTest);
+}
@@ -0,0 +1,180 @@
+#include "test/include/CppUnitHelperMacros.h"
+#include "DBAccess/SingleFlight.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sfc
+{
+namespace
+{
+typedef std::shared_ptr<std::string> Value;
+typedef SingleFlight<std::string, Value, std::hash<std::string>> Flight;
+
+// a load that blocks until released, so that the other callers pile up
+struct Load
+{
+  std::atomic<int> calls{0};
+  std::atomic<bool> released{false};
+  bool fail = false;
+
+  Value operator()()
+  {
+    ++calls;
+    while (!released)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (fail)
+      throw std::runtime_error("ORA-03113");
+    return std::make_shared<std::string>("fares");
+  }
+};
+}
+
+class SingleFlightTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(SingleFlightTest);
+  CPPUNIT_TEST(testDisabled);
+  CPPUNIT_TEST(testConcurrentCallersShareOneLoad);
+  CPPUNIT_TEST(testErrorReachesWaiters);
+  CPPUNIT_TEST(testTimeoutLoadsAlone);
+  CPPUNIT_TEST(testForgetStartsNewLoad);
+  CPPUNIT_TEST(testKeysLoadSeparately);
+  CPPUNIT_TEST_SUITE_END();
+
+  // starts the callers, waits until they all joined, then releases the load
+  void runConcurrently(Flight& flight,
+                       Load& load,
+                       size_t threads,
+                       std::vector<Value>& values,
+                       std::atomic<int>& errors)
+  {
+    values.assign(threads, Value());
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < threads; ++i)
+    {
+      workers.emplace_back([&, i]()
+                           {
+        try
+        {
+          values[i] = flight.run("LON|NYC|BA", std::ref(load), std::ref(load));
+        }
+        catch (const std::runtime_error&)
+        {
+          ++errors;
+        }
+      });
+    }
+    while (flight.stats().loads + flight.stats().coalesced < threads)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    load.released = true;
+    for (std::thread& worker : workers)
+      worker.join();
+  }
+
+public:
+  void testDisabled()
+  {
+    Flight flight;
+    CPPUNIT_ASSERT(!flight.enabled());
+    flight.setTimeout(100);
+    CPPUNIT_ASSERT(flight.enabled());
+  }
+
+  void testConcurrentCallersShareOneLoad()
+  {
+    Flight flight;
+    flight.setTimeout(60000);
+    Load load;
+    std::vector<Value> values;
+    std::atomic<int> errors(0);
+    runConcurrently(flight, load, 8, values, errors);
+
+    CPPUNIT_ASSERT_EQUAL(1, load.calls.load());
+    CPPUNIT_ASSERT_EQUAL(0, errors.load());
+    for (const Value& value : values)
+      CPPUNIT_ASSERT(value == values.front());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), flight.stats().loads);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(7), flight.stats().coalesced);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), flight.stats().timeouts);
+
+    // the flight has landed, the next caller loads again
+    flight.run("LON|NYC|BA", std::ref(load), std::ref(load));
+    CPPUNIT_ASSERT_EQUAL(2, load.calls.load());
+  }
+
+  void testErrorReachesWaiters()
+  {
+    Flight flight;
+    flight.setTimeout(60000);
+    Load load;
+    load.fail = true;
+    std::vector<Value> values;
+    std::atomic<int> errors(0);
+    runConcurrently(flight, load, 4, values, errors);
+
+    CPPUNIT_ASSERT_EQUAL(1, load.calls.load());
+    CPPUNIT_ASSERT_EQUAL(4, errors.load());
+  }
+
+  void testTimeoutLoadsAlone()
+  {
+    Flight flight;
+    flight.setTimeout(1);
+    Load load;
+    std::thread leader([&]() { flight.run("K", std::ref(load), std::ref(load)); });
+    while (load.calls == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    Load own;
+    own.released = true;
+    // the waiter does not wait for the hung load again
+    const Value value(flight.run("K", std::ref(load), std::ref(own)));
+    CPPUNIT_ASSERT_EQUAL(std::string("fares"), *value);
+    CPPUNIT_ASSERT_EQUAL(1, own.calls.load());
+    CPPUNIT_ASSERT_EQUAL(1, load.calls.load());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), flight.stats().timeouts);
+
+    load.released = true;
+    leader.join();
+  }
+
+  void testForgetStartsNewLoad()
+  {
+    Flight flight;
+    flight.setTimeout(60000);
+    Load load;
+    std::thread leader([&]() { flight.run("K", std::ref(load), std::ref(load)); });
+    while (load.calls == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    flight.forget("K");
+    Load fresh;
+    fresh.released = true;
+    flight.run("K", std::ref(fresh), std::ref(fresh));
+    CPPUNIT_ASSERT_EQUAL(1, fresh.calls.load());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), flight.stats().coalesced);
+
+    load.released = true;
+    leader.join();
+  }
+
+  void testKeysLoadSeparately()
+  {
+    Flight flight;
+    flight.setTimeout(60000);
+    Load load;
+    load.released = true;
+    flight.run("A", std::ref(load), std::ref(load));
+    flight.run("B", std::ref(load), std::ref(load));
+    CPPUNIT_ASSERT_EQUAL(2, load.calls.load());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), flight.stats().coalesced);
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(SingleFlightTest);
+}
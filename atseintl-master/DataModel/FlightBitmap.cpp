@@ -0,0 +1,240 @@
+//-------------------------------------------------------------------
+//
+//  Copyright Sabre 2016
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//-------------------------------------------------------------------
+#include "DataModel/FlightBitmap.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+
+namespace tse
+{
+namespace flightbitmap
+{
+namespace
+{
+#ifdef __AVX2__
+constexpr size_t BLOCK = 32;
+using Mask = uint32_t;
+
+inline Mask
+matchBlock(const uint8_t* status, const __m256i value)
+{
+  const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(status));
+  return Mask(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, value)));
+}
+
+inline __m256i
+broadcast(const uint8_t value)
+{
+  return _mm256_set1_epi8(char(value));
+}
+
+// mask words per vector
+constexpr size_t WORDS = 4;
+using Vector = __m256i;
+
+inline Vector
+load(const uint64_t* const mask)
+{
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask));
+}
+
+inline void
+store(uint64_t* const mask, const Vector value)
+{
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(mask), value);
+}
+
+inline Vector
+andVector(const Vector a, const Vector b)
+{
+  return _mm256_and_si256(a, b);
+}
+
+inline Vector
+orVector(const Vector a, const Vector b)
+{
+  return _mm256_or_si256(a, b);
+}
+
+// Bits set in each 64-bit lane: the count of each nibble is looked up in a register and the
+// bytes are summed by lane.
+inline __m256i
+popcountVector(const __m256i value)
+{
+  const __m256i lookup =
+      _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                       0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low = _mm256_set1_epi8(0x0f);
+  const __m256i counts =
+      _mm256_add_epi8(_mm256_shuffle_epi8(lookup, _mm256_and_si256(value, low)),
+                      _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(value, 4), low)));
+  return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+}
+#else
+constexpr size_t BLOCK = 16;
+using Mask = uint32_t;
+
+inline Mask
+matchBlock(const uint8_t* status, const __m128i value)
+{
+  const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(status));
+  return Mask(_mm_movemask_epi8(_mm_cmpeq_epi8(block, value)));
+}
+
+inline __m128i
+broadcast(const uint8_t value)
+{
+  return _mm_set1_epi8(char(value));
+}
+
+// mask words per vector
+constexpr size_t WORDS = 2;
+using Vector = __m128i;
+
+inline Vector
+load(const uint64_t* const mask)
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+inline void
+store(uint64_t* const mask, const Vector value)
+{
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(mask), value);
+}
+
+inline Vector
+andVector(const Vector a, const Vector b)
+{
+  return _mm_and_si128(a, b);
+}
+
+inline Vector
+orVector(const Vector a, const Vector b)
+{
+  return _mm_or_si128(a, b);
+}
+#endif
+
+inline Mask
+matchTail(const uint8_t* status, const size_t flights, const uint8_t value)
+{
+  Mask mask = 0;
+  for (size_t i = 0; i < flights; ++i)
+    mask |= Mask(status[i] == value) << i;
+  return mask;
+}
+}
+
+void
+pack(const uint8_t* const status, const size_t flights, const uint8_t value, uint64_t* const mask)
+{
+  const auto values = broadcast(value);
+  const size_t blocks = flights / BLOCK;
+
+  // BLOCK divides 64, so a block never spans two words
+  for (size_t block = 0; block < blocks; ++block)
+  {
+    const size_t flight = block * BLOCK;
+    mask[flight / 64] |= uint64_t(matchBlock(status + flight, values)) << (flight % 64);
+  }
+
+  const size_t flight = blocks * BLOCK;
+  if (flight < flights)
+    mask[flight / 64] |= uint64_t(matchTail(status + flight, flights - flight, value))
+                         << (flight % 64);
+}
+
+size_t
+count(const uint8_t* const status, const size_t flights, const uint8_t value)
+{
+  const auto values = broadcast(value);
+  const size_t blocks = flights / BLOCK;
+  size_t result = 0;
+
+  for (size_t block = 0; block < blocks; ++block)
+    result += __builtin_popcount(matchBlock(status + block * BLOCK, values));
+
+  const size_t flight = blocks * BLOCK;
+  return result + __builtin_popcount(matchTail(status + flight, flights - flight, value));
+}
+
+size_t
+find(const uint8_t* const status, const size_t flights, const uint8_t value)
+{
+  const auto values = broadcast(value);
+  const size_t blocks = flights / BLOCK;
+
+  for (size_t block = 0; block < blocks; ++block)
+  {
+    const Mask mask = matchBlock(status + block * BLOCK, values);
+    if (mask)
+      return block * BLOCK + __builtin_ctz(mask);
+  }
+
+  for (size_t flight = blocks * BLOCK; flight < flights; ++flight)
+  {
+    if (status[flight] == value)
+      return flight;
+  }
+  return flights;
+}
+
+void
+andMask(uint64_t* const mask, const uint64_t* const other, const size_t words)
+{
+  const size_t vectors = words / WORDS;
+  for (size_t i = 0; i < vectors * WORDS; i += WORDS)
+    store(mask + i, andVector(load(mask + i), load(other + i)));
+
+  for (size_t i = vectors * WORDS; i < words; ++i)
+    mask[i] &= other[i];
+}
+
+void
+orMask(uint64_t* const mask, const uint64_t* const other, const size_t words)
+{
+  const size_t vectors = words / WORDS;
+  for (size_t i = 0; i < vectors * WORDS; i += WORDS)
+    store(mask + i, orVector(load(mask + i), load(other + i)));
+
+  for (size_t i = vectors * WORDS; i < words; ++i)
+    mask[i] |= other[i];
+}
+
+size_t
+popcount(const uint64_t* const mask, const size_t words)
+{
+  size_t result = 0;
+  size_t i = 0;
+#ifdef __AVX2__
+  // without AVX2 the popcnt instruction (or its builtin fallback) is as good as SSE2 gets
+  __m256i sums = _mm256_setzero_si256();
+  for (; i + WORDS <= words; i += WORDS)
+    sums = _mm256_add_epi64(sums, popcountVector(load(mask + i)));
+
+  uint64_t lanes[WORDS];
+  store(lanes, sums);
+  for (const uint64_t lane : lanes)
+    result += lane;
+#endif
+  for (; i < words; ++i)
+    result += __builtin_popcountll(mask[i]);
+  return result;
+}
+}
+}
@@ -0,0 +1,306 @@
+//-------------------------------------------------------------------
+//
+//  Copyright Sabre 2016
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//-------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace tse
+{
+namespace flightbitmap
+{
+// Kernels over the status column of a flight bitmap, one byte per flight.
+// A mask has one bit per flight, 64 flights per word, the first one in the lowest bit.
+
+inline size_t
+maskWords(const size_t flights)
+{
+  return (flights + 63) / 64;
+}
+
+// Sets the mask bits of the flights with the status; the mask has maskWords(flights) words.
+void
+pack(const uint8_t* status, size_t flights, uint8_t value, uint64_t* mask);
+
+size_t
+count(const uint8_t* status, size_t flights, uint8_t value);
+
+// Index of the first flight with the status, or flights if there is none.
+size_t
+find(const uint8_t* status, size_t flights, uint8_t value);
+
+// Word-wise operations on masks, vectorized like the status kernels.
+void
+andMask(uint64_t* mask, const uint64_t* other, size_t words);
+
+void
+orMask(uint64_t* mask, const uint64_t* other, size_t words);
+
+size_t
+popcount(const uint64_t* mask, size_t words);
+
+inline bool
+test(const uint64_t* mask, const size_t flight)
+{
+  return (mask[flight / 64] >> (flight % 64)) & 1;
+}
+}
+
+// Flight bitmap of a fare, stored by columns.
+//
+// A shopping fare has a status for each of the SOPs of its leg (0 - valid, 'S' - skipped or the
+// reason of the failure), so the statuses are a byte array which the kernels above scan without
+// touching the other columns. The segment statuses of all the flights share one array, a flight
+// only keeps where its ones are.
+//
+// The element access returns a proxy with the members of PaxTypeFare::FlightBit as references;
+// the segment statuses are read only, setSegmentStatus() replaces them. A proxy is valid until
+// the bitmap is resized or a segment status is set.
+template <class BookingCodeStatus, class SegmentStatus>
+class FlightBitmapT
+{
+public:
+  using SegmentStatusVec = std::vector<SegmentStatus>;
+
+  class SegmentStatusRange
+  {
+  public:
+    using value_type = SegmentStatus;
+    using const_iterator = const SegmentStatus*;
+    using iterator = const_iterator;
+
+    SegmentStatusRange() = default;
+    SegmentStatusRange(const SegmentStatus* begin, const SegmentStatus* end)
+      : _begin(begin), _end(end)
+    {
+    }
+
+    const_iterator begin() const { return _begin; }
+    const_iterator end() const { return _end; }
+    size_t size() const { return _end - _begin; }
+    bool empty() const { return _begin == _end; }
+
+    const SegmentStatus& operator[](const size_t i) const { return _begin[i]; }
+    const SegmentStatus& at(const size_t i) const
+    {
+      if (i >= size())
+        throw std::out_of_range("FlightBitmap segment status");
+      return _begin[i];
+    }
+
+    operator SegmentStatusVec() const { return SegmentStatusVec(_begin, _end); }
+
+  private:
+    const SegmentStatus* _begin = nullptr;
+    const SegmentStatus* _end = nullptr;
+  };
+
+  template <class Status, class Bkg, class Mpm>
+  struct BitReference
+  {
+    Status& _flightBit;
+    Bkg& _bookingCodeStatus;
+    Mpm& _mpmPercentage;
+    SegmentStatusRange _segmentStatus;
+
+    const BitReference* operator->() const { return this; }
+  };
+
+  using reference = BitReference<uint8_t, BookingCodeStatus, uint16_t>;
+  using const_reference = BitReference<const uint8_t, const BookingCodeStatus, const uint16_t>;
+
+  template <class Bitmap, class Reference>
+  class Iterator : public std::iterator<std::random_access_iterator_tag,
+                                       Reference,
+                                       std::ptrdiff_t,
+                                       Reference,
+                                       Reference>
+  {
+  public:
+    Iterator() = default;
+    Iterator(Bitmap* bitmap, size_t index) : _bitmap(bitmap), _index(index) {}
+
+    // iterator to const_iterator
+    template <class OtherBitmap, class OtherReference>
+    Iterator(const Iterator<OtherBitmap, OtherReference>& it)
+      : _bitmap(it._bitmap), _index(it._index)
+    {
+    }
+
+    Reference operator*() const { return (*_bitmap)[_index]; }
+    Reference operator->() const { return (*_bitmap)[_index]; }
+    Reference operator[](std::ptrdiff_t n) const { return (*_bitmap)[_index + n]; }
+
+    Iterator& operator++() { ++_index; return *this; }
+    Iterator operator++(int) { Iterator it(*this); ++_index; return it; }
+    Iterator& operator--() { --_index; return *this; }
+    Iterator operator--(int) { Iterator it(*this); --_index; return it; }
+    Iterator& operator+=(std::ptrdiff_t n) { _index += n; return *this; }
+    Iterator& operator-=(std::ptrdiff_t n) { _index -= n; return *this; }
+    Iterator operator+(std::ptrdiff_t n) const { return Iterator(_bitmap, _index + n); }
+    Iterator operator-(std::ptrdiff_t n) const { return Iterator(_bitmap, _index - n); }
+    std::ptrdiff_t operator-(const Iterator& it) const { return std::ptrdiff_t(_index - it._index); }
+
+    bool operator==(const Iterator& it) const { return _index == it._index; }
+    bool operator!=(const Iterator& it) const { return _index != it._index; }
+    bool operator<(const Iterator& it) const { return _index < it._index; }
+
+  private:
+    template <class, class>
+    friend class Iterator;
+
+    Bitmap* _bitmap = nullptr;
+    size_t _index = 0;
+  };
+
+  using iterator = Iterator<FlightBitmapT, reference>;
+  using const_iterator = Iterator<const FlightBitmapT, const_reference>;
+
+  size_t size() const { return _status.size(); }
+  bool empty() const { return _status.empty(); }
+
+  void resize(const size_t size)
+  {
+    _status.resize(size, 0);
+    _bookingCodeStatus.resize(size);
+    _mpmPercentage.resize(size, 0);
+    if (!_segments.empty())
+      _segments.resize(size);
+  }
+
+  void clear()
+  {
+    _status.clear();
+    _bookingCodeStatus.clear();
+    _mpmPercentage.clear();
+    _segments.clear();
+    _segmentStatus.clear();
+  }
+
+  void swap(FlightBitmapT& other)
+  {
+    _status.swap(other._status);
+    _bookingCodeStatus.swap(other._bookingCodeStatus);
+    _mpmPercentage.swap(other._mpmPercentage);
+    _segments.swap(other._segments);
+    _segmentStatus.swap(other._segmentStatus);
+  }
+
+  reference operator[](const size_t i)
+  {
+    return reference{_status[i], _bookingCodeStatus[i], _mpmPercentage[i], segmentStatus(i)};
+  }
+  const_reference operator[](const size_t i) const
+  {
+    return const_reference{_status[i], _bookingCodeStatus[i], _mpmPercentage[i], segmentStatus(i)};
+  }
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, size()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size()); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  // copies all the columns of a flight
+  void copyBit(const size_t to, const size_t from)
+  {
+    _status[to] = _status[from];
+    _bookingCodeStatus[to] = _bookingCodeStatus[from];
+    _mpmPercentage[to] = _mpmPercentage[from];
+    if (!_segments.empty())
+      setSegmentStatus(to, segmentStatus(from));
+  }
+
+  // the flight bits, for the kernels
+  uint8_t* status() { return _status.data(); }
+  const uint8_t* status() const { return _status.data(); }
+
+  SegmentStatusRange segmentStatus(const size_t i) const
+  {
+    if (i >= _segments.size() || !_segments[i]._size)
+      return SegmentStatusRange();
+
+    const SegmentStatus* const begin = _segmentStatus.data() + _segments[i]._begin;
+    return SegmentStatusRange(begin, begin + _segments[i]._size);
+  }
+
+  template <class It>
+  void setSegmentStatus(const size_t i, It begin, It end)
+  {
+    if (_segments.empty())
+      _segments.resize(size());
+
+    Segments& segments = _segments[i];
+    const uint32_t count = uint32_t(std::distance(begin, end));
+    if (count > segments._size)
+    {
+      // the flight moves to the end, its previous statuses are not reused
+      segments._begin = uint32_t(_segmentStatus.size());
+      _segmentStatus.resize(_segmentStatus.size() + count);
+    }
+    std::copy(begin, end, _segmentStatus.begin() + segments._begin);
+    segments._size = count;
+  }
+  void setSegmentStatus(const size_t i, const SegmentStatusVec& segmentStatus)
+  {
+    setSegmentStatus(i, segmentStatus.begin(), segmentStatus.end());
+  }
+  void setSegmentStatus(const size_t i, const SegmentStatusRange& segmentStatus)
+  {
+    const SegmentStatusVec copy(segmentStatus);
+    setSegmentStatus(i, copy.begin(), copy.end());
+  }
+
+  size_t count(const uint8_t value) const
+  {
+    return flightbitmap::count(_status.data(), _status.size(), value);
+  }
+  bool contains(const uint8_t value) const
+  {
+    return flightbitmap::find(_status.data(), _status.size(), value) != _status.size();
+  }
+  void mask(const uint8_t value, std::vector<uint64_t>& mask) const
+  {
+    mask.assign(flightbitmap::maskWords(_status.size()), 0);
+    flightbitmap::pack(_status.data(), _status.size(), value, mask.data());
+  }
+
+  // heap memory held by the bitmap
+  size_t memoryUsage() const
+  {
+    return _status.capacity() * sizeof(uint8_t) +
+           _bookingCodeStatus.capacity() * sizeof(BookingCodeStatus) +
+           _mpmPercentage.capacity() * sizeof(uint16_t) + _segments.capacity() * sizeof(Segments) +
+           _segmentStatus.capacity() * sizeof(SegmentStatus);
+  }
+
+private:
+  struct Segments
+  {
+    uint32_t _begin = 0;
+    uint32_t _size = 0;
+  };
+
+  std::vector<uint8_t> _status;
+  std::vector<BookingCodeStatus> _bookingCodeStatus;
+  std::vector<uint16_t> _mpmPercentage;
+  std::vector<Segments> _segments; // empty until a segment status is set
+  std::vector<SegmentStatus> _segmentStatus;
+};
+}
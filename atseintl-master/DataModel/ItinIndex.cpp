@@ -170,7 +170,9 @@ ItinIndex::ItinIndexIterator::generateItinSet()
     // We can only go through the row key specified carrier SOPs
     if (jumpedLegIdx == _adoptedLegIndex)
     {
-      ItinIndex::ItinRowCellVector& curCellVector = curRowCellMap[_rowKey];
+      ItinIndex::ItinRowCellMapIterator rowIter = curRowCellMap.find(_rowKey);
+      TSE_ASSERT(rowIter != curRowCellMap.end());
+      ItinIndex::ItinRowCellVector& curCellVector = rowIter->second;
       IndexPair& iPair = _currentItinSet[n];
       iPair.first = _rowKey;
       iPair.second = curIdxVal;
@@ -259,7 +261,9 @@ ItinIndex::ItinIndexIterator::prepareAcrossLegCell(uint32_t atIndex)
     ShoppingTrx::Leg& curJumpedLeg = _shoppingTrx->legs()[jumpedLegIdx];
     ItinIndex::ItinRowCellMap& curRowCellMap = curJumpedLeg.carrierIndex().rowCellMap();
     IndexPair& curPair = *iCIter;
-    ItinIndex::ItinRowCellVector& curCellVector = curRowCellMap[curPair.first];
+    ItinIndex::ItinRowCellMapIterator rowIter = curRowCellMap.find(curPair.first);
+    TSE_ASSERT(rowIter != curRowCellMap.end());
+    ItinIndex::ItinRowCellVector& curCellVector = rowIter->second;
     ItinIndex::ItinCell& curPairCell = curCellVector[curPair.second];
     std::vector<TravelSeg*>& curITSeg = curPairCell.second->travelSeg();
 
@@ -848,6 +852,23 @@ ItinIndex::beginRow(const ItinIndex::Key& itinRowKey)
   return (ItinIndex::ItinIndexIterator(itinRowKey, &curV));
 }
 
+ItinIndex::ItinIndexIterator
+ItinIndex::beginRow(const ItinIndex::Key& itinRowKey, const uint32_t bitIndex)
+{
+  ItinIndex::ItinRowCellMapIterator curVIter = _rowCellMap.find(itinRowKey);
+  if (UNLIKELY(curVIter == _rowCellMap.end()))
+  {
+    throw ErrorResponseException(ErrorResponseException::INVALID_INPUT,
+                                 "Invalid governing carrier specified for leg index iterator");
+  }
+  ItinIndex::ItinRowCellVector& curV = curVIter->second;
+  if (bitIndex >= curV.size())
+  {
+    return endRow();
+  }
+  return (ItinIndex::ItinIndexIterator(itinRowKey, &curV, bitIndex));
+}
+
 //-------------------------------------------------------------------
 // Creates an iterator that points to the end of the
 // row cell base specified by the key
@@ -870,6 +891,22 @@ ItinIndex::beginAcrossStopOverRow(ShoppingTrx& trx,
   return (ItinIndex::ItinIndexIterator(govCxr, acrossStopOverLegIdx, &trx));
 }
 
+ItinIndex::ItinIndexIterator
+ItinIndex::beginAcrossStopOverRow(ShoppingTrx& trx,
+                                  const uint32_t& acrossStopOverLegIdx,
+                                  const ItinIndex::Key& govCxr,
+                                  const uint32_t bitIndex)
+{
+  // Checked up front, the iterator rewrites the across stop over leg itin
+  // and only restores it when it reaches the end
+  if (acrossStopOverLegIdx < trx.legs().size() &&
+      bitIndex >= trx.legs()[acrossStopOverLegIdx].getFlightBitmapSize(trx, govCxr))
+  {
+    return endAcrossStopOverRow();
+  }
+  return (ItinIndex::ItinIndexIterator(govCxr, acrossStopOverLegIdx, &trx, bitIndex));
+}
+
 ItinIndex::ItinIndexIterator
 ItinIndex::endAcrossStopOverRow()
 {
@@ -16,6 +16,7 @@
 #include "Common/Hasher.h"
 #include "Common/TseStlTypes.h"
 #include "Common/TsePrimitiveTypes.h"
+#include "Common/VecMap.h"
 
 #include <cstring>
 #include <map>
@@ -47,6 +48,11 @@ AA - - - - - 0 -  -  -  -  0 -  -  -  -  -  0 - Itin0 --
                               \ -  -  -  -  2 - Itin5 --
 
 -------------------------------------------------------------------
+
+Rows, columns and row cells are kept in sorted key arrays (VecMap). The index is
+built once per leg by the itin analyzer and only read afterwards, so lookups are
+binary searches over contiguous memory. Inserting a key moves the entries behind
+it; references into the index must not be held across addItinCell().
 */
 class ItinIndex final
 {
@@ -110,7 +116,7 @@ public:
   typedef ItinColumn::const_iterator ItinColumnConstIterator;
 
   // ItinIndex ItinRow type
-  typedef std::map<Key, ItinColumn> ItinRow;
+  typedef VecMap<Key, ItinColumn> ItinRow;
   typedef ItinRow::iterator ItinRowIterator;
   typedef ItinRow::const_iterator ItinRowConstIterator;
 
@@ -118,7 +124,7 @@ public:
   typedef std::pair<Key, ItinColumn> ItinRowPair;
 
   // ItinIndex ItinMatrix type
-  typedef std::map<Key, ItinRow> ItinMatrix;
+  typedef VecMap<Key, ItinRow> ItinMatrix;
   typedef ItinMatrix::iterator ItinMatrixIterator;
   typedef ItinMatrix::const_iterator ItinMatrixConstIterator;
 
@@ -131,7 +137,7 @@ public:
   typedef ItinRowCellVector::const_iterator ItinRowCellVectorConstIterator;
 
   // ItinIndex RowCell vector map type
-  typedef std::map<Key, ItinRowCellVector> ItinRowCellMap;
+  typedef VecMap<Key, ItinRowCellVector> ItinRowCellMap;
   typedef ItinRowCellMap::iterator ItinRowCellMapIterator;
   typedef ItinRowCellMap::const_iterator ItinRowCellMapConstIterator;
 
@@ -279,6 +285,10 @@ public:
   // row specified by the key for normal leg carrier indices
   ItinIndex::ItinIndexIterator beginRow(const ItinIndex::Key& itinRowKey);
 
+  // Creates an iterator that points to the cell of the row at the bit index,
+  // or an end iterator if the row has fewer cells
+  ItinIndex::ItinIndexIterator beginRow(const ItinIndex::Key& itinRowKey, uint32_t bitIndex);
+
   // Creates an end iterator for normal leg carrier indices
   ItinIndex::ItinIndexIterator endRow();
 
@@ -288,6 +298,13 @@ public:
                                                       const uint32_t& acrossStopOverLegIdx,
                                                       const ItinIndex::Key& itinRowKey);
 
+  // Creates an iterator that points to the across stop over leg combination
+  // at the bit index, or an end iterator if the row has fewer combinations
+  ItinIndex::ItinIndexIterator beginAcrossStopOverRow(ShoppingTrx& trx,
+                                                      const uint32_t& acrossStopOverLegIdx,
+                                                      const ItinIndex::Key& itinRowKey,
+                                                      uint32_t bitIndex);
+
   // Creates an end iterator for across stop over leg carrier indices
   ItinIndex::ItinIndexIterator endAcrossStopOverRow();
 
@@ -2063,15 +2063,10 @@ bool
 PaxTypeFare::isFlightBitmapInvalid(const FlightBitmap& flightBitmap,
                                    bool skippedAsInvalid)
 {
-  FlightBitEqualTo isBitValid(0);
-  FlightBitEqualTo isBitSkipped('S');
+  if (flightBitmap.contains(0))
+    return false;
 
-  return std::none_of(flightBitmap.begin(), flightBitmap.end(), [&](const FlightBit& fb)
-  {
-    if (isBitValid(fb))
-      return true;
-    return !skippedAsInvalid && isBitSkipped(fb);
-  });
+  return skippedAsInvalid || !flightBitmap.contains('S');
 }
 
 bool
@@ -2120,60 +2115,29 @@ PaxTypeFare::setFlightMPMPercentage(const uint32_t& i, const uint16_t& mpmPercen
 }
 
 bool
-PaxTypeFare::swapInFlightSegmentStatus(const uint32_t& i, std::vector<SegmentStatus>& segmentStatus)
+PaxTypeFare::setFlightSegmentStatus(const uint32_t& i,
+                                    const std::vector<SegmentStatus>& segmentStatus)
 {
-  if (_flightBitmapForCarrier)
-  {
-    if (UNLIKELY(_flightBitmapForCarrier->size() <= i))
-      return false;
-
-    (*_flightBitmapForCarrier)[i]._segmentStatus.swap(segmentStatus);
-  }
+  FlightBitmap& flightBitmap = _flightBitmapForCarrier ? *_flightBitmapForCarrier : _flightBitmap;
 
-  if (i >= _flightBitmap.size())
+  if (UNLIKELY(i >= flightBitmap.size()))
     return false;
 
-  _flightBitmap[i]._segmentStatus.swap(segmentStatus);
+  flightBitmap.setSegmentStatus(i, segmentStatus);
 
   return true;
 }
 
-std::vector<PaxTypeFare::SegmentStatus>*
-PaxTypeFare::getFlightSegmentStatus(const uint32_t& i)
-{
-  if (_flightBitmapForCarrier)
-  {
-    if (_flightBitmapForCarrier->size() <= i)
-      return nullptr;
-
-    return &((*_flightBitmapForCarrier)[i]._segmentStatus);
-  }
-
-  if (i >= _flightBitmapSize)
-  {
-    return nullptr;
-  }
-
-  return (&(_flightBitmap[i]._segmentStatus));
-}
-
-const std::vector<PaxTypeFare::SegmentStatus>*
+PaxTypeFare::FlightBitmap::SegmentStatusRange
 PaxTypeFare::getFlightSegmentStatus(const uint32_t& i) const
 {
   if (_flightBitmapForCarrier)
-  {
-    if (_flightBitmapForCarrier->size() <= i)
-      return nullptr;
-
-    return &((*_flightBitmapForCarrier)[i]._segmentStatus);
-  }
+    return _flightBitmapForCarrier->segmentStatus(i);
 
   if (i >= _flightBitmapSize)
-  {
-    return nullptr;
-  }
+    return FlightBitmap::SegmentStatusRange();
 
-  return (&(_flightBitmap[i]._segmentStatus));
+  return _flightBitmap.segmentStatus(i);
 }
 
 void
@@ -37,6 +37,7 @@
 #include "DataModel/FareDisplayInfo.h"
 #include "DataModel/FareMarket.h"
 #include "DataModel/FlexFares/ValidationStatus.h"
+#include "DataModel/FlightBitmap.h"
 #include "DataModel/Itin.h"
 #include "DataModel/StructuredRuleData.h"
 #include "DataModel/TNBrandsTypes.h"
@@ -339,23 +340,13 @@ public:
     uint8_t _flightBit = 0;
   };
 
-  using FlightBitmap = std::vector<FlightBit>;
+  // The columns of FlightBit, see DataModel/FlightBitmap.h
+  using FlightBitmap = FlightBitmapT<BookingCodeStatus, SegmentStatus>;
 
   using FlightBitmapIterator = FlightBitmap::iterator;
   using FlightBitmapConstIterator = FlightBitmap::const_iterator;
   using FlightBitmapPerCarrier = VecMap<uint32_t, FlightBitmap>;
 
-  class FlightBitEqualTo : public std::unary_function<FlightBit, bool>
-  {
-  private:
-    const uint8_t _countValue;
-
-  public:
-    explicit FlightBitEqualTo(uint8_t countValue) : _countValue(countValue) {}
-
-    bool operator()(const FlightBit& x) { return (x._flightBit == _countValue); }
-  };
-
   //--------------------------------------------------------------------------//
   //-- End Flight Bitmap data structure declarations
   //--------------------------------------------------------------------------//
@@ -1510,13 +1501,11 @@ public:
   // Returns true if the operation succeeded
   bool setFlightMPMPercentage(const uint32_t& i, const uint16_t& mpmPercentage);
 
-  bool swapInFlightSegmentStatus(const uint32_t& i, std::vector<SegmentStatus>& segmentStatus);
+  bool setFlightSegmentStatus(const uint32_t& i, const std::vector<SegmentStatus>& segmentStatus);
 
-  // Get a pointer to the flight segment status
-  // Returns NULL if the operation failed
-  // Returns a pointer to the data if the operation succeeded
-  std::vector<SegmentStatus>* getFlightSegmentStatus(const uint32_t& i);
-  const std::vector<SegmentStatus>* getFlightSegmentStatus(const uint32_t& i) const;
+  // Get the flight segment status
+  // Returns an empty range if the operation failed
+  FlightBitmap::SegmentStatusRange getFlightSegmentStatus(const uint32_t& i) const;
 
   // Only to be set during bitmap validation
   void setIsShoppingFare() { _isShoppingFare = true; }
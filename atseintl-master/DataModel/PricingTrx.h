@@ -703,6 +703,10 @@ public:
   bool& delayXpn() { return _delayXpn; }
   const bool& delayXpn() const { return _delayXpn; }
 
+  // percentage of the search limits to drop, set when the admission control degrades the trx
+  void setAdmissionDegradePercent(uint32_t percent) { _admissionDegradePercent = percent; }
+  uint32_t admissionDegradePercent() const { return _admissionDegradePercent; }
+
   void setFlexFarePhase1(const bool& val) { _isFlexFarePhase1 = val; }
   const bool& isFlexFarePhase1() const { return _isFlexFarePhase1; }
 
@@ -997,6 +1001,7 @@ private:
   std::pair<const DateTime*, const DateTime*> _itinsTimeSpan;
   bool _showBaggageTravelIndex = false;
   bool _delayXpn = false;
+  uint32_t _admissionDegradePercent = 0;
   bool _isFlexFarePhase1 = false;
   bool _isFlexFare = false;
   bool _isMainFare = false;
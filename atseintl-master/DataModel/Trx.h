@@ -150,6 +150,12 @@ public:
   boost::mutex& statDataMutex() { return _statDataMutex; }
   const boost::mutex& statDataMutex() const { return _statDataMutex; }
 
+  // Queue wait of the pool tasks, counted without the stat data mutex and
+  // folded into statData by TseSrvStats: tasks per wait bucket, then the
+  // total wait in microseconds.
+  static constexpr size_t TASK_QUEUE_WAIT_SIZE = 6;
+  std::atomic<uint64_t>* taskQueueWait() { return _taskQueueWait; }
+
   DateTime& transactionStartTime() { return _transactionStartTime; }
   const DateTime& transactionStartTime() const { return _transactionStartTime; }
 
@@ -308,6 +314,7 @@ protected:
   TrxAborter* _aborter = nullptr;
   std::vector<double> _statData;
   boost::mutex _statDataMutex;
+  std::atomic<uint64_t> _taskQueueWait[TASK_QUEUE_WAIT_SIZE]{};
 
   // These are used for the billing record
   DateTime _transactionStartTime;
@@ -0,0 +1,236 @@
+// ----------------------------------------------------------------
+//
+//   Copyright Sabre 2016
+//
+//           The copyright to the computer program(s) herein
+//           is the property of Sabre.
+//           The program(s) may be used and/or copied only with
+//           the written permission of Sabre or in accordance
+//           with the terms and conditions stipulated in the
+//           agreement/contract under which the program(s)
+//           have been supplied.
+//
+// ----------------------------------------------------------------
+#include "test/include/CppUnitHelperMacros.h"
+#include "DataModel/FlightBitmap.h"
+#include "DataModel/PaxTypeFare.h"
+
+#include <algorithm>
+
+namespace tse
+{
+class FlightBitmapTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(FlightBitmapTest);
+  CPPUNIT_TEST(testPack);
+  CPPUNIT_TEST(testCountAndFind);
+  CPPUNIT_TEST(testMaskOperations);
+  CPPUNIT_TEST(testMaskOperationsWords);
+  CPPUNIT_TEST(testReference);
+  CPPUNIT_TEST(testIterator);
+  CPPUNIT_TEST(testSegmentStatus);
+  CPPUNIT_TEST(testSegmentStatusAfterResize);
+  CPPUNIT_TEST(testCopyBit);
+  CPPUNIT_TEST(testSwap);
+  CPPUNIT_TEST(testIsFlightBitmapInvalid);
+  CPPUNIT_TEST_SUITE_END();
+
+  using FlightBitmap = PaxTypeFare::FlightBitmap;
+
+  // sizes not multiple of the vector width, so both the blocks and the tail are checked
+  static constexpr size_t FLIGHTS = 150;
+
+public:
+  void setUp() override
+  {
+    _bitmap.resize(FLIGHTS);
+    for (size_t i = 0; i < FLIGHTS; ++i)
+      _bitmap[i]._flightBit = statusOf(i);
+  }
+
+  void tearDown() override { _bitmap.clear(); }
+
+  void testPack()
+  {
+    std::vector<uint64_t> mask;
+    _bitmap.mask('S', mask);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(3), mask.size());
+    for (size_t i = 0; i < FLIGHTS; ++i)
+      CPPUNIT_ASSERT_EQUAL(statusOf(i) == 'S', flightbitmap::test(mask.data(), i));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), mask[2] >> (FLIGHTS % 64));
+  }
+
+  void testCountAndFind()
+  {
+    size_t valid = 0;
+    for (size_t i = 0; i < FLIGHTS; ++i)
+      valid += statusOf(i) == 0;
+
+    CPPUNIT_ASSERT_EQUAL(valid, _bitmap.count(0));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), _bitmap.count('X'));
+    CPPUNIT_ASSERT(_bitmap.contains('S'));
+    CPPUNIT_ASSERT(!_bitmap.contains('X'));
+
+    _bitmap[FLIGHTS - 1]._flightBit = 'X';
+    CPPUNIT_ASSERT_EQUAL(FLIGHTS - 1, flightbitmap::find(_bitmap.status(), FLIGHTS, 'X'));
+    _bitmap[17]._flightBit = 'X';
+    CPPUNIT_ASSERT_EQUAL(size_t(17), flightbitmap::find(_bitmap.status(), FLIGHTS, 'X'));
+  }
+
+  void testMaskOperations()
+  {
+    std::vector<uint64_t> valid, skipped;
+    _bitmap.mask(0, valid);
+    _bitmap.mask('S', skipped);
+
+    std::vector<uint64_t> live(valid);
+    flightbitmap::orMask(live.data(), skipped.data(), live.size());
+    CPPUNIT_ASSERT_EQUAL(_bitmap.count(0) + _bitmap.count('S'),
+                         flightbitmap::popcount(live.data(), live.size()));
+
+    flightbitmap::andMask(valid.data(), skipped.data(), valid.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), flightbitmap::popcount(valid.data(), valid.size()));
+  }
+
+  void testMaskOperationsWords()
+  {
+    // enough words for the vector loops and a tail
+    const size_t words = 11;
+    std::vector<uint64_t> mask(words), other(words);
+    uint64_t seed = 0x9e3779b97f4a7c15ull;
+    for (size_t i = 0; i < words; ++i)
+    {
+      mask[i] = seed *= 0xbf58476d1ce4e5b9ull;
+      other[i] = seed *= 0xbf58476d1ce4e5b9ull;
+    }
+
+    std::vector<uint64_t> orred(mask), anded(mask);
+    flightbitmap::orMask(orred.data(), other.data(), words);
+    flightbitmap::andMask(anded.data(), other.data(), words);
+    size_t bits = 0;
+    for (size_t i = 0; i < words; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(mask[i] | other[i], orred[i]);
+      CPPUNIT_ASSERT_EQUAL(mask[i] & other[i], anded[i]);
+      bits += __builtin_popcountll(mask[i]);
+    }
+    CPPUNIT_ASSERT_EQUAL(bits, flightbitmap::popcount(mask.data(), words));
+
+    std::fill(mask.begin(), mask.end(), ~uint64_t(0));
+    CPPUNIT_ASSERT_EQUAL(words * 64, flightbitmap::popcount(mask.data(), words));
+  }
+
+  void testReference()
+  {
+    PaxTypeFare::BookingCodeStatus bookingCodeStatus;
+    bookingCodeStatus.set(PaxTypeFare::BKS_PASS);
+
+    _bitmap[5]._bookingCodeStatus = bookingCodeStatus;
+    _bitmap[5]._mpmPercentage = 25;
+
+    const FlightBitmap& bitmap = _bitmap;
+    CPPUNIT_ASSERT(bitmap[5]._bookingCodeStatus.isSet(PaxTypeFare::BKS_PASS));
+    CPPUNIT_ASSERT(!bitmap[6]._bookingCodeStatus.isSet(PaxTypeFare::BKS_PASS));
+    CPPUNIT_ASSERT_EQUAL(uint16_t(25), bitmap[5]._mpmPercentage);
+    CPPUNIT_ASSERT(bitmap[5]._segmentStatus.empty());
+  }
+
+  void testIterator()
+  {
+    size_t index = 0;
+    for (FlightBitmap::const_iterator it = _bitmap.begin(); it != _bitmap.end(); ++it, ++index)
+      CPPUNIT_ASSERT_EQUAL(statusOf(index), it->_flightBit);
+    CPPUNIT_ASSERT_EQUAL(FLIGHTS, index);
+
+    for (auto bit : _bitmap)
+      if (bit._flightBit == 0)
+        bit._flightBit = 'S';
+    CPPUNIT_ASSERT_EQUAL(size_t(0), _bitmap.count(0));
+    CPPUNIT_ASSERT_EQUAL(std::ptrdiff_t(FLIGHTS), _bitmap.end() - _bitmap.begin());
+  }
+
+  void testSegmentStatus()
+  {
+    FlightBitmap::SegmentStatusVec segmentStatus(2);
+    segmentStatus[0]._bkgCodeReBook = "Y";
+    segmentStatus[1]._bkgCodeReBook = "B";
+    _bitmap.setSegmentStatus(3, segmentStatus);
+
+    CPPUNIT_ASSERT(_bitmap.segmentStatus(2).empty());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), _bitmap[3]._segmentStatus.size());
+    CPPUNIT_ASSERT_EQUAL(BookingCode("B"), _bitmap[3]._segmentStatus[1]._bkgCodeReBook);
+
+    // shorter statuses are overwritten in place, longer ones are appended
+    segmentStatus.resize(1);
+    _bitmap.setSegmentStatus(3, segmentStatus);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), _bitmap.segmentStatus(3).size());
+
+    segmentStatus.resize(3);
+    segmentStatus[2]._bkgCodeReBook = "M";
+    _bitmap.setSegmentStatus(3, segmentStatus);
+    const FlightBitmap::SegmentStatusVec copy = _bitmap.segmentStatus(3);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), copy.size());
+    CPPUNIT_ASSERT_EQUAL(BookingCode("M"), copy[2]._bkgCodeReBook);
+    CPPUNIT_ASSERT_THROW(_bitmap.segmentStatus(3).at(3), std::out_of_range);
+  }
+
+  void testSegmentStatusAfterResize()
+  {
+    _bitmap.setSegmentStatus(FLIGHTS - 1, FlightBitmap::SegmentStatusVec(1));
+    _bitmap.resize(FLIGHTS + 10);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(1), _bitmap.segmentStatus(FLIGHTS - 1).size());
+    CPPUNIT_ASSERT(_bitmap.segmentStatus(FLIGHTS + 9).empty());
+    CPPUNIT_ASSERT_EQUAL(uint8_t(0), _bitmap[FLIGHTS + 9]._flightBit);
+  }
+
+  void testCopyBit()
+  {
+    _bitmap[1]._mpmPercentage = 10;
+    _bitmap.setSegmentStatus(1, FlightBitmap::SegmentStatusVec(2));
+
+    _bitmap.copyBit(2, 1);
+    CPPUNIT_ASSERT_EQUAL(uint8_t('S'), _bitmap[2]._flightBit);
+    CPPUNIT_ASSERT_EQUAL(uint16_t(10), _bitmap[2]._mpmPercentage);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), _bitmap[2]._segmentStatus.size());
+  }
+
+  void testSwap()
+  {
+    FlightBitmap other;
+    other.resize(1);
+    other.setSegmentStatus(0, FlightBitmap::SegmentStatusVec(2));
+
+    _bitmap.swap(other);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), _bitmap.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), _bitmap.segmentStatus(0).size());
+    CPPUNIT_ASSERT_EQUAL(FLIGHTS, other.size());
+  }
+
+  void testIsFlightBitmapInvalid()
+  {
+    CPPUNIT_ASSERT(!PaxTypeFare::isFlightBitmapInvalid(_bitmap));
+
+    for (size_t i = 0; i < FLIGHTS; ++i)
+      if (_bitmap[i]._flightBit == 0)
+        _bitmap[i]._flightBit = 'R';
+    CPPUNIT_ASSERT(!PaxTypeFare::isFlightBitmapInvalid(_bitmap));
+    CPPUNIT_ASSERT(PaxTypeFare::isFlightBitmapInvalid(_bitmap, true));
+
+    _bitmap[FLIGHTS - 1]._flightBit = 0;
+    CPPUNIT_ASSERT(!PaxTypeFare::isFlightBitmapInvalid(_bitmap, true));
+
+    CPPUNIT_ASSERT(PaxTypeFare::isFlightBitmapInvalid(FlightBitmap()));
+  }
+
+private:
+  static uint8_t statusOf(const size_t i)
+  {
+    return i % 3 == 0 ? 0 : (i % 3 == 1 ? 'S' : 'R');
+  }
+
+  FlightBitmap _bitmap;
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(FlightBitmapTest);
+}
@@ -0,0 +1,166 @@
+#include "test/include/CppUnitHelperMacros.h"
+
+#include "Common/ErrorResponseException.h"
+#include "DataModel/Itin.h"
+#include "DataModel/ItinIndex.h"
+#include "test/include/TestConfigInitializer.h"
+#include "test/include/TestMemHandle.h"
+
+namespace tse
+{
+namespace
+{
+const ItinIndex::Key AA = 20;
+const ItinIndex::Key LH = 10;
+}
+
+class ItinIndexTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ItinIndexTest);
+  CPPUNIT_TEST(testRowsSortedByKey);
+  CPPUNIT_TEST(testRowCellMapSkipsFakeDirectFlights);
+  CPPUNIT_TEST(testRetrieveTopItinCell);
+  CPPUNIT_TEST(testRetrieveTopItinCell_SkipFakeDirectFlight);
+  CPPUNIT_TEST(testNumberOfCells);
+  CPPUNIT_TEST(testIterateRow);
+  CPPUNIT_TEST(testBeginRowAtBitIndex);
+  CPPUNIT_TEST(testBeginRowAtBitIndex_OutOfRange);
+  CPPUNIT_TEST(testBeginRow_UnknownCarrier);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() { _memHandle.create<TestConfigInitializer>(); }
+
+  void tearDown() { _memHandle.clear(); }
+
+  Itin* addCell(const ItinIndex::Key row,
+                const ItinIndex::Key column,
+                const uint32_t sopIndex,
+                const uint32_t flags = 0)
+  {
+    Itin* itin = _memHandle.create<Itin>();
+    ItinIndex::ItinCellInfo info;
+    info.sopIndex() = sopIndex;
+    info.flags() = flags;
+    _index.addItinCell(itin, info, row, column);
+    return itin;
+  }
+
+  void populate()
+  {
+    addCell(AA, 1, 0);
+    addCell(LH, 0, 1);
+    addCell(AA, 0, 2);
+    addCell(AA, 1, 3);
+  }
+
+  void testRowsSortedByKey()
+  {
+    populate();
+
+    CPPUNIT_ASSERT_EQUAL(size_t(2), _index.root().size());
+    CPPUNIT_ASSERT_EQUAL(LH, _index.root().begin()->first);
+    CPPUNIT_ASSERT_EQUAL(AA, (_index.root().begin() + 1)->first);
+
+    const ItinIndex::ItinRow* row = _index.retrieveItinRow(AA);
+    CPPUNIT_ASSERT(row);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), row->size());
+    CPPUNIT_ASSERT_EQUAL(ItinIndex::Key(0), row->begin()->first);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), row->find(0)->second.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), row->find(1)->second.size());
+    CPPUNIT_ASSERT_EQUAL(uint32_t(1), row->find(1)->second[1].first.itinColumnIndex());
+  }
+
+  void testRowCellMapSkipsFakeDirectFlights()
+  {
+    populate();
+    addCell(AA, 0, 4, ItinIndex::ITININDEXCELLINFO_FAKEDIRECTFLIGHT);
+
+    const ItinIndex::ItinRowCellVector& cells = _index.rowCellMap().find(AA)->second;
+    CPPUNIT_ASSERT_EQUAL(size_t(3), cells.size());
+    CPPUNIT_ASSERT_EQUAL(uint32_t(0), cells[0].first.sopIndex());
+    CPPUNIT_ASSERT_EQUAL(uint32_t(2), cells[1].first.sopIndex());
+    CPPUNIT_ASSERT_EQUAL(uint32_t(3), cells[2].first.sopIndex());
+  }
+
+  void testRetrieveTopItinCell()
+  {
+    populate();
+
+    const ItinIndex::ItinCell* cell = _index.retrieveTopItinCell(AA, ItinIndex::CHECK_NOTHING);
+    CPPUNIT_ASSERT(cell);
+    CPPUNIT_ASSERT_EQUAL(uint32_t(2), cell->first.sopIndex());
+    CPPUNIT_ASSERT(!_index.retrieveTopItinCell(30, ItinIndex::CHECK_NOTHING));
+  }
+
+  void testRetrieveTopItinCell_SkipFakeDirectFlight()
+  {
+    addCell(AA, 1, 0);
+    addCell(AA, 0, 1, ItinIndex::ITININDEXCELLINFO_FAKEDIRECTFLIGHT);
+
+    const ItinIndex::ItinCell* cell =
+        _index.retrieveTopItinCell(AA, ItinIndex::CHECK_FAKEDIRECTFLIGHT);
+    CPPUNIT_ASSERT(cell);
+    CPPUNIT_ASSERT_EQUAL(uint32_t(0), cell->first.sopIndex());
+  }
+
+  void testNumberOfCells()
+  {
+    populate();
+    addCell(LH, 0, 4, ItinIndex::ITININDEXCELLINFO_FAKEDIRECTFLIGHT);
+
+    CPPUNIT_ASSERT_EQUAL(uint32_t(4), _index.retrieveTotalNumberCells());
+    CPPUNIT_ASSERT_EQUAL(uint32_t(3), _index.retrieveNumberCellsInARow(AA));
+    CPPUNIT_ASSERT_EQUAL(uint32_t(1), _index.retrieveNumberCellsInARow(LH));
+    CPPUNIT_ASSERT_EQUAL(uint32_t(0), _index.retrieveNumberCellsInARow(30));
+  }
+
+  void testIterateRow()
+  {
+    populate();
+
+    std::vector<uint32_t> sops;
+    ItinIndex::ItinIndexIterator it = _index.beginRow(AA);
+    const ItinIndex::ItinIndexIterator end = _index.endRow();
+    for (; it != end; ++it)
+      sops.push_back(it->first.sopIndex());
+
+    const std::vector<uint32_t> expected = {0, 2, 3};
+    CPPUNIT_ASSERT(expected == sops);
+  }
+
+  void testBeginRowAtBitIndex()
+  {
+    populate();
+
+    ItinIndex::ItinIndexIterator it = _index.beginRow(AA, 2);
+    CPPUNIT_ASSERT(it.isValid());
+    CPPUNIT_ASSERT_EQUAL(uint32_t(2), it.bitIndex());
+    CPPUNIT_ASSERT_EQUAL(uint32_t(3), it->first.sopIndex());
+
+    ++it;
+    CPPUNIT_ASSERT(!it.isValid());
+  }
+
+  void testBeginRowAtBitIndex_OutOfRange()
+  {
+    populate();
+
+    CPPUNIT_ASSERT(!_index.beginRow(AA, 3).isValid());
+  }
+
+  void testBeginRow_UnknownCarrier()
+  {
+    populate();
+
+    CPPUNIT_ASSERT_THROW(_index.beginRow(30), ErrorResponseException);
+    CPPUNIT_ASSERT_THROW(_index.beginRow(30, 0), ErrorResponseException);
+  }
+
+private:
+  TestMemHandle _memHandle;
+  ItinIndex _index;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ItinIndexTest);
+}
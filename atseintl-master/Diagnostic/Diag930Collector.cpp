@@ -686,7 +686,7 @@ Diag930Collector::getBookingCodeCabin(const FarePath& fpath,
           }
 
           TSE_ASSERT(bitmapNumber < fu.paxTypeFare()->flightBitmap().size());
-          const PaxTypeFare::FlightBit& bitMap = fu.paxTypeFare()->flightBitmap()[bitmapNumber];
+          const auto bitMap = fu.paxTypeFare()->flightBitmap()[bitmapNumber];
           const PaxTypeFare::SegmentStatus* segStat = nullptr;
 
           if (!bitMap._segmentStatus.empty())
@@ -126,6 +126,7 @@
 #include "Rules/RuleConst.h"
 #include "Rules/RuleUtil.h"
 #include "Server/TseServer.h"
+#include "Util/Algorithm/Integer.h"
 #include "Util/BranchPrediction.h"
 
 #include <algorithm>
@@ -3357,7 +3358,7 @@ FareValidatorOrchestrator::makeFlightList(FlightFinderTrx& fFTrx)
         if (curFare && curFare->isValid())
         {
           combineFlightBitmapsForEachPaxTypeFare(
-              combinedFlightBitmap, curFare, curFare->flightBitmap(), nullptr);
+              combinedFlightBitmap, curFare, curFare->flightBitmap());
         }
       }
 
@@ -4170,8 +4171,7 @@ FareValidatorOrchestrator::combineDurationsFlightBitmapsForEachPaxTypeFare(
 
     for (; itCombDurFlBitmap != curFare->durationFlightBitmap().end(); ++itCombDurFlBitmap)
     {
-      std::vector<PaxTypeFare::FlightBit>::const_iterator itFlightBit =
-          itCombDurFlBitmap->second.begin();
+      PaxTypeFare::FlightBitmapConstIterator itFlightBit = itCombDurFlBitmap->second.begin();
 
       for (; itFlightBit != itCombDurFlBitmap->second.end(); ++itFlightBit)
       {
@@ -4200,10 +4200,8 @@ FareValidatorOrchestrator::combineDurationsFlightBitmapsForEachPaxTypeFare(
       if (itCurDurFlBitmap != curFare->durationFlightBitmap().end() &&
           !(itCurDurFlBitmap->second.empty()))
       {
-        combineFlightBitmapsForEachPaxTypeFare(itCombDurFlBitmap->second,
-                                               curFare,
-                                               itCurDurFlBitmap->second,
-                                               &(itCurDurFlBitmap->first));
+        combineFlightBitmapsForEachPaxTypeFare(
+            itCombDurFlBitmap->second, curFare, itCurDurFlBitmap->second);
       }
     }
   }
@@ -4213,15 +4211,13 @@ void
 FareValidatorOrchestrator::combineFlightBitmapsForEachPaxTypeFare(
     std::vector<FlightFinderTrx::FlightBitInfo>& combinedFlightBitmap,
     PaxTypeFare* curFare,
-    const std::vector<PaxTypeFare::FlightBit>& flightBitmap,
-    const uint64_t* const duration)
+    const PaxTypeFare::FlightBitmap& flightBitmap)
 {
-  std::vector<PaxTypeFare::FlightBit>::const_iterator itFlightBit = flightBitmap.begin();
-  uint32_t flightBitNumber = 0;
+  PaxTypeFare::FlightBitmapConstIterator itFlightBit = flightBitmap.begin();
 
   if (combinedFlightBitmap.empty()) // for first time add whole bitMap at once
   {
-    for (; itFlightBit != flightBitmap.end(); ++itFlightBit, ++flightBitNumber)
+    for (; itFlightBit != flightBitmap.end(); ++itFlightBit)
     {
       FlightFinderTrx::FlightBitInfo flightBInfo;
       flightBInfo.flightBitStatus = itFlightBit->_flightBit;
@@ -4236,26 +4232,20 @@ FareValidatorOrchestrator::combineFlightBitmapsForEachPaxTypeFare(
   }
   else // for next fare
   {
-    for (; itFlightBit != flightBitmap.end(); ++itFlightBit, ++flightBitNumber)
+    // the valid and the skipped flights of the fare, packed once instead of checked one by one
+    std::vector<uint64_t> liveFlights, skippedFlights;
+    flightBitmap.mask(0, liveFlights);
+    flightBitmap.mask(RuleConst::SKIP, skippedFlights);
+    flightbitmap::orMask(liveFlights.data(), skippedFlights.data(), liveFlights.size());
+
+    for (size_t word = 0; word < liveFlights.size(); ++word)
     {
-      if (duration == nullptr) // for flightBitmap inside curFare
-      {
-        if (curFare->isFlightValid(flightBitNumber) ||
-            *(curFare->getFlightBit(flightBitNumber)) == RuleConst::SKIP) // change bitmap
-        {
-          combinedFlightBitmap[flightBitNumber].paxTypeFareVect.push_back(curFare);
-          combinedFlightBitmap[flightBitNumber].flightBitStatus = 0;
-        }
-      }
-      else // for flightBitmap inside durationFlightBitmap for proper duration
+      for (uint64_t bits = liveFlights[word]; bits; bits &= bits - 1)
       {
-        if (curFare->isFlightValid(*duration, flightBitNumber) ||
-            *(curFare->getFlightBit(*duration, flightBitNumber)) ==
-                RuleConst::SKIP) // change bitmap
-        {
-          combinedFlightBitmap[flightBitNumber].paxTypeFareVect.push_back(curFare);
-          combinedFlightBitmap[flightBitNumber].flightBitStatus = 0;
-        }
+        FlightFinderTrx::FlightBitInfo& flightBInfo =
+            combinedFlightBitmap[word * 64 + alg::trailingZeros(bits)];
+        flightBInfo.paxTypeFareVect.push_back(curFare);
+        flightBInfo.flightBitStatus = 0;
       }
     }
   }
@@ -5333,7 +5323,7 @@ FareValidatorOrchestrator::updateDurationFlightBitmapAfterValidation(
     PaxTypeFare* curFare, PaxTypeFare::FlightBitmap& flightBitmap, const int bitIndex)
 {
   curFare->setFlightInvalid(flightBitmap, bitIndex, *(curFare->getFlightBit(bitIndex)));
-  flightBitmap[bitIndex]._segmentStatus.swap(curFare->flightBitmap()[bitIndex]._segmentStatus);
+  flightBitmap.setSegmentStatus(bitIndex, curFare->flightBitmap().segmentStatus(bitIndex));
 }
 namespace
 {
@@ -5352,7 +5342,7 @@ getNumSeats(const std::vector<ClassOfService*>& thrufareClassOfService, const Bo
 void
 getBookingCodeVect(std::vector<std::vector<FlightFinderTrx::BookingCodeData>>& bkgCodeDataVect,
                    const std::vector<std::vector<ClassOfService*>*>& thrufareClassOfService,
-                   const std::vector<PaxTypeFare::SegmentStatus>& segStatus,
+                   const PaxTypeFare::FlightBitmap::SegmentStatusRange& segStatus,
                    PaxTypeFare* paxTypeFare,
                    const std::vector<TravelSeg*>& travelSegs)
 {
@@ -5361,7 +5351,7 @@ getBookingCodeVect(std::vector<std::vector<FlightFinderTrx::BookingCodeData>>& b
   if (segStatus.size() == travelSegs.size())
   {
     int16_t tvlItem = 0;
-    std::vector<PaxTypeFare::SegmentStatus>::const_iterator segItem = segStatus.begin();
+    PaxTypeFare::FlightBitmap::SegmentStatusRange::const_iterator segItem = segStatus.begin();
 
     for (; segItem != segStatus.end(); ++segItem, ++tvlItem)
     {
@@ -5404,8 +5394,8 @@ FareValidatorOrchestrator::getBookingCodeVectVect(
 {
   for (auto paxTypeFare : paxTypeFareVect)
   {
-    const std::vector<PaxTypeFare::SegmentStatus>& segStatus =
-        paxTypeFare->durationFlightBitmap()[duration][bitmapIndex]._segmentStatus;
+    const PaxTypeFare::FlightBitmap::SegmentStatusRange segStatus =
+        paxTypeFare->durationFlightBitmap()[duration].segmentStatus(bitmapIndex);
     getBookingCodeVect(bkgCodeDataVect, thrufareClassOfService, segStatus, paxTypeFare, travelSegs);
   }
 }
@@ -5421,8 +5411,8 @@ FareValidatorOrchestrator::getBookingCodeVectVect(
 {
   for (auto paxTypeFare : paxTypeFareVect)
   {
-    const std::vector<PaxTypeFare::SegmentStatus>& segStatus =
-        paxTypeFare->flightBitmap()[bitmapIndex]._segmentStatus;
+    const PaxTypeFare::FlightBitmap::SegmentStatusRange segStatus =
+        paxTypeFare->flightBitmap().segmentStatus(bitmapIndex);
     getBookingCodeVect(bkgCodeDataVect, thrufareClassOfService, segStatus, paxTypeFare, travelSegs);
   }
 }
@@ -6136,7 +6126,7 @@ FareValidatorOrchestrator::processCarrierFares(
         }
 
         cleanupAfterShoppingValidation(trx, journeyItin, fM, fmb, beginLeg, endLeg);
-        const PaxTypeFare::FlightBit& bitInfo = curFare->flightBitmap()[bitIndex];
+        const auto bitInfo = curFare->flightBitmap()[bitIndex];
         uint32_t startN = 0;
         uint32_t segmentCount = travelSegs.size();
 
@@ -333,8 +333,7 @@ protected:
   void combineFlightBitmapsForEachPaxTypeFare(
       std::vector<FlightFinderTrx::FlightBitInfo>& combinedFlightBitmap,
       PaxTypeFare* curFare,
-      const std::vector<PaxTypeFare::FlightBit>& flightBitmap,
-      const uint64_t* const duration);
+      const PaxTypeFare::FlightBitmap& flightBitmap);
 
   void getBookingCodeVectVect(
       std::vector<std::vector<FlightFinderTrx::BookingCodeData> >& bkgCodeDataVect,
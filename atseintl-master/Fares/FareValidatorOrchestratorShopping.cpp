@@ -1011,7 +1011,7 @@ FareValidatorOrchestratorShopping::copyAlreadyValidatedBit(PaxTypeFare::FlightBi
 
   if ((uint32_t)usage.flightsFirstProcessedIn_ < bitIndex && usage.flightsFirstProcessedIn_ >= 0)
   {
-    bitmap[bitIndex] = bitmap[usage.flightsFirstProcessedIn_];
+    bitmap.copyBit(bitIndex, usage.flightsFirstProcessedIn_);
     return true;
   }
   return false;
@@ -1447,7 +1447,7 @@ FareValidatorOrchestratorShopping::processCarrierFaresImpl(
 
         if (UNLIKELY(!trx.isSumOfLocalsProcessingEnabled()))
         {
-          const PaxTypeFare::FlightBit& bitInfo = curFare->flightBitmap()[bitIndex];
+          const auto bitInfo = curFare->flightBitmap()[bitIndex];
 
           uint32_t startN = 0;
           uint32_t segmentCount = travelSegs.size();
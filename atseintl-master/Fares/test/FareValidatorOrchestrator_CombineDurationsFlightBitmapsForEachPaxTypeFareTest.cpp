@@ -183,12 +183,11 @@ protected:
                                 std::vector<uint8_t>& bits)
   {
     PaxTypeFare::FlightBitmap vectFligthBitmap;
-    PaxTypeFare::FlightBit bit;
+    vectFligthBitmap.resize(bits.size());
 
     for (uint32_t bitNo = 0; bitNo < bits.size(); ++bitNo)
     {
-      bit._flightBit = bits[bitNo];
-      vectFligthBitmap.push_back(bit);
+      vectFligthBitmap[bitNo]._flightBit = bits[bitNo];
     }
 
     paxTypeFare->durationFlightBitmap()[duration] = vectFligthBitmap;
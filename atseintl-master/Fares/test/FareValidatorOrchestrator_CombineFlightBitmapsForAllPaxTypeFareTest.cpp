@@ -163,7 +163,7 @@ protected:
       if (curFare)
       {
         _fvo->combineFlightBitmapsForEachPaxTypeFare(
-            combinedFlightBitmap, curFare, curFare->flightBitmap(), 0);
+            combinedFlightBitmap, curFare, curFare->flightBitmap());
       }
     }
   }
@@ -173,16 +173,13 @@ protected:
     PaxTypeFare* paxTypeFare = 0;
     _memHandle.get(paxTypeFare);
 
-    PaxTypeFare::FlightBit bit;
-    uint32_t bitNo = 0;
-    for (; bitNo < bits.size(); ++bitNo)
+    paxTypeFare->setFlightBitmapSize(bits.size());
+
+    for (uint32_t bitNo = 0; bitNo < bits.size(); ++bitNo)
     {
-      bit._flightBit = bits[bitNo];
-      paxTypeFare->flightBitmap().push_back(bit);
+      paxTypeFare->flightBitmap()[bitNo]._flightBit = bits[bitNo];
     }
 
-    paxTypeFare->setFlightBitmapSize(bitNo);
-
     return paxTypeFare;
   }
 
@@ -670,19 +670,17 @@ ItinAnalyzerService::ensureGroupHasDirectFlight(ShoppingTrx& trx, ShoppingTrx::L
       continue;
     }
 
+    // Get data associated with first itin column, copied as the row
+    // moves its columns when the direct one is inserted
+    const ItinIndex::ItinCellInfo firstItinCellInfo = firstColumnInRow.front().first;
+
+    // Get the itinerary from this cell
+    Itin* const firstItin = firstColumnInRow.front().second;
+
     // Insert the itin row pair (key, ItinColumn) that will represent
     // the direct flight itinerary for this carrier
     curRow.insert(ItinIndex::ItinRowPair(directFlightKey, ItinIndex::ItinColumn()));
 
-    // Now we need to retrieve the newly added direct itin column
-    // ItinIndex::ItinColumn& newColumn = curRow[directFlightKey];
-
-    // Get data associated with first itin column
-    ItinIndex::ItinCell& firstItinCell = firstColumnInRow.front();
-
-    // Get the itinerary from this cell
-    Itin*& firstItin = firstItinCell.second;
-
     // Get the governing carrier code
     const CarrierCode& govCxrCode = firstItin->fareMarket().front()->governingCarrier();
 
@@ -735,7 +733,7 @@ ItinAnalyzerService::ensureGroupHasDirectFlight(ShoppingTrx& trx, ShoppingTrx::L
     // Create the itin cell info structure
     ItinIndex::ItinCellInfo itinCellInfo;
     itinCellInfo.sopIndex() = curLeg.sop().size();
-    itinCellInfo.combineSameCxr() = firstItinCell.first.combineSameCxr();
+    itinCellInfo.combineSameCxr() = firstItinCellInfo.combineSameCxr();
     GlobalDirection& gDir = itinCellInfo.globalDirection();
     if (trx.isAltDates())
     {
@@ -2470,7 +2468,7 @@ ItinAnalyzerService::estimateGovCxrForStopOverLegs(ShoppingTrx& trx)
     // Go through the itin index and pick out the governing carriers
     for (; iMIter != iMEIter; ++iMIter)
     {
-      ItinIndex::ItinMatrixPair iMPair = *iMIter;
+      const ItinIndex::ItinMatrixPair& iMPair = *iMIter;
       ItinIndex::ItinCell* curCell =
           chosenLegIdx.retrieveTopItinCell(iMPair.first, ItinIndex::CHECK_FAKEDIRECTFLIGHT);
 
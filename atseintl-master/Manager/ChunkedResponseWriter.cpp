@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+// Copyright 2005, Sabre Inc.  All rights reserved.
+// This software/documentation is the confidential and proprietary product of
+// Sabre Inc.   Any unauthorized use, reproduction, or transfer of this
+// software/documentation,  in any medium, or incorporation of this
+// software/documentation into any system or publication, is strictly prohibited.
+//------------------------------------------------------------------------------
+//
+
+#include "Manager/ChunkedResponseWriter.h"
+
+#include "ClientSocket/EOSocket.h"
+#include "Common/Logger.h"
+#include "Util/CompressUtil.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <arpa/inet.h>
+
+namespace tse
+{
+namespace
+{
+Logger
+logger("atseintl.Manager.ChunkedResponseWriter");
+
+const size_t PREFIX_SIZE = sizeof(uint32_t);
+const size_t MIN_CHUNK_SIZE = 1024;
+}
+
+ChunkedResponseWriter::ChunkedResponseWriter(eo::Socket& socket, bool compress, size_t chunkSize)
+  : _socket(socket),
+    _deflate(compress ? new DeflateStream : nullptr),
+    _chunkSize(std::max(chunkSize, MIN_CHUNK_SIZE))
+{
+  _buffer.reserve(PREFIX_SIZE + _chunkSize);
+  _buffer.resize(PREFIX_SIZE);
+}
+
+ChunkedResponseWriter::~ChunkedResponseWriter() {}
+
+bool
+ChunkedResponseWriter::write(const char* data, size_t size)
+{
+  if (!_deflate)
+    return append(data, size);
+
+  // compress a chunk size of input at a time, the buffer may grow past the
+  // chunk size by what one of them produces
+  while (size > 0)
+  {
+    const size_t part = std::min(size, _chunkSize);
+    if (!_deflate->write(data, part, _buffer))
+      return false;
+    data += part;
+    size -= part;
+
+    if (_buffer.size() - PREFIX_SIZE >= _chunkSize && !send())
+      return false;
+  }
+  return true;
+}
+
+bool
+ChunkedResponseWriter::finish()
+{
+  if (_deflate && !_deflate->finish(_buffer))
+    return false;
+
+  if (_buffer.size() > PREFIX_SIZE && !send())
+    return false;
+
+  // the empty chunk ends the response
+  return send();
+}
+
+bool
+ChunkedResponseWriter::append(const char* data, size_t size)
+{
+  while (size > 0)
+  {
+    const size_t part = std::min(size, _chunkSize - (_buffer.size() - PREFIX_SIZE));
+    _buffer.insert(_buffer.end(), data, data + part);
+    data += part;
+    size -= part;
+
+    if (_buffer.size() - PREFIX_SIZE == _chunkSize && !send())
+      return false;
+  }
+  return true;
+}
+
+bool
+ChunkedResponseWriter::send()
+{
+  const uint32_t length = htonl(uint32_t(_buffer.size() - PREFIX_SIZE));
+  memcpy(&_buffer[0], &length, PREFIX_SIZE);
+
+  if (_socket.write(&_buffer[0], _buffer.size()) < 0)
+  {
+    LOG4CXX_FATAL(logger,
+                  "Write of response chunk " << _chunksSent << " (" << _buffer.size()
+                                             << " bytes) failed, channel: "
+                                             << _socket.getChannel());
+    return false;
+  }
+
+  _bytesSent += _buffer.size();
+  ++_chunksSent;
+  _buffer.resize(PREFIX_SIZE);
+  return true;
+}
+} // namespace tse
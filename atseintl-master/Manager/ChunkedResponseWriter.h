@@ -0,0 +1,64 @@
+//-------------------------------------------------------------------------------
+// Copyright 2005, Sabre Inc.  All rights reserved.
+// This software/documentation is the confidential and proprietary product of
+// Sabre Inc.   Any unauthorized use, reproduction, or transfer of this
+// software/documentation,  in any medium, or incorporation of this
+// software/documentation into any system or publication, is strictly prohibited.
+//-------------------------------------------------------------------------------
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace eo
+{
+class Socket;
+}
+
+namespace tse
+{
+class DeflateStream;
+
+//-------------------------------------------------------------------------
+// Writes a response of unknown length as a sequence of chunks, each one a
+// four byte (network order) length followed by the data, ended by an empty
+// chunk. The header sent before has eo::CHUNKED_PAYLOAD_SIZE as payload size.
+//
+// Data is kept in a buffer of at most chunkSize bytes and sent as soon as
+// the buffer is full, so that the first bytes are on the wire while the rest
+// is still being produced. When compressing, the chunks together form a
+// single zlib stream, which the clients of the compressed (RQDC) requests
+// already decode; lz4, used for the cache entries in DBAccess, would need a
+// new request type on both sides.
+//-------------------------------------------------------------------------
+class ChunkedResponseWriter
+{
+public:
+  ChunkedResponseWriter(eo::Socket& socket, bool compress, size_t chunkSize);
+  ~ChunkedResponseWriter();
+
+  ChunkedResponseWriter(const ChunkedResponseWriter&) = delete;
+  ChunkedResponseWriter& operator=(const ChunkedResponseWriter&) = delete;
+
+  bool write(const char* data, size_t size);
+  bool finish();
+
+  size_t bytesSent() const { return _bytesSent; }
+  size_t chunksSent() const { return _chunksSent; }
+
+private:
+  bool append(const char* data, size_t size);
+  bool send();
+
+  eo::Socket& _socket;
+  std::unique_ptr<DeflateStream> _deflate;
+  const size_t _chunkSize;
+  std::vector<char> _buffer; // length prefix and the data of the next chunk
+  size_t _bytesSent = 0;
+  size_t _chunksSent = 0;
+};
+} // namespace tse
@@ -0,0 +1,435 @@
+//----------------------------------------------------------------------------
+//
+//  File:               EventSocketReader.cpp
+//
+//  Description:        Reads client requests of many connections with epoll
+//                      and hands the complete ones to the transaction pool
+//
+//  Copyright Sabre 2004
+//
+//      The copyright to the computer program(s) herein
+//      is the property of Sabre.
+//      The program(s) may be used and/or copied only with
+//      the written permission of Sabre or in accordance
+//      with the terms and conditions stipulated in the
+//      agreement/contract under which the program(s)
+//      have been supplied.
+//
+//----------------------------------------------------------------------------
+
+#include "Manager/EventSocketReader.h"
+
+#include "ClientSocket/EOSocket.h"
+#include "Common/Logger.h"
+#include "Common/Thread/TseTransactionExecutor.h"
+#include "Manager/SocketRequestImpl.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace tse
+{
+namespace
+{
+Logger
+logger("atseintl.Manager.EventSocketReader");
+
+const int MAX_EVENTS = 256;
+// wakes up the loop this often to close the expired connections
+const int EXPIRY_CHECK_MS = 1000;
+// reads of one connection before giving the others a chance
+const int MAX_READS_PER_EVENT = 16;
+
+bool
+setBlocking(int fd, bool blocking)
+{
+  const int flags = ::fcntl(fd, F_GETFL, 0);
+  if (flags < 0)
+    return false;
+  return ::fcntl(fd, F_SETFL, blocking ? flags & ~O_NONBLOCK : flags | O_NONBLOCK) == 0;
+}
+}
+
+EventSocketReader::Connection::Connection(eo::Socket* s)
+  : socket(s), lastActive(std::time(nullptr))
+{
+}
+
+EventSocketReader::Connection::~Connection() { delete socket; }
+
+EventSocketReader::EventSocketReader(Service& service,
+                                     Xform& xform,
+                                     uint32_t ioBufSize,
+                                     uint16_t timeout,
+                                     ZThread::CountingSemaphore* processedRequestsCS,
+                                     uint32_t maxConnections,
+                                     uint32_t maxInflightRequests,
+                                     uint32_t idleTimeout)
+  : _service(service),
+    _xform(xform),
+    _ioBufSize(ioBufSize),
+    _timeout(timeout),
+    _processedRequestsCS(processedRequestsCS),
+    _maxConnections(maxConnections),
+    _maxInflightRequests(maxInflightRequests),
+    _idleTimeout(idleTimeout),
+    _buffer(std::max(ioBufSize, 1u))
+{
+}
+
+EventSocketReader::~EventSocketReader()
+{
+  shutdown();
+
+  // wait for the requests being processed, they resume or close their sockets
+  _executor.reset();
+
+  std::deque<SocketRequestImpl*> waiting;
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    waiting.swap(_waiting);
+    // each of them calls requestDone() when deleted
+    _numberInflight += waiting.size();
+    _connections.clear();
+  }
+  for (SocketRequestImpl* request : waiting)
+    delete request;
+
+  if (_wakeup >= 0)
+    ::close(_wakeup);
+  if (_epoll >= 0)
+    ::close(_epoll);
+}
+
+bool
+EventSocketReader::initialize()
+{
+  _epoll = ::epoll_create1(EPOLL_CLOEXEC);
+  if (_epoll < 0)
+  {
+    LOG4CXX_FATAL(logger, "epoll_create1 failed: " << std::strerror(errno));
+    return false;
+  }
+
+  _wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (_wakeup < 0)
+  {
+    LOG4CXX_FATAL(logger, "eventfd failed: " << std::strerror(errno));
+    return false;
+  }
+
+  epoll_event event;
+  event.events = EPOLLIN;
+  event.data.ptr = nullptr;
+  if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeup, &event) < 0)
+  {
+    LOG4CXX_FATAL(logger, "epoll_ctl failed: " << std::strerror(errno));
+    return false;
+  }
+
+  _executor.reset(new TseTransactionExecutor);
+
+  LOG4CXX_INFO(logger,
+               "Event driven reader: maxConnections=" << _maxConnections
+                                                      << ", maxInflightRequests="
+                                                      << _maxInflightRequests
+                                                      << ", idleTimeout=" << _idleTimeout);
+  return true;
+}
+
+void
+EventSocketReader::run()
+{
+  epoll_event events[MAX_EVENTS];
+  time_t lastCheck = std::time(nullptr);
+
+  while (!_exiting)
+  {
+    const int count = ::epoll_wait(_epoll, events, MAX_EVENTS, EXPIRY_CHECK_MS);
+    if (count < 0 && errno != EINTR)
+    {
+      LOG4CXX_FATAL(logger, "epoll_wait failed: " << std::strerror(errno));
+      break;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+      Connection* connection = static_cast<Connection*>(events[i].data.ptr);
+      if (connection == nullptr)
+        continue; // woken up by shutdown()
+
+      if (events[i].events & (EPOLLERR | EPOLLHUP))
+        close(connection);
+      else
+        read(connection);
+    }
+
+    const time_t now = std::time(nullptr);
+    if (now != lastCheck)
+    {
+      closeExpired(now);
+      lastCheck = now;
+    }
+  }
+  LOG4CXX_INFO(logger, "Event driven reader exiting");
+}
+
+void
+EventSocketReader::shutdown()
+{
+  if (_exiting.exchange(true))
+    return;
+
+  if (_wakeup >= 0)
+  {
+    const uint64_t one = 1;
+    if (::write(_wakeup, &one, sizeof(one)) < 0)
+      LOG4CXX_WARN(logger, "Unable to wake up the reader: " << std::strerror(errno));
+  }
+
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+  }
+  _capacity.notify_all();
+}
+
+bool
+EventSocketReader::add(eo::Socket* socket)
+{
+  {
+    boost::unique_lock<boost::mutex> lock(_mutex);
+    while (!_exiting && _maxConnections > 0 && _numberConnections >= _maxConnections)
+      _capacity.wait(lock);
+
+    if (_exiting)
+    {
+      lock.unlock();
+      delete socket;
+      return false;
+    }
+    ++_numberConnections;
+  }
+
+  LOG4CXX_DEBUG(logger, "New connection: " << socket->getChannel());
+  return watch(socket);
+}
+
+void
+EventSocketReader::resume(eo::Socket* socket)
+{
+  if (_exiting)
+  {
+    delete socket;
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    --_numberConnections;
+    return;
+  }
+  watch(socket);
+}
+
+bool
+EventSocketReader::watch(eo::Socket* socket)
+{
+  Connection* connection = new Connection(socket);
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    _connections.emplace(connection, std::unique_ptr<Connection>(connection));
+  }
+
+  epoll_event event;
+  event.events = EPOLLIN | EPOLLRDHUP;
+  event.data.ptr = connection;
+  if (!setBlocking(socket->getChannel(), false) ||
+      ::epoll_ctl(_epoll, EPOLL_CTL_ADD, socket->getChannel(), &event) < 0)
+  {
+    LOG4CXX_ERROR(logger,
+                  "Unable to watch connection " << socket->getChannel() << ": "
+                                                << std::strerror(errno));
+    close(connection);
+    return false;
+  }
+  return true;
+}
+
+void
+EventSocketReader::read(Connection* connection)
+{
+  const int channel = connection->socket->getChannel();
+  SocketRequestFrame& frame = connection->frame;
+
+  for (int i = 0; i < MAX_READS_PER_EVENT; ++i)
+  {
+    const ssize_t size = ::read(channel, &_buffer[0], std::min(frame.needed(), _buffer.size()));
+    if (size == 0)
+    {
+      LOG4CXX_DEBUG(logger, "Connection " << channel << " closed by remote host");
+      close(connection);
+      return;
+    }
+    if (size < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      if (errno != EAGAIN && errno != EWOULDBLOCK)
+      {
+        LOG4CXX_WARN(logger, "Read error on " << channel << ": " << std::strerror(errno));
+        close(connection);
+      }
+      return;
+    }
+
+    if (!frame.started())
+      connection->startTime = boost::posix_time::microsec_clock::local_time();
+    connection->lastActive = std::time(nullptr);
+
+    switch (frame.consume(&_buffer[0], size_t(size)))
+    {
+    case SocketRequestFrame::INCOMPLETE:
+      break;
+    case SocketRequestFrame::COMPLETE:
+      dispatch(connection);
+      return;
+    case SocketRequestFrame::FAILED:
+      LOG4CXX_WARN(logger, "Invalid request on " << channel);
+      close(connection);
+      return;
+    }
+  }
+}
+
+void
+EventSocketReader::dispatch(Connection* connection)
+{
+  eo::Socket* socket = connection->socket;
+  ::epoll_ctl(_epoll, EPOLL_CTL_DEL, socket->getChannel(), nullptr);
+  // the response is written by the transaction thread with the blocking calls
+  setBlocking(socket->getChannel(), true);
+
+  SocketRequestImpl* request = new SocketRequestImpl(connection->startTime,
+                                                     socket,
+                                                     _service,
+                                                     _xform,
+                                                     _ioBufSize,
+                                                     _timeout,
+                                                     connection->frame,
+                                                     this,
+                                                     _processedRequestsCS);
+  connection->socket = nullptr;
+
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    _connections.erase(connection);
+    if (_maxInflightRequests > 0 && _numberInflight >= _maxInflightRequests)
+    {
+      _waiting.push_back(request);
+      return;
+    }
+    ++_numberInflight;
+  }
+  execute(request);
+}
+
+void
+EventSocketReader::requestDone(bool closed)
+{
+  SocketRequestImpl* next = nullptr;
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    --_numberInflight;
+    if (closed)
+    {
+      --_numberConnections;
+      _capacity.notify_one();
+    }
+    if (!_waiting.empty() && !_exiting)
+    {
+      next = _waiting.front();
+      _waiting.pop_front();
+      ++_numberInflight;
+    }
+  }
+  if (next != nullptr)
+    execute(next);
+}
+
+void
+EventSocketReader::execute(SocketRequestImpl* request)
+{
+  try
+  {
+    _executor->execute(request);
+  }
+  catch (...)
+  {
+    LOG4CXX_ERROR(logger, "Unable to execute the request");
+    delete request;
+  }
+}
+
+void
+EventSocketReader::close(Connection* connection)
+{
+  ::epoll_ctl(_epoll, EPOLL_CTL_DEL, connection->socket->getChannel(), nullptr);
+
+  std::unique_ptr<Connection> closed;
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    auto it = _connections.find(connection);
+    if (it == _connections.end())
+      return;
+    closed.swap(it->second);
+    _connections.erase(it);
+    --_numberConnections;
+  }
+  _capacity.notify_one();
+}
+
+void
+EventSocketReader::closeExpired(time_t now)
+{
+  std::vector<Connection*> expired;
+  {
+    boost::lock_guard<boost::mutex> lock(_mutex);
+    for (const auto& elem : _connections)
+    {
+      Connection* connection = elem.first;
+      const time_t timeout = connection->frame.started() ? _timeout : _idleTimeout;
+      if (timeout > 0 && now - connection->lastActive > timeout)
+        expired.push_back(connection);
+    }
+  }
+
+  for (Connection* connection : expired)
+  {
+    LOG4CXX_DEBUG(logger, "Closing expired connection " << connection->socket->getChannel());
+    close(connection);
+  }
+}
+
+size_t
+EventSocketReader::numberConnections() const
+{
+  boost::lock_guard<boost::mutex> lock(_mutex);
+  return _numberConnections;
+}
+
+size_t
+EventSocketReader::numberInflightRequests() const
+{
+  boost::lock_guard<boost::mutex> lock(_mutex);
+  return _numberInflight;
+}
+
+size_t
+EventSocketReader::numberWaitingRequests() const
+{
+  boost::lock_guard<boost::mutex> lock(_mutex);
+  return _waiting.size();
+}
+} // namespace tse
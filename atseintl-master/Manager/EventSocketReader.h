@@ -0,0 +1,141 @@
+//----------------------------------------------------------------------------
+//
+//  File:               EventSocketReader.h
+//
+//  Description:        Reads client requests of many connections with epoll
+//                      and hands the complete ones to the transaction pool
+//
+//  Copyright Sabre 2004
+//
+//      The copyright to the computer program(s) herein
+//      is the property of Sabre.
+//      The program(s) may be used and/or copied only with
+//      the written permission of Sabre or in accordance
+//      with the terms and conditions stipulated in the
+//      agreement/contract under which the program(s)
+//      have been supplied.
+//
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "Common/DateTime.h"
+#include "Manager/SocketRequestFrame.h"
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <atomic>
+#include <ctime>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace eo
+{
+class Socket;
+}
+
+namespace ZThread
+{
+class CountingSemaphore;
+}
+
+namespace tse
+{
+class Service;
+class SocketRequestImpl;
+class TseTransactionExecutor;
+class Xform;
+
+// Single thread reading the requests of all the client connections.
+//
+// The listener threads accept the connections and add() them; they are made
+// non blocking and watched with epoll, so that an idle keep-alive connection
+// costs a file descriptor rather than a thread. The reader assembles each
+// request with a SocketRequestFrame (decompressing it if needed) and only then
+// gives the connection to a SocketRequestImpl running on the transaction pool.
+// Once the response is written the SocketRequestImpl resume()s the connection
+// for the next request.
+//
+// Admission limits: add() waits while maxConnections connections are open,
+// which leaves the next clients in the listen backlog, and at most
+// maxInflightRequests requests (0 - no limit) are processed at a time, the
+// others wait here in arrival order. Connections idle for idleTimeout seconds
+// (0 - never) and requests not completed within the read timeout are closed.
+class EventSocketReader
+{
+public:
+  EventSocketReader(Service& service,
+                    Xform& xform,
+                    uint32_t ioBufSize,
+                    uint16_t timeout,
+                    ZThread::CountingSemaphore* processedRequestsCS,
+                    uint32_t maxConnections,
+                    uint32_t maxInflightRequests,
+                    uint32_t idleTimeout);
+  EventSocketReader(const EventSocketReader&) = delete;
+  EventSocketReader& operator=(const EventSocketReader&) = delete;
+  ~EventSocketReader();
+
+  bool initialize();
+
+  // event loop, returns after shutdown()
+  void run();
+  void shutdown();
+
+  // takes the ownership of the socket, false if it was closed on shutdown
+  bool add(eo::Socket* socket);
+
+  // the response of the last request on the socket has been sent
+  void resume(eo::Socket* socket);
+
+  // called once by each request taken from the reader
+  void requestDone(bool closed);
+
+  size_t numberConnections() const;
+  size_t numberInflightRequests() const;
+  size_t numberWaitingRequests() const;
+
+private:
+  struct Connection
+  {
+    explicit Connection(eo::Socket* s);
+    ~Connection();
+
+    eo::Socket* socket;
+    SocketRequestFrame frame;
+    DateTime startTime;
+    time_t lastActive;
+  };
+
+  bool watch(eo::Socket* socket);
+  void read(Connection* connection);
+  void dispatch(Connection* connection);
+  void close(Connection* connection);
+  void closeExpired(time_t now);
+  void execute(SocketRequestImpl* request);
+
+  Service& _service;
+  Xform& _xform;
+  uint32_t _ioBufSize;
+  uint16_t _timeout;
+  ZThread::CountingSemaphore* _processedRequestsCS;
+  const size_t _maxConnections;
+  const size_t _maxInflightRequests;
+  const time_t _idleTimeout;
+
+  int _epoll = -1;
+  int _wakeup = -1;
+  std::atomic<bool> _exiting{false};
+  std::vector<char> _buffer;
+  std::unique_ptr<TseTransactionExecutor> _executor;
+
+  mutable boost::mutex _mutex;
+  boost::condition_variable _capacity;
+  std::unordered_map<Connection*, std::unique_ptr<Connection>> _connections; // being read
+  std::deque<SocketRequestImpl*> _waiting;
+  size_t _numberConnections = 0; // being read or processed
+  size_t _numberInflight = 0;
+};
+} // namespace tse
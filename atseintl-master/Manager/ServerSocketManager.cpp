@@ -25,6 +25,7 @@
 #include "Common/Config/ConfigurableValue.h"
 #include "Common/Global.h"
 #include "Common/Logger.h"
+#include "Manager/EventSocketReader.h"
 #include "Manager/TseManagerUtil.h"
 #include "Server/TseServer.h"
 #include "Service/Service.h"
@@ -58,6 +59,10 @@ struct ServerSocketManagerConfigurableValues
   ConfigurableValue<uint32_t> maxTransactionRetryTime;
   ConfigurableValue<uint32_t> maxBigIpDeregistrationWait;
   ConfigurableValue<uint32_t> maxBigIpDeregistrationRetryTime;
+  ConfigurableValue<bool> eventDrivenReader;
+  ConfigurableValue<uint32_t> maxConnections;
+  ConfigurableValue<uint32_t> maxInflightRequests;
+  ConfigurableValue<uint32_t> idleConnectionTimeout;
 
   ServerSocketManagerConfigurableValues(const std::string& name)
     : serviceName(name),
@@ -75,7 +80,11 @@ struct ServerSocketManagerConfigurableValues
       maxTransactionWait(serviceName, "MAX_TRANSACTION_WAIT"),
       maxTransactionRetryTime(serviceName, "MAX_TRANSACTION_SHUTDOWN_RETRY_TIME"),
       maxBigIpDeregistrationWait(serviceName, "MAX_BIGIP_DEREGISTRATION_WAIT_TIME"),
-      maxBigIpDeregistrationRetryTime(serviceName, "MAX_BIGIP_DEREGISTRATION_RETRY_TIME")
+      maxBigIpDeregistrationRetryTime(serviceName, "MAX_BIGIP_DEREGISTRATION_RETRY_TIME"),
+      eventDrivenReader(serviceName, "EVENT_DRIVEN_READER", false),
+      maxConnections(serviceName, "MAX_CONNECTIONS", 4096),
+      maxInflightRequests(serviceName, "MAX_INFLIGHT_REQUESTS", 0),
+      idleConnectionTimeout(serviceName, "IDLE_CONNECTION_TIMEOUT", 300)
   {
   }
 } serverSocketManagerCvs("TO_MAN");
@@ -100,6 +109,13 @@ ServerSocketManager::~ServerSocketManager()
     for (boost::thread& thread : _threads)
       thread.join();
 
+    if (_reader != nullptr)
+    {
+      _reader->shutdown();
+      if (_readerThread.joinable())
+        _readerThread.join();
+    }
+
     TseManagerUtil::deinitialize();
   }
   catch (...)
@@ -111,6 +127,7 @@ ServerSocketManager::~ServerSocketManager()
   {
     delete elem;
   }
+  delete _reader;
   delete _shutdownHandler;
   LOG4CXX_DEBUG(logger, "ServerSocketManager destructed");
 }
@@ -162,6 +179,25 @@ ServerSocketManager::initialize(int argc, char* argv[])
   if (!initializeShutdownHandler())
     return false;
 
+  // Read the requests of all the connections with one epoll thread, so that
+  // the idle keep-alive connections do not hold transaction threads
+  if (serverSocketManagerCvs.eventDrivenReader.getValue())
+  {
+    _reader = new EventSocketReader(*_service,
+                                    *_xform,
+                                    _adapter->getIOBufSize(),
+                                    _adapter->getTimeout(),
+                                    _shutdownHandler->processedTransactionsCS(),
+                                    serverSocketManagerCvs.maxConnections.getValue(),
+                                    serverSocketManagerCvs.maxInflightRequests.getValue(),
+                                    serverSocketManagerCvs.idleConnectionTimeout.getValue());
+    if (!_reader->initialize())
+    {
+      LOG4CXX_FATAL(logger, "Unable to initialize EventSocketReader");
+      return false;
+    }
+  }
+
   // Initialize configured number of threads
   const uint32_t numListeners = _adapter->getNumListeners();
   for (uint32_t i = 0; i < numListeners; i++)
@@ -169,7 +205,7 @@ ServerSocketManager::initialize(int argc, char* argv[])
     ServerSocketThread* t = new ServerSocketThread(_name, i);
     _threadTasks.push_back(t);
 
-    if (!t->initialize(_adapter, _service, _xform, _shutdownHandler))
+    if (!t->initialize(_adapter, _service, _xform, _shutdownHandler, _reader))
     {
       LOG4CXX_FATAL(logger,
                     "Unable to initalize ServerSocketThread"
@@ -292,6 +328,9 @@ ServerSocketManager::postInitialize()
 {
   ServerSocketThread::warmServer(*_xform, *_service);
 
+  if (_reader != nullptr)
+    _readerThread = boost::thread(std::bind(&EventSocketReader::run, _reader));
+
   for (uint32_t i = 0; i < _threadTasks.size(); i++)
   {
     LOG4CXX_DEBUG(logger, "Executing Thread with index [" << i << "]");
@@ -313,6 +352,8 @@ ServerSocketManager::preShutdown()
   {
     _shutdownHandler->finish();
     _adapter->shutdown();
+    if (_reader != nullptr)
+      _reader->shutdown();
 
     for (boost::thread& thread : _threads)
       thread.interrupt();
@@ -29,6 +29,7 @@
 
 namespace tse
 {
+class EventSocketReader;
 class TseServer;
 class ServerSocketManager;
 class ServerSocketAdapter;
@@ -46,6 +47,8 @@ private:
   Xform* _xform = nullptr;
   ServerSocketShutdownHandler* _shutdownHandler = nullptr;
   std::vector<boost::thread> _threads;
+  EventSocketReader* _reader = nullptr;
+  boost::thread _readerThread;
 
   std::vector<ServerSocketThread*> _threadTasks;
 
@@ -31,6 +31,7 @@
 #include "Common/TrxUtil.h"
 #include "Common/TseSrvStats.h"
 #include "Common/TseUtil.h"
+#include "Manager/EventSocketReader.h"
 #include "Manager/SocketRequestImpl.h"
 #include "Manager/TseManagerUtil.h"
 
@@ -206,6 +207,12 @@ ServerSocketThread::run()
           _shutdownHandler->finish();
         }
       }
+      else if (_reader != nullptr)
+      {
+        // the reader takes the connection, waiting here while it is at its
+        // connection limit
+        _reader->add(clientSocket);
+      }
       else
       {
         SocketRequestImpl* socketRequestImpl(new SocketRequestImpl(startTime,
@@ -250,7 +257,8 @@ bool
 ServerSocketThread::initialize(ServerSocketAdapter* adapter,
                                Service* service,
                                Xform* xform,
-                               ServerSocketShutdownHandler* shutdownHandler)
+                               ServerSocketShutdownHandler* shutdownHandler,
+                               EventSocketReader* reader)
 {
   const MallocContextDisabler context;
 
@@ -286,6 +294,9 @@ ServerSocketThread::initialize(ServerSocketAdapter* adapter,
     return false; // failure
   }
 
+  // Optional reader of the accepted connections
+  _reader = reader;
+
   return true;
 }
 
@@ -33,6 +33,7 @@ class CountingSemaphore;
 
 namespace tse
 {
+class EventSocketReader;
 class ServerSocketAdapter;
 class Service;
 class Xform;
@@ -46,6 +47,7 @@ protected:
   Service* _service = nullptr;
   Xform* _xform = nullptr;
   ServerSocketShutdownHandler* _shutdownHandler = nullptr;
+  EventSocketReader* _reader = nullptr;
   uint32_t _index = 0;
 
 public:
@@ -58,7 +60,8 @@ public:
   virtual bool initialize(ServerSocketAdapter* adapter,
                           Service* service,
                           Xform* xform,
-                          ServerSocketShutdownHandler* shutdownHandler);
+                          ServerSocketShutdownHandler* shutdownHandler,
+                          EventSocketReader* reader = nullptr);
 
 public:
   // functions that are not specific to thread instance
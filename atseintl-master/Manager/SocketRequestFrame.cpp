@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+// Copyright 2005, Sabre Inc.  All rights reserved.
+// This software/documentation is the confidential and proprietary product of
+// Sabre Inc.   Any unauthorized use, reproduction, or transfer of this
+// software/documentation,  in any medium, or incorporation of this
+// software/documentation into any system or publication, is strictly prohibited.
+//------------------------------------------------------------------------------
+//
+
+#include "Manager/SocketRequestFrame.h"
+
+#include "Common/Logger.h"
+#include "Util/BranchPrediction.h"
+#include "Util/CompressUtil.h"
+
+#include <cstring>
+#include <vector>
+
+#include <arpa/inet.h>
+
+namespace tse
+{
+namespace
+{
+Logger
+logger("atseintl.Manager.SocketRequestFrame");
+
+// payloadSize, command, schemaVersion and schemaRevision
+const size_t TRX_HEADER_SIZE = sizeof(uint32_t) + COMMAND_SIZE + VERSION_SIZE + REVISION_SIZE;
+// command and schemaVersion after the inclusive length
+const size_t ISELL_HEADER_SIZE = COMMAND_SIZE + VERSION_SIZE;
+
+uint32_t
+readLength(const char* data)
+{
+  uint32_t length = 0;
+  memcpy(&length, data, sizeof(length));
+  return ntohl(length);
+}
+}
+
+void
+SocketRequestFrame::reset()
+{
+  _stage = HEADER_SIZE;
+  _needed = sizeof(uint32_t);
+  _payloadSize = 0;
+  _header.clear();
+  _command.clear();
+  _version.clear();
+  _revision.clear();
+  _request.clear();
+  _use8ByteHeader = false;
+}
+
+SocketRequestFrame::Status
+SocketRequestFrame::consume(const char* data, size_t size)
+{
+  if (size > _needed)
+    size = _needed;
+
+  if (_stage == PAYLOAD)
+    _request.append(data, size);
+  else
+    _header.append(data, size);
+
+  _needed -= size;
+  return _needed == 0 ? nextStage() : INCOMPLETE;
+}
+
+SocketRequestFrame::Status
+SocketRequestFrame::nextStage()
+{
+  switch (_stage)
+  {
+  case HEADER_SIZE:
+  {
+    const uint32_t headerSize = readLength(_header.data());
+    _header.clear();
+    _stage = HEADER;
+    if (headerSize != TRX_HEADER_SIZE)
+    {
+      // Assume IntelliSell header, the size is the total inclusive length
+      if (headerSize < sizeof(uint32_t) + ISELL_HEADER_SIZE)
+      {
+        LOG4CXX_WARN(logger, "Invalid IntelliSell request length: " << headerSize);
+        return FAILED;
+      }
+      _use8ByteHeader = true;
+      _payloadSize = headerSize - sizeof(uint32_t) - ISELL_HEADER_SIZE;
+      _needed = ISELL_HEADER_SIZE;
+    }
+    else
+    {
+      _needed = TRX_HEADER_SIZE;
+    }
+    return INCOMPLETE;
+  }
+
+  case HEADER:
+  {
+    const char* header = _header.data();
+    if (!_use8ByteHeader)
+    {
+      _payloadSize = readLength(header);
+      header += sizeof(uint32_t);
+    }
+    _command.assign(header, COMMAND_SIZE);
+    if (!_use8ByteHeader)
+    {
+      _version.assign(header + COMMAND_SIZE, VERSION_SIZE);
+      _revision.assign(header + COMMAND_SIZE + VERSION_SIZE, REVISION_SIZE);
+    }
+    LOG4CXX_DEBUG(logger, "Request command: '" << _command << "', numNeeded: " << _payloadSize);
+
+    _stage = PAYLOAD;
+    _needed = _payloadSize;
+    if (_needed > 0)
+      return INCOMPLETE;
+  }
+  // fall through, no payload
+
+  case PAYLOAD:
+    if (shouldZip(_command))
+    {
+      std::vector<char> buf(_request.begin(), _request.end());
+      if (!CompressUtil::decompress(buf))
+        return FAILED;
+
+      _request.assign(buf.begin(), buf.end());
+    }
+    return COMPLETE;
+  }
+  return FAILED;
+}
+
+bool
+SocketRequestFrame::shouldZip(const std::string& command)
+{
+  if (LIKELY(command == "RQDF" || command == "REDF"))
+    return true;
+  return command == "RQDC" || command == "REDC";
+}
+
+bool
+SocketRequestFrame::shouldChunk(const std::string& command)
+{
+  return command == "RQDC" || command == "REDC" || command == "RQSC" || command == "RESC";
+}
+}
@@ -0,0 +1,86 @@
+//-------------------------------------------------------------------------------
+// Copyright 2005, Sabre Inc.  All rights reserved.
+// This software/documentation is the confidential and proprietary product of
+// Sabre Inc.   Any unauthorized use, reproduction, or transfer of this
+// software/documentation,  in any medium, or incorporation of this
+// software/documentation into any system or publication, is strictly prohibited.
+//-------------------------------------------------------------------------------
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace tse
+{
+const static int32_t COMMAND_SIZE = 4;
+const static int32_t VERSION_SIZE = 4;
+const static int32_t REVISION_SIZE = 4;
+
+//-------------------------------------------------------------------------
+// Incremental reader of one socket request, for callers that cannot block
+// on the socket. It understands the same framing as
+// SocketRequestImpl::receive(): a four byte header size followed either by
+// the 16 byte TRX header and the payload, or by the 8 byte IntelliSell header
+// and the rest of the inclusive length.
+//
+// Feed it with at most needed() bytes at a time, so that it never takes bytes
+// of the next request from the connection.
+//-------------------------------------------------------------------------
+class SocketRequestFrame
+{
+public:
+  enum Status
+  {
+    INCOMPLETE,
+    COMPLETE,
+    FAILED
+  };
+
+  SocketRequestFrame() { reset(); }
+
+  void reset();
+
+  // number of bytes still needed to finish the current part of the request
+  size_t needed() const { return _needed; }
+
+  // true once a byte of the request has been read
+  bool started() const { return _stage != HEADER_SIZE || _needed != sizeof(uint32_t); }
+
+  // consume size bytes, size must not exceed needed()
+  Status consume(const char* data, size_t size);
+
+  const std::string& command() const { return _command; }
+  const std::string& version() const { return _version; }
+  const std::string& revision() const { return _revision; }
+  std::string& request() { return _request; }
+  bool use8ByteHeader() const { return _use8ByteHeader; }
+
+  static bool shouldZip(const std::string& command);
+
+  // the response is sent in chunks, see ChunkedResponseWriter
+  static bool shouldChunk(const std::string& command);
+
+private:
+  enum Stage
+  {
+    HEADER_SIZE,
+    HEADER,
+    PAYLOAD
+  };
+
+  Status nextStage();
+
+  Stage _stage;
+  size_t _needed;
+  size_t _payloadSize;
+  std::string _header;
+  std::string _command;
+  std::string _version;
+  std::string _revision;
+  std::string _request;
+  bool _use8ByteHeader;
+};
+} // namespace tse
@@ -11,6 +11,8 @@
 
 #include "ClientSocket/EOSocket.h"
 #include "Common/Logger.h"
+#include "Manager/ChunkedResponseWriter.h"
+#include "Manager/EventSocketReader.h"
 #include "Manager/TseManagerUtil.h"
 #include "Util/CompressUtil.h"
 #include "Xform/Xform.h"
@@ -33,6 +35,10 @@ DEFAULT_RSP("REST");
 const std::string
 COMPRESSED_RSP("REDF");
 const std::string
+CHUNKED_RSP("RESC");
+const std::string
+COMPRESSED_CHUNKED_RSP("REDC");
+const std::string
 DEFAULT_VERSION("0001");
 const std::string
 DEFAULT_REVISION("0000");
@@ -66,15 +72,50 @@ SocketRequestImpl::SocketRequestImpl(DateTime startTime,
 {
 }
 
+SocketRequestImpl::SocketRequestImpl(DateTime startTime,
+                                     eo::Socket* socket,
+                                     Service& svce,
+                                     Xform& xform,
+                                     uint32_t& ioBufSize,
+                                     uint16_t& timeout,
+                                     SocketRequestFrame& frame,
+                                     EventSocketReader* reader,
+                                     ZThread::CountingSemaphore* processedRequestCS)
+  : _startTime(startTime),
+    _socket(socket),
+    _service(svce),
+    _xform(xform),
+    _ioBufSize(ioBufSize),
+    _timeout(timeout),
+    _use8ByteHeader(frame.use8ByteHeader()),
+    _countSem(nullptr),
+    _processedRequestCS(processedRequestCS),
+    _reader(reader),
+    _received(true),
+    _command(frame.command()),
+    _version(frame.version()),
+    _revision(frame.revision())
+{
+  _request.swap(frame.request());
+}
+
 SocketRequestImpl::~SocketRequestImpl() { cleanup(); }
 
 void
 SocketRequestImpl::cleanup()
 {
+  bool closed = false;
   if (_socket != nullptr)
   {
     delete _socket;
     _socket = nullptr;
+    closed = true;
+  }
+
+  if (_reader != nullptr)
+  {
+    _reader->requestDone(closed);
+    _reader = nullptr;
   }
 
   if (_countSem != nullptr)
@@ -106,7 +147,14 @@ SocketRequestImpl::run()
     std::string version;
     std::string revision;
 
-    if (receive(command, version, revision, request) == false)
+    if (_received)
+    {
+      command.swap(_command);
+      version.swap(_version);
+      revision.swap(_revision);
+      request.swap(_request);
+    }
+    else if (receive(command, version, revision, request) == false)
     {
       cleanup();
       return;
@@ -137,7 +185,9 @@ SocketRequestImpl::run()
     // now output the response with its ID.
     LOG4CXX_DEBUG(logger, "Response: ID(" << id << ") {{{\n" << response.c_str() << "\n}}}\n");
 
-    const std::string& responseType = shouldZip(command) ? COMPRESSED_RSP : DEFAULT_RSP;
+    const std::string& responseType =
+        shouldChunk(command) ? (shouldZip(command) ? COMPRESSED_CHUNKED_RSP : CHUNKED_RSP)
+                             : (shouldZip(command) ? COMPRESSED_RSP : DEFAULT_RSP);
 
     // Respond
     if (respond(responseType, DEFAULT_VERSION, DEFAULT_REVISION, response) == false)
@@ -146,6 +196,13 @@ SocketRequestImpl::run()
       return;
     }
 
+    if (_reader != nullptr)
+    {
+      // keep the connection for the next request
+      _reader->resume(_socket);
+      _socket = nullptr;
+    }
+
     cleanup();
     return;
   }
@@ -279,6 +336,9 @@ SocketRequestImpl::respond(const std::string& command,
 {
   LOG4CXX_DEBUG(logger, "Doing respond...");
 
+  if (shouldChunk(command))
+    return respondChunked(command, version, revision, responseStr);
+
   // add 1 for the terminating zero byte
   uint32_t len = uint32_t(responseStr.size() + 1);
 
@@ -305,6 +365,60 @@ SocketRequestImpl::respond(const std::string& command,
 
   const std::string& response = *responsePtr;
 
+  if (!writeHeader(command, version, revision, len))
+    return false;
+
+  uint16_t retries = 3;
+  bool writeOK = true;
+  for (uint16_t i = 0; i < retries; i++)
+  {
+    // Next the response data
+    if (_socket->write(response.c_str(), len) < 0)
+    {
+      LOG4CXX_FATAL(logger,
+          "Impl: " << this << ", write (response data) failed, channel:" << _socket->getChannel());
+      writeOK = false;
+    }
+    else
+    {
+      writeOK = true;
+      break;
+    }
+  }
+
+  if (writeOK == false)
+    return writeOK;
+
+  LOG4CXX_DEBUG(logger, "Response successful");
+  return true;
+}
+
+bool
+SocketRequestImpl::respondChunked(const std::string& command,
+                                  const std::string& version,
+                                  const std::string& revision,
+                                  const std::string& response)
+{
+  if (!writeHeader(command, version, revision, eo::CHUNKED_PAYLOAD_SIZE))
+    return false;
+
+  // the terminating zero byte is sent as well, as in respond()
+  ChunkedResponseWriter writer(*_socket, shouldZip(command), _ioBufSize);
+  if (!writer.write(response.c_str(), response.size() + 1) || !writer.finish())
+    return false;
+
+  LOG4CXX_DEBUG(logger,
+                "Chunked response successful, " << writer.chunksSent() << " chunks, "
+                                                << writer.bytesSent() << " bytes");
+  return true;
+}
+
+bool
+SocketRequestImpl::writeHeader(const std::string& command,
+                               const std::string& version,
+                               const std::string& revision,
+                               uint32_t len)
+{
   uint16_t retries = 3;
 
   TrxHeader header;
@@ -317,7 +431,9 @@ SocketRequestImpl::respond(const std::string& command,
     responseHeaderSize =
         sizeof(header.payloadSize) + sizeof(header.command) + sizeof(header.schemaVersion);
     std::fill(header.schemaVersion, header.schemaVersion + sizeof(header.schemaVersion), 0);
-    header.payloadSize = htonl(responseHeaderSize + len);
+    header.payloadSize = htonl(len == eo::CHUNKED_PAYLOAD_SIZE
+                                   ? len
+                                   : responseHeaderSize + len);
   }
   else
   {
@@ -377,38 +493,6 @@ SocketRequestImpl::respond(const std::string& command,
       break;
     }
   }
-  if (writeOK == false)
-    return writeOK;
-
-  writeOK = true;
-  for (uint16_t i = 0; i < retries; i++)
-  {
-    // Next the response data
-    if (_socket->write(response.c_str(), len) < 0)
-    {
-      LOG4CXX_FATAL(logger,
-          "Impl: " << this << ", write (response data) failed, channel:" << _socket->getChannel());
-      writeOK = false;
-    }
-    else
-    {
-      writeOK = true;
-      break;
-    }
-  }
-
-  if (writeOK == false)
-    return writeOK;
-
-  LOG4CXX_DEBUG(logger, "Response successful");
-  return true;
-}
-
-bool
-SocketRequestImpl::shouldZip(const std::string& command)
-{
-  if (LIKELY(command == "RQDF" || command == "REDF"))
-    return true;
-  return false;
+  return writeOK;
 }
 }
@@ -12,6 +12,7 @@
 #include "Common/DateTime.h"
 #include "Common/Thread/TseCallableTask.h"
 #include "Common/TseStringTypes.h"
+#include "Manager/SocketRequestFrame.h"
 #include "Manager/TseManagerUtil.h"
 
 #include <ZThreads/zthread/CountingSemaphore.h>
@@ -23,13 +24,10 @@ class Socket;
 
 namespace tse
 {
+class EventSocketReader;
 class Service;
 class Xform;
 
-const static int32_t COMMAND_SIZE = 4;
-const static int32_t VERSION_SIZE = 4;
-const static int32_t REVISION_SIZE = 4;
-
 class SocketRequestImpl : public TseCallableTask
 {
 public:
@@ -41,6 +39,18 @@ public:
                     uint16_t& timeout,
                     ZThread::CountingSemaphore* countSem = nullptr,
                     ZThread::CountingSemaphore* processedRequestsCS = nullptr);
+
+  // The request has already been read by the reader. After a successful
+  // response the socket is given back to the reader for the next request.
+  SocketRequestImpl(DateTime startTime,
+                    eo::Socket* socket,
+                    Service& svce,
+                    Xform& xform,
+                    uint32_t& ioBufSize,
+                    uint16_t& timeout,
+                    SocketRequestFrame& frame,
+                    EventSocketReader* reader,
+                    ZThread::CountingSemaphore* processedRequestsCS = nullptr);
   virtual ~SocketRequestImpl();
 
   bool initialize() { return true; }
@@ -68,8 +78,18 @@ private:
   bool _use8ByteHeader = false;
   ZThread::CountingSemaphore* _countSem;
   ZThread::CountingSemaphore* _processedRequestCS;
+  EventSocketReader* _reader = nullptr;
+  bool _received = false;
+  std::string _command;
+  std::string _version;
+  std::string _revision;
+  std::string _request;
 
-  bool shouldZip(const std::string& command);
+  bool shouldZip(const std::string& command) { return SocketRequestFrame::shouldZip(command); }
+  bool shouldChunk(const std::string& command)
+  {
+    return SocketRequestFrame::shouldChunk(command);
+  }
   void cleanup();
 
   //-------------------------------------------------------------------------
@@ -101,5 +121,17 @@ private:
                const std::string& version,
                const std::string& revision,
                const std::string& response);
+
+  // sends the response with a ChunkedResponseWriter
+  bool respondChunked(const std::string& command,
+                      const std::string& version,
+                      const std::string& revision,
+                      const std::string& response);
+
+  // len - size of the payload following the header
+  bool writeHeader(const std::string& command,
+                   const std::string& version,
+                   const std::string& revision,
+                   uint32_t len);
 };
 } // namespace tse
@@ -30,6 +30,7 @@
 #include "Common/Gauss.h"
 #include "Common/Global.h"
 #include "Common/Logger.h"
+#include "Common/Memory/AdmissionController.h"
 #include "Common/Memory/GlobalManager.h"
 #include "Common/MetricsUtil.h"
 #include "Common/NonFatalErrorResponseException.h"
@@ -560,6 +561,9 @@ TseManagerUtil::process(DateTime startTime,
       Throttling throttling(*trx);
       throttling.checkThrottlingConditions();
 
+      // Reserve the estimated memory of the trx, released once the response is built.
+      const Memory::AdmissionController::Reservation memoryReservation(*trx);
+
       // We are about to process the transaction, so update the counter of
       // processed transactions
       if (processedRequestsCS != nullptr)
@@ -680,6 +684,10 @@ TseManagerUtil::process(DateTime startTime,
         MetricsUtil::header(tmp, "TseManagerUtil Metrics");
         MetricsUtil::lineItemHeader(tmp);
 
+        if (const Memory::AdmissionController* admission =
+                Memory::AdmissionController::instance())
+          admission->print(tmp);
+
         // MetricsUtil::lineItem(tmp, "TSEMANAGERUTIL SERVICE");
         // MetricsUtil::lineItem(tmp, "TSEMANAGERUTIL RSPXFORM");
       }
@@ -0,0 +1,130 @@
+#include "test/include/CppUnitHelperMacros.h"
+
+#include "ClientSocket/EOSocket.h"
+#include "Manager/ChunkedResponseWriter.h"
+#include "Util/CompressUtil.h"
+
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace tse
+{
+class ChunkedResponseWriterTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ChunkedResponseWriterTest);
+  CPPUNIT_TEST(testEmpty);
+  CPPUNIT_TEST(testSmallResponse);
+  CPPUNIT_TEST(testChunks);
+  CPPUNIT_TEST(testCompressed);
+  CPPUNIT_TEST_SUITE_END();
+
+  int _peer = -1;
+  eo::Socket* _socket = nullptr;
+
+  // reads the chunks sent by the writer, returns their sizes
+  std::vector<size_t> readChunks(std::string& data)
+  {
+    std::vector<size_t> sizes;
+    for (;;)
+    {
+      uint32_t size = 0;
+      CPPUNIT_ASSERT_EQUAL(ssize_t(sizeof(size)), ::read(_peer, &size, sizeof(size)));
+      size = ntohl(size);
+      if (size == 0)
+        return sizes;
+      sizes.push_back(size);
+      const size_t start = data.size();
+      data.resize(start + size);
+      for (size_t got = 0; got < size;)
+      {
+        const ssize_t part = ::read(_peer, &data[start + got], size - got);
+        CPPUNIT_ASSERT(part > 0);
+        got += size_t(part);
+      }
+    }
+  }
+
+  std::string response(size_t size)
+  {
+    std::string data;
+    for (size_t i = 0; data.size() < size; ++i)
+      data += "<Option id=\"" + std::to_string(i) + "\"/>";
+    data.resize(size);
+    return data;
+  }
+
+public:
+  void setUp()
+  {
+    int fds[2];
+    CPPUNIT_ASSERT_EQUAL(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    // large enough for the responses below, nobody reads while writing
+    const int bufferSize = 4 * 1024 * 1024;
+    ::setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+    ::setsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+    _socket = new eo::Socket(fds[0], nullptr);
+    _peer = fds[1];
+  }
+
+  void tearDown()
+  {
+    delete _socket;
+    ::close(_peer);
+  }
+
+  void testEmpty()
+  {
+    ChunkedResponseWriter writer(*_socket, false, 1024);
+    CPPUNIT_ASSERT(writer.finish());
+    std::string data;
+    CPPUNIT_ASSERT(readChunks(data).empty());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), writer.chunksSent());
+  }
+
+  void testSmallResponse()
+  {
+    ChunkedResponseWriter writer(*_socket, false, 1024);
+    const std::string expected("<PricingResponse/>");
+    CPPUNIT_ASSERT(writer.write(expected.data(), expected.size()));
+    CPPUNIT_ASSERT(writer.finish());
+    std::string data;
+    CPPUNIT_ASSERT_EQUAL(size_t(1), readChunks(data).size());
+    CPPUNIT_ASSERT_EQUAL(expected, data);
+  }
+
+  void testChunks()
+  {
+    ChunkedResponseWriter writer(*_socket, false, 1024);
+    const std::string expected = response(5000);
+    CPPUNIT_ASSERT(writer.write(expected.data(), 100));
+    CPPUNIT_ASSERT(writer.write(expected.data() + 100, expected.size() - 100));
+    CPPUNIT_ASSERT(writer.finish());
+
+    std::string data;
+    const std::vector<size_t> sizes = readChunks(data);
+    CPPUNIT_ASSERT_EQUAL(size_t(5), sizes.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(1024), sizes[0]);
+    CPPUNIT_ASSERT_EQUAL(size_t(5000 - 4 * 1024), sizes[4]);
+    CPPUNIT_ASSERT_EQUAL(expected, data);
+  }
+
+  void testCompressed()
+  {
+    ChunkedResponseWriter writer(*_socket, true, 1024);
+    const std::string expected = response(200000);
+    CPPUNIT_ASSERT(writer.write(expected.data(), expected.size()));
+    CPPUNIT_ASSERT(writer.finish());
+
+    std::string data;
+    CPPUNIT_ASSERT(readChunks(data).size() > 1);
+    CPPUNIT_ASSERT(data.size() < expected.size());
+    CPPUNIT_ASSERT(CompressUtil::decompress(data));
+    CPPUNIT_ASSERT_EQUAL(expected, data);
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(ChunkedResponseWriterTest);
+}
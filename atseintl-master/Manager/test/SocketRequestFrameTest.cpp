@@ -0,0 +1,134 @@
+#include "test/include/CppUnitHelperMacros.h"
+
+#include "Manager/SocketRequestFrame.h"
+#include "Util/CompressUtil.h"
+
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+
+namespace tse
+{
+namespace
+{
+std::string
+length(uint32_t value)
+{
+  value = htonl(value);
+  return std::string(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+std::string
+trxRequest(const std::string& command, const std::string& payload)
+{
+  return length(16) + length(uint32_t(payload.size())) + command + "0002" + "0003" + payload;
+}
+
+std::string
+isellRequest(const std::string& payload)
+{
+  return length(uint32_t(4 + 8 + payload.size())) + "RQST" + "0001" + payload;
+}
+
+// feeds the bytes as the reader does, at most needed() at a time
+SocketRequestFrame::Status
+feed(SocketRequestFrame& frame, const std::string& bytes, size_t chunk = 1024)
+{
+  SocketRequestFrame::Status status = SocketRequestFrame::INCOMPLETE;
+  size_t pos = 0;
+  while (status == SocketRequestFrame::INCOMPLETE && pos < bytes.size())
+  {
+    const size_t size = std::min(std::min(frame.needed(), chunk), bytes.size() - pos);
+    status = frame.consume(bytes.data() + pos, size);
+    pos += size;
+  }
+  return status;
+}
+}
+
+class SocketRequestFrameTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(SocketRequestFrameTest);
+  CPPUNIT_TEST(testTrxHeader);
+  CPPUNIT_TEST(testByteByByte);
+  CPPUNIT_TEST(testIsellHeader);
+  CPPUNIT_TEST(testInvalidIsellLength);
+  CPPUNIT_TEST(testEmptyPayload);
+  CPPUNIT_TEST(testCompressed);
+  CPPUNIT_TEST(testReset);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testTrxHeader()
+  {
+    SocketRequestFrame frame;
+    CPPUNIT_ASSERT(!frame.started());
+    CPPUNIT_ASSERT_EQUAL(SocketRequestFrame::COMPLETE,
+                         feed(frame, trxRequest("RQST", "<PricingRequest/>")));
+    CPPUNIT_ASSERT_EQUAL(std::string("RQST"), frame.command());
+    CPPUNIT_ASSERT_EQUAL(std::string("0002"), frame.version());
+    CPPUNIT_ASSERT_EQUAL(std::string("0003"), frame.revision());
+    CPPUNIT_ASSERT_EQUAL(std::string("<PricingRequest/>"), frame.request());
+    CPPUNIT_ASSERT(!frame.use8ByteHeader());
+  }
+
+  void testByteByByte()
+  {
+    SocketRequestFrame frame;
+    const std::string bytes = trxRequest("RQST", "<PricingRequest/>");
+    CPPUNIT_ASSERT_EQUAL(SocketRequestFrame::INCOMPLETE, frame.consume(bytes.data(), 1));
+    CPPUNIT_ASSERT(frame.started());
+    CPPUNIT_ASSERT_EQUAL(SocketRequestFrame::COMPLETE, feed(frame, bytes.substr(1), 1));
+    CPPUNIT_ASSERT_EQUAL(std::string("<PricingRequest/>"), frame.request());
+  }
+
+  void testIsellHeader()
+  {
+    SocketRequestFrame frame;
+    CPPUNIT_ASSERT_EQUAL(SocketRequestFrame::COMPLETE, feed(frame, isellRequest("<Shop/>")));
+    CPPUNIT_ASSERT_EQUAL(std::string("RQST"), frame.command());
+    CPPUNIT_ASSERT_EQUAL(std::string("<Shop/>"), frame.request());
+    CPPUNIT_ASSERT(frame.use8ByteHeader());
+  }
+
+  void testInvalidIsellLength()
+  {
+    SocketRequestFrame frame;
+    CPPUNIT_ASSERT_EQUAL(SocketRequestFrame::FAILED, feed(frame, length(8)));
+  }
+
+  void testEmptyPayload()
+  {
+    SocketRequestFrame frame;
+    CPPUNIT_ASSERT_EQUAL(SocketRequestFrame::COMPLETE, feed(frame, trxRequest("RQST", "")));
+    CPPUNIT_ASSERT(frame.request().empty());
+  }
+
+  void testCompressed()
+  {
+    std::vector<char> buf;
+    const std::string xml("<PricingRequest/>");
+    buf.assign(xml.begin(), xml.end());
+    CPPUNIT_ASSERT(CompressUtil::compress(buf));
+
+    SocketRequestFrame frame;
+    CPPUNIT_ASSERT_EQUAL(SocketRequestFrame::COMPLETE,
+                         feed(frame, trxRequest("RQDF", std::string(buf.begin(), buf.end()))));
+    CPPUNIT_ASSERT_EQUAL(xml, frame.request());
+  }
+
+  void testReset()
+  {
+    SocketRequestFrame frame;
+    feed(frame, isellRequest("<Shop/>"));
+    frame.reset();
+    CPPUNIT_ASSERT(!frame.started());
+    CPPUNIT_ASSERT_EQUAL(size_t(4), frame.needed());
+    CPPUNIT_ASSERT_EQUAL(SocketRequestFrame::COMPLETE, feed(frame, trxRequest("RQST", "<A/>")));
+    CPPUNIT_ASSERT(!frame.use8ByteHeader());
+    CPPUNIT_ASSERT_EQUAL(std::string("<A/>"), frame.request());
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(SocketRequestFrameTest);
+}
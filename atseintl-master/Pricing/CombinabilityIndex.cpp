@@ -0,0 +1,331 @@
+//----------------------------------------------------------------------------
+//  Copyright Sabre 2016
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//----------------------------------------------------------------------------
+#include "Pricing/CombinabilityIndex.h"
+
+#include "Common/TseConsts.h"
+#include "DBAccess/FareClassRestRule.h"
+#include "DBAccess/TariffRuleRest.h"
+#include "Diagnostic/DiagCollector.h"
+#include "Pricing/Combinations.h"
+#include "Rules/RuleUtil.h"
+
+#include <boost/functional/hash.hpp>
+
+#include <iomanip>
+#include <sstream>
+
+namespace tse
+{
+namespace
+{
+template <class Key>
+inline CombinabilityIndex::RuleMask
+maskOf(const boost::container::flat_map<Key, CombinabilityIndex::RuleMask>& masks,
+       const Key& key)
+{
+  const auto it = masks.find(key);
+  return it == masks.end() ? 0 : it->second;
+}
+}
+
+//----------------------------------------------------------------------------
+// 107 - a rule matches when its global direction matches, and either its tariff matches and
+// its rule matches, or the tariff does not match and the rule has no tariff or rule number.
+// Any other rule is defaulted.
+//----------------------------------------------------------------------------
+bool
+CombinabilityIndex::TariffRuleItem::compile(const std::vector<TariffRuleRest*>& rules)
+{
+  if (rules.empty() || rules.size() > MAX_RULES)
+    return false;
+
+  RuleMask bit = 1;
+  for (const TariffRuleRest* rule : rules)
+  {
+    // same tariff/rule needs the current fare and the carrier preference, default rule the
+    // fare market rules
+    if (rule->sametrfRuleInd() != Combinations::NO_APPLICATION || rule->defaultRuleInd() == 'X')
+      return false;
+
+    if (rule->trfRuleApplInd() == Combinations::NOT_ALLOWED)
+      _negative = true;
+
+    if (rule->ruleTariff() == Combinations::ANY_TARIFF)
+      _anyTariff |= bit;
+    else
+      _tariffs[rule->ruleTariff()] |= bit;
+
+    if (rule->rule() == ANY_RULE)
+      _anyRule |= bit;
+    else
+      _rules[rule->rule()] |= bit;
+
+    if (rule->ruleTariff() == Combinations::NO_TARIFF_APPLICATION || rule->rule() == RULENUM_BLANK)
+      _noTariffRule |= bit;
+
+    if (rule->globalDirection() == ' ' || rule->globalDirection() == GlobalDirection::ZZ)
+      _anyGlobalDir |= bit;
+    else
+      _globalDirs[uint8_t(rule->globalDirection())] |= bit;
+
+    bit <<= 1;
+  }
+  return true;
+}
+
+bool
+CombinabilityIndex::TariffRuleItem::matchesNone(const TariffNumber tariff,
+                                                const RuleNumber& rule,
+                                                const GlobalDirection globalDir) const
+{
+  const RuleMask tariffMatched = _anyTariff | maskOf(_tariffs, tariff);
+  const RuleMask ruleMatched = _anyRule | maskOf(_rules, rule);
+  const RuleMask globalDirMatched = _anyGlobalDir | maskOf(_globalDirs, uint8_t(globalDir));
+
+  return !(globalDirMatched &
+           ((tariffMatched & ruleMatched) | (~tariffMatched & _noTariffRule)));
+}
+
+//----------------------------------------------------------------------------
+// 108 - a rule matches when it passes the ow/rt check of the target fare and its fare class or
+// fare type matches. The ow/rt check depends only on the owrt of the target fare.
+//----------------------------------------------------------------------------
+size_t
+CombinabilityIndex::FareClassItem::owrtIndex(const Indicator owrt)
+{
+  switch (owrt)
+  {
+  case ONE_WAY_MAY_BE_DOUBLED:
+    return 0;
+  case ROUND_TRIP_MAYNOT_BE_HALVED:
+    return 1;
+  case ONE_WAY_MAYNOT_BE_DOUBLED:
+    return 2;
+  default:
+    return 3;
+  }
+}
+
+bool
+CombinabilityIndex::FareClassItem::compile(const std::vector<FareClassRestRule*>& rules)
+{
+  if (rules.empty() || rules.size() > MAX_RULES)
+    return false;
+
+  RuleMask bit = 1;
+  for (const FareClassRestRule* rule : rules)
+  {
+    if (rule->normalFaresInd() == 'X' || rule->samediffInd() != ' ')
+      return false;
+
+    const Indicator owrt = rule->owrt();
+    if (rule->normalFaresInd() != ' ' || (owrt != '2' && owrt != '7' && owrt != '8'))
+      _owrt[owrtIndex(ONE_WAY_MAY_BE_DOUBLED)] |= bit;
+    if (owrt != '1' && owrt != '5' && owrt != '6')
+      _owrt[owrtIndex(ROUND_TRIP_MAYNOT_BE_HALVED)] |= bit;
+    if (owrt != '2')
+      _owrt[owrtIndex(ONE_WAY_MAYNOT_BE_DOUBLED)] |= bit;
+    _owrt[owrtIndex(' ')] |= bit;
+
+    const FareType& code = rule->typeCode();
+    switch (rule->typeInd())
+    {
+    case ' ':
+      _anyType |= bit;
+      break;
+    case 'F':
+    case 'A':
+      // a fare class without a hyphen only matches itself
+      if (code.empty() || code.find('-') != FareType::npos)
+        _fareFamilies.emplace_back(code, bit);
+      else
+        _fareClasses[code] |= bit;
+      break;
+    case 'T':
+      if (code.empty())
+        _anyType |= bit;
+      else if (code.size() > 1 && code[0] == ALL_TYPE)
+        _genericFareTypes.emplace_back(code, bit);
+      else
+        _fareTypes[code] |= bit;
+      break;
+    default:
+      return false;
+    }
+
+    if (rule->fareClassTypeApplInd() == Combinations::NOT_ALLOWED)
+      _negative = true;
+    if (rule->penaltysvcchrgApplInd() == Combinations::RESTRICTION_APPLIES)
+      _penalty |= bit;
+
+    _rules.push_back(rule);
+    bit <<= 1;
+  }
+  return true;
+}
+
+bool
+CombinabilityIndex::FareClassItem::matchesNone(const Indicator owrt,
+                                               const FareClassCode& fareClass,
+                                               const FareType& fareType) const
+{
+  const RuleMask candidates = _owrt[owrtIndex(owrt)];
+  const RuleMask matched =
+      _anyType | maskOf(_fareClasses, fareClass) | maskOf(_fareTypes, fareType);
+
+  if (candidates & matched)
+    return false;
+
+  for (const auto& family : _fareFamilies)
+  {
+    if ((candidates & family.second) &&
+        RuleUtil::matchFareClass(family.first.c_str(), fareClass.c_str()))
+      return false;
+  }
+
+  for (const auto& generic : _genericFareTypes)
+  {
+    if ((candidates & generic.second) && RuleUtil::matchFareType(generic.first, fareType))
+      return false;
+  }
+  return true;
+}
+
+const FareClassRestRule*
+CombinabilityIndex::FareClassItem::lastRule(const RuleMask mask) const
+{
+  return mask ? _rules[63 - __builtin_clzll(mask)] : nullptr;
+}
+
+const FareClassRestRule*
+CombinabilityIndex::FareClassItem::lastOwrtMatched(const Indicator owrt) const
+{
+  return lastRule(_owrt[owrtIndex(owrt)]);
+}
+
+const FareClassRestRule*
+CombinabilityIndex::FareClassItem::lastPenalty(const Indicator owrt) const
+{
+  return lastRule(_owrt[owrtIndex(owrt)] & _penalty);
+}
+
+//----------------------------------------------------------------------------
+template <class Item>
+CombinabilityIndex::ItemTable<Item>::~ItemTable()
+{
+  for (std::atomic<Entry*>& slot : _slots)
+    delete slot.load(std::memory_order_relaxed);
+}
+
+// The lookup only loads the slots. A thread missing the item compiles it and publishes it in
+// the first free slot; when another thread publishes the same item first, its copy is dropped.
+template <class Item, class Rule>
+const Item*
+CombinabilityIndex::item(ItemTable<Item>& items,
+                         const SubCat subCat,
+                         const VendorCode& vendor,
+                         const uint32_t itemNo,
+                         const std::vector<Rule*>& rules)
+{
+  using Entry = typename ItemTable<Item>::Entry;
+
+  const ItemKey key(vendor, itemNo, &rules);
+  size_t hash = boost::hash<const void*>()(&rules);
+  boost::hash_combine(hash, itemNo);
+
+  std::unique_ptr<Entry> compiled;
+  for (size_t probe = 0; probe < ItemTable<Item>::CAPACITY; ++probe)
+  {
+    std::atomic<Entry*>& slot = items._slots[(hash + probe) % ItemTable<Item>::CAPACITY];
+    Entry* entry = slot.load(std::memory_order_acquire);
+
+    if (!entry)
+    {
+      if (!compiled)
+      {
+        compiled.reset(new Entry{key, std::unique_ptr<Item>(new Item)});
+        if (!compiled->item->compile(rules))
+          compiled->item.reset();
+      }
+
+      if (slot.compare_exchange_strong(
+              entry, compiled.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+        ++_stats[subCat].items;
+        if (compiled->item)
+          ++_stats[subCat].indexed;
+        return compiled.release()->item.get();
+      }
+    }
+
+    if (entry->key == key)
+      return entry->item.get();
+  }
+
+  return nullptr;
+}
+
+const CombinabilityIndex::TariffRuleItem*
+CombinabilityIndex::tariffRuleItem(const VendorCode& vendor,
+                                   const uint32_t itemNo,
+                                   const std::vector<TariffRuleRest*>& rules)
+{
+  return item(_tariffRuleItems, TARIFF_RULE, vendor, itemNo, rules);
+}
+
+const CombinabilityIndex::FareClassItem*
+CombinabilityIndex::fareClassItem(const VendorCode& vendor,
+                                  const uint32_t itemNo,
+                                  const std::vector<FareClassRestRule*>& rules)
+{
+  return item(_fareClassItems, FARE_CLASS, vendor, itemNo, rules);
+}
+
+void
+CombinabilityIndex::addStats(const CombinabilityIndex& other)
+{
+  for (size_t subCat = 0; subCat < SUBCAT_COUNT; ++subCat)
+  {
+    Stats& stats = _stats[subCat];
+    const Stats& otherStats = other._stats[subCat];
+    stats.items += otherStats.items.load();
+    stats.indexed += otherStats.indexed.load();
+    stats.checked += otherStats.checked.load();
+    stats.skipped += otherStats.skipped.load();
+  }
+}
+
+void
+CombinabilityIndex::printStats(DiagCollector& diag) const
+{
+  static const char* const subCatNames[SUBCAT_COUNT] = {"107", "108"};
+
+  diag << " CAT10 COMBINABILITY PRECHECK\n"
+       << " SUBCAT   ITEMS INDEXED   CHECKED   SKIPPED  HIT RATE\n";
+
+  for (size_t subCat = 0; subCat < SUBCAT_COUNT; ++subCat)
+  {
+    const Stats& stats = _stats[subCat];
+    const uint32_t checked = stats.checked.load();
+    const uint32_t skipped = stats.skipped.load();
+
+    std::ostringstream hitRate;
+    hitRate << std::fixed << std::setprecision(1) << (checked ? 100.0 * skipped / checked : 0.0)
+            << "%";
+
+    diag << "  " << subCatNames[subCat] << std::setw(10) << stats.items.load() << std::setw(8)
+         << stats.indexed.load() << std::setw(10) << checked << std::setw(10) << skipped
+         << std::setw(10) << hitRate.str() << "\n";
+  }
+}
+}
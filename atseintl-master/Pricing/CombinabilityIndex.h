@@ -0,0 +1,185 @@
+//----------------------------------------------------------------------------
+//  Copyright Sabre 2016
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "Common/TseBoostStringTypes.h"
+#include "Common/TseCodeTypes.h"
+#include "Common/TseEnums.h"
+#include "Common/TsePrimitiveTypes.h"
+
+#include <boost/container/flat_map.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace tse
+{
+class DiagCollector;
+class FareClassRestRule;
+class TariffRuleRest;
+
+// Cat 10 Record 3 restriction items compiled into bitsets over their rules.
+//
+// A 107 or 108 item passes when any of its rules matches the target fare. When none of its rules
+// needs the current fare or the database, the condition of each rule is split by the field of the
+// target fare it looks at, and every value found in the item maps to the mask of the rules it
+// satisfies. The target fare matches no rule when the intersection of the masks of its values is
+// empty, then the full validation only ends in NOT MATCHED and Combinations skips it.
+class CombinabilityIndex
+{
+public:
+  using RuleMask = uint64_t;
+
+  static constexpr size_t MAX_RULES = 64;
+
+  enum SubCat
+  {
+    TARIFF_RULE, // 107
+    FARE_CLASS, // 108
+    SUBCAT_COUNT
+  };
+
+  class TariffRuleItem
+  {
+  public:
+    // false when the item can not be indexed: same tariff/rule or default rule indicators
+    bool compile(const std::vector<TariffRuleRest*>& rules);
+
+    bool matchesNone(TariffNumber tariff, const RuleNumber& rule, GlobalDirection globalDir) const;
+
+    // a rule of the item does not allow the combination
+    bool negative() const { return _negative; }
+
+  private:
+    RuleMask _anyTariff = 0;
+    RuleMask _anyRule = 0;
+    RuleMask _anyGlobalDir = 0;
+    RuleMask _noTariffRule = 0; // rules matching any tariff/rule not in their tariff
+    boost::container::flat_map<TariffNumber, RuleMask> _tariffs;
+    boost::container::flat_map<RuleNumber, RuleMask> _rules;
+    boost::container::flat_map<uint8_t, RuleMask> _globalDirs;
+    bool _negative = false;
+  };
+
+  class FareClassItem
+  {
+  public:
+    // false when the item can not be indexed: normal fares 'X', same/different or season and
+    // day of week indicators
+    bool compile(const std::vector<FareClassRestRule*>& rules);
+
+    bool matchesNone(Indicator owrt, const FareClassCode& fareClass, const FareType& fareType) const;
+
+    // The rules whose same min/max stay and penalty data the full validation leaves in the
+    // current fare usage when no rule matches, nullptr for none.
+    const FareClassRestRule* lastOwrtMatched(Indicator owrt) const;
+    const FareClassRestRule* lastPenalty(Indicator owrt) const;
+
+    bool negative() const { return _negative; }
+
+  private:
+    static size_t owrtIndex(Indicator owrt);
+    const FareClassRestRule* lastRule(RuleMask mask) const;
+
+    std::vector<const FareClassRestRule*> _rules;
+    RuleMask _owrt[4] = {0, 0, 0, 0};
+    RuleMask _anyType = 0;
+    RuleMask _penalty = 0;
+    boost::container::flat_map<FareType, RuleMask> _fareClasses;
+    boost::container::flat_map<FareType, RuleMask> _fareTypes;
+    std::vector<std::pair<FareType, RuleMask>> _fareFamilies;
+    std::vector<std::pair<FareType, RuleMask>> _genericFareTypes;
+    bool _negative = false;
+  };
+
+  CombinabilityIndex() = default;
+  CombinabilityIndex(const CombinabilityIndex&) = delete;
+  CombinabilityIndex& operator=(const CombinabilityIndex&) = delete;
+
+  // The compiled item, nullptr when it can not be indexed. Each item is compiled once and
+  // published to the other pricing unit threads, which read it without a lock.
+  const TariffRuleItem* tariffRuleItem(const VendorCode& vendor,
+                                       uint32_t itemNo,
+                                       const std::vector<TariffRuleRest*>& rules);
+  const FareClassItem* fareClassItem(const VendorCode& vendor,
+                                     uint32_t itemNo,
+                                     const std::vector<FareClassRestRule*>& rules);
+
+  void countCheck(const SubCat subCat, const bool skipped)
+  {
+    ++_stats[subCat].checked;
+    if (skipped)
+      ++_stats[subCat].skipped;
+  }
+
+  // adds the counts of another index, for the private instances of concurrent fare path factories
+  void addStats(const CombinabilityIndex& other);
+
+  // hit rates for Diagnostic 610/620
+  void printStats(DiagCollector& diag) const;
+
+private:
+  // the rules of an item differ by date, the vector from the data handle tells them apart
+  using ItemKey = std::tuple<VendorCode, uint32_t, const void*>;
+
+  // Open addressing table of compiled items; an entry is never replaced once published.
+  // When it is full the remaining items are not indexed.
+  template <class Item>
+  class ItemTable
+  {
+  public:
+    static constexpr size_t CAPACITY = 1024;
+
+    struct Entry
+    {
+      ItemKey key;
+      std::unique_ptr<Item> item;
+    };
+
+    ItemTable()
+    {
+      for (std::atomic<Entry*>& slot : _slots)
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+    ~ItemTable();
+    ItemTable(const ItemTable&) = delete;
+    ItemTable& operator=(const ItemTable&) = delete;
+
+    std::array<std::atomic<Entry*>, CAPACITY> _slots;
+  };
+
+  template <class Item, class Rule>
+  const Item* item(ItemTable<Item>& items,
+                   SubCat subCat,
+                   const VendorCode& vendor,
+                   uint32_t itemNo,
+                   const std::vector<Rule*>& rules);
+
+  struct Stats
+  {
+    std::atomic<uint32_t> items{0};
+    std::atomic<uint32_t> indexed{0};
+    std::atomic<uint32_t> checked{0};
+    std::atomic<uint32_t> skipped{0};
+  };
+
+  ItemTable<TariffRuleItem> _tariffRuleItems;
+  ItemTable<FareClassItem> _fareClassItems;
+  Stats _stats[SUBCAT_COUNT];
+};
+}
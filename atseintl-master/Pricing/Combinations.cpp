@@ -87,6 +87,7 @@ dataStringLogger("atseintl.Pricing.Combinations.DataString");
 
 bool Combinations::_enablePULevelFailedFareUsageOptimization = true;
 bool Combinations::_enableFPLevelFailedFareUsageOptimization = true;
+bool Combinations::_enableCombinabilityPrecheck = true;
 
 const char Combinations::PASSCOMB;
 const char Combinations::FAILCOMB;
@@ -4200,6 +4201,12 @@ Combinations::processTariffRuleRestriction(DiagCollector& diag,
   bool mustVerifyCarrierPreference =
       (!validationFareComponent.hasOneCarrier() || !validationFareComponent.hasOneVendor());
 
+  // the diagnostic shows every rule, so the precheck is off with it
+  const CombinabilityIndex::TariffRuleItem* indexedItem =
+      (_enableCombinabilityPrecheck && !diag.isActive())
+          ? _combinabilityIndex.tariffRuleItem(pCat10->vendorCode(), itemNo, tariffRuleRestVector)
+          : nullptr;
+
   size_t numOfFU = validationFareComponent.size();
 
   for (size_t fuCount = 0; fuCount < numOfFU; ++fuCount)
@@ -4246,6 +4253,24 @@ Combinations::processTariffRuleRestriction(DiagCollector& diag,
       diag << "  COMBINING WITH FARE " << targetFare->createFareBasis(nullptr) << std::endl;
     }
 
+    // A target matching no rule ends in NOT MATCHED; a match from a previous item is left to
+    // the rules as the defaulted ones keep it.
+    if (indexedItem &&
+        validationFareComponent[fuCount].getSubCat(m107) != ValidationElement::MATCHED)
+    {
+      const bool noMatch = indexedItem->matchesNone(
+          targetFare->tcrRuleTariff(), targetFare->ruleNumber(), targetFare->globalDirection());
+      _combinabilityIndex.countCheck(CombinabilityIndex::TARIFF_RULE, noMatch);
+
+      if (noMatch)
+      {
+        if (indexedItem->negative())
+          negative = true;
+        validationFareComponent[fuCount].getSubCat(m107) = ValidationElement::NOT_MATCHED;
+        continue;
+      }
+    }
+
     iter = tariffRuleRestVector.begin();
     iterEnd = tariffRuleRestVector.end();
 
@@ -4516,6 +4541,11 @@ Combinations::processFareClassTypeRestriction(DiagCollector& diag,
          << curFu.paxTypeFare()->createFareBasis(nullptr) << std::endl;
   }
 
+  const CombinabilityIndex::FareClassItem* indexedItem =
+      (_enableCombinabilityPrecheck && !diag.isActive())
+          ? _combinabilityIndex.fareClassItem(pCat10->vendorCode(), itemNo, fareClassRestRuleVector)
+          : nullptr;
+
   size_t numOfFU = validationFareComponent.size();
 
   for (size_t fuCount = 0; fuCount < numOfFU; ++fuCount)
@@ -4546,6 +4576,30 @@ Combinations::processFareClassTypeRestriction(DiagCollector& diag,
       diag << "  COMBINING WITH FARE " << targetFare->createFareBasis(nullptr) << std::endl;
     }
 
+    if (indexedItem)
+    {
+      const bool noMatch = indexedItem->matchesNone(
+          targetFare->owrt(), targetFare->fareClass(), targetFare->fcaFareType());
+      _combinabilityIndex.countCheck(CombinabilityIndex::FARE_CLASS, noMatch);
+
+      if (noMatch)
+      {
+        // leave what the rules passing the ow/rt check would have set
+        FareUsage& currentFareUsage = *validationFareComponent[fuCount]._currentFareUsage;
+        if (const FareClassRestRule* rule = indexedItem->lastOwrtMatched(targetFare->owrt()))
+          currentFareUsage.sameMinMaxInd() = rule->sameminMaxInd();
+        if (const FareClassRestRule* rule = indexedItem->lastPenalty(targetFare->owrt()))
+        {
+          currentFareUsage.penaltyRestInd() = rule->penaltyRestInd();
+          currentFareUsage.appendageCode() = rule->appendageCode();
+        }
+        if (indexedItem->negative())
+          negative = true;
+        validationFareComponent[fuCount].getSubCat(m108) = ValidationElement::NOT_MATCHED;
+        continue;
+      }
+    }
+
     iter = fareClassRestRuleVector.begin();
     iterEnd = fareClassRestRuleVector.end();
 
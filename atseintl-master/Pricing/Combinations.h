@@ -22,6 +22,7 @@
 #include "DBAccess/CombinabilityRuleItemInfo.h"
 #include "DBAccess/Record2Types.h"
 #include "DBAccess/EndOnEnd.h"
+#include "Pricing/CombinabilityIndex.h"
 #include "Pricing/CombinabilityScoreboard.h"
 
 namespace tse
@@ -218,6 +219,10 @@ public:
   {
     _enableFPLevelFailedFareUsageOptimization = enableIt;
   }
+  static void enableCombinabilityPrecheck(bool enableIt) { _enableCombinabilityPrecheck = enableIt; }
+
+  CombinabilityIndex& combinabilityIndex() { return _combinabilityIndex; }
+  const CombinabilityIndex& combinabilityIndex() const { return _combinabilityIndex; }
 
   static Combinations* getNewInstance(PricingTrx* pricingTrx)
   {
@@ -236,6 +241,7 @@ public:
 private:
   PricingTrx* _trx = nullptr;
   CombinabilityScoreboard* _comboScoreboard = nullptr;
+  CombinabilityIndex _combinabilityIndex;
 
   std::pair<bool, CombinabilityRuleItemInfo>
   findCategoryRuleItem(const std::vector<CombinabilityRuleItemInfoSet*>& catRuleInfoSetVec);
@@ -797,6 +803,7 @@ private:
 
   static bool _enablePULevelFailedFareUsageOptimization;
   static bool _enableFPLevelFailedFareUsageOptimization;
+  static bool _enableCombinabilityPrecheck;
 
   static uint16_t getSubCat(const PricingUnit::Type puType);
   static bool diagInMajorSubCat(const DiagnosticTypes& diagType);
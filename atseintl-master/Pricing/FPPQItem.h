@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "Common/ArrayVector.h"
 #include "Common/TsePrimitiveTypes.h"
 #include "DataModel/PaxTypeFare.h"
 #include "Pricing/PricingEnums.h"
@@ -36,6 +37,10 @@ class FPPQItem
 
 public:
   friend class FPPQItemComparatorsTest;
+  // Inline index tuples, the pooled item needs no allocation for up to four pricing units
+  using PUIndices = ArrayVector<uint32_t, 4>;
+  using PUPQItemVec = ArrayVector<PUPQItem*, 4>;
+
   enum class EOEValidationStatus : uint8_t
   { EOE_UNKNOWN,
     EOE_PASSED,
@@ -52,11 +57,11 @@ public:
   FarePathFactory*& farePathFactory() { return _farePathFactory; }
   const FarePathFactory* farePathFactory() const { return _farePathFactory; }
 
-  std::vector<uint32_t>& puIndices() { return _puIndices; }
-  const std::vector<uint32_t>& puIndices() const { return _puIndices; }
+  PUIndices& puIndices() { return _puIndices; }
+  const PUIndices& puIndices() const { return _puIndices; }
 
-  std::vector<PUPQItem*>& pupqItemVect() { return _pupqItemVect; }
-  const std::vector<PUPQItem*>& pupqItemVect() const { return _pupqItemVect; }
+  PUPQItemVec& pupqItemVect() { return _pupqItemVect; }
+  const PUPQItemVec& pupqItemVect() const { return _pupqItemVect; }
 
   uint16_t& xPoint() { return _xPoint; }
   const uint16_t& xPoint() const { return _xPoint; }
@@ -146,8 +151,8 @@ private:
   //
   PUPath* _puPath = nullptr;
 
-  std::vector<uint32_t> _puIndices;
-  std::vector<PUPQItem*> _pupqItemVect;
+  PUIndices _puIndices;
+  PUPQItemVec _pupqItemVect;
 
   FarePathFactory* _farePathFactory = nullptr; // added for IS optimization
 
@@ -71,6 +71,7 @@ public:
                      ValidationLevel);
   void setYqyrCalc(YQYRCalculator* yqyrCalc) { _yqyrCalc = yqyrCalc; }
   void setBagCalculator(BaggageCalculator* bagCalc) { _bagCalculator = bagCalc; }
+  void setCombinations(Combinations* combinations) { _combinations = combinations; }
 
 private:
   PricingTrx& _trx;
@@ -48,6 +48,8 @@ ConfigurableValue<int32_t>
 globalPushBackMaxCfg("PRICING_SVC", "PER_PAX_TYPE_GLOBAL_PUSH_BACK_MAX", -1);
 ConfigurableValue<bool>
 avoidStaticObjectPoolCfg("PRICING_SVC", "AVOID_STATIC_OBJECT_POOL", true);
+ConfigurableValue<uint32_t>
+speculativeFarePathFactoriesCfg("PRICING_SVC", "SPECULATIVE_FARE_PATH_FACTORIES", 1);
 }
 // for unit tests only
 FactoriesConfig::FactoriesConfig()
@@ -56,6 +58,7 @@ FactoriesConfig::FactoriesConfig()
     _plusUpPushBackThreshold(100),
     _plusUpPushBackMax(10000),
     _globalPushBackMax(-1),
+    _speculativeFarePathFactories(1),
     _puScopeValidationEnabled(true),
     _eoeTuningEnabled(true),
     _searchAlwaysLowToHigh(false),
@@ -70,6 +73,7 @@ FactoriesConfig::FactoriesConfig(const tse::ConfigMan& config)
     _plusUpPushBackThreshold(100),
     _plusUpPushBackMax(10000),
     _globalPushBackMax(-1),
+    _speculativeFarePathFactories(1),
     _puScopeValidationEnabled(true),
     _eoeTuningEnabled(true),
     _searchAlwaysLowToHigh(false),
@@ -91,6 +95,7 @@ FactoriesConfig::FactoriesConfig(const tse::ConfigMan& config)
   _plusUpPushBackMax = plusUpPushBackMaxCfg.getValue();
   _globalPushBackMax = globalPushBackMaxCfg.getValue();
   _avoidStaticObjectPool = avoidStaticObjectPoolCfg.getValue();
+  _speculativeFarePathFactories = speculativeFarePathFactoriesCfg.getValue();
 }
 
 } /* namespace tse */
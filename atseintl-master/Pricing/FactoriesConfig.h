@@ -56,6 +56,9 @@ public:
 
   int32_t plusUpPushBackThreshold() const { return _plusUpPushBackThreshold; }
 
+  // Fare path factories of a passenger type advanced concurrently, 1 or less means serially
+  uint32_t speculativeFarePathFactories() const { return _speculativeFarePathFactories; }
+
 protected:
   FactoriesConfig(); // for unit tests
 
@@ -64,6 +67,11 @@ protected:
     _searchAlwaysLowToHigh = value;
   }
 
+  void setSpeculativeFarePathFactoriesForUnitTestsOnly(const uint32_t value)
+  {
+    _speculativeFarePathFactories = value;
+  }
+
 private:
   uint32_t _maxNbrCombMsgThreshold;
   int32_t _multiPaxShortCktTimeOut; // In case of Multi-Pax Trx, short-ckt after 30 sec
@@ -71,6 +79,7 @@ private:
   int32_t _plusUpPushBackMax; // negative value means ignore it
   int32_t _globalPushBackMax; // for all FPFactory of a PaxType combined limit,
   // negative value means ignore it
+  uint32_t _speculativeFarePathFactories;
 
   bool _puScopeValidationEnabled;
   bool _eoeTuningEnabled;
@@ -171,6 +171,11 @@ FarePathFactory::createFarePathFactory(const FarePathFactoryCreator& creator,
   fpFactory->_paxFPFBaseData = paxFPFBaseData;
   fpFactory->paxType() = paxFPFBaseData->paxType();
   fpFactory->combinations() = combinations;
+  if (paxFPFBaseData->getFactoriesConfig().speculativeFarePathFactories() > 1)
+  {
+    // combinability keeps per call state, factories advanced concurrently can not share it
+    fpFactory->combinations() = Combinations::getNewInstance(pricingTrx);
+  }
   fpFactory->_pricingUnitRequester.initialize(*pricingTrx);
   fpFactory->_storage.initialize(*pricingTrx, itin->getMemoryManager(), puPath->allPU().size());
   fpFactory->setSavedFPPQItems(savedFPPQItems);
@@ -450,7 +455,7 @@ FarePathFactory::buildPausedFarePath(FPPQItem& item, DiagCollector& diag)
     FPPQItem& fppqItem = *nextItem;
     fppqItem.paused() = false;
     const uint16_t xPoint = fppqItem.xPoint();
-    const std::vector<uint32_t>& puIndices = fppqItem.puIndices();
+    const FPPQItem::PUIndices& puIndices = fppqItem.puIndices();
     const uint32_t puIdx = puIndices[xPoint];
 
     const MoneyAmount delta = getPUDelta(fppqItem);
@@ -516,7 +521,7 @@ FarePathFactory::buildNextFarePathSet(FPPQItem& fppqItem, DiagCollector& diagnos
     return;
   }
 
-  const std::vector<uint32_t>& puIndices = fppqItem.puIndices();
+  const FPPQItem::PUIndices& puIndices = fppqItem.puIndices();
   const MoneyAmount puDelta = getPUDelta(fppqItem);
   const unsigned totalPUFactory = _puPath->totalPU();
 
@@ -537,7 +542,7 @@ FarePathFactory::buildNextFarePathSet(FPPQItem& fppqItem, DiagCollector& diagnos
 
 void
 FarePathFactory::requestForNewPricingUnits(uint16_t xPoint,
-                                           const std::vector<uint32_t>& puIndices,
+                                           const FPPQItem::PUIndices& puIndices,
                                            const MoneyAmount puDelta,
                                            unsigned expandStep,
                                            DiagCollector& diagnostic)
@@ -559,7 +564,7 @@ FarePathFactory::buildInitialFarePath(DiagCollector& diagnostic)
     _pricingUnitRequester.clearFactoryForRex(_allPUF, diagnostic);
   }
 
-  const std::vector<uint32_t> puIndices(_puPath->totalPU(), 0);
+  const FPPQItem::PUIndices puIndices(_puPath->totalPU(), 0);
   requestForNewPricingUnits(0, puIndices, -1.0, 0, diagnostic);
   _pricingUnitRequester.processRequests(diagnostic);
 
@@ -572,7 +577,7 @@ FarePathFactory::buildInitialFarePath(DiagCollector& diagnostic)
 //----------------------------------------------------------------------------
 bool
 FarePathFactory::buildFarePath(bool initStage,
-                               const std::vector<uint32_t>& puIndices,
+                               const FPPQItem::PUIndices& puIndices,
                                const unsigned xPoint,
                                DiagCollector& diagnostic)
 {
@@ -1070,8 +1075,8 @@ void
 FarePathFactory::recalculatePriority(FPPQItem& fppqItem)
 {
   fppqItem.clearPriority();
-  std::vector<PUPQItem*>::iterator it = fppqItem.pupqItemVect().begin();
-  std::vector<PUPQItem*>::iterator itEnd = fppqItem.pupqItemVect().end();
+  FPPQItem::PUPQItemVec::iterator it = fppqItem.pupqItemVect().begin();
+  FPPQItem::PUPQItemVec::iterator itEnd = fppqItem.pupqItemVect().end();
   for (; it != itEnd; ++it)
   {
     farepathutils::setPriority(*_trx, **it, fppqItem, itin());
@@ -1309,6 +1314,7 @@ FarePathFactory::isFarePathValid(FPPQItem& fppqItem,
   FarePathValidator farePathValidator(*_paxFPFBaseData);
 
   farePathValidator.setSettings(*_farePathSettings);
+  farePathValidator.setCombinations(_combinations);
 
   farePathValidator.setEoeCombinabilityEnabled(_eoeCombinabilityEnabled);
 
@@ -1353,6 +1359,7 @@ FarePathFactory::isFarePathValid(FPPQItem& fppqItem,
   FPPQItemValidator fppqItemValidator(*_paxFPFBaseData, allPUF(), _failedPricingUnits, diag);
   fppqItemValidator.setYqyrCalc(_yqyrPreCalc);
   fppqItemValidator.setBagCalculator(_bagCalculator);
+  fppqItemValidator.setCombinations(_combinations);
 
   for (FPPQItem* fpPQI : clonedFpPQ)
   {
@@ -2574,7 +2581,7 @@ FarePathFactory::getFPValCxrFromPTF(const FPPQItem& fppqItem, std::vector<Carrie
 bool
 FarePathFactory::buildCxrFarePath(const bool initStage,
                                   const FPPQItem& prevFPPQItem,
-                                  const std::vector<uint32_t>& puIndices,
+                                  const FPPQItem::PUIndices& puIndices,
                                   const CarrierCode& valCxr,
                                   const std::deque<bool>& cxrFareRest,
                                   const uint16_t xPoint,
@@ -2728,11 +2735,61 @@ FarePathFactory::buildCxrFarePath(const bool initStage,
   fppqItem->ignorePUIndices() = true;
   fppqItem->farePath()->validatingCarriers().clear();
   fppqItem->farePath()->validatingCarriers().push_back(valCxr);
-  _cxrFarePathPQ.push(fppqItem);
+  pushCxrFPPQItem(fppqItem);
 
   return true;
 }
 
+//----------------------------------------------------------------------------
+// The cxr fare search skips PUs of other carriers, so different items can
+// expand to the same PU combination. Only one of them is queued; it keeps the
+// lowest expansion point so no combination reachable from a duplicate is lost.
+void
+FarePathFactory::pushCxrFPPQItem(FPPQItem* fppqItem)
+{
+  const uint16_t xPoint = fppqItem->xPoint();
+  auto inserted = _cxrFarePathQueued.emplace(fppqItem->puIndices(), CxrFarePathQueuedEntry());
+  CxrFarePathQueuedEntry& entry = inserted.first->second;
+
+  if (!inserted.second)
+  {
+    if (entry.xPoint <= xPoint)
+    {
+      LOG4CXX_DEBUG(logger, "pushCxrFPPQItem: PU combination already queued");
+      releaseFPPQItem(fppqItem);
+      return;
+    }
+
+    entry.xPoint = xPoint;
+    if (entry.item)
+    {
+      // xPoint is not part of the PQ ordering, lower it in place
+      LOG4CXX_DEBUG(logger, "pushCxrFPPQItem: lowered xPoint of queued PU combination");
+      entry.item->xPoint() = xPoint;
+      releaseFPPQItem(fppqItem);
+      return;
+    }
+  }
+
+  entry.item = fppqItem;
+  entry.xPoint = xPoint;
+  _cxrFarePathPQ.push(fppqItem);
+}
+
+//----------------------------------------------------------------------------
+FPPQItem*
+FarePathFactory::popCxrFPPQItem()
+{
+  FPPQItem* fppqItem = _cxrFarePathPQ.top();
+  _cxrFarePathPQ.pop();
+
+  auto it = _cxrFarePathQueued.find(fppqItem->puIndices());
+  if (it != _cxrFarePathQueued.end() && it->second.item == fppqItem)
+    it->second.item = nullptr;
+
+  return fppqItem;
+}
+
 //----------------------------------------------------------------------------
 void
 FarePathFactory::buildNextCxrFarePathSet(const bool initStage,
@@ -2742,7 +2799,7 @@ FarePathFactory::buildNextCxrFarePathSet(const bool initStage,
                                          DiagCollector& diag)
 {
   const uint16_t totalPUFactory = _puPath->totalPU();
-  const std::vector<uint32_t> puIndices(prevFPPQItem.puIndices());
+  const FPPQItem::PUIndices puIndices(prevFPPQItem.puIndices());
 
   uint16_t xPoint = prevFPPQItem.xPoint();
   for (; xPoint < totalPUFactory; ++xPoint)
@@ -2820,8 +2877,9 @@ FarePathFactory::checkCxrFPPQItemExists(const std::string& fpFareType,
     _cxrFarePathPQ.pop();
     releaseFPPQItem(item);
   }
+  _cxrFarePathQueued.clear();
 
-  const std::vector<uint32_t> puIndices(_puPath->totalPU(), 0);
+  const FPPQItem::PUIndices puIndices(_puPath->totalPU(), 0);
   if (!buildCxrFarePath(true, fppqItem, puIndices, valCxr, cxrFareRest, 0, diag))
   {
     // no CXR-Fare combination could be built to init the Q
@@ -2835,8 +2893,7 @@ FarePathFactory::checkCxrFPPQItemExists(const std::string& fpFareType,
 
   while (true)
   {
-    FPPQItem* fppqItem = _cxrFarePathPQ.top();
-    _cxrFarePathPQ.pop();
+    FPPQItem* fppqItem = popCxrFPPQItem();
 
     FarePath& fpath = *(fppqItem->farePath());
     if (UNLIKELY(fpath.processed()))
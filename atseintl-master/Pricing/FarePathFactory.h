@@ -30,9 +30,11 @@
 #include "Pricing/PUPath.h"
 #include "Rules/RuleControllerWithChancelor.h"
 
+#include <boost/functional/hash.hpp>
 #include <boost/heap/priority_queue.hpp>
 
 #include <queue>
+#include <unordered_map>
 #include <vector>
 
 namespace tse
@@ -250,7 +252,7 @@ protected:
 
   void buildNextFarePathSet(FPPQItem& fppqItem, DiagCollector& diagnostic);
   void requestForNewPricingUnits(uint16_t xPoint,
-                                 const std::vector<uint32_t>& puIndices,
+                                 const FPPQItem::PUIndices& puIndices,
                                  const MoneyAmount puDelta,
                                  unsigned expandStep,
                                  DiagCollector& diagnostic);
@@ -260,7 +262,7 @@ protected:
   FPPQItem* buildPausedFarePath(FPPQItem& fppqItem, DiagCollector& diag);
 
   bool buildFarePath(bool initStage,
-                     const std::vector<uint32_t>& puIndices,
+                     const FPPQItem::PUIndices& puIndices,
                      const unsigned xPoint,
                      DiagCollector& diagnostic);
 
@@ -338,12 +340,31 @@ protected:
 
   bool buildCxrFarePath(const bool initStage,
                         const FPPQItem& prevFPPQItem,
-                        const std::vector<uint32_t>& puIndices,
+                        const FPPQItem::PUIndices& puIndices,
                         const CarrierCode& valCxr,
                         const std::deque<bool>& cxrFareRest,
                         const uint16_t xPoint,
                         DiagCollector& diag);
 
+  struct PUIndicesHash
+  {
+    size_t operator()(const FPPQItem::PUIndices& puIndices) const
+    {
+      return boost::hash_range(puIndices.begin(), puIndices.end());
+    }
+  };
+
+  // Lowest expansion point seen for a PU combination and the item that still
+  // sits in _cxrFarePathPQ for it, if any
+  struct CxrFarePathQueuedEntry
+  {
+    FPPQItem* item = nullptr;
+    uint16_t xPoint = 0;
+  };
+
+  void pushCxrFPPQItem(FPPQItem* fppqItem);
+  FPPQItem* popCxrFPPQItem();
+
   void resetPriority(const PUPQItem& pupqItem, FPPQItem& fppqItem);
 
   inline MoneyAmount getPUDelta(const FPPQItem& prevFPpqItem);
@@ -564,6 +585,9 @@ protected:
   LowToHighFarePathPQ _lthFarePathPQ;
 
   FarePathPQ _cxrFarePathPQ;
+  // PU index combinations queued by the current cxr fare search
+  std::unordered_map<FPPQItem::PUIndices, CxrFarePathQueuedEntry, PUIndicesHash>
+  _cxrFarePathQueued;
   std::map<std::string, uint16_t> _fpFareTypeCountMap;
   std::map<std::string, std::map<CarrierCode, uint16_t>> _fpFareTypeCountByValCxrMap;
   std::multimap<std::string, FPPQItem*> _processedYYFarePaths;
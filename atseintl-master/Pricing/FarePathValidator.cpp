@@ -1174,8 +1174,8 @@ FarePathValidator::checkFailedPUIdx(FPPQItem& fppqItem,
     return true;
   }
 
-  std::vector<uint32_t>::const_iterator puIt = fppqItem.puIndices().begin();
-  std::vector<uint32_t>::const_iterator puItEnd = fppqItem.puIndices().end();
+  FPPQItem::PUIndices::const_iterator puIt = fppqItem.puIndices().begin();
+  FPPQItem::PUIndices::const_iterator puItEnd = fppqItem.puIndices().end();
   for (uint32_t puFactIdx = 0; puIt != puItEnd; ++puIt, ++puFactIdx)
   {
     const std::vector<CarrierCode>& valCxrList = fppqItem.farePath()->validatingCarriers();
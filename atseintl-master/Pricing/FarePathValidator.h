@@ -57,6 +57,8 @@ public:
     _externalLowerBoundAmount = settings._externalLowerBoundAmount;
   }
 
+  void setCombinations(Combinations* combinations) { _combinations = combinations; }
+
   void setEoeCombinabilityEnabled(bool isEoeCombinabilityEnabled)
   {
     _isEoeCombinabilityEnabled = isEoeCombinabilityEnabled;
@@ -311,8 +311,7 @@ SoloFarePathWrapperSource::fillWithItin(FarePath& farePath)
 std::vector<PaxTypeFare::SegmentStatus>
 SoloFarePathWrapperSource::getSegmentStatus()
 {
-  PaxTypeFare::FlightBit& bitMap = paxTypeFare.flightBitmap()[bitIndex];
-  return bitMap._segmentStatus;
+  return paxTypeFare.flightBitmap().segmentStatus(bitIndex);
 }
 
 void
@@ -399,8 +398,7 @@ ShoppingFarePathWrapperSource::fillWithItin(FarePath& farePath)
 std::vector<PaxTypeFare::SegmentStatus>
 ShoppingFarePathWrapperSource::getSegmentStatus()
 {
-  PaxTypeFare::FlightBit& bitMap = paxTypeFare.flightBitmap()[bitIndex];
-  return bitMap._segmentStatus;
+  return paxTypeFare.flightBitmap().segmentStatus(bitIndex);
 }
 
 PaxType*
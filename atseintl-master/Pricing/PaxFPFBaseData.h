@@ -22,6 +22,8 @@
 
 #include "Pricing/FactoriesConfig.h"
 
+#include <atomic>
+
 #include <time.h>
 
 namespace tse
@@ -59,10 +61,10 @@ public:
   time_t& shortCktKeepValidFPsTime() { return _shortCktOnPushBackTimeout; }
 
   const bool pricingShortCktHappened() const { return _pricingShortCktHappened; }
-  bool& pricingShortCktHappened() { return _pricingShortCktHappened; }
+  std::atomic<bool>& pricingShortCktHappened() { return _pricingShortCktHappened; }
 
   const bool validFPPushedBack() const { return _validFPPushedBack; }
-  bool& validFPPushedBack() { return _validFPPushedBack; }
+  std::atomic<bool>& validFPPushedBack() { return _validFPPushedBack; }
 
   Combinations*& combinations() { return _combinations; }
 
@@ -72,10 +74,11 @@ protected:
   PricingTrx* _trx = nullptr;
   PaxType* _paxType = nullptr;
   time_t _shortCktOnPushBackTimeout = 0;
-  uint32_t _fpCombTried = 0;
-  int32_t _globalPushBackCount = 0; // For All FarePathFactory combined Push Back count
-  bool _pricingShortCktHappened = false;
-  bool _validFPPushedBack = false;
+  // the fare path factories of a passenger type may be advanced concurrently
+  std::atomic<uint32_t> _fpCombTried{0};
+  std::atomic<int32_t> _globalPushBackCount{0}; // For All FarePathFactory combined Push Back count
+  std::atomic<bool> _pricingShortCktHappened{false};
+  std::atomic<bool> _validFPPushedBack{false};
 };
 
 } /* namespace tse */
@@ -27,6 +27,7 @@
 #include "Common/Money.h"
 #include "Common/PaxTypeUtil.h"
 #include "Common/ShoppingUtil.h"
+#include "Common/Thread/TseRunnableExecutor.h"
 #include "Common/TSELatencyData.h"
 #include "DataModel/Agent.h"
 #include "DataModel/AirSeg.h"
@@ -69,6 +70,7 @@
 #include "Rules/RuleUtil.h"
 
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -687,6 +689,9 @@ PaxFarePathFactory::buildNextLevelFarePath(DiagCollector& diag)
     return false;
   }
 
+  if (speculationAllowed())
+    return buildNextLevelFarePathSpeculatively(diag);
+
   int32_t genCount = 0;
   bool validFound = false;
 
@@ -938,6 +943,228 @@ PaxFarePathFactory::buildNextLevelFarePath(DiagCollector& diag)
   return true;
 }
 
+//----------------------------------------------------------------------------
+// The speculative search advances the first factories of the PQ on worker threads and keeps
+// the fare paths in the order of the serial search. It is used only when the factories
+// validate without state shared between them, the features below keep such state.
+bool
+PaxFarePathFactory::speculationAllowed() const
+{
+  if (_factoriesConfig.speculativeFarePathFactories() <= 1)
+    return false;
+
+  return _trx->diagnostic().diagnosticType() == DiagnosticNone &&
+         _trx->getTrxType() != PricingTrx::IS_TRX && !_trx->delayXpn() && !_trx->isAltDates() &&
+         !_trx->isValidatingCxrGsaApplicable() && !RexPricingTrx::isRexTrxAndNewItin(*_trx) &&
+         !dynamic_cast<const NoPNRPricingTrx*>(_trx) && !_throughFarePricing &&
+         _externalFmpLowerBoundAmount < 0;
+}
+
+// A factory can be advanced together with others when it shares neither the PU factories
+// nor the fare market path (and so the YQYR precalculation) with any of them.
+bool
+PaxFarePathFactory::isIndependentFPF(FarePathFactory& fpf,
+                                     const std::vector<FarePathFactory*>& speculativeFPFs)
+{
+  // similar itins collect the failed fare paths in the passenger type factory
+  if (fpf.itin()->isThroughFarePrecedence() || !fpf.itin()->getSimilarItins().empty())
+    return false;
+
+  for (FarePathFactory* other : speculativeFPFs)
+  {
+    if (other->puPath()->fareMarketPath() == fpf.puPath()->fareMarketPath())
+      return false;
+
+    const std::vector<PricingUnitFactory*>& otherPUF = other->allPUF();
+    for (PricingUnitFactory* puf : fpf.allPUF())
+    {
+      if (std::find(otherPUF.begin(), otherPUF.end(), puf) != otherPUF.end())
+        return false;
+    }
+  }
+
+  return true;
+}
+
+void
+PaxFarePathFactory::popSpeculativeSteps(std::vector<SpeculativeStep>& steps)
+{
+  std::vector<FarePathFactory*> speculativeFPFs;
+  while (!pqEmpty() && speculativeFPFs.size() < _factoriesConfig.speculativeFarePathFactories())
+  {
+    FarePathFactory* fpf = pqTop();
+    if (!speculativeFPFs.empty() && !isIndependentFPF(*fpf, speculativeFPFs))
+      break;
+
+    pqPop();
+    speculativeFPFs.push_back(fpf);
+  }
+
+  steps.clear();
+  steps.resize(speculativeFPFs.size());
+
+  for (size_t i = 0; i < speculativeFPFs.size(); ++i)
+  {
+    // as in the serial search, a factory is bounded by the one following it in the PQ
+    FarePathFactory* fpf = speculativeFPFs[i];
+    if (i + 1 < speculativeFPFs.size())
+      fpf->externalLowerBoundAmount() = speculativeFPFs[i + 1]->lowerBoundFPAmount();
+    else
+      fpf->externalLowerBoundAmount() = pqEmpty() ? -1 : pqTop()->lowerBoundFPAmount();
+
+    SpeculativeStep& step = steps[i];
+    step.fpf = fpf;
+    step.diag = DCFactory::instance()->create(*_trx);
+    step.trx(_trx);
+  }
+}
+
+void
+PaxFarePathFactory::runSpeculativeSteps(std::vector<SpeculativeStep>& steps, DiagCollector& diag)
+{
+  TseRunnableExecutor speculativeExecutor(TseThreadingConst::SPECULATIVE_FAREPATH_TASK);
+
+  for (size_t i = 1; i < steps.size(); ++i)
+    speculativeExecutor.execute(steps[i]);
+
+  // no need to run the first one in another thread
+  steps.front().performTask();
+  speculativeExecutor.wait();
+
+  for (const SpeculativeStep& step : steps)
+    diag << *step.diag;
+
+  for (const SpeculativeStep& step : steps)
+  {
+    if (step.errResponseCode != ErrorResponseException::NO_ERROR)
+      throw ErrorResponseException(step.errResponseCode, step.errResponseMsg.c_str());
+  }
+}
+
+bool
+PaxFarePathFactory::buildNextLevelFarePathSpeculatively(DiagCollector& diag)
+{
+  FPPQItem::GreaterLowToHigh<FPPQItem::GreaterFare> greater;
+  std::vector<SpeculativeStep> steps;
+  std::vector<SpeculativeStep*> results;
+  int32_t genCount = 0;
+  bool validFound = false;
+  CurrencyConversionFacade ccFacade;
+  uint32_t addForDups = 0; // Additional FarePaths created for duplicate totals
+  auto done = [&]()
+  {
+    return validFound && genCount >= _reqDiagFPCount &&
+           _fpCount >= _reqValidFPCount + addForDups;
+  };
+
+  while (!pqEmpty())
+  {
+    PricingUtil::checkTrxAborted(
+        *_trx, _factoriesConfig.maxNbrCombMsgThreshold(), _fpCombTried, _maxNbrCombMsgSet);
+
+    if ((_maxSearchNextLevelFarePath >= 0) && (genCount > _maxSearchNextLevelFarePath))
+      return false;
+
+    popSpeculativeSteps(steps);
+    runSpeculativeSteps(steps, diag);
+    genCount += steps.size();
+
+    results.clear();
+    for (SpeculativeStep& step : steps)
+    {
+      if (step.fppqItem)
+        results.push_back(&step);
+    }
+
+    std::stable_sort(results.begin(),
+                     results.end(),
+                     [&greater](const SpeculativeStep* lhs, const SpeculativeStep* rhs)
+                     { return greater(rhs->fppqItem, lhs->fppqItem); });
+
+    // A fare path is taken only when no factory can build a lower one,
+    // the others are put back and come out again in a later round.
+    for (SpeculativeStep* result : results)
+    {
+      FPPQItem* fppqItem = result->fppqItem;
+      bool isFarePathGreater = done();
+
+      for (SpeculativeStep& step : steps)
+      {
+        if (isFarePathGreater)
+          break;
+        if (step.fpf->lowerBoundFPAmount() >= 0)
+          isFarePathGreater = greater(fppqItem, step.fpf->lowerBoundFPPQItem());
+      }
+
+      if (!isFarePathGreater && !pqEmpty())
+        isFarePathGreater = greater(fppqItem, pqTop()->lowerBoundFPPQItem());
+
+      if (isFarePathGreater)
+        result->fpf->pushBack(fppqItem);
+      else if (isFarePathValidAfterPlusUps(*fppqItem, diag))
+      {
+        if (!_allowDuplicateTotals)
+          checkUniqueFarePathTotals(fppqItem->farePath(), ccFacade, addForDups, false);
+
+        ++_fpCount;
+        _validFPPQItemVect.push_back(fppqItem);
+        validFound = true;
+      }
+      else
+        releaseFPPQItem(*result->fpf, fppqItem);
+    }
+
+    for (SpeculativeStep& step : steps)
+    {
+      FarePathFactory& fpf = *step.fpf;
+      if (fpf.lowerBoundFPAmount() < 0) // no more in its PQ
+        continue;
+
+      if (UNLIKELY(!_trx->isForceNoTimeout() && shutdownFPFactory(fpf)))
+      {
+        LOG4CXX_INFO(logger, __FUNCTION__ << ":shortcircuit logic");
+        if (fpf.keepValidItems() <= 0)
+          continue;
+      }
+
+      pqPush(&fpf);
+    }
+
+    if (done())
+      return true;
+
+    if (UNLIKELY(startMultiPaxShortCkt()))
+      return true;
+  }
+
+  LOG4CXX_INFO(logger, _paxType->paxType() << " buildNextLevelFarePath: PQ empty");
+  return true;
+}
+
+void
+PaxFarePathFactory::SpeculativeStep::performTask()
+{
+  try { fppqItem = fpf->getNextFPPQItem(*diag); }
+  catch (ErrorResponseException& ex)
+  {
+    LOG4CXX_INFO(logger, "Exception:" << ex.message() << " - Speculative GetFPPQItem failed");
+    errResponseCode = ex.code();
+    errResponseMsg = ex.message();
+  }
+  catch (std::exception& e)
+  {
+    LOG4CXX_ERROR(logger, "Exception:" << e.what() << " - Speculative GetFPPQItem failed");
+    errResponseCode = ErrorResponseException::SYSTEM_EXCEPTION;
+    errResponseMsg = "ATSEI SYSTEM EXCEPTION";
+  }
+  catch (...)
+  {
+    LOG4CXX_ERROR(logger, "UNKNOWN Exception Caught: Speculative GetFPPQItem failed");
+    errResponseCode = ErrorResponseException::UNKNOWN_EXCEPTION;
+    errResponseMsg = "UNKNOWN EXCEPTION";
+  }
+}
+
 //---------------------------------------------------------------
 void
 PaxFarePathFactory::checkUniqueFarePathTotals(FarePath* farePath,
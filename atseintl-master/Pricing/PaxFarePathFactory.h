@@ -18,7 +18,9 @@
 #pragma once
 
 #include "Common/Assert.h"
+#include "Common/ErrorResponseException.h"
 #include "Common/Gauss.h"
+#include "Common/Thread/TseCallableTrxTask.h"
 #include "Common/TseDateTimeTypes.h"
 #include "Pricing/FactoriesConfig.h"
 #include "Pricing/FarePathFactory.h"
@@ -30,6 +32,7 @@
 #include <boost/heap/priority_queue.hpp>
 
 #include <queue>
+#include <string>
 #include <vector>
 
 namespace tse
@@ -57,6 +60,8 @@ public:
 
 class PaxFarePathFactory : public PaxFarePathFactoryBase
 {
+  friend class PaxFarePathFactoryTest;
+
 public:
   typedef boost::heap::priority_queue<FarePathFactory*,
     boost::heap::compare<FarePathFactory::Greater<FPPQItem::GreaterFare> > > FarePathFactoryPQ;
@@ -136,6 +141,20 @@ public:
   uint32_t fpCount() const { return _fpCount; }
 
 protected:
+  // Advances one fare path factory of a speculative round on a worker thread
+  struct SpeculativeStep : public TseCallableTrxTask
+  {
+    SpeculativeStep() { desc("SPECULATIVE FAREPATH TASK"); }
+
+    void performTask() override;
+
+    FarePathFactory* fpf = nullptr;
+    DiagCollector* diag = nullptr;
+    FPPQItem* fppqItem = nullptr;
+    ErrorResponseException::ErrorResponseCode errResponseCode = ErrorResponseException::NO_ERROR;
+    std::string errResponseMsg;
+  };
+
   bool processFareMarketPaths();
   void updateGaussForDelayedExpansion();
   void startTimer() { _startTime = time(nullptr); }
@@ -157,6 +176,12 @@ protected:
   createFarePathFactories(const FarePathFactoryCreator& creator, std::vector<PUPath*>& puPaths);
   bool addFarePathFactoriesToPQ(DiagCollector& diag);
   bool buildNextLevelFarePath(DiagCollector& diag);
+  bool speculationAllowed() const;
+  static bool
+  isIndependentFPF(FarePathFactory& fpf, const std::vector<FarePathFactory*>& speculativeFPFs);
+  void popSpeculativeSteps(std::vector<SpeculativeStep>& steps);
+  void runSpeculativeSteps(std::vector<SpeculativeStep>& steps, DiagCollector& diag);
+  bool buildNextLevelFarePathSpeculatively(DiagCollector& diag);
   void checkUniqueFarePathTotals(FarePath* farePath,
                                  CurrencyConversionFacade& ccFacade,
                                  uint32_t& addForDups,
@@ -280,6 +280,19 @@ PaxTypeFareBitmapValidator::validate(ItinIndex::Key key, bool considerNonStopsOn
     }
   }
 
+  // Only the valid and the skipped flights need the cell validation, the failed ones are found
+  // in the packed flight bits instead of cell by cell. The alt date cells are all validated,
+  // their dates are checked first.
+  const PaxTypeFare::FlightBitmap& flightBitmap = _ptFare.flightBitmap();
+  const bool packed = _dates == nullptr;
+  std::vector<uint64_t> liveFlights, skippedFlights;
+  if (packed)
+  {
+    flightBitmap.mask(0, liveFlights);
+    flightBitmap.mask(RuleConst::SKIP, skippedFlights);
+    flightbitmap::orMask(liveFlights.data(), skippedFlights.data(), liveFlights.size());
+  }
+
   uint32_t loopCount = 0;
   for (; i1 != i2; ++i1)
   {
@@ -287,7 +300,10 @@ PaxTypeFareBitmapValidator::validate(ItinIndex::Key key, bool considerNonStopsOn
       continue;
 
     ++loopCount;
-    if (!validate(i1, key))
+    const uint32_t bit = i1.bitIndex();
+    const bool live =
+        !packed || bit >= flightBitmap.size() || flightbitmap::test(liveFlights.data(), bit);
+    if ((live || _skippedBitValidator->foundHighestFarePath()) && !validate(i1, key))
       continue;
 
     if ((_acrossStopOver) && (loopCount > _skippedBitValidator->maxFlightsForRuleValidation()))
@@ -323,21 +339,16 @@ PaxTypeFareBitmapValidator::validate(const uint32_t bit, const ItinIndex::Key& k
 {
   ItinIndex& index = _leg.carrierIndex();
 
-  const ItinIndex::ItinIndexIterator itinIndexBegin =
-      _acrossStopOver ? index.beginAcrossStopOverRow(_trx, _legIndex, key) : index.beginRow(key);
-  const ItinIndex::ItinIndexIterator itinIndexEnd =
-      _acrossStopOver ? index.endAcrossStopOverRow() : index.endRow();
+  ItinIndex::ItinIndexIterator itinIndex =
+      _acrossStopOver ? index.beginAcrossStopOverRow(_trx, _legIndex, key, bit)
+                      : index.beginRow(key, bit);
 
-  for (ItinIndex::ItinIndexIterator itinIndex = itinIndexBegin; itinIndex != itinIndexEnd;
-       ++itinIndex)
+  if (!itinIndex.isValid() || itinIndex.bitIndex() != bit)
   {
-    if (itinIndex.bitIndex() == bit)
-    {
-      return validate(itinIndex, key);
-    }
+    return false;
   }
 
-  return false;
+  return validate(itinIndex, key);
 }
 
 bool
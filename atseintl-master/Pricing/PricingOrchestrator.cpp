@@ -39,6 +39,7 @@
 #include "Common/IntlJourneyUtil.h"
 #include "Common/ItinUtil.h"
 #include "Common/Logger.h"
+#include "Common/Memory/AdmissionController.h"
 #include "Common/Memory/OutOfMemoryException.h"
 #include "Common/MetricsUtil.h"
 #include "Common/PaxTypeFareRuleDataCast.h"
@@ -212,6 +213,8 @@ ConfigurableValue<bool>
 enableFPLevelFailedFareUsageOptimizationCfg("PRICING_SVC",
                                             "FP_FAILED_FARE_USAGE_PAIR_TUNING",
                                             true);
+ConfigurableValue<bool>
+enableCombinabilityPrecheckCfg("PRICING_SVC", "CAT10_COMBINABILITY_PRECHECK", true);
 ConfigurableValue<uint32_t>
 additionalFarePathCount("PRICING_SVC", "ADDITIONAL_FARE_PATH_COUNT");
 ConfigurableValue<uint16_t>
@@ -274,6 +277,7 @@ PricingOrchestrator::PricingOrchestrator(TseServer& srv)
       enablePULevelFailedFareUsageOptimizationCfg.getValue());
   Combinations::enableFPLevelFailedFareUsageOptimization(
       enableFPLevelFailedFareUsageOptimizationCfg.getValue());
+  Combinations::enableCombinabilityPrecheck(enableCombinabilityPrecheckCfg.getValue());
 
   _additionalFarePathCount = additionalFarePathCount.getValue();
 
@@ -1964,6 +1968,44 @@ PricingOrchestrator::displayPriceItinDiags(
   }
 }
 
+void
+PricingOrchestrator::displayCombinabilityPrecheck(
+    DiagCollector& diag,
+    PUPathMatrix* puMatrix,
+    const std::vector<PaxFarePathFactory*>& paxFarePathFactoryBucket)
+{
+  diag.enable(puMatrix, Diagnostic610, Diagnostic620);
+  if (LIKELY(!diag.isActive()) || paxFarePathFactoryBucket.empty())
+    return;
+
+  // the pricing units of all the passenger types share one Combinations
+  const PricingUnitFactoryBucket* puFactoryBucket =
+      paxFarePathFactoryBucket.front()->puFactoryBucket();
+  if (puFactoryBucket && puFactoryBucket->combinations())
+  {
+    diag << " PRICING UNIT\n";
+    puFactoryBucket->combinations()->combinabilityIndex().printStats(diag);
+  }
+
+  for (PaxFarePathFactory* paxFPF : paxFarePathFactoryBucket)
+  {
+    if (!paxFPF->combinations())
+      continue;
+
+    // speculative fare path factories have private instances, count them with the passenger type
+    CombinabilityIndex& paxIndex = paxFPF->combinations()->combinabilityIndex();
+    for (const FarePathFactory* fpf : paxFPF->farePathFactoryBucket())
+    {
+      if (fpf->combinations() && fpf->combinations() != paxFPF->combinations())
+        paxIndex.addStats(fpf->combinations()->combinabilityIndex());
+    }
+
+    diag << " FARE PATH " << paxFPF->paxType()->paxType() << "\n";
+    paxIndex.printStats(diag);
+  }
+  diag.flushMsg();
+}
+
 void
 PricingOrchestrator::getFMCOSBasedOnAvailBreak(PricingTrx& trx, Itin* itin)
 {
@@ -2144,6 +2186,7 @@ PricingOrchestrator::priceItin(PricingTrx& trx,
     }
   }
 
+  displayCombinabilityPrecheck(diag, puMatrixVect.front(), paxFarePathFactoryBucket);
   displayPriceItinDiags(trx, diag, false, puMatrixVect.front(), ret);
   groupFarePathFactory.clearFactories();
   return ret;
@@ -2974,6 +3017,10 @@ PricingOrchestrator::createPaxFarePathFactory(
     }
   }
 
+  // an over budget trx searches fewer fare paths
+  maxSearchFP =
+      Memory::AdmissionController::degradeLimit(maxSearchFP, trx.admissionDegradePercent());
+
   time_t shortCktKeepValidFPsTime(0), shortCktShutdownFPFsTime(0);
   getPricingShortCktTimes(trx, shortCktKeepValidFPsTime, shortCktShutdownFPFsTime);
 
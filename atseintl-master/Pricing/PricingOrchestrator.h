@@ -391,6 +391,9 @@ private:
 
   void displayPriceItinDiags(
       PricingTrx& trx, DiagCollector& diag, bool first, PUPathMatrix*, bool ret = true);
+  void displayCombinabilityPrecheck(DiagCollector& diag,
+                                    PUPathMatrix* puMatrix,
+                                    const std::vector<PaxFarePathFactory*>& paxFarePathFactoryBucket);
 
   bool returnOrThrow(PricingTrx& trx, TaskVector& tasks);
   bool returnOrThrow(PricingTrx& trx, bool itinPassed);
@@ -941,7 +941,7 @@ SoloItinGenerator::getBookingCodes(const std::vector<int>& oSopVec,
   uint32_t bitMapNumber = ShoppingUtil::getFlightBitIndex(_trx, id);
   TSE_ASSERT(bitMapNumber < ptf->flightBitmap().size());
 
-  const PaxTypeFare::FlightBit& bitMap = ptf->flightBitmap()[bitMapNumber];
+  const auto bitMap = ptf->flightBitmap()[bitMapNumber];
 
   if (bitMap._segmentStatus.empty())
   {
@@ -957,8 +957,8 @@ SoloItinGenerator::getBookingCodes(const std::vector<int>& oSopVec,
   {
     uint16_t tvlSegSize = tSegs.size();
 
-    std::vector<PaxTypeFare::SegmentStatus>::const_iterator i = bitMap._segmentStatus.begin();
-    std::vector<PaxTypeFare::SegmentStatus>::const_iterator iEnd = bitMap._segmentStatus.end();
+    auto i = bitMap._segmentStatus.begin();
+    const auto iEnd = bitMap._segmentStatus.end();
 
     for (uint16_t tvlItem = 0; i != iEnd; ++i, ++tvlItem)
     {
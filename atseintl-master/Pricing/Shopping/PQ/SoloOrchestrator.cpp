@@ -374,12 +374,10 @@ SoloOrchestrator::setSegmentStatuses(SortedFlightsMap& flightMap, ShoppingTrx& t
 
         fareUsage->segmentStatus().clear();
 
-        if (ptf->getFlightSegmentStatus(bitmapNumber))
-        {
-          fareUsage->segmentStatus().insert(fareUsage->segmentStatus().end(),
-                                            ptf->getFlightSegmentStatus(bitmapNumber)->begin(),
-                                            ptf->getFlightSegmentStatus(bitmapNumber)->end());
-        }
+        const auto flightSegmentStatus = ptf->getFlightSegmentStatus(bitmapNumber);
+        fareUsage->segmentStatus().insert(fareUsage->segmentStatus().end(),
+                                          flightSegmentStatus.begin(),
+                                          flightSegmentStatus.end());
 
         TSE_ASSERT(fareUsage->segmentStatus().size() == fareUsage->travelSeg().size());
 
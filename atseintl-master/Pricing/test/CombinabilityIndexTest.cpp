@@ -0,0 +1,288 @@
+#include "test/include/CppUnitHelperMacros.h"
+
+#include "Common/TseConsts.h"
+#include "DBAccess/FareClassRestRule.h"
+#include "DBAccess/TariffRuleRest.h"
+#include "Diagnostic/DiagCollector.h"
+#include "Pricing/CombinabilityIndex.h"
+#include "Pricing/Combinations.h"
+#include "test/include/TestMemHandle.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace tse
+{
+class CombinabilityIndexTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(CombinabilityIndexTest);
+  CPPUNIT_TEST(testTariffRule_TariffAndRule);
+  CPPUNIT_TEST(testTariffRule_AnyTariffAnyRule);
+  CPPUNIT_TEST(testTariffRule_NoTariffApplication);
+  CPPUNIT_TEST(testTariffRule_GlobalDirection);
+  CPPUNIT_TEST(testTariffRule_Negative);
+  CPPUNIT_TEST(testTariffRule_NotIndexed);
+  CPPUNIT_TEST(testFareClass_FareClass);
+  CPPUNIT_TEST(testFareClass_FareFamily);
+  CPPUNIT_TEST(testFareClass_FareType);
+  CPPUNIT_TEST(testFareClass_NoType);
+  CPPUNIT_TEST(testFareClass_Owrt);
+  CPPUNIT_TEST(testFareClass_LastRules);
+  CPPUNIT_TEST(testFareClass_NotIndexed);
+  CPPUNIT_TEST(testIndex_CompiledOnce);
+  CPPUNIT_TEST(testIndex_CompiledOnceAcrossThreads);
+  CPPUNIT_TEST(testIndex_Stats);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void tearDown() { _memHandle.clear(); }
+
+  TariffRuleRest* addTariffRule(const TariffNumber tariff,
+                                const RuleNumber& rule,
+                                const GlobalDirection globalDir = GlobalDirection::ZZ)
+  {
+    TariffRuleRest* rest = _memHandle.create<TariffRuleRest>();
+    rest->ruleTariff() = tariff;
+    rest->rule() = rule;
+    rest->globalDirection() = globalDir;
+    rest->sametrfRuleInd() = ' ';
+    rest->primeRuleInd() = ' ';
+    rest->defaultRuleInd() = ' ';
+    rest->trfRuleApplInd() = ' ';
+    _tariffRules.push_back(rest);
+    return rest;
+  }
+
+  FareClassRestRule*
+  addFareClass(const Indicator typeInd, const FareType& typeCode, const Indicator owrt = ' ')
+  {
+    FareClassRestRule* rest = _memHandle.create<FareClassRestRule>();
+    rest->typeInd() = typeInd;
+    rest->typeCode() = typeCode;
+    rest->owrt() = owrt;
+    rest->normalFaresInd() = ' ';
+    rest->samediffInd() = ' ';
+    rest->fareClassTypeApplInd() = ' ';
+    rest->penaltysvcchrgApplInd() = ' ';
+    _fareClasses.push_back(rest);
+    return rest;
+  }
+
+  void testTariffRule_TariffAndRule()
+  {
+    addTariffRule(3, "1000");
+    addTariffRule(8, "2000");
+
+    CombinabilityIndex::TariffRuleItem item;
+    CPPUNIT_ASSERT(item.compile(_tariffRules));
+    CPPUNIT_ASSERT(!item.matchesNone(3, "1000", GlobalDirection::AT));
+    CPPUNIT_ASSERT(!item.matchesNone(8, "2000", GlobalDirection::AT));
+    CPPUNIT_ASSERT(item.matchesNone(3, "2000", GlobalDirection::AT));
+    CPPUNIT_ASSERT(item.matchesNone(5, "1000", GlobalDirection::AT));
+  }
+
+  void testTariffRule_AnyTariffAnyRule()
+  {
+    addTariffRule(Combinations::ANY_TARIFF, "1000");
+    addTariffRule(8, ANY_RULE);
+
+    CombinabilityIndex::TariffRuleItem item;
+    CPPUNIT_ASSERT(item.compile(_tariffRules));
+    CPPUNIT_ASSERT(!item.matchesNone(5, "1000", GlobalDirection::AT));
+    CPPUNIT_ASSERT(!item.matchesNone(8, "3000", GlobalDirection::AT));
+    CPPUNIT_ASSERT(item.matchesNone(5, "3000", GlobalDirection::AT));
+  }
+
+  void testTariffRule_NoTariffApplication()
+  {
+    addTariffRule(Combinations::NO_TARIFF_APPLICATION, "1000");
+
+    CombinabilityIndex::TariffRuleItem item;
+    CPPUNIT_ASSERT(item.compile(_tariffRules));
+    CPPUNIT_ASSERT(!item.matchesNone(5, "3000", GlobalDirection::AT));
+  }
+
+  void testTariffRule_GlobalDirection()
+  {
+    addTariffRule(3, "1000", GlobalDirection::PA);
+
+    CombinabilityIndex::TariffRuleItem item;
+    CPPUNIT_ASSERT(item.compile(_tariffRules));
+    CPPUNIT_ASSERT(!item.matchesNone(3, "1000", GlobalDirection::PA));
+    CPPUNIT_ASSERT(item.matchesNone(3, "1000", GlobalDirection::AT));
+  }
+
+  void testTariffRule_Negative()
+  {
+    addTariffRule(3, "1000");
+    addTariffRule(8, "2000")->trfRuleApplInd() = Combinations::NOT_ALLOWED;
+
+    CombinabilityIndex::TariffRuleItem item;
+    CPPUNIT_ASSERT(item.compile(_tariffRules));
+    CPPUNIT_ASSERT(item.negative());
+  }
+
+  void testTariffRule_NotIndexed()
+  {
+    addTariffRule(3, "1000")->sametrfRuleInd() = Combinations::SAME_TARIFF;
+    CombinabilityIndex::TariffRuleItem sameTariff;
+    CPPUNIT_ASSERT(!sameTariff.compile(_tariffRules));
+
+    _tariffRules.clear();
+    addTariffRule(3, "1000")->defaultRuleInd() = 'X';
+    CombinabilityIndex::TariffRuleItem defaultRule;
+    CPPUNIT_ASSERT(!defaultRule.compile(_tariffRules));
+  }
+
+  void testFareClass_FareClass()
+  {
+    addFareClass('F', "YOW");
+    addFareClass('A', "BEX");
+
+    CombinabilityIndex::FareClassItem item;
+    CPPUNIT_ASSERT(item.compile(_fareClasses));
+    CPPUNIT_ASSERT(!item.matchesNone(ONE_WAY_MAY_BE_DOUBLED, "YOW", "EU"));
+    CPPUNIT_ASSERT(!item.matchesNone(ONE_WAY_MAY_BE_DOUBLED, "BEX", "EU"));
+    CPPUNIT_ASSERT(item.matchesNone(ONE_WAY_MAY_BE_DOUBLED, "YOW1", "EU"));
+  }
+
+  void testFareClass_FareFamily()
+  {
+    addFareClass('F', "-EE");
+
+    CombinabilityIndex::FareClassItem item;
+    CPPUNIT_ASSERT(item.compile(_fareClasses));
+    CPPUNIT_ASSERT(!item.matchesNone(ONE_WAY_MAY_BE_DOUBLED, "BEE", "EU"));
+    CPPUNIT_ASSERT(item.matchesNone(ONE_WAY_MAY_BE_DOUBLED, "EE", "EU"));
+  }
+
+  void testFareClass_FareType()
+  {
+    addFareClass('T', "XEX");
+    addFareClass('T', "*Y");
+
+    CombinabilityIndex::FareClassItem item;
+    CPPUNIT_ASSERT(item.compile(_fareClasses));
+    CPPUNIT_ASSERT(!item.matchesNone(ONE_WAY_MAY_BE_DOUBLED, "Y", "XEX"));
+    CPPUNIT_ASSERT(!item.matchesNone(ONE_WAY_MAY_BE_DOUBLED, "Y", "EU"));
+    CPPUNIT_ASSERT(item.matchesNone(ONE_WAY_MAY_BE_DOUBLED, "Y", "BU"));
+  }
+
+  void testFareClass_NoType()
+  {
+    addFareClass('F', "YOW");
+    addFareClass(' ', "");
+
+    CombinabilityIndex::FareClassItem item;
+    CPPUNIT_ASSERT(item.compile(_fareClasses));
+    CPPUNIT_ASSERT(!item.matchesNone(ONE_WAY_MAY_BE_DOUBLED, "BEX", "EU"));
+  }
+
+  void testFareClass_Owrt()
+  {
+    addFareClass('F', "YOW", '2');
+    addFareClass('F', "BEX", '1');
+
+    CombinabilityIndex::FareClassItem item;
+    CPPUNIT_ASSERT(item.compile(_fareClasses));
+    CPPUNIT_ASSERT(item.matchesNone(ONE_WAY_MAY_BE_DOUBLED, "YOW", "EU"));
+    CPPUNIT_ASSERT(!item.matchesNone(ROUND_TRIP_MAYNOT_BE_HALVED, "YOW", "EU"));
+    CPPUNIT_ASSERT(item.matchesNone(ROUND_TRIP_MAYNOT_BE_HALVED, "BEX", "EU"));
+    CPPUNIT_ASSERT(!item.matchesNone(ONE_WAY_MAYNOT_BE_DOUBLED, "BEX", "EU"));
+    CPPUNIT_ASSERT(item.matchesNone(ONE_WAY_MAYNOT_BE_DOUBLED, "YOW", "EU"));
+  }
+
+  void testFareClass_LastRules()
+  {
+    FareClassRestRule* first = addFareClass('F', "YOW");
+    first->penaltysvcchrgApplInd() = Combinations::RESTRICTION_APPLIES;
+    FareClassRestRule* second = addFareClass('F', "BEX");
+    FareClassRestRule* roundTrip = addFareClass('F', "MRT", '2');
+
+    CombinabilityIndex::FareClassItem item;
+    CPPUNIT_ASSERT(item.compile(_fareClasses));
+    CPPUNIT_ASSERT_EQUAL(static_cast<const FareClassRestRule*>(second),
+                         item.lastOwrtMatched(ONE_WAY_MAY_BE_DOUBLED));
+    CPPUNIT_ASSERT_EQUAL(static_cast<const FareClassRestRule*>(roundTrip),
+                         item.lastOwrtMatched(ROUND_TRIP_MAYNOT_BE_HALVED));
+    CPPUNIT_ASSERT_EQUAL(static_cast<const FareClassRestRule*>(first),
+                         item.lastPenalty(ONE_WAY_MAY_BE_DOUBLED));
+  }
+
+  void testFareClass_NotIndexed()
+  {
+    addFareClass('F', "YOW")->samediffInd() = '1';
+    CombinabilityIndex::FareClassItem sameDiff;
+    CPPUNIT_ASSERT(!sameDiff.compile(_fareClasses));
+
+    _fareClasses.clear();
+    addFareClass('S', "H");
+    CombinabilityIndex::FareClassItem season;
+    CPPUNIT_ASSERT(!season.compile(_fareClasses));
+
+    _fareClasses.clear();
+    addFareClass('F', "YOW")->normalFaresInd() = 'X';
+    CombinabilityIndex::FareClassItem normalFares;
+    CPPUNIT_ASSERT(!normalFares.compile(_fareClasses));
+  }
+
+  void testIndex_CompiledOnce()
+  {
+    addTariffRule(3, "1000");
+    addFareClass('S', "H");
+
+    CombinabilityIndex index;
+    const CombinabilityIndex::TariffRuleItem* item = index.tariffRuleItem("ATP", 10, _tariffRules);
+    CPPUNIT_ASSERT(item);
+    CPPUNIT_ASSERT_EQUAL(item, index.tariffRuleItem("ATP", 10, _tariffRules));
+    CPPUNIT_ASSERT(item != index.tariffRuleItem("SITA", 10, _tariffRules));
+    CPPUNIT_ASSERT(!index.fareClassItem("ATP", 10, _fareClasses));
+  }
+
+  void testIndex_CompiledOnceAcrossThreads()
+  {
+    addTariffRule(3, "1000");
+
+    CombinabilityIndex index;
+    std::vector<const CombinabilityIndex::TariffRuleItem*> items(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < items.size(); ++i)
+      threads.emplace_back([&, i]() { items[i] = index.tariffRuleItem("ATP", 10, _tariffRules); });
+    for (std::thread& thread : threads)
+      thread.join();
+
+    CPPUNIT_ASSERT(items.front());
+    CPPUNIT_ASSERT(std::count(items.begin(), items.end(), items.front()) == 4);
+    CPPUNIT_ASSERT_EQUAL(items.front(), index.tariffRuleItem("ATP", 10, _tariffRules));
+  }
+
+  void testIndex_Stats()
+  {
+    addTariffRule(3, "1000");
+
+    CombinabilityIndex index;
+    index.tariffRuleItem("ATP", 10, _tariffRules);
+    index.countCheck(CombinabilityIndex::TARIFF_RULE, true);
+    index.countCheck(CombinabilityIndex::TARIFF_RULE, false);
+    index.countCheck(CombinabilityIndex::TARIFF_RULE, true);
+    index.countCheck(CombinabilityIndex::TARIFF_RULE, true);
+
+    DiagCollector diag;
+    diag.activate();
+    index.printStats(diag);
+
+    CPPUNIT_ASSERT_EQUAL(std::string(" CAT10 COMBINABILITY PRECHECK\n"
+                                     " SUBCAT   ITEMS INDEXED   CHECKED   SKIPPED  HIT RATE\n"
+                                     "  107         1       1         4         3     75.0%\n"
+                                     "  108         0       0         0         0      0.0%\n"),
+                         diag.str());
+  }
+
+private:
+  TestMemHandle _memHandle;
+  std::vector<TariffRuleRest*> _tariffRules;
+  std::vector<FareClassRestRule*> _fareClasses;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CombinabilityIndexTest);
+}
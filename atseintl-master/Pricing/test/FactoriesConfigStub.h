@@ -35,6 +35,11 @@ public:
   {
     FactoriesConfig::setSearchAlwaysLowToHighForUnitTestsOnly(value);
   }
+
+  void setSpeculativeFarePathFactories(const uint32_t value)
+  {
+    FactoriesConfig::setSpeculativeFarePathFactoriesForUnitTestsOnly(value);
+  }
 };
 }
 }
@@ -118,6 +118,7 @@ class FarePathFactoryTest : public CppUnit::TestFixture
   CPPUNIT_TEST(testFailedFareExistsInPU);
   CPPUNIT_TEST(testRecalculatePriority);
   CPPUNIT_TEST(testReplaceWithNewPU);
+  CPPUNIT_TEST(testCxrFarePathDuplicatesKeepEnumerationOrder);
 
   CPPUNIT_TEST(testFppqPriorityIsSameAsPupqPriorityWhenSamePriority);
   CPPUNIT_TEST(testFppqPriorityChangesToLowerWhenPupqPriorityHasLowerPriority);
@@ -457,6 +458,63 @@ public:
     CPPUNIT_ASSERT_EQUAL(pupqItem, _fppqItem->pupqItemVect()[0]);
   }
 
+  FPPQItem* pushCxrItem(const FPPQItem::PUIndices& puIndices, uint16_t xPoint)
+  {
+    static const MoneyAmount puAmounts[2][3] = {{100, 200, 400}, {10, 20, 40}};
+
+    FPPQItem* fppqItem = _factory->constructFPPQItem();
+    fppqItem->farePath() = _factory->constructFarePath();
+    fppqItem->puIndices() = puIndices;
+    fppqItem->xPoint() = xPoint;
+    fppqItem->farePath()->setTotalNUCAmount(puAmounts[0][puIndices[0]] +
+                                            puAmounts[1][puIndices[1]]);
+    _factory->pushCxrFPPQItem(fppqItem);
+    return fppqItem;
+  }
+
+  // Same expansion as buildNextCxrFarePathSet: only PUs at or after xPoint move
+  std::vector<FPPQItem::PUIndices> enumerateCxrItems(bool submitDuplicates)
+  {
+    _factory->_storage.initialize(*_trx, nullptr, 2);
+    _factory->_cxrFarePathQueued.clear();
+
+    std::vector<FPPQItem::PUIndices> popped;
+    pushCxrItem(FPPQItem::PUIndices(2, 0), 0);
+
+    while (!_factory->_cxrFarePathPQ.empty())
+    {
+      FPPQItem* fppqItem = _factory->popCxrFPPQItem();
+      popped.push_back(fppqItem->puIndices());
+
+      if (submitDuplicates)
+        pushCxrItem(fppqItem->puIndices(), fppqItem->xPoint() + 1);
+
+      for (uint16_t xPoint = fppqItem->xPoint(); xPoint < 2; ++xPoint)
+      {
+        FPPQItem::PUIndices next(fppqItem->puIndices());
+        if (++next[xPoint] == 3)
+          continue;
+
+        // a sibling reaching the same combination later in the PU path
+        // must not hide the expansions of this one
+        if (submitDuplicates)
+          pushCxrItem(next, xPoint + 1);
+        pushCxrItem(next, xPoint);
+      }
+      _factory->releaseFPPQItem(fppqItem);
+    }
+    return popped;
+  }
+
+  void testCxrFarePathDuplicatesKeepEnumerationOrder()
+  {
+    const std::vector<FPPQItem::PUIndices> expected = enumerateCxrItems(false);
+    CPPUNIT_ASSERT_EQUAL(size_t(9), expected.size());
+
+    const std::vector<FPPQItem::PUIndices> actual = enumerateCxrItems(true);
+    CPPUNIT_ASSERT(expected == actual);
+  }
+
   void testFppqPriorityIsSameAsPupqPriorityWhenSamePriority()
   {
     _pupqItem1->mutablePriorityStatus().setNegotiatedFarePriority(PRIORITY_LOW);
@@ -3,7 +3,11 @@
 #include "Pricing/test/FactoriesConfigStub.h"
 #include "Common/TseCodeTypes.h"
 #include "DataModel/NoPNRPricingTrx.h"
+#include "Pricing/FareMarketPath.h"
+#include "Pricing/PricingUnitFactory.h"
+#include "Pricing/PUPath.h"
 #include "test/include/CppUnitHelperMacros.h"
+#include "test/include/TestConfigInitializer.h"
 #include "test/include/TestMemHandle.h"
 
 namespace tse
@@ -16,6 +20,15 @@ class PaxFarePathFactoryTest : public CppUnit::TestFixture
   CPPUNIT_TEST(testIsValidForIntegratedAllNoMatches);
   CPPUNIT_TEST(testIsValidForIntegratedValid);
   CPPUNIT_TEST(testIsValidForIntegratedNotValid);
+  CPPUNIT_TEST(testSpeculationAllowed_Disabled);
+  CPPUNIT_TEST(testSpeculationAllowed_Enabled);
+  CPPUNIT_TEST(testSpeculationAllowed_NoPNR);
+  CPPUNIT_TEST(testIsIndependentFPF);
+  CPPUNIT_TEST(testIsIndependentFPF_SharedPUFactory);
+  CPPUNIT_TEST(testIsIndependentFPF_SameFareMarketPath);
+  CPPUNIT_TEST(testIsIndependentFPF_ThroughFarePrecedence);
+  CPPUNIT_TEST(testBuildNextLevelFarePathSpeculatively_SameOrderAsSerial);
+  CPPUNIT_TEST(testBuildNextLevelFarePathSpeculatively_ReqDiagFPCount);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -197,8 +210,146 @@ public:
     CPPUNIT_ASSERT(!_factory->isValidForIntegrated(&noMatchFarePath));
   }
 
+  void testSpeculationAllowed_Disabled()
+  {
+    PricingTrx trx;
+    _factory->trx() = &trx;
+
+    CPPUNIT_ASSERT(!_factory->speculationAllowed());
+  }
+
+  void testSpeculationAllowed_Enabled()
+  {
+    PricingTrx trx;
+    _factory->trx() = &trx;
+    _factoriesConfig.setSpeculativeFarePathFactories(4);
+
+    CPPUNIT_ASSERT(_factory->speculationAllowed());
+  }
+
+  void testSpeculationAllowed_NoPNR()
+  {
+    NoPNRPricingTrx trx;
+    _factory->trx() = &trx;
+    _factoriesConfig.setSpeculativeFarePathFactories(4);
+
+    CPPUNIT_ASSERT(!_factory->speculationAllowed());
+  }
+
+  FarePathFactory* createFPF(FareMarketPath* fmp, PricingUnitFactory* puf)
+  {
+    FarePathFactory* fpf = _memHandle.create<FarePathFactory>(_factoriesConfig);
+    fpf->itin() = &_itin;
+    fpf->puPath() = _memHandle.create<PUPath>();
+    fpf->puPath()->fareMarketPath() = fmp;
+    fpf->allPUF().push_back(puf);
+    return fpf;
+  }
+
+  void testIsIndependentFPF()
+  {
+    FareMarketPath fmp1, fmp2;
+    PricingUnitFactory puf1, puf2;
+    const std::vector<FarePathFactory*> fpfs = {createFPF(&fmp1, &puf1)};
+
+    CPPUNIT_ASSERT(PaxFarePathFactory::isIndependentFPF(*createFPF(&fmp2, &puf2), fpfs));
+  }
+
+  void testIsIndependentFPF_SharedPUFactory()
+  {
+    FareMarketPath fmp1, fmp2;
+    PricingUnitFactory puf1, puf2;
+    const std::vector<FarePathFactory*> fpfs = {createFPF(&fmp1, &puf1)};
+    FarePathFactory* fpf = createFPF(&fmp2, &puf2);
+    fpf->allPUF().push_back(&puf1);
+
+    CPPUNIT_ASSERT(!PaxFarePathFactory::isIndependentFPF(*fpf, fpfs));
+  }
+
+  void testIsIndependentFPF_SameFareMarketPath()
+  {
+    FareMarketPath fmp;
+    PricingUnitFactory puf1, puf2;
+    const std::vector<FarePathFactory*> fpfs = {createFPF(&fmp, &puf1)};
+
+    CPPUNIT_ASSERT(!PaxFarePathFactory::isIndependentFPF(*createFPF(&fmp, &puf2), fpfs));
+  }
+
+  void testIsIndependentFPF_ThroughFarePrecedence()
+  {
+    FareMarketPath fmp1, fmp2;
+    PricingUnitFactory puf1, puf2;
+    const std::vector<FarePathFactory*> fpfs = {createFPF(&fmp1, &puf1)};
+    _itin.setThroughFarePrecedence(true);
+
+    CPPUNIT_ASSERT(!PaxFarePathFactory::isIndependentFPF(*createFPF(&fmp2, &puf2), fpfs));
+  }
+
+  std::vector<MoneyAmount> buildFarePathsSpeculatively(uint32_t speculativeFPFs,
+                                                       uint32_t reqValidFPCount = 100,
+                                                       int32_t reqDiagFPCount = 0)
+  {
+    static const std::vector<std::vector<MoneyAmount>> fpfAmounts = {
+        {100, 130, 170}, {110, 120, 180}, {105, 150, 160}};
+
+    _memHandle.create<TestConfigInitializer>();
+    _factoriesConfig.setSpeculativeFarePathFactories(speculativeFPFs);
+    PricingTrx* trx = _memHandle.create<PricingTrx>();
+    PaxFarePathFactory* paxFPF = _memHandle.create<PaxFarePathFactory>(_factoriesConfig);
+    paxFPF->trx() = trx;
+    paxFPF->reqValidFPCount() = reqValidFPCount;
+    paxFPF->_reqDiagFPCount = reqDiagFPCount;
+
+    for (const std::vector<MoneyAmount>& amounts : fpfAmounts)
+    {
+      FarePathFactory* fpf = createFPF(_memHandle.create<FareMarketPath>(),
+                                       _memHandle.create<PricingUnitFactory>());
+      fpf->trx() = trx;
+      for (MoneyAmount amount : amounts)
+      {
+        // already validated, getNextFPPQItem() returns it as it is
+        FarePath* farePath = _memHandle.create<FarePath>();
+        farePath->setTotalNUCAmount(amount);
+        farePath->processed() = true;
+        FPPQItem* fppqItem = _memHandle.create<FPPQItem>();
+        fppqItem->farePath() = farePath;
+        fpf->pushBack(fppqItem);
+      }
+      paxFPF->pqPush(fpf);
+    }
+
+    DiagCollector diag;
+    paxFPF->buildNextLevelFarePathSpeculatively(diag);
+
+    std::vector<MoneyAmount> result;
+    for (const FPPQItem* fppqItem : paxFPF->_validFPPQItemVect)
+      result.push_back(fppqItem->farePath()->getTotalNUCAmount());
+    return result;
+  }
+
+  void testBuildNextLevelFarePathSpeculatively_SameOrderAsSerial()
+  {
+    const std::vector<MoneyAmount> expected = {100, 105, 110, 120, 130, 150, 160, 170, 180};
+    const std::vector<MoneyAmount> serial = buildFarePathsSpeculatively(1);
+    const std::vector<MoneyAmount> speculative = buildFarePathsSpeculatively(3);
+
+    CPPUNIT_ASSERT(expected == serial);
+    CPPUNIT_ASSERT(expected == speculative);
+  }
+
+  // as the serial search, a round does not end before the fare paths requested for the diagnostic
+  void testBuildNextLevelFarePathSpeculatively_ReqDiagFPCount()
+  {
+    const std::vector<MoneyAmount> one = buildFarePathsSpeculatively(3, 1);
+    const std::vector<MoneyAmount> diag = buildFarePathsSpeculatively(3, 1, 6);
+
+    CPPUNIT_ASSERT(std::vector<MoneyAmount>{100} == one);
+    CPPUNIT_ASSERT((std::vector<MoneyAmount>{100, 105, 110, 120}) == diag);
+  }
+
 private:
   test::FactoriesConfigStub _factoriesConfig;
+  Itin _itin;
   PaxFarePathFactory* _factory;
   TestMemHandle _memHandle;
 };
@@ -98,6 +98,9 @@ struct AppConsoleStats
   uint64_t dbOkCount;
   uint64_t dbErrorCount;
   double dbElapsedTime;
+
+  uint64_t taskQueueWait[5]; // Pool tasks by queue wait: 1ms, 10ms, 100ms, 1s, longer
+  double taskQueueWaitTime; // Total time pool tasks waited in queues
 }; // End struct
 
 } // End namespace
@@ -26,6 +26,7 @@
 #include "Common/Logger.h"
 #include "Common/TseSrvStats.h"
 #include "DBAccess/CacheControl.h"
+#include "DBAccess/CacheInitializer.h"
 #include "DBAccess/CacheManager.h"
 #include "DBAccess/CacheRegistry.h"
 #include "DBAccess/DataHandle.h"
@@ -112,6 +113,8 @@ CMD_CACHE_STATS("TATS");
 const std::string
 CMD_COMPR_CACHE_STATS("CCST");
 const std::string
+CMD_CACHE_INIT("CINI");
+const std::string
 CMD_DISPOSE_CACHE("DSPC");
 const std::string
 CMD_TO_ELAPSED("LAPS");
@@ -270,6 +273,12 @@ struct LogComprCacheStats
           << "mem~" << stats._memoryEstimate << DELIM
           << "avrgComprBytes=" << stats._averageCompressedBytes << DELIM
           << "avrgRatio=" << stats._averageRatio << DELIM << "thld=" << stats._threshold << DELIM
+          << "#hit=" << stats._hits << DELIM << "#miss=" << stats._misses << DELIM
+          << "#infl=" << stats._inflations << DELIM << "#defl=" << stats._deflations << DELIM
+          << "#rej=" << stats._admissionRejects << DELIM
+          << "#load=" << stats._coalescedLoads << DELIM
+          << "#coalesced=" << stats._coalescedWaits << DELIM
+          << "#coalescedTmo=" << stats._coalescedTimeouts << DELIM
           << "#access=" << ctl->accessCount() << DELIM << "#read=" << ctl->readCount() << DELIM
           << "err:" << errors << DELIM;
     }
@@ -412,6 +421,10 @@ TseAppConsole::processMessage(const ac::SocketUtils::Message& req, ac::SocketUti
   {
     return processCompressedCacheStats(req, rsp);
   }
+  else if (CMD_CACHE_INIT == req.command)
+  {
+    return processCacheInit(req, rsp);
+  }
   else if (CMD_DISPOSE_CACHE == req.command)
   {
     return processDisposeCache(req, rsp);
@@ -1034,6 +1047,34 @@ TseAppConsole::processCompressedCacheStats(const ac::SocketUtils::Message& req,
   return true;
 }
 
+bool
+TseAppConsole::processCacheInit(const ac::SocketUtils::Message& req,
+                                ac::SocketUtils::Message& rsp)
+{
+  rsp.command = req.command;
+  rsp.xmlVersion = VER;
+  rsp.xmlRevision = REV;
+  const std::string& optionalCacheId(req.payload);
+  ostringstream oss;
+  if (!CacheManager::initialized())
+  {
+    oss << "Caches are loading" << std::endl;
+  }
+  else if (optionalCacheId.empty())
+  {
+    CacheManager::instance().cacheInitializer().print(oss);
+  }
+  else
+  {
+    oss << optionalCacheId << " "
+        << (CacheManager::instance().cacheInitializer().ready(optionalCacheId) ? "READY"
+                                                                               : "LOADING")
+        << std::endl;
+  }
+  rsp.payload = oss.str();
+  return true;
+}
+
 bool
 TseAppConsole::processDisposeCache(const ac::SocketUtils::Message& req,
                                    ac::SocketUtils::Message& rsp)
@@ -63,6 +63,7 @@ private:
   bool processCacheStats(const ac::SocketUtils::Message& req, ac::SocketUtils::Message& rsp);
   bool
   processCompressedCacheStats(const ac::SocketUtils::Message& req, ac::SocketUtils::Message& rsp);
+  bool processCacheInit(const ac::SocketUtils::Message& req, ac::SocketUtils::Message& rsp);
   bool processDisposeCache(const ac::SocketUtils::Message& req, ac::SocketUtils::Message& rsp);
   bool processDAOCoverageStats(const ac::SocketUtils::Message& req, ac::SocketUtils::Message& rsp);
   bool processTOElapsed(const ac::SocketUtils::Message& req, ac::SocketUtils::Message& rsp);
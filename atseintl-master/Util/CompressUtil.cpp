@@ -329,4 +329,79 @@ CompressUtil::decompressBz2(std::string& buf)
 
   return true;
 }
+
+namespace
+{
+// compressed output is appended to the caller's buffer in blocks of this size
+const size_t DEFLATE_BLOCK_SIZE = 16384;
+}
+
+DeflateStream::DeflateStream() : _stream(new z_stream_s)
+{
+  _stream->zalloc = Z_NULL;
+  _stream->zfree = Z_NULL;
+  _stream->opaque = Z_NULL;
+  _initialized = (deflateInit(_stream.get(), Z_DEFAULT_COMPRESSION) == Z_OK);
+  if (!_initialized)
+  {
+    log4cxx::LoggerPtr _logger(log4cxx::Logger::getLogger("atseintl.Common.CompressUtil"));
+    LOG4CXX_FATAL(_logger, "Error initializing compression stream\n");
+  }
+}
+
+DeflateStream::~DeflateStream()
+{
+  if (_initialized)
+    deflateEnd(_stream.get());
+}
+
+bool
+DeflateStream::write(const char* data, size_t size, std::vector<char>& out)
+{
+  return deflate(data, size, Z_NO_FLUSH, out);
+}
+
+bool
+DeflateStream::finish(std::vector<char>& out)
+{
+  return deflate(nullptr, 0, Z_FINISH, out);
+}
+
+bool
+DeflateStream::deflate(const char* data, size_t size, int flush, std::vector<char>& out)
+{
+  if (!_initialized)
+    return false;
+
+  _stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  _stream->avail_in = uInt(size);
+
+  for (;;)
+  {
+    const size_t used = out.size();
+    out.resize(used + DEFLATE_BLOCK_SIZE);
+    _stream->next_out = reinterpret_cast<Bytef*>(&out[used]);
+    _stream->avail_out = uInt(DEFLATE_BLOCK_SIZE);
+
+    const int res = ::deflate(_stream.get(), flush);
+    out.resize(out.size() - _stream->avail_out);
+
+    if (res == Z_STREAM_END)
+      return true;
+
+    if (res == Z_BUF_ERROR && _stream->avail_in == 0 && flush != Z_FINISH)
+      return true; // nothing more to do
+
+    if (res != Z_OK && res != Z_BUF_ERROR)
+    {
+      log4cxx::LoggerPtr _logger(log4cxx::Logger::getLogger("atseintl.Common.CompressUtil"));
+      LOG4CXX_FATAL(_logger, "Error compressing data: unknown error " << res << "\n");
+      return false;
+    }
+
+    // all the input taken and no output pending
+    if (flush != Z_FINISH && _stream->avail_in == 0 && _stream->avail_out != 0)
+      return true;
+  }
+}
 }
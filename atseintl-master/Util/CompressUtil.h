@@ -14,9 +14,12 @@
 //----------------------------------------------------------------------------
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
+struct z_stream_s;
+
 namespace tse
 {
 
@@ -151,5 +154,47 @@ private:
   static const char* xlateBz2StatusCode(int rcode);
 };
 
+/**
+*   @class DeflateStream
+*
+*   @Description Compresses data given in pieces. The output of all the
+*                write() calls followed by finish() is a single zlib stream,
+*                which CompressUtil::decompress() accepts.
+*/
+class DeflateStream
+{
+public:
+  DeflateStream();
+  ~DeflateStream();
+
+  DeflateStream(const DeflateStream&) = delete;
+  DeflateStream& operator=(const DeflateStream&) = delete;
+
+  /**
+  *   @method write
+  *
+  *   @Description Compresses the data, appending to out whatever
+  *                compressed output is ready
+  *
+  *   @return bool - true if successful, false otherwise
+  */
+  bool write(const char* data, size_t size, std::vector<char>& out);
+
+  /**
+  *   @method finish
+  *
+  *   @Description Appends the rest of the compressed output to out
+  *
+  *   @return bool - true if successful, false otherwise
+  */
+  bool finish(std::vector<char>& out);
+
+private:
+  bool deflate(const char* data, size_t size, int flush, std::vector<char>& out);
+
+  std::unique_ptr<z_stream_s> _stream;
+  bool _initialized = false;
+};
+
 } // end tse namespace
 
@@ -0,0 +1,110 @@
+// ----------------------------------------------------------------
+//
+//   Copyright Sabre 2015
+//
+//           The copyright to the computer program(s) herein
+//           is the property of Sabre.
+//           The program(s) may be used and/or copied only with
+//           the written permission of Sabre or in accordance
+//           with the terms and conditions stipulated in the
+//           agreement/contract under which the program(s)
+//           have been supplied.
+//
+//  Description:
+//    Formatting of numbers into a caller's buffer, without streams
+//    or allocation. Integers are formatted without sprintf, two
+//    digits at a time from a table; the output is the same as with
+//    "%d"/"%u". Doubles go through snprintf, which gives the exact
+//    rounding of "%.*f".
+//
+// ----------------------------------------------------------------
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+#include <stdint.h>
+
+namespace tse
+{
+namespace number_format
+{
+// enough for any 64-bit integer with its sign
+constexpr size_t IntegerBufferSize = 21;
+
+// Writes the digits of value backwards, ending just before end.
+// Returns the position of the first digit.
+inline char*
+formatUnsignedBackwards(uint64_t value, char* end)
+{
+  static const char digitPairs[] = "00010203040506070809"
+                                   "10111213141516171819"
+                                   "20212223242526272829"
+                                   "30313233343536373839"
+                                   "40414243444546474849"
+                                   "50515253545556575859"
+                                   "60616263646566676869"
+                                   "70717273747576777879"
+                                   "80818283848586878889"
+                                   "90919293949596979899";
+  char* out = end;
+  while (value >= 100)
+  {
+    const unsigned pair = unsigned(value % 100) * 2;
+    value /= 100;
+    *--out = digitPairs[pair + 1];
+    *--out = digitPairs[pair];
+  }
+  if (value >= 10)
+  {
+    const unsigned pair = unsigned(value) * 2;
+    *--out = digitPairs[pair + 1];
+    *--out = digitPairs[pair];
+  }
+  else
+  {
+    *--out = char('0' + value);
+  }
+  return out;
+}
+
+// Writes value to buffer, which must hold IntegerBufferSize characters.
+// Returns the number of characters written, no terminating zero is added.
+template <typename T>
+inline size_t
+formatInteger(T value, char* buffer)
+{
+  static_assert(std::is_integral<T>::value, "T must be integral");
+
+  char tmp[IntegerBufferSize];
+  char* const end = tmp + sizeof(tmp);
+  char* begin;
+  if (std::is_signed<T>::value && value < 0)
+  {
+    // negate in unsigned arithmetic, safe for the minimum value
+    begin = formatUnsignedBackwards(uint64_t(0) - uint64_t(int64_t(value)), end);
+    *--begin = '-';
+  }
+  else
+  {
+    begin = formatUnsignedBackwards(uint64_t(value), end);
+  }
+  const size_t size = size_t(end - begin);
+  memcpy(buffer, begin, size);
+  return size;
+}
+
+// Writes value in fixed notation with the given number of decimals, as
+// "%.*f" does. Returns the number of characters written, or 0 if they do
+// not fit in the buffer.
+inline size_t
+formatFixed(double value, int numDecimal, char* buffer, size_t bufferSize)
+{
+  const int size = std::snprintf(buffer, bufferSize, "%.*f", numDecimal, value);
+  if (size < 0 || size_t(size) >= bufferSize)
+    return 0;
+  return size_t(size);
+}
+}
+}
@@ -16,6 +16,8 @@ class CompressUtilTest : public CppUnit::TestFixture
   CPPUNIT_TEST(testCompressDecompressInputStringToOutputString);
   CPPUNIT_TEST(testCompressBz2);
   CPPUNIT_TEST(testDecompressBz2);
+  CPPUNIT_TEST(testDeflateStream);
+  CPPUNIT_TEST(testDeflateStreamEmpty);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -93,6 +95,34 @@ public:
     CPPUNIT_ASSERT(CompressUtil::decompressBz2(decodedStr));
     CPPUNIT_ASSERT_EQUAL(uncmpStr, decodedStr);
   }
+
+  void testDeflateStream()
+  {
+    std::string initialString;
+    for (int i = 0; i < 10000; ++i)
+      initialString += "The quick brown fox jumped over the lazy dog's back " + to_string(i) + ".";
+
+    DeflateStream stream;
+    std::vector<char> buf;
+    for (size_t pos = 0; pos < initialString.size(); pos += 1000)
+    {
+      const size_t size = std::min(size_t(1000), initialString.size() - pos);
+      CPPUNIT_ASSERT(stream.write(initialString.data() + pos, size, buf));
+    }
+    CPPUNIT_ASSERT(stream.finish(buf));
+    CPPUNIT_ASSERT(buf.size() < initialString.size());
+
+    CPPUNIT_ASSERT(CompressUtil::decompress(buf));
+    CPPUNIT_ASSERT_EQUAL(initialString, std::string(buf.begin(), buf.end()));
+  }
+
+  void testDeflateStreamEmpty()
+  {
+    DeflateStream stream;
+    std::vector<char> buf;
+    CPPUNIT_ASSERT(stream.finish(buf));
+    CPPUNIT_ASSERT(!buf.empty());
+  }
 };
 CPPUNIT_TEST_SUITE_REGISTRATION(CompressUtilTest);
 }
@@ -0,0 +1,82 @@
+// ----------------------------------------------------------------
+//
+//   Copyright Sabre 2015
+//
+//           The copyright to the computer program(s) herein
+//           is the property of Sabre.
+//           The program(s) may be used and/or copied only with
+//           the written permission of Sabre or in accordance
+//           with the terms and conditions stipulated in the
+//           agreement/contract under which the program(s)
+//           have been supplied.
+//
+// ----------------------------------------------------------------
+
+#include "Util/NumberFormat.h"
+
+#include <cstdio>
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "test/include/GtestHelperMacros.h"
+
+namespace tse
+{
+namespace
+{
+template <typename T>
+std::string
+format(T value)
+{
+  char buffer[number_format::IntegerBufferSize];
+  return std::string(buffer, number_format::formatInteger(value, buffer));
+}
+
+std::string
+printed(long long value)
+{
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%lld", value);
+  return buffer;
+}
+}
+
+TEST(NumberFormatTest, testSmallIntegers)
+{
+  for (int i = -1000; i <= 1000; ++i)
+    ASSERT_EQ(printed(i), format(i));
+}
+
+TEST(NumberFormatTest, testPowersOfTen)
+{
+  int64_t value = 1;
+  for (int i = 0; i < 18; ++i, value *= 10)
+  {
+    ASSERT_EQ(printed(value - 1), format(value - 1));
+    ASSERT_EQ(printed(value), format(value));
+    ASSERT_EQ(printed(-value), format(-value));
+  }
+}
+
+TEST(NumberFormatTest, testLimits)
+{
+  ASSERT_EQ("-32768", format(std::numeric_limits<int16_t>::min()));
+  ASSERT_EQ("65535", format(std::numeric_limits<uint16_t>::max()));
+  ASSERT_EQ("-2147483648", format(std::numeric_limits<int32_t>::min()));
+  ASSERT_EQ("4294967295", format(std::numeric_limits<uint32_t>::max()));
+  ASSERT_EQ("-9223372036854775808", format(std::numeric_limits<int64_t>::min()));
+  ASSERT_EQ("9223372036854775807", format(std::numeric_limits<int64_t>::max()));
+  ASSERT_EQ("18446744073709551615", format(std::numeric_limits<uint64_t>::max()));
+}
+
+TEST(NumberFormatTest, testFixed)
+{
+  char buffer[16];
+  ASSERT_EQ(6u, number_format::formatFixed(123.456, 2, buffer, sizeof(buffer)));
+  ASSERT_EQ("123.46", std::string(buffer));
+  ASSERT_EQ(2u, number_format::formatFixed(-1.5, 0, buffer, sizeof(buffer)));
+  ASSERT_EQ("-2", std::string(buffer));
+  ASSERT_EQ(0u, number_format::formatFixed(1e20, 2, buffer, sizeof(buffer)));
+}
+}
@@ -0,0 +1,294 @@
+#include "Xform/CustomXMLParser/IBinaryXML.h"
+
+#include "Xform/CustomXMLParser/IBaseHandler.h"
+#include "Xform/CustomXMLParser/IParser.h"
+#include "Xform/CustomXMLParser/ISchemaBase.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <stdint.h>
+#include <tr1/unordered_map>
+
+namespace
+{
+  const char _magic[] = "TBX";
+  const size_t _headerLength(4);
+
+  enum IToken
+  {
+    START_ELEMENT = 1,
+    ATTRIBUTE = 2,
+    TEXT = 3,
+    END_ELEMENT = 4,
+    CDATA = 5
+  };
+
+  void _putVarint (std::string &out,
+                   uint32_t value)
+  {
+    while (value >= 0x80)
+    {
+      out.push_back(char(value | 0x80));
+      value >>= 7;
+    }
+    out.push_back(char(value));
+  }
+  void _putValue (std::string &out,
+                  const char *value,
+                  size_t length)
+  {
+    _putVarint(out, uint32_t(length));
+    out.append(value, length);
+  }
+  bool _getVarint (const char *&p,
+                   const char *end,
+                   uint32_t &value)
+  {
+    value = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7)
+    {
+      const uint8_t byte(*p++);
+      value |= uint32_t(byte & 0x7f) << shift;
+      if (0 == (byte & 0x80))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+  bool _getValue (const char *&p,
+                  const char *end,
+                  const char *&value,
+                  size_t &length)
+  {
+    uint32_t size(0);
+    if (!_getVarint(p, end, size) || size_t(end - p) < size)
+    {
+      return false;
+    }
+    value = p;
+    length = size;
+    p += size;
+    return true;
+  }
+  void _invalid ()
+  {
+    throw std::runtime_error("invalid binary xml");
+  }
+
+  typedef std::tr1::unordered_map<IKeyString, uint32_t, IKeyStringHasher> INameMap;
+
+  // Writes the tokens as IParser reports the document.
+  class IEncoder : public ISchemaBase, public IBaseHandler
+  {
+  public:
+    explicit IEncoder (std::string &out)
+      : ISchemaBase(true)
+      , _out(out)
+    {
+    }
+
+    void insertAttr (const char *name,
+                     size_t nameLength,
+                     const char *value,
+                     size_t valueLength) const override
+    {
+      checkName(IKeyString(name, nameLength));
+      // only checks the entities, the value is sent as in the text
+      const char *decoded(value);
+      size_t decodedLength(valueLength);
+      decode(decoded, decodedLength);
+      _out.push_back(char(ATTRIBUTE));
+      putName(IKeyString(name, nameLength));
+      _putValue(_out, value, valueLength);
+    }
+    void newElement (const IKeyString &name) const override
+    {
+      onStartElement(name);
+      _out.push_back(char(START_ELEMENT));
+      putName(name);
+    }
+    void startElement (IBaseHandler &,
+                       const IKeyString &) const override
+    {
+    }
+    void endElement (IBaseHandler &,
+                     const IKeyString &name) const override
+    {
+      onEndElement(name);
+      _out.push_back(char(END_ELEMENT));
+    }
+    void characters (IBaseHandler &,
+                     const char *value,
+                     size_t length,
+                     bool bdecode) const override
+    {
+      if (bdecode)
+      {
+        const char *decoded(value);
+        size_t decodedLength(length);
+        decode(decoded, decodedLength);
+      }
+      _out.push_back(char(bdecode ? TEXT : CDATA));
+      _putValue(_out, value, length);
+    }
+
+    // IBaseHandler, the document goes to the schema only
+    bool startElement (const IKeyString &, const IAttributes &) override { return true; }
+    void characters (const char *, size_t) override {}
+    bool endElement (const IKeyString &) override { return true; }
+    bool startElement (int, const IAttributes &) override { return true; }
+    bool endElement (int) override { return true; }
+
+  private:
+    void putName (const IKeyString &name) const
+    {
+      INameMap::const_iterator it(_names.find(name));
+      if (it != _names.end())
+      {
+        _putVarint(_out, it->second);
+        return;
+      }
+      const uint32_t ref(uint32_t(_names.size() + 1));
+      _names.insert(std::make_pair(name, ref));
+      _putVarint(_out, 0);
+      _putValue(_out, name.c_str(), name.length());
+    }
+
+    std::string &_out;
+    mutable INameMap _names;
+  };
+}
+
+namespace IBinaryXML
+{
+bool
+encode(const char* xml, size_t length, std::string& binary)
+{
+  binary.clear();
+  binary.reserve(length / 2);
+  binary.append(_magic, _headerLength - 1);
+  binary.push_back(char(_version));
+  try
+  {
+    IEncoder encoder(binary);
+    IParser parser(xml, length, encoder, encoder);
+    parser.parse();
+  }
+  catch (const std::exception&)
+  {
+    binary.clear();
+    return false;
+  }
+  return true;
+}
+
+bool
+encode(const std::string& xml, std::string& binary)
+{
+  return encode(xml.data(), xml.size(), binary);
+}
+
+bool
+isBinary(const char* data, size_t length)
+{
+  return length >= _headerLength && 0 == memcmp(data, _magic, _headerLength - 1);
+}
+
+void
+parse(const char* binary, size_t length, IBaseHandler& handler, const ISchemaBase& schema)
+{
+  if (!isBinary(binary, length) || uint8_t(binary[_headerLength - 1]) != _version)
+    _invalid();
+
+  const char* p = binary + _headerLength;
+  const char* const end = binary + length;
+  std::vector<IKeyString> names;
+  std::vector<IKeyString> open;
+  bool inStartTag = false;
+  bool root = false;
+
+  // a name reference, see encode()
+  auto getName = [&]() -> const IKeyString&
+  {
+    uint32_t ref = 0;
+    if (!_getVarint(p, end, ref))
+      _invalid();
+    if (ref == 0)
+    {
+      const char* name = nullptr;
+      size_t size = 0;
+      if (!_getValue(p, end, name, size) || size == 0)
+        _invalid();
+      names.push_back(IKeyString(name, size));
+      ref = uint32_t(names.size());
+    }
+    if (ref > names.size())
+      _invalid();
+    return names[ref - 1];
+  };
+  // the attributes of an element are complete at its first child or end
+  auto closeStartTag = [&]()
+  {
+    if (inStartTag)
+    {
+      schema.startElement(handler, open.back());
+      inStartTag = false;
+    }
+  };
+
+  schema.startDocument(handler);
+  while (p < end)
+  {
+    const char token = *p++;
+    const char* value = nullptr;
+    size_t size = 0;
+    switch (token)
+    {
+    case START_ELEMENT:
+    {
+      closeStartTag();
+      if (open.empty() && root)
+        _invalid();
+      const IKeyString& name(getName());
+      schema.newElement(name);
+      open.push_back(name);
+      inStartTag = root = true;
+      break;
+    }
+    case ATTRIBUTE:
+    {
+      if (!inStartTag)
+        _invalid();
+      const IKeyString& name(getName());
+      if (!_getValue(p, end, value, size))
+        _invalid();
+      schema.insertAttr(name.c_str(), name.length(), value, size);
+      break;
+    }
+    case TEXT:
+    case CDATA:
+      if (!_getValue(p, end, value, size))
+        _invalid();
+      closeStartTag();
+      schema.characters(handler, value, size, TEXT == token);
+      break;
+    case END_ELEMENT:
+      if (open.empty())
+        _invalid();
+      closeStartTag();
+      schema.endElement(handler, open.back());
+      open.pop_back();
+      break;
+    default:
+      _invalid();
+    }
+  }
+  if (!root || !open.empty())
+    _invalid();
+  schema.endDocument(handler);
+}
+}
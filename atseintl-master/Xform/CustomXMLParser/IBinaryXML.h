@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+class IBaseHandler;
+class ISchemaBase;
+
+// Compact binary form of an XML request, which IParser reads directly: its
+// tokens drive the schema and the handler building the transaction as the
+// XML text does, without the text being produced or scanned.
+//
+// The document is a sequence of tokens following a four byte header
+// ("TBX" and the format version):
+//   1 - start of an element: name
+//   2 - attribute of the current element: name, value
+//   3 - text: value, with XML entities
+//   4 - end of the current element
+//   5 - CDATA section: value
+// A value is its length as a varint followed by the bytes. A name is a varint
+// reference to the names already seen in the document (1 - the first one),
+// or 0 followed by a new name as a value, so that each element and attribute
+// name is sent once. Values are kept as in the XML text, the schema decodes
+// the entities as it does for XML.
+//
+// Comments, processing instructions and formatting white space are not kept.
+namespace IBinaryXML
+{
+const unsigned char _version = 1;
+
+// false if xml is not well formed
+bool
+encode(const char* xml, size_t length, std::string& binary);
+bool
+encode(const std::string& xml, std::string& binary);
+
+bool
+isBinary(const char* data, size_t length);
+
+// Reports the document to the schema and the handler as IParser::parse
+// does for XML; throws std::runtime_error if it is not a valid document of
+// a known version.
+void
+parse(const char* binary, size_t length, IBaseHandler& handler, const ISchemaBase& schema);
+}
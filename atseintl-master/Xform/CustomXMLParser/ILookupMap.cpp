@@ -0,0 +1,127 @@
+#include "Xform/CustomXMLParser/ILookupMap.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+  // seeds tried for a bucket before the table is made larger
+  const uint32_t _maxSeed(1u << 16);
+
+  size_t _powerOf2 (size_t n)
+  {
+    size_t result(1);
+    while (result < n)
+    {
+      result <<= 1;
+    }
+    return result;
+  }
+}
+
+ILookupMap::ILookupMap ()
+  : _bucketMask(0)
+  , _slotMask(0)
+{
+}
+
+void ILookupMap::insert (const char *name,
+                         size_t length,
+                         int idx)
+{
+  for (Entry &entry : _entries)
+  {
+    if (entry._length == length && 0 == memcmp(entry._name, name, length))
+    {
+      entry._idx = idx;
+      return;
+    }
+  }
+  Entry entry = { name, length, idx };
+  _entries.push_back(entry);
+}
+
+void ILookupMap::build ()
+{
+  _seeds.clear();
+  _slots.clear();
+  if (_entries.empty())
+  {
+    return;
+  }
+  const size_t bucketCount(_powerOf2((_entries.size() + 1) / 2));
+  size_t slotCount(_powerOf2(_entries.size()));
+  while (!place(bucketCount, slotCount))
+  {
+    slotCount <<= 1;
+    if (slotCount > (_entries.size() << 6))
+    {
+      throw std::runtime_error("unable to build the schema name lookup");
+    }
+  }
+}
+
+bool ILookupMap::place (size_t bucketCount,
+                        size_t slotCount)
+{
+  _bucketMask = bucketCount - 1;
+  _slotMask = slotCount - 1;
+  _seeds.assign(bucketCount, 0);
+  Entry empty = { nullptr, 0, -1 };
+  _slots.assign(slotCount, empty);
+
+  std::vector<std::vector<const Entry *> > buckets(bucketCount);
+  for (const Entry &entry : _entries)
+  {
+    buckets[hash(entry._name, entry._length, 0) & _bucketMask].push_back(&entry);
+  }
+  // the largest buckets first, while most of the slots are free
+  std::vector<size_t> order(bucketCount);
+  for (size_t i = 0; i < bucketCount; ++i)
+  {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(),
+                   order.end(),
+                   [&buckets](size_t a, size_t b)
+                   { return buckets[a].size() > buckets[b].size(); });
+
+  std::vector<size_t> positions;
+  for (size_t b : order)
+  {
+    const std::vector<const Entry *> &bucket(buckets[b]);
+    if (bucket.empty())
+    {
+      break;
+    }
+    uint32_t seed(1);
+    for (; seed < _maxSeed; ++seed)
+    {
+      positions.clear();
+      for (const Entry *entry : bucket)
+      {
+        const size_t pos(hash(entry->_name, entry->_length, seed) & _slotMask);
+        if (_slots[pos]._name != nullptr
+            || std::find(positions.begin(), positions.end(), pos) != positions.end())
+        {
+          break;
+        }
+        positions.push_back(pos);
+      }
+      if (positions.size() == bucket.size())
+      {
+        break;
+      }
+    }
+    if (seed == _maxSeed)
+    {
+      return false;
+    }
+    _seeds[b] = seed;
+    for (size_t i = 0; i < bucket.size(); ++i)
+    {
+      _slots[positions[i]] = *bucket[i];
+    }
+  }
+  return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Xform/CustomXMLParser/ICString.h"
+
+#include <cstring>
+#include <vector>
+
+#include <stdint.h>
+
+// Maps the element or attribute names of a schema to their indices.
+//
+// The names are known when the handler is initialized, so instead of a hash
+// map the lookup uses a perfect hash built from them (hash and displace): the
+// first hash of a name selects a bucket, the seed stored for the bucket gives
+// the second hash, which is the slot of the name. A lookup is then two hashes
+// of the name and one comparison, without chains or probing.
+//
+// insert() the names, then build() the table; find() returns -1 for names
+// which are not in the schema.
+class ILookupMap
+{
+public:
+  ILookupMap ();
+
+  // the name is not copied, it must outlive the map
+  void insert (const char *name,
+               size_t length,
+               int idx);
+  void build ();
+
+  int find (const char *name,
+            size_t length) const
+  {
+    if (UNLIKELY(_slots.empty()))
+    {
+      return -1;
+    }
+    const uint64_t h(hash(name, length, 0));
+    const uint32_t seed(_seeds[h & _bucketMask]);
+    const Entry &entry(_slots[hash(name, length, seed) & _slotMask]);
+    if (entry._length == length
+        && entry._name != nullptr
+        && 0 == memcmp(entry._name, name, length))
+    {
+      return entry._idx;
+    }
+    return -1;
+  }
+  int find (const IKeyString &name) const
+  {
+    return find(name.c_str(), name.length());
+  }
+  size_t size () const
+  {
+    return _entries.size();
+  }
+
+  static uint64_t hash (const char *name,
+                        size_t length,
+                        uint32_t seed)
+  {
+    // FNV-1a, the names are a few characters long
+    uint64_t h(0xcbf29ce484222325ULL ^ (uint64_t(seed) * 0x9e3779b97f4a7c15ULL));
+    for (size_t i = 0; i < length; ++i)
+    {
+      h = (h ^ uint8_t(name[i])) * 0x100000001b3ULL;
+    }
+    return h ^ (h >> 29);
+  }
+
+private:
+  struct Entry
+  {
+    const char *_name;
+    size_t _length;
+    int _idx;
+  };
+
+  bool place (size_t bucketCount,
+              size_t slotCount);
+
+  std::vector<Entry> _entries;
+  std::vector<uint32_t> _seeds;
+  std::vector<Entry> _slots;
+  uint64_t _bucketMask;
+  uint64_t _slotMask;
+};
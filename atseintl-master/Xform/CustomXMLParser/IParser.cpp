@@ -1,5 +1,7 @@
 #include "Xform/CustomXMLParser/IParser.h"
 
+#include "Xform/CustomXMLParser/IBinaryXML.h"
+#include "Xform/CustomXMLParser/IScanner.h"
 #include "Xform/CustomXMLParser/ISchemaBase.h"
 #include "Util/BranchPrediction.h"
 
@@ -20,46 +22,26 @@ const size_t _npos(std::string::npos),
              _comEndLength(strlen(_COMMENT_END));
 namespace
 {
+  const IScanner::ICharSet _chars1(_CHARS1),
+                           _chars2(_CHARS2),
+                           // null characters are skipped as white space
+                           _whiteOrNull(_WHITE, sizeof(_WHITE));
   inline const char *_find (const char *buffer,
                             const char * const bufferEnd,
                             char ch)
   {
-    const char *pCh(buffer);
-    for (; pCh < bufferEnd && *pCh != ch; ++pCh);
-    return pCh;
+    return IScanner::find(buffer, bufferEnd, ch);
   }
   inline const char *_find_first_of (const char *buffer,
                                      const char *bufferEnd,
-                                     const char * const chrs)
+                                     const IScanner::ICharSet &chrs)
   {
-    const char *pChar(buffer);
-    for (; pChar < bufferEnd; ++pChar)
-    {
-      const char *pCh(chrs);
-      char r(0);
-      for (char chCurr(*pChar); (r = *pCh) != 0 && chCurr != r; ++pCh);
-      if (r != 0)
-      {
-        break;
-      }
-    }
-    return pChar;
+    return IScanner::findFirstOf(buffer, bufferEnd, chrs);
   }
   inline const char *_find_first_not_white (const char *buffer,
                                             const char *bufferEnd)
   {
-    const char *pChar(buffer);
-    for (; pChar < bufferEnd; ++pChar)
-    {
-      const char *sep(_WHITE);
-            char r(0);
-            for (char chCurr(*pChar); (r = *sep) != 0 && chCurr != r; ++sep);
-      if (0 == r && *pChar != 0)
-      {
-        break;
-      }
-    }
-    return pChar;
+    return IScanner::findFirstNotOf(buffer, bufferEnd, _whiteOrNull);
   }
   inline const char *_find_last_not_white (const char *bufferLast,
                                            const char *bufferFirst)
@@ -208,7 +190,7 @@ size_t IParser::parseTag () const
       startElement = false;
       endElement = true;
     }
-    index = _find_first_of(index, bufferEnd, _CHARS1);
+    index = _find_first_of(index, bufferEnd, _chars1);
     if (UNLIKELY(bufferEnd == index))
     {
       throwXMLError(INCOMPLETEXML, buffer, length);
@@ -275,7 +257,7 @@ size_t IParser::parseTag () const
         {
           throwXMLError(NOWHITESPACEBETWEENATTRIBUTES, buffer, length);
         }
-        if (UNLIKELY(bufferEnd == (index = _find_first_of(first + 1, bufferEnd, _CHARS2))))
+        if (UNLIKELY(bufferEnd == (index = _find_first_of(first + 1, bufferEnd, _chars2))))
         {
           throwXMLError(INVALIDATTRIBUTEFORMAT, buffer, length);
         }
@@ -364,6 +346,12 @@ size_t IParser::oncdata () const
 void IParser::parse ()
 {
   _index = 0;
+  if (IBinaryXML::isBinary(_source, _length))
+  {
+    IBinaryXML::parse(_source, _length, _handler, _schema);
+    _index = _length;
+    return;
+  }
   _schema.startDocument(_handler);
   parseOutComments();
   const char *end(_source + _length);
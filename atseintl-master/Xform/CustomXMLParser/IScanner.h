@@ -0,0 +1,206 @@
+#pragma once
+
+#include "Util/BranchPrediction.h"
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Structural character scanning for IParser.
+//
+// The request is scanned in blocks of 32 (AVX2) or 16 (SSE2) bytes: every
+// byte of the block is compared with each character of a small set at once
+// and the first match is taken from the resulting bit mask. The tail shorter
+// than a block, and builds without SSE2, use the scalar loops.
+namespace IScanner
+{
+// Set of up to 8 characters searched for together.
+class ICharSet
+{
+public:
+  explicit ICharSet (const char *chars)
+    : _size(0)
+  {
+    for (; chars[_size] != 0 && _size < MaxSize; ++_size)
+    {
+      _chars[_size] = chars[_size];
+    }
+  }
+  ICharSet (const char *chars,
+            size_t size)
+    : _size(size < MaxSize ? size : MaxSize)
+  {
+    memcpy(_chars, chars, _size);
+  }
+  bool contains (char c) const
+  {
+    for (size_t i = 0; i < _size; ++i)
+    {
+      if (_chars[i] == c)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+  size_t size () const
+  {
+    return _size;
+  }
+  char operator [] (size_t i) const
+  {
+    return _chars[i];
+  }
+  static const size_t MaxSize = 8;
+private:
+  char _chars[MaxSize];
+  size_t _size;
+};
+
+namespace detail
+{
+#if defined(__AVX2__)
+typedef __m256i IBlock;
+const size_t BlockSize = 32;
+inline IBlock load (const char *p)
+{
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+inline IBlock splat (char c)
+{
+  return _mm256_set1_epi8(c);
+}
+inline IBlock equal (IBlock a, IBlock b)
+{
+  return _mm256_cmpeq_epi8(a, b);
+}
+inline IBlock either (IBlock a, IBlock b)
+{
+  return _mm256_or_si256(a, b);
+}
+inline IBlock none ()
+{
+  return _mm256_setzero_si256();
+}
+inline unsigned mask (IBlock a)
+{
+  return unsigned(_mm256_movemask_epi8(a));
+}
+const unsigned FullMask = 0xffffffffu;
+#elif defined(__SSE2__)
+typedef __m128i IBlock;
+const size_t BlockSize = 16;
+inline IBlock load (const char *p)
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+inline IBlock splat (char c)
+{
+  return _mm_set1_epi8(c);
+}
+inline IBlock equal (IBlock a, IBlock b)
+{
+  return _mm_cmpeq_epi8(a, b);
+}
+inline IBlock either (IBlock a, IBlock b)
+{
+  return _mm_or_si128(a, b);
+}
+inline IBlock none ()
+{
+  return _mm_setzero_si128();
+}
+inline unsigned mask (IBlock a)
+{
+  return unsigned(_mm_movemask_epi8(a));
+}
+const unsigned FullMask = 0xffffu;
+#endif
+
+#if defined(__SSE2__)
+// Returns the first byte whose membership in set is 'member', or the start of
+// the last incomplete block.
+inline const char *scanBlocks (const char *p,
+                               const char * const end,
+                               const ICharSet &set,
+                               bool member)
+{
+  IBlock chars[ICharSet::MaxSize];
+  const size_t size(set.size());
+  for (size_t i = 0; i < size; ++i)
+  {
+    chars[i] = splat(set[i]);
+  }
+  const unsigned flip(member ? 0 : FullMask);
+  for (; end - p >= std::ptrdiff_t(BlockSize); p += BlockSize)
+  {
+    const IBlock block(load(p));
+    IBlock found(none());
+    for (size_t i = 0; i < size; ++i)
+    {
+      found = either(found, equal(block, chars[i]));
+    }
+    const unsigned bits(mask(found) ^ flip);
+    if (bits != 0)
+    {
+      return p + __builtin_ctz(bits);
+    }
+  }
+  return p;
+}
+#endif
+}
+
+// First occurrence of ch in [buffer, bufferEnd), bufferEnd if none.
+inline const char *find (const char *buffer,
+                         const char * const bufferEnd,
+                         char ch)
+{
+  if (UNLIKELY(buffer >= bufferEnd))
+  {
+    return buffer;
+  }
+  // vectorized by the C library
+  const void *found(memchr(buffer, ch, bufferEnd - buffer));
+  return found ? static_cast<const char *>(found) : bufferEnd;
+}
+
+// First character of [buffer, bufferEnd) in set, bufferEnd if none.
+inline const char *findFirstOf (const char *buffer,
+                                const char * const bufferEnd,
+                                const ICharSet &set)
+{
+  const char *pChar(buffer);
+#if defined(__SSE2__)
+  pChar = detail::scanBlocks(pChar, bufferEnd, set, true);
+#endif
+  for (; pChar < bufferEnd && !set.contains(*pChar); ++pChar);
+  return pChar;
+}
+
+// First character of [buffer, bufferEnd) not in set, bufferEnd if none.
+inline const char *findFirstNotOf (const char *buffer,
+                                   const char * const bufferEnd,
+                                   const ICharSet &set)
+{
+  const char *pChar(buffer);
+  // most of the runs of white space are short, try them first
+  for (size_t i = 0; pChar < bufferEnd && i < 4; ++i, ++pChar)
+  {
+    if (LIKELY(!set.contains(*pChar)))
+    {
+      return pChar;
+    }
+  }
+#if defined(__SSE2__)
+  pChar = detail::scanBlocks(pChar, bufferEnd, set, false);
+#endif
+  for (; pChar < bufferEnd && set.contains(*pChar); ++pChar);
+  return pChar;
+}
+}
@@ -44,10 +44,9 @@ void IXMLSchema::insertAttr (const char *pName,
   }
   if (LIKELY(_idx != -1))
   {
-    ILookupMap::const_iterator iter(_attrLookupMap.find(name));
-    if (_attrLookupMap.end() != iter)
+    const int idx(_attrLookupMap.find(pName, nameLength));
+    if (idx != -1)
     {
-      int idx(iter->second);
       IValueString &val = _attrValueArray[idx];
       if (UNLIKELY(!val.empty()))
       {
@@ -121,12 +120,7 @@ void IXMLSchema::newElement (const IKeyString &name) const
   {
     onStartElement(name);
   }
-  _idx = -1;
-  ILookupMap::const_iterator iter(_elemLookupMap.find(name));
-  if (iter != _elemLookupMap.end())
-  {
-    _idx = iter->second;
-  }
+  _idx = _elemLookupMap.find(name);
 }
 
 void IXMLSchema::clear () const
@@ -1,11 +1,8 @@
 #pragma once
 
+#include "Xform/CustomXMLParser/ILookupMap.h"
 #include "Xform/CustomXMLParser/ISchemaBase.h"
 
-#include <tr1/unordered_map>
-
-typedef std::tr1::unordered_map<IKeyString, int, IKeyStringHasher> ILookupMap;
-
 class IXMLSchema : public ISchemaBase
 {
  public:
@@ -48,9 +48,9 @@ initLookupMaps(const char* const elementNames[],
 
   for (int i = 0; i < numberOfElementNames - mapSize; i++, idx++)
   {
-    IKeyString nm(elementNames[i], strlen(elementNames[i]));
-    elemLookupMap[nm] = idx;
+    elemLookupMap.insert(elementNames[i], strlen(elementNames[i]), idx);
   }
+  elemLookupMap.build();
   return true;
 }
 
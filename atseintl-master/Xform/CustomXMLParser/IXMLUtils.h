@@ -1,14 +1,11 @@
 #pragma once
 
 #include "Xform/CustomXMLParser/ICString.h"
+#include "Xform/CustomXMLParser/ILookupMap.h"
 
 #include <ostream>
 #include <string>
 
-#include <tr1/unordered_map>
-
-typedef std::tr1::unordered_map<IKeyString, int, IKeyStringHasher> ILookupMap;
-
 namespace IXMLUtils
 {
 const char* const
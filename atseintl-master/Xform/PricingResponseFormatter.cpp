@@ -158,6 +158,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <sstream>
 #include <vector>
@@ -220,6 +221,26 @@ ConfigurableValue<uint32_t>
 maxTotalBuffSize("OUTPUT_LIMITS", "MAX_PSS_OUTPUT", DEFAULT_MAX_PSS_OUTPUT_SIZE);
 ConfigurableValue<uint16_t>
 maxNumberOfFees("SERVICE_FEES_SVC", "MAX_NUMBER_OF_FEES", 0);
+
+// The responses are built into a buffer reserved from the average size of the
+// recent ones, so that the long responses are not copied while growing.
+constexpr size_t MIN_RESPONSE_BUFFER_SIZE = 4096;
+std::atomic<size_t> averageResponseSize(MIN_RESPONSE_BUFFER_SIZE);
+
+size_t
+responseBufferSize()
+{
+  const size_t average = averageResponseSize.load(std::memory_order_relaxed);
+  return average + average / 4;
+}
+
+void
+updateResponseSize(size_t size)
+{
+  const size_t average = averageResponseSize.load(std::memory_order_relaxed);
+  averageResponseSize.store(std::max(MIN_RESPONSE_BUFFER_SIZE, (average * 7 + size) / 8),
+                            std::memory_order_relaxed);
+}
 }
 static const unsigned int AVAILABLE_SIZE_FOR_MSG = 204;
 static const char MAY_NOT_APPLY_TO_ALL_PASSENGERS = 'P';
@@ -503,6 +524,7 @@ inline const std::string&
 PricingResponseFormatter::logXmlData(const XMLConstruct& construct) const
 {
   LOG4CXX_INFO(logger, "Response in XML:\n" << construct.getXMLData());
+  updateResponseSize(construct.getXMLData().size());
   return construct.getXMLData();
 }
 
@@ -602,7 +624,7 @@ PricingResponseFormatter::formatResponse(const std::string& responseString,
       (pricingTrx.excTrxType() == PricingTrx::EXC1_WITHIN_ME) ||
       (pricingTrx.excTrxType() == PricingTrx::EXC2_WITHIN_ME))
   {
-    XMLConstruct construct;
+    XMLConstruct construct(responseBufferSize());
     appendCDataToResponse(pricingTrx, construct);
     formatPricingResponse(
         construct, responseString, displayOnly, pricingTrx, fareCalcCollector, tktErrCode);
@@ -621,7 +643,7 @@ PricingResponseFormatter::formatResponse(const std::string& responseString,
     return formatRexPricingResponse(
         responseString, static_cast<RexBaseTrx&>(pricingTrx), fareCalcCollector, tktErrCode);
 
-  XMLConstruct construct;
+  XMLConstruct construct(responseBufferSize());
 
   BaseExchangeTrx* anyRexTrx = dynamic_cast<BaseExchangeTrx*>(&pricingTrx);
   if (anyRexTrx)
@@ -701,7 +723,7 @@ PricingResponseFormatter::formatRexPricingResponse(
     FareCalcCollector* fareCalcCollector,
     ErrorResponseException::ErrorResponseCode tktErrCode)
 {
-  XMLConstruct construct;
+  XMLConstruct construct(responseBufferSize());
   construct.openElement("RexPricingResponse");
   construct.addAttribute(xml2::RequestType, trx.reqType());
 
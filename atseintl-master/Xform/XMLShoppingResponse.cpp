@@ -1506,7 +1506,7 @@ XMLShoppingResponse::formatBKK(const Itin& itin,
   const ShoppingUtil::ExternalSopId extId = ShoppingUtil::createExternalSopId(legId, sopId);
   const uint32_t bitmapNumber = ShoppingUtil::getFlightBitIndex(*_shoppingTrx, extId);
 
-  const PaxTypeFare::FlightBit& bitMap = fu.paxTypeFare()->flightBitmap()[bitmapNumber];
+  const auto bitMap = fu.paxTypeFare()->flightBitmap()[bitmapNumber];
 
   if (bitMap._segmentStatus.empty())
   {
@@ -1646,7 +1646,7 @@ XMLShoppingResponse::formatBKKAso(const Itin& itin,
       Node nodeSID(_writer, "SID");
       nodeSID.convertAttr("Q14", legNumber)
           .convertAttr("Q15", ShoppingUtil::findSopId(_trx, legNumber, sop));
-      const PaxTypeFare::FlightBit& bitMap = fu.paxTypeFare()->flightBitmap()[bitmapNumber];
+      const auto bitMap = fu.paxTypeFare()->flightBitmap()[bitmapNumber];
 
       const std::vector<TravelSeg*>& travelSeg = fu.travelSeg(); // lint !e530
       TSE_ASSERT(!travelSeg.empty());
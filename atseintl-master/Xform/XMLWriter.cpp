@@ -21,8 +21,6 @@
 #include "Common/Assert.h"
 #include "Util/BranchPrediction.h"
 
-#include <algorithm>
-
 namespace tse
 {
 
@@ -59,21 +57,30 @@ XMLWriter::startNode(const std::string& name)
 {
   enterNode();
 
-  _streams.top().append(_openElements.size() * 2, ' ');
-
-  std::string buf;
-  _streams.top() += "<" + escapeString(name, buf);
+  std::string& out = _streams.top();
+  out.append(_openElements.size() * 2, ' ');
+  out += '<';
+  appendEscaped(out, name);
   _openElements.push_back(name);
   _inStartElement = true;
 }
 
 void
 XMLWriter::addAttribute(const std::string& name, const std::string& value)
+{
+  addAttribute(name, value.data(), value.size());
+}
+
+void
+XMLWriter::addAttribute(const std::string& name, const char* value, size_t size)
 {
   TSE_ASSERT(_inStartElement);
-  std::string bufName, bufValue;
-  _streams.top() +=
-      " " + escapeString(name, bufName) + "=\"" + escapeString(value, bufValue) + '\"';
+  std::string& out = _streams.top();
+  out += ' ';
+  appendEscaped(out, name);
+  out += "=\"";
+  appendEscaped(out, value, size);
+  out += '\"';
 }
 
 void
@@ -91,8 +98,7 @@ XMLWriter::addText(const std::string& text)
 {
   enterNode();
 
-  std::string buf;
-  _streams.top() += escapeString(text, buf);
+  appendEscaped(_streams.top(), text);
 }
 
 void
@@ -106,8 +112,7 @@ XMLWriter::addSimpleText(const std::string& text)
     _inStartElement = false;
   }
 
-  std::string buf;
-  _streams.top() += escapeString(text, buf);
+  appendEscaped(_streams.top(), text);
 }
 
 void
@@ -140,18 +145,14 @@ XMLWriter::endNode()
   }
   else
   {
-    std::string buf;
-    if (LIKELY(_openElements.size() > 0))
-    {
-      if (!_simpleString)
-        for (size_t item = 0; item < _openElements.size() - 1; ++item)
-        {
-          _streams.top() += "  ";
-        }
-      else
-        _simpleString = false;
-    }
-    _streams.top() += "</" + escapeString(_openElements.back(), buf) + ">\n";
+    std::string& out = _streams.top();
+    if (!_simpleString)
+      out.append((_openElements.size() - 1) * 2, ' ');
+    else
+      _simpleString = false;
+    out += "</";
+    appendEscaped(out, _openElements.back());
+    out += ">\n";
   }
 
   _openElements.pop_back();
@@ -159,49 +160,41 @@ XMLWriter::endNode()
 
 namespace
 {
-
-const std::string escapeChars = "&<>";
-
-struct needsEscaping
+inline bool
+needsEscaping(const char c)
 {
-  bool operator()(const char c) const
-  {
-    return c == 0 || std::find(escapeChars.begin(), escapeChars.end(), c) != escapeChars.end();
-  }
-};
+  return c == '\0' || c == '<' || c == '>' || c == '&';
+}
 }
 
-const std::string&
-XMLWriter::escapeString(const std::string& str, std::string& buf)
+void
+XMLWriter::appendEscaped(std::string& out, const char* str, size_t size)
 {
-  if (LIKELY(std::find_if(str.begin(), str.end(), needsEscaping()) == str.end()))
+  const char* const end = str + size;
+  const char* run = str;
+  for (const char* p = str; p != end; ++p)
   {
-    return str;
-  }
+    if (LIKELY(!needsEscaping(*p)))
+      continue;
 
-  buf.clear();
-  for (const char elem : str)
-  {
-    switch (elem)
+    out.append(run, p);
+    run = p + 1;
+    switch (*p)
     {
-    case '\0':
-      break; // null characters get stripped
     case '<':
-      buf += "&lt;";
+      out += "&lt;";
       break;
     case '>':
-      buf += "&gt;";
+      out += "&gt;";
       break;
     case '&':
-      buf += "&amp;";
+      out += "&amp;";
       break;
     default:
-      buf.push_back(elem);
-      break;
+      break; // null characters get stripped
     }
   }
-
-  return buf;
+  out.append(run, end);
 }
 
 void
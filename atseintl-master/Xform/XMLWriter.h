@@ -20,10 +20,12 @@
 #pragma once
 
 #include "Common/Code.h"
+#include "Util/NumberFormat.h"
 
 #include <sstream>
 #include <stack>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace tse
@@ -97,12 +99,32 @@ public:
     // by being passed through a stringstream.
     template <typename T>
     XMLWriter::Node& convertAttr(const std::string& name, const T& value)
+    {
+      // the single byte types are streamed as characters
+      typedef std::integral_constant<bool, (std::is_integral<T>::value && sizeof(T) > 1)> IsNumber;
+      return convertAttr(name, value, IsNumber());
+    }
+
+  private:
+    template <typename T>
+    XMLWriter::Node& convertAttr(const std::string& name, const T& value, std::false_type)
     {
       std::ostringstream stream;
       stream << value;
       return attr(name, stream.str());
     }
 
+    // integers are formatted without a stream, the output is the same
+    template <typename T>
+    XMLWriter::Node& convertAttr(const std::string& name, const T& value, std::true_type)
+    {
+      char buf[number_format::IntegerBufferSize];
+      _writer.addAttribute(name, buf, number_format::formatInteger(value, buf));
+      return *this;
+    }
+
+  public:
+
     // function to add text as a child of this node.
     // pre-condition: this Node may not yet have any child nodes.
     XMLWriter::Node& addText(const std::string& text);
@@ -145,6 +167,7 @@ public:
 private:
   void startNode(const std::string& name);
   void addAttribute(const std::string& name, const std::string& value);
+  void addAttribute(const std::string& name, const char* value, size_t size);
   void enterNode();
   void addText(const std::string& text);
   void addSimpleText(const std::string& text);
@@ -152,7 +175,11 @@ private:
   void addRawText(const std::string& text);
   void endNode();
 
-  static const std::string& escapeString(const std::string& str, std::string& buf);
+  static void appendEscaped(std::string& out, const char* str, size_t size);
+  static void appendEscaped(std::string& out, const std::string& str)
+  {
+    appendEscaped(out, str.data(), str.size());
+  }
 
   void openSubDocument();
   void closeSubDocument();
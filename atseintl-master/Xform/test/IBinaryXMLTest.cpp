@@ -0,0 +1,185 @@
+#include "test/include/CppUnitHelperMacros.h"
+
+#include "Xform/CustomXMLParser/IBaseHandler.h"
+#include "Xform/CustomXMLParser/IBinaryXML.h"
+#include "Xform/CustomXMLParser/IParser.h"
+#include "Xform/CustomXMLParser/ISchemaBase.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace tse
+{
+namespace
+{
+// logs the events which build a transaction from the request
+class RecordingHandler : public IBaseHandler
+{
+public:
+  bool startElement(const IKeyString& name, const IAttributes&) override
+  {
+    _log << '<' << std::string(name.c_str(), name.length()) << _attrs.str() << ">\n";
+    _attrs.str(std::string());
+    return true;
+  }
+  void characters(const char* value, size_t length) override
+  {
+    _log << "text:" << std::string(value, length) << '\n';
+  }
+  bool endElement(const IKeyString& name) override
+  {
+    _log << "</" << std::string(name.c_str(), name.length()) << ">\n";
+    return true;
+  }
+  bool startElement(int, const IAttributes&) override { return true; }
+  bool endElement(int) override { return true; }
+
+  std::string log() const { return _log.str(); }
+
+  std::ostringstream _attrs;
+
+private:
+  std::ostringstream _log;
+};
+
+// the attributes as the handler gets them, decoded
+class RecordingSchema : public ISchemaBase
+{
+public:
+  explicit RecordingSchema(RecordingHandler& handler) : ISchemaBase(true), _handler(handler) {}
+
+  void insertAttr(const char* name,
+                  size_t nameLength,
+                  const char* value,
+                  size_t valueLength) const override
+  {
+    ISchemaBase::insertAttr(name, nameLength, value, valueLength);
+    decode(value, valueLength);
+    _handler._attrs << ' ' << std::string(name, nameLength) << "=\""
+                    << std::string(value, valueLength) << '"';
+  }
+
+private:
+  RecordingHandler& _handler;
+};
+
+std::string
+readFile(const std::string& name)
+{
+  std::ifstream input(name.c_str());
+  std::ostringstream content;
+  content << input.rdbuf();
+  return content.str();
+}
+
+std::string
+events(const std::string& request)
+{
+  RecordingHandler handler;
+  RecordingSchema schema(handler);
+  IParser parser(request, handler, schema);
+  parser.parse();
+  return handler.log();
+}
+}
+
+class IBinaryXMLTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(IBinaryXMLTest);
+  CPPUNIT_TEST(testRoundTrip);
+  CPPUNIT_TEST(testRoundTripSampleRequests);
+  CPPUNIT_TEST(testEncodeMalformed);
+  CPPUNIT_TEST(testParseMalformed);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testRoundTrip()
+  {
+    const std::string request("<?xml version=\"1.0\"?>\n"
+                              "<!-- comment -->\n"
+                              "<ShoppingRequest A=\"1\" B='a &amp; b'>\n"
+                              "  <LEG Q14=\"0\"/><LEG Q14=\"1\"/>\n"
+                              "  <TXT>&lt;text&gt;</TXT>\n"
+                              "  <![CDATA[<raw>]]>\n"
+                              "</ShoppingRequest>\n");
+    std::string binary;
+    CPPUNIT_ASSERT(IBinaryXML::encode(request, binary));
+    CPPUNIT_ASSERT(IBinaryXML::isBinary(binary.data(), binary.size()));
+    CPPUNIT_ASSERT(!IBinaryXML::isBinary(request.data(), request.size()));
+    CPPUNIT_ASSERT(binary.size() < request.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("<ShoppingRequest A=\"1\" B=\"a & b\">\n"
+                                     "<LEG Q14=\"0\">\n</LEG>\n"
+                                     "<LEG Q14=\"1\">\n</LEG>\n"
+                                     "<TXT>\ntext:<text>\n</TXT>\n"
+                                     "text:<raw>\n"
+                                     "</ShoppingRequest>\n"),
+                         events(binary));
+  }
+
+  // the handlers build the same transaction from the binary form of a request
+  void testRoundTripSampleRequests()
+  {
+    const char* const files[] = {"XformClientShoppingXML1.xml",
+                                 "pricing_req_test1.xml",
+                                 "pricing_req_test2.xml",
+                                 "request02BD09.xml",
+                                 "selectionReqMissingObfInMainSection.xml",
+                                 "selectionReqObfInMainSection.xml",
+                                 "selectionReqObfInSumSection.xml",
+                                 "shopping_request.xml",
+                                 "wpdf_dtl_test1.xml",
+                                 "wpdf_dtl_test2.xml",
+                                 "wpdf_dtl_test3.xml",
+                                 "wpdf_dtl_test4.xml"};
+    for (const char* file : files)
+    {
+      const std::string request = readFile(file);
+      if (request.empty())
+        continue;
+
+      std::string expected;
+      try
+      {
+        expected = events(request);
+      }
+      catch (const std::exception&)
+      {
+        // not a request the parser accepts
+        continue;
+      }
+      std::string binary;
+      CPPUNIT_ASSERT_MESSAGE(file, IBinaryXML::encode(request, binary));
+      CPPUNIT_ASSERT_EQUAL_MESSAGE(file, expected, events(binary));
+    }
+  }
+
+  void testEncodeMalformed()
+  {
+    std::string binary("x");
+    CPPUNIT_ASSERT(!IBinaryXML::encode(std::string("<A><B></A>"), binary));
+    CPPUNIT_ASSERT(binary.empty());
+    CPPUNIT_ASSERT(!IBinaryXML::encode(std::string("<A>&bad;</A>"), binary));
+  }
+
+  void testParseMalformed()
+  {
+    std::string binary;
+    CPPUNIT_ASSERT(IBinaryXML::encode(std::string("<A B=\"1\"><C/></A>"), binary));
+
+    // truncated, the elements are not closed
+    const std::string truncated(binary.substr(0, binary.size() - 2));
+    CPPUNIT_ASSERT_THROW(events(truncated), std::runtime_error);
+    // unknown name reference
+    std::string badName(binary);
+    badName[5] = char(9);
+    CPPUNIT_ASSERT_THROW(events(badName), std::runtime_error);
+    // unknown version
+    std::string badVersion(binary);
+    badVersion[3] = char(IBinaryXML::_version + 1);
+    CPPUNIT_ASSERT_THROW(events(badVersion), std::runtime_error);
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(IBinaryXMLTest);
+}
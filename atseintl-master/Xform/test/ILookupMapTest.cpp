@@ -0,0 +1,101 @@
+#include "test/include/CppUnitHelperMacros.h"
+
+#include "Xform/CustomXMLParser/ILookupMap.h"
+#include "Xform/CustomXMLParser/IXMLUtils.h"
+#include "Xform/ShoppingSchemaNames.h"
+
+#include <cstring>
+#include <string>
+
+namespace tse
+{
+class ILookupMapTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ILookupMapTest);
+  CPPUNIT_TEST(testEmpty);
+  CPPUNIT_TEST(testShoppingNames);
+  CPPUNIT_TEST(testUnknownNames);
+  CPPUNIT_TEST(testDuplicateName);
+  CPPUNIT_TEST(testAdditionalNames);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testEmpty()
+  {
+    ILookupMap map;
+    CPPUNIT_ASSERT_EQUAL(-1, map.find("FGG", 3));
+    map.build();
+    CPPUNIT_ASSERT_EQUAL(-1, map.find("FGG", 3));
+  }
+
+  void testShoppingNames()
+  {
+    ILookupMap elements, attributes;
+    IXMLUtils::initLookupMaps(shopping::shoppingElementNames,
+                              shopping::_NumberElementNames_,
+                              elements,
+                              shopping::shoppingAttributeNames,
+                              shopping::_NumberAttributeNames_,
+                              attributes);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(shopping::_NumberElementNames_), elements.size());
+    for (int i = 0; i < shopping::_NumberElementNames_; ++i)
+    {
+      const char* name = shopping::shoppingElementNames[i];
+      CPPUNIT_ASSERT_EQUAL(i, elements.find(name, strlen(name)));
+    }
+    for (int i = 0; i < shopping::_NumberAttributeNames_; ++i)
+    {
+      // the arrays may contain a name twice, the last index is kept
+      const char* name = shopping::shoppingAttributeNames[i];
+      const int idx = attributes.find(name, strlen(name));
+      CPPUNIT_ASSERT(idx >= i);
+      CPPUNIT_ASSERT(strcmp(name, shopping::shoppingAttributeNames[idx]) == 0);
+    }
+    CPPUNIT_ASSERT_EQUAL(int(shopping::_LEG), elements.find(IKeyString("LEG", 3)));
+  }
+
+  void testUnknownNames()
+  {
+    ILookupMap map;
+    map.insert("ABC", 3, 0);
+    map.insert("ABD", 3, 1);
+    map.insert("ShoppingRequest", 15, 2);
+    map.build();
+
+    CPPUNIT_ASSERT_EQUAL(-1, map.find("ABE", 3));
+    CPPUNIT_ASSERT_EQUAL(-1, map.find("AB", 2));
+    CPPUNIT_ASSERT_EQUAL(-1, map.find("ABCD", 4));
+    CPPUNIT_ASSERT_EQUAL(-1, map.find("", 0));
+    CPPUNIT_ASSERT_EQUAL(-1, map.find("Shopping", 8));
+    CPPUNIT_ASSERT_EQUAL(2, map.find("ShoppingRequest", 15));
+  }
+
+  void testDuplicateName()
+  {
+    ILookupMap map;
+    map.insert("ABC", 3, 0);
+    map.insert("ABC", 3, 5);
+    map.build();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), map.size());
+    CPPUNIT_ASSERT_EQUAL(5, map.find("ABC", 3));
+  }
+
+  void testAdditionalNames()
+  {
+    const char* names[] = {"A", "B", "C"};
+    const char* additional[] = {"D", "E", "F", "G", "H"};
+    ILookupMap map;
+    IXMLUtils::initLookupMaps(names, 3, map);
+    IXMLUtils::initLookupMaps(additional, 5, map);
+
+    // as with the hash map before, only the names past the current size are added
+    CPPUNIT_ASSERT_EQUAL(size_t(5), map.size());
+    CPPUNIT_ASSERT_EQUAL(2, map.find("C", 1));
+    CPPUNIT_ASSERT_EQUAL(3, map.find("D", 1));
+    CPPUNIT_ASSERT_EQUAL(4, map.find("E", 1));
+    CPPUNIT_ASSERT_EQUAL(-1, map.find("F", 1));
+  }
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(ILookupMapTest);
+}
@@ -0,0 +1,170 @@
+#include "test/include/CppUnitHelperMacros.h"
+
+#include "Xform/CustomXMLParser/IBaseHandler.h"
+#include "Xform/CustomXMLParser/IParser.h"
+#include "Xform/CustomXMLParser/IScanner.h"
+#include "Xform/CustomXMLParser/ISchemaBase.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace tse
+{
+namespace
+{
+const char*
+naiveFirstOf(const char* p, const char* end, const char* chars, size_t size)
+{
+  for (; p < end && std::find(chars, chars + size, *p) == chars + size; ++p)
+    ;
+  return p;
+}
+
+const char*
+naiveFirstNotOf(const char* p, const char* end, const char* chars, size_t size)
+{
+  for (; p < end && std::find(chars, chars + size, *p) != chars + size; ++p)
+    ;
+  return p;
+}
+
+class CountingHandler : public IBaseHandler
+{
+public:
+  bool startElement(const IKeyString&, const IAttributes&) override
+  {
+    ++_elements;
+    return true;
+  }
+  void characters(const char*, size_t length) override { _characters += length; }
+  bool endElement(const IKeyString&) override { return true; }
+  bool startElement(int, const IAttributes&) override { return true; }
+  bool endElement(int) override { return true; }
+
+  size_t _elements = 0;
+  size_t _characters = 0;
+};
+
+std::string
+readFile(const std::string& name)
+{
+  std::ifstream input(name.c_str());
+  std::ostringstream content;
+  content << input.rdbuf();
+  return content.str();
+}
+}
+
+class IScannerTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(IScannerTest);
+  CPPUNIT_TEST(testFind);
+  CPPUNIT_TEST(testFindFirstOf);
+  CPPUNIT_TEST(testFindFirstNotOf);
+  CPPUNIT_TEST(testParse);
+  CPPUNIT_TEST(testParseSampleRequests);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp()
+  {
+    std::srand(17);
+    // mostly letters and white space, with a structural character now and then
+    const char alphabet[] = "abcdefgh    \n\t\r=/>\"<";
+    _text.resize(1000);
+    for (char& c : _text)
+      c = alphabet[std::rand() % (sizeof(alphabet) - 1)];
+  }
+
+  void testFind()
+  {
+    for (size_t first = 0; first < 40; ++first)
+      for (size_t last = first; last < _text.size(); last += 7)
+      {
+        const char* begin = _text.data() + first;
+        const char* end = _text.data() + last;
+        CPPUNIT_ASSERT_EQUAL(naiveFirstOf(begin, end, "<", 1), IScanner::find(begin, end, '<'));
+      }
+  }
+
+  void testFindFirstOf()
+  {
+    const char chars[] = " \n\t/>\r";
+    const IScanner::ICharSet set(chars);
+    for (size_t first = 0; first < 40; ++first)
+      for (size_t last = first; last < _text.size(); last += 7)
+      {
+        const char* begin = _text.data() + first;
+        const char* end = _text.data() + last;
+        CPPUNIT_ASSERT_EQUAL(naiveFirstOf(begin, end, chars, sizeof(chars) - 1),
+                             IScanner::findFirstOf(begin, end, set));
+      }
+  }
+
+  void testFindFirstNotOf()
+  {
+    std::string text(_text);
+    // long runs of white space and nulls, as in formatted requests
+    text.replace(100, 300, std::string(300, ' '));
+    text.replace(200, 50, std::string(50, '\0'));
+
+    const char chars[] = " \n\t\r";
+    const IScanner::ICharSet set(chars, sizeof(chars));
+    for (size_t first = 0; first < 400; first += 3)
+      for (size_t last = first; last < text.size(); last += 11)
+      {
+        const char* begin = text.data() + first;
+        const char* end = text.data() + last;
+        CPPUNIT_ASSERT_EQUAL(naiveFirstNotOf(begin, end, chars, sizeof(chars)),
+                             IScanner::findFirstNotOf(begin, end, set));
+      }
+  }
+
+  void testParse()
+  {
+    const std::string request("<?xml version=\"1.0\"?>\n"
+                              "<!-- comment -->\n"
+                              "<ShoppingRequest   A=\"1\"\tB = 'two' >\n"
+                              "  <LEG Q14=\"0\" Q15=\"1234567890123456789012345678901234\"/>\n"
+                              "  <TXT>   some text that is longer than one block   </TXT>\n"
+                              "  <![CDATA[<raw>]]>\n"
+                              "</ShoppingRequest>\n");
+    CountingHandler handler;
+    IParser parser(request, handler, true);
+    parser.parse();
+    CPPUNIT_ASSERT_EQUAL(size_t(3), handler._elements);
+    CPPUNIT_ASSERT_EQUAL(strlen("some text that is longer than one block") + strlen("<raw>"),
+                         handler._characters);
+  }
+
+  // every element start tag of the sample requests reaches the handler
+  void testParseSampleRequests()
+  {
+    const char* const files[] = {"shopping_request.xml", "XformClientShoppingXML1.xml"};
+    for (const char* file : files)
+    {
+      const std::string request = readFile(file);
+      if (request.empty())
+        continue;
+
+      size_t startTags = 0;
+      for (size_t pos = request.find('<'); pos != std::string::npos; pos = request.find('<', pos + 1))
+        if (pos + 1 < request.size() && std::isalpha(static_cast<unsigned char>(request[pos + 1])))
+          ++startTags;
+
+      CountingHandler handler;
+      IParser parser(request, handler);
+      parser.parse();
+      CPPUNIT_ASSERT(startTags > 0);
+      CPPUNIT_ASSERT_EQUAL(startTags, handler._elements);
+    }
+  }
+
+private:
+  std::string _text;
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(IScannerTest);
+}
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include "Common/XMLConstruct.h"
 #include "test/include/CppUnitHelperMacros.h"
 
@@ -10,6 +11,11 @@ class XMLConstructTest : public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(XMLConstructTest);
   CPPUNIT_TEST(testOpenElement);
   CPPUNIT_TEST(testAddAttribute);
+  CPPUNIT_TEST(testAddAttributeStringName);
+  CPPUNIT_TEST(testAddAttributeInteger);
+  CPPUNIT_TEST(testAddAttributeDouble);
+  CPPUNIT_TEST(testAddAttributeDoubleLong);
+  CPPUNIT_TEST(testAddAttributeEmpty);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -62,6 +68,78 @@ public:
     // std::cerr << xml.getXMLData() << std::endl;
     CPPUNIT_ASSERT(xml.getXMLData() == "<Foo Foz=\"foz\"><Bar Baz=\"baz\" Boz=\"boz\"/></Foo>");
   }
+
+  void testAddAttributeStringName()
+  {
+    const std::string foo("Foo"), foz("Foz"), baz("Baz");
+    XMLConstruct xml;
+    xml.openElement(foo);
+    xml.addAttribute(foz, std::string("foz"));
+    xml.addAttributeInteger(baz, 12);
+    xml.closeElement();
+    CPPUNIT_ASSERT(xml.isWellFormed());
+    CPPUNIT_ASSERT_EQUAL(std::string("<Foo Foz=\"foz\" Baz=\"12\"/>"), xml.getXMLData());
+  }
+
+  void testAddAttributeInteger()
+  {
+    XMLConstruct xml;
+    xml.openElement("Foo");
+    xml.addAttributeShort("S", int16_t(-32768));
+    xml.addAttributeUShort("U", uint16_t(65535));
+    xml.addAttributeInteger("I", 0);
+    xml.addAttributeUInteger("J", 4294967295u);
+    xml.addAttributeLong("L", INT64_MIN);
+    xml.addAttributeULong("M", UINT64_MAX);
+    xml.closeElement();
+    CPPUNIT_ASSERT_EQUAL(std::string("<Foo S=\"-32768\" U=\"65535\" I=\"0\" J=\"4294967295\" "
+                                     "L=\"-9223372036854775808\" M=\"18446744073709551615\"/>"),
+                         xml.getXMLData());
+  }
+
+  void testAddAttributeDouble()
+  {
+    XMLConstruct xml;
+    xml.openElement("Foo");
+    xml.addAttributeDouble("A", 0.0, 0);
+    xml.addAttributeDouble("B", 0.0, 2);
+    xml.addAttributeDouble("C", 123.456, 2);
+    xml.addAttributeDouble("D", -1.5, 0);
+    xml.addAttributeDouble("E", 1.25);
+    xml.addAttributeDouble("F", 0.0);
+    xml.addAttributeDouble("G", 5.0);
+    xml.closeElement();
+    CPPUNIT_ASSERT_EQUAL(std::string("<Foo A=\"0\" B=\"0.00\" C=\"123.46\" D=\"-2\" E=\"1.25\" "
+                                     "F=\"0\" G=\"5.\"/>"),
+                         xml.getXMLData());
+  }
+
+  void testAddAttributeDoubleLong()
+  {
+    std::ostringstream expected;
+    expected.setf(std::ios::fixed, std::ios::floatfield);
+    expected.precision(2);
+    expected << 1e300;
+
+    XMLConstruct xml;
+    xml.openElement("Foo");
+    xml.addAttributeDouble("A", 1e300, 2);
+    xml.closeElement();
+    CPPUNIT_ASSERT_EQUAL("<Foo A=\"" + expected.str() + "\"/>", xml.getXMLData());
+  }
+
+  void testAddAttributeEmpty()
+  {
+    XMLConstruct xml;
+    xml.openElement("Foo");
+    xml.addAttribute("A", "");
+    xml.addAttributeChar("B", 0);
+    xml.addAttributeChar("C", 'c');
+    xml.addAlsoEmptyAttribute(std::string("D"), std::string());
+    xml.addAttributeNoNull(std::string("E"), std::string());
+    xml.closeElement();
+    CPPUNIT_ASSERT_EQUAL(std::string("<Foo C=\"c\" D=\"\"/>"), xml.getXMLData());
+  }
 };
 CPPUNIT_TEST_SUITE_REGISTRATION(XMLConstructTest);
 }
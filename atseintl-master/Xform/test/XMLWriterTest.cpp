@@ -7,6 +7,8 @@ class XMLWriterTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(XMLWriterTest);
   CPPUNIT_TEST(testXMLWriter);
+  CPPUNIT_TEST(testConvertAttr);
+  CPPUNIT_TEST(testEscaping);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -47,6 +49,39 @@ public:
 
     CPPUNIT_ASSERT_EQUAL(expectedResult, writer.result());
   }
+
+  void testConvertAttr()
+  {
+    XMLWriter writer;
+    {
+      XMLWriter::Node node(writer, "n");
+      node.convertAttr("a", -12)
+          .convertAttr("b", uint64_t(18446744073709551615ull))
+          .convertAttr("c", int16_t(-32768))
+          .convertAttr("d", true)
+          .convertAttr("e", 'x')
+          .convertAttr("f", 1.5);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(std::string("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                                     "<n a=\"-12\" b=\"18446744073709551615\" c=\"-32768\" "
+                                     "d=\"1\" e=\"x\" f=\"1.5\"/>\n"),
+                         writer.result());
+  }
+
+  void testEscaping()
+  {
+    XMLWriter writer;
+    {
+      XMLWriter::Node node(writer, "n");
+      node.attr("a", std::string("<&>\0z", 5));
+      node.addSimpleText("x<y");
+    }
+
+    CPPUNIT_ASSERT_EQUAL(std::string("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                                     "<n a=\"&lt;&amp;&gt;z\">x&lt;y</n>\n"),
+                         writer.result());
+  }
 };
 CPPUNIT_TEST_SUITE_REGISTRATION(XMLWriterTest);
 }
@@ -0,0 +1,60 @@
+//----------------------------------------------------------------------------
+//  Copyright Sabre 2016
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//----------------------------------------------------------------------------
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+
+// Benchmarks are kept out of the unit test suites: they only report numbers
+// and their results depend on the machine. They are built into the utbench
+// program next to utexe and run by hand:
+//
+//   utbench              run all benchmarks
+//   utbench --list       list the benchmarks
+//   utbench Name ...     run the named benchmarks
+namespace tse
+{
+namespace benchmark
+{
+typedef void (*Function)(std::ostream& out);
+
+std::map<std::string, Function>& registry();
+
+struct Registrar
+{
+  Registrar(const char* name, Function function) { registry()[name] = function; }
+};
+
+class Stopwatch
+{
+public:
+  Stopwatch() : _start(std::chrono::steady_clock::now()) {}
+
+  double elapsedMicroseconds() const
+  {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - _start)
+        .count();
+  }
+
+private:
+  std::chrono::steady_clock::time_point _start;
+};
+}
+}
+
+#define TSE_BENCHMARK(name)                                                                        \
+  static void name(std::ostream& out);                                                             \
+  static const tse::benchmark::Registrar name##Registrar(#name, &name);                            \
+  static void name(std::ostream& out)
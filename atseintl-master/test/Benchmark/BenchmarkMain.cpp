@@ -0,0 +1,64 @@
+//----------------------------------------------------------------------------
+//  Copyright Sabre 2016
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//----------------------------------------------------------------------------
+#include "test/Benchmark/Benchmark.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace tse
+{
+namespace benchmark
+{
+std::map<std::string, Function>&
+registry()
+{
+  static std::map<std::string, Function> benchmarks;
+  return benchmarks;
+}
+}
+}
+
+int
+main(int argc, char* argv[])
+{
+  const std::map<std::string, tse::benchmark::Function>& benchmarks(tse::benchmark::registry());
+
+  if (argc > 1 && !std::strcmp(argv[1], "--list"))
+  {
+    for (const auto& benchmark : benchmarks)
+      std::cout << benchmark.first << std::endl;
+    return 0;
+  }
+
+  int failed(0);
+  for (const auto& benchmark : benchmarks)
+  {
+    bool selected(argc == 1);
+    for (int i = 1; i < argc && !selected; ++i)
+      selected = benchmark.first == argv[i];
+    if (!selected)
+      continue;
+
+    std::cout << benchmark.first << std::endl;
+    try
+    {
+      benchmark.second(std::cout);
+    }
+    catch (const std::exception& e)
+    {
+      std::cout << "  failed: " << e.what() << std::endl;
+      ++failed;
+    }
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,33 @@
+//----------------------------------------------------------------------------
+//  Copyright Sabre 2016
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "DBAccess/DiskCache.h"
+#include "test/include/MockDataManager.h"
+#include "test/include/TestConfigInitializer.h"
+
+namespace tse
+{
+namespace benchmark
+{
+// The configuration the cache types read on construction, as in their unit tests.
+class CacheEnvironment : public TestConfigInitializer
+{
+public:
+  CacheEnvironment() { DiskCache::initialize(_config); }
+
+private:
+  MockDataManager _dataManager;
+};
+}
+}
@@ -0,0 +1,136 @@
+//----------------------------------------------------------------------------
+//  Copyright Sabre 2016
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//----------------------------------------------------------------------------
+#include "Common/TseCodeTypes.h"
+#include "DBAccess/PerfectHash.h"
+#include "DBAccess/SimpleCache.h"
+#include "test/Benchmark/Benchmark.h"
+#include "test/Benchmark/CacheEnvironment.h"
+
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace tse
+{
+namespace
+{
+class LocFactory : public sfc::KeyedFactory<LocCode, std::string>
+{
+public:
+  std::string* create(LocCode key) override { return new std::string(key.c_str()); }
+
+  void destroy(LocCode key, std::string* object) override { delete object; }
+};
+
+// All three letter city/airport codes plus five letter codes, about the size
+// of the production Loc table.
+void
+locCodes(std::vector<LocCode>& codes)
+{
+  char code[6] = {};
+  for (code[0] = 'A'; code[0] <= 'Z'; ++code[0])
+    for (code[1] = 'A'; code[1] <= 'Z'; ++code[1])
+      for (code[2] = 'A'; code[2] <= 'Z'; ++code[2])
+      {
+        code[3] = 0;
+        codes.push_back(LocCode(code));
+      }
+  for (int i = 0; i < 20000; ++i)
+  {
+    code[0] = 'A' + i % 26;
+    code[1] = 'A' + i / 26 % 26;
+    code[2] = '0' + i / 676 % 10;
+    code[3] = '0' + i / 6760 % 10;
+    code[4] = 0;
+    codes.push_back(LocCode(code));
+  }
+  std::sort(codes.begin(), codes.end());
+  codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+}
+
+template <typename CacheType>
+void
+lookupAll(CacheType& cache, const std::vector<LocCode>& codes, int rounds, size_t& found)
+{
+  for (int round = 0; round < rounds; ++round)
+  {
+    for (const LocCode& code : codes)
+    {
+      found += cache.get(code) ? 1 : 0;
+    }
+  }
+}
+
+// lookups per microsecond with numThreads threads reading every code
+template <typename CacheType>
+double
+lookupsPerMicrosecond(CacheType& cache, const std::vector<LocCode>& codes, int numThreads)
+{
+  const int ROUNDS(20);
+  std::vector<size_t> found(numThreads, 0);
+  std::vector<boost::thread> threads(numThreads);
+  const benchmark::Stopwatch stopwatch;
+  for (int i = 0; i < numThreads; ++i)
+  {
+    threads[i] = boost::thread(
+        [&cache, &codes, &found, i]() { lookupAll(cache, codes, ROUNDS, found[i]); });
+  }
+  for (int i = 0; i < numThreads; ++i)
+  {
+    threads[i].join();
+    if (found[i] != codes.size() * ROUNDS)
+      throw std::runtime_error("lookup missed a loaded code");
+  }
+  return static_cast<double>(codes.size()) * ROUNDS * numThreads /
+         std::max(1.0, stopwatch.elapsedMicroseconds());
+}
+}
+
+// Lookup rate and index memory of the frozen snapshot against the SimpleCache
+// used for Loc today.
+TSE_BENCHMARK(FrozenCacheLocLookup)
+{
+  benchmark::CacheEnvironment environment;
+  LocFactory factory;
+  std::vector<LocCode> codes;
+  locCodes(codes);
+
+  sfc::SimpleCache<LocCode, std::string> before(factory, "Loc", 0, 1);
+  FrozenCache<LocCode, std::string> after(factory, "Loc", 0, 1);
+  for (const LocCode& code : codes)
+  {
+    before.get(code);
+    after.get(code);
+  }
+  after.consolidate(0);
+  if (after.frozenSize() != codes.size())
+    throw std::runtime_error("not all codes were frozen");
+
+  // node based map: key, pointer, next pointer, cached hash and the bucket
+  const size_t nodeMapBytes(codes.size() * (sizeof(LocCode) + 3 * sizeof(void*)) +
+                            codes.size() * sizeof(void*));
+  out << "  " << codes.size() << " Loc codes, index bytes: SimpleCache ~" << nodeMapBytes
+      << ", FrozenCache " << after.frozenMemoryUsed() << "\n";
+
+  const int maxThreads(std::max(2u, boost::thread::hardware_concurrency()));
+  out << "  threads  SimpleCache gets/us  FrozenCache gets/us\n";
+  for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+  {
+    const double beforeRate(lookupsPerMicrosecond(before, codes, numThreads));
+    const double afterRate(lookupsPerMicrosecond(after, codes, numThreads));
+    out << "  " << numThreads << "  " << beforeRate << "  " << afterRate << "\n";
+  }
+}
+}
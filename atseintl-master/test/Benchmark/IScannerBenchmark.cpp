@@ -0,0 +1,77 @@
+//----------------------------------------------------------------------------
+//  Copyright Sabre 2016
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//----------------------------------------------------------------------------
+#include "test/Benchmark/Benchmark.h"
+#include "Xform/CustomXMLParser/IBaseHandler.h"
+#include "Xform/CustomXMLParser/IParser.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace tse
+{
+namespace
+{
+class CountingHandler : public IBaseHandler
+{
+public:
+  bool startElement(const IKeyString&, const IAttributes&) override
+  {
+    ++_elements;
+    return true;
+  }
+  void characters(const char*, size_t length) override { _characters += length; }
+  bool endElement(const IKeyString&) override { return true; }
+  bool startElement(int, const IAttributes&) override { return true; }
+  bool endElement(int) override { return true; }
+
+  size_t _elements = 0;
+  size_t _characters = 0;
+};
+
+std::string
+readFile(const std::string& name)
+{
+  std::ifstream input(name.c_str());
+  std::ostringstream content;
+  content << input.rdbuf();
+  return content.str();
+}
+}
+
+// Parse throughput of the sample requests, utbench is run from the source root.
+TSE_BENCHMARK(IScannerParse)
+{
+  const char* const files[] = {"Xform/test/shopping_request.xml",
+                               "Xform/test/XformClientShoppingXML1.xml"};
+  const int REPEAT = 200;
+  for (const char* file : files)
+  {
+    const std::string request(readFile(file));
+    if (request.empty())
+      throw std::runtime_error(std::string("cannot read ") + file);
+
+    CountingHandler handler;
+    const benchmark::Stopwatch stopwatch;
+    for (int i = 0; i < REPEAT; ++i)
+    {
+      IParser parser(request, handler);
+      parser.parse();
+    }
+    const double us(stopwatch.elapsedMicroseconds());
+    out << "  " << file << ": " << request.size() * REPEAT / us << " MB/s, "
+        << handler._elements / REPEAT << " elements\n";
+  }
+}
+}
@@ -0,0 +1,119 @@
+//----------------------------------------------------------------------------
+//  Copyright Sabre 2016
+//
+//          The copyright to the computer program(s) herein
+//          is the property of Sabre.
+//          The program(s) may be used and/or copied only with
+//          the written permission of Sabre or in accordance
+//          with the terms and conditions stipulated in the
+//          agreement/contract under which the program(s)
+//          have been supplied.
+//
+//----------------------------------------------------------------------------
+#include "DBAccess/LRUCache.h"
+#include "DBAccess/ShardedLRUCache.h"
+#include "test/Benchmark/Benchmark.h"
+#include "test/Benchmark/CacheEnvironment.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace tse
+{
+namespace
+{
+typedef int Key;
+
+class StringFactory : public sfc::KeyedFactory<Key, std::string>
+{
+public:
+  std::string* create(Key key) override
+  {
+    return new std::string(boost::lexical_cast<std::string>(key));
+  }
+
+  void destroy(Key key, std::string* object) override { delete object; }
+};
+
+// Each worker hammers a small, hot key range, which is the access pattern of
+// the Fare and GeneralFareRule caches in a busy pricing server.
+struct Worker
+{
+  Worker(sfc::Cache<Key, std::string>& cache, int numKeys, int numGets, int seed, int& numErrors)
+    : _cache(cache), _numKeys(numKeys), _numGets(numGets), _seed(seed), _numErrors(numErrors)
+  {
+  }
+
+  void run()
+  {
+    unsigned state(static_cast<unsigned>(_seed) * 2654435761u + 1);
+    for (int i = 0; i < _numGets; ++i)
+    {
+      state = state * 1103515245u + 12345u;
+      const Key key(static_cast<Key>((state >> 8) % _numKeys));
+      const std::string* ptr(_cache.get(key).get());
+      if (nullptr == ptr || *ptr != boost::lexical_cast<std::string>(key))
+      {
+        ++_numErrors;
+      }
+    }
+  }
+
+  sfc::Cache<Key, std::string>& _cache;
+  const int _numKeys;
+  const int _numGets;
+  const int _seed;
+  int& _numErrors;
+};
+
+// lookups per microsecond with numThreads threads hitting warm keys
+double
+runContention(sfc::Cache<Key, std::string>& cache, int numThreads, int numGets)
+{
+  std::vector<boost::thread> threads(numThreads);
+  std::vector<int> numErrors(numThreads, 0);
+  const benchmark::Stopwatch stopwatch;
+  for (int i = 0; i < numThreads; ++i)
+  {
+    Worker worker(cache, 5000, numGets, i, numErrors[i]);
+    threads[i] = boost::thread(boost::bind(&Worker::run, worker));
+  }
+  for (int i = 0; i < numThreads; ++i)
+  {
+    threads[i].join();
+    if (numErrors[i])
+      throw std::runtime_error("cache returned a wrong object");
+  }
+  return static_cast<double>(numThreads) * numGets /
+         std::max(1.0, stopwatch.elapsedMicroseconds());
+}
+}
+
+// The single mutex LRUCache against ShardedLRUCache, 1 to all cores.
+TSE_BENCHMARK(ShardedLRUCacheContention)
+{
+  benchmark::CacheEnvironment environment;
+  StringFactory factory;
+  const int maxThreads(std::max(2u, boost::thread::hardware_concurrency()));
+  const int NUMGETS(50000);
+
+  sfc::LRUCache<Key, std::string> lru(factory, "Test", 1, 10000);
+  sfc::ShardedLRUCache<Key, std::string> sharded(factory, "Test", 1, 10000);
+  runContention(lru, 1, 5000);
+  runContention(sharded, 1, 5000);
+
+  out << "  threads  LRUCache gets/us  ShardedLRUCache gets/us\n";
+  for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+  {
+    const double lruRate(runContention(lru, numThreads, NUMGETS));
+    const double shardedRate(runContention(sharded, numThreads, NUMGETS));
+    out << "  " << numThreads << "  " << lruRate << "  " << shardedRate << "\n";
+  }
+  lru.emptyTrash();
+  sharded.emptyTrash();
+}
+}